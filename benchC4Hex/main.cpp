@@ -0,0 +1,509 @@
+#include <MC3D/Interface/MCGenerator.hpp>
+#include <MC3D/Interface/Reader.hpp>
+
+#include <MC3D/Algorithm/TetRemesher.hpp>
+
+#include <QGP3D/ISP/ISPQuantizer.hpp>
+#include <QGP3D/SeparationChecker.hpp>
+
+#include <C4Hex/Algorithm/MCCollapser.hpp>
+#include <C4Hex/Interface/HexRemesher.hpp>
+#include <C4Hex/Interface/IGMGenerator.hpp>
+#include <C4Hex/Interface/PipelineReport.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace mc3d;
+using namespace qgp3d;
+using namespace c4hex;
+
+namespace
+{
+
+/**
+ * @brief Measurements of a single stage of the pipeline run on a single input
+ */
+struct StageResult
+{
+    std::string input;
+    std::string stage;
+    bool success = true;
+    bool converged = true; // false if an iterative stage stopped at its iteration limit
+    double seconds = 0.0;
+    size_t tets = 0;    // tets in the base mesh at the end of the stage
+    size_t hexes = 0;   // hexes in the quantization/hex mesh at the end of the stage (0 if not yet known)
+    size_t peakRSS = 0; // KiB
+};
+
+const char* CSV_HEADER = "input,stage,status,seconds,tets,hexes,tets_per_second,hexes_per_second,peak_rss_kib";
+
+/**
+ * @brief Generate an (n x n x n)-cube of Kuhn-subdivided cells with its identity parametrization in .hexex format.
+ *        Interior vertices are jittered geometrically (not parametrically), so the parametrization is non-trivial.
+ *
+ * @param n IN: cells per side, the quantized mesh has n^3 hexes at scaling 1
+ * @param jitter IN: maximum vertex displacement relative to the cell size (< 0.25 keeps the geometry valid)
+ * @param filename IN: file to write to
+ * @return true if written
+ * @return false else
+ */
+bool writeGridMesh(int n, double jitter, const std::string& filename)
+{
+    std::ofstream os(filename);
+    if (!os.good())
+        return false;
+    os << std::setprecision(17);
+
+    auto vIdx = [n](int i, int j, int k) { return (i * (n + 1) + j) * (n + 1) + k; };
+    vector<Vec3i> uvws;
+    std::mt19937 rng(n);
+    std::uniform_real_distribution<double> dist(-jitter, jitter);
+    os << (n + 1) * (n + 1) * (n + 1) << "\n";
+    for (int i = 0; i <= n; i++)
+        for (int j = 0; j <= n; j++)
+            for (int k = 0; k <= n; k++)
+            {
+                Vec3i uvw(i, j, k);
+                uvws.emplace_back(uvw);
+                Vec3d xyz(i, j, k);
+                for (int coord = 0; coord < 3; coord++)
+                    if (uvw[coord] > 0 && uvw[coord] < n)
+                        xyz[coord] += dist(rng);
+                os << xyz[0] / n << " " << xyz[1] / n << " " << xyz[2] / n << "\n";
+            }
+
+    // Kuhn subdivision: one tet per monotone path from (0,0,0) to (1,1,1) through the cube
+    const int perms[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    os << 6 * n * n * n << "\n";
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            for (int k = 0; k < n; k++)
+                for (const auto& perm : perms)
+                {
+                    std::array<int, 4> tet;
+                    Vec3i corner(i, j, k);
+                    tet[0] = vIdx(corner[0], corner[1], corner[2]);
+                    for (int step = 0; step < 3; step++)
+                    {
+                        corner[perm[step]]++;
+                        tet[step + 1] = vIdx(corner[0], corner[1], corner[2]);
+                    }
+                    Vec3i d1 = uvws[tet[1]] - uvws[tet[0]];
+                    Vec3i d2 = uvws[tet[2]] - uvws[tet[0]];
+                    Vec3i d3 = uvws[tet[3]] - uvws[tet[0]];
+                    if (((d1 % d2) | d3) < 0)
+                        std::swap(tet[2], tet[3]);
+                    os << tet[0] << " " << tet[1] << " " << tet[2] << " " << tet[3];
+                    for (int v : tet)
+                        os << " " << uvws[v][0] << " " << uvws[v][1] << " " << uvws[v][2];
+                    os << "\n";
+                }
+    return os.good();
+}
+
+/**
+ * @brief Run the collapse pipeline (read, MC tracing/reduction, quantization, collapsing, IGM generation, hex
+ *        extraction, smoothing, write) on \p inputFile and record each stage
+ *
+ * @param name IN: name of the input in the results
+ * @param inputFile IN: .hexex file to read
+ * @param outputFile IN: .vtk file to write the hex mesh to
+ * @param scaling IN: quantization scaling
+ * @param untanglingIter IN: inner untangling iterations per outer IGM untangling iteration
+ * @param smoothIter IN: surface smoothing iterations of the hex mesh
+ * @param snapBits IN: denominator bits to snap block-interior IGM coordinates to (0 for exact values)
+ * @param results OUT: measurements appended per stage
+ * @return true if all stages succeeded
+ * @return false else
+ */
+bool runPipeline(const std::string& name,
+                 const std::string& inputFile,
+                 const std::string& outputFile,
+                 double scaling,
+                 int untanglingIter,
+                 int smoothIter,
+                 int snapBits,
+                 vector<StageResult>& results)
+{
+    TetMesh meshRaw;
+    MCMesh mcMeshRaw;
+    TetMeshProps meshProps(meshRaw, mcMeshRaw);
+    size_t nHexes = 0;
+
+    auto runStage = [&](const std::string& stage, const std::function<int()>& call)
+    {
+        LOG(INFO) << "Benchmarking " << stage << " on " << name << "...";
+        StageResult result;
+        result.input = name;
+        result.stage = stage;
+        PipelineReport::resetPeakRSS();
+        auto start = std::chrono::high_resolution_clock::now();
+        int ret = call();
+        result.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        result.peakRSS = PipelineReport::peakRSS();
+        result.tets = meshRaw.n_logical_cells();
+        result.hexes = nHexes;
+        result.success = ret == 0;
+        if (!result.success)
+            LOG(ERROR) << stage << " failed on " << name << " with error code " << ret;
+        results.push_back(result);
+        return result.success;
+    };
+
+    MCGenerator mcgen(meshProps);
+    if (!runStage("read",
+                  [&]()
+                  {
+                      meshProps.allocate<TOUCHED>(true);
+                      return Reader(meshProps, inputFile).readSeamlessParam();
+                  })
+        || !runStage("trace_mc", [&]() { return mcgen.traceMC(true, true); })
+        || !runStage("reduce_mc", [&]() { return mcgen.reduceMC(true, true, true); })
+        || !runStage("derefine_base_mesh",
+                     [&]()
+                     {
+                         meshProps.allocate<TOUCHED>(true);
+                         TetRemesher(meshProps).collapseAllPossibleEdges(true, true, false, false);
+                         return 0;
+                     })
+        || !runStage("quantize",
+                     [&]()
+                     {
+                         SeparationChecker sep(meshProps);
+                         ISPQuantizer quantizer(meshProps, sep);
+                         auto ret = quantizer.quantize(scaling, 0.0);
+                         nHexes = sep.numHexesInQuantization();
+                         return ret;
+                     })
+        || !runStage("collapse",
+                     [&]()
+                     {
+                         MCCollapser collapser(meshProps);
+                         collapser.markZeros();
+                         if (!collapser.hasZeroLengthArcs())
+                             return (int)MCCollapser::SUCCESS;
+                         return (int)collapser.collapseAllZeroElements();
+                     }))
+        return false;
+
+    IGMGenerator igmgen(meshProps);
+    bool igmConverged = true;
+    if (!runStage("generate_igm",
+                  [&]()
+                  {
+                      auto ret = igmgen.generateBlockwiseIGM(
+                          false, untanglingIter, 40, IGMGenerator::RemeshSchedule::FIXED, snapBits);
+                      // An IGM that is not fully untangled can still be extracted, so the pipeline continues
+                      igmConverged = ret != IGMGenerator::NO_CONVERGENCE;
+                      return igmConverged ? (int)ret : (int)IGMGenerator::SUCCESS;
+                  }))
+        return false;
+    if (!igmConverged)
+    {
+        LOG(WARNING) << "generate_igm did not converge on " << name;
+        results.back().converged = false;
+    }
+    // IGMInitializer and IGMUntangler are interleaved with remeshing, report their shares of the IGM stage. Status and
+    // peak memory belong to generate_igm only
+    for (auto stageAndSeconds : {std::make_pair("igm_initializer", igmgen.initializationSeconds()),
+                                 std::make_pair("igm_untangler", igmgen.untanglingSeconds())})
+    {
+        StageResult result;
+        result.input = name;
+        result.stage = stageAndSeconds.first;
+        result.seconds = stageAndSeconds.second;
+        result.tets = meshRaw.n_logical_cells();
+        results.push_back(result);
+    }
+
+    HexRemesher hexer(meshProps);
+    HexMesh hexMeshRaw;
+    HexMeshProps hexMeshProps(hexMeshRaw);
+    return runStage("extract_hex_mesh",
+                    [&]()
+                    {
+                        auto ret = hexer.extractHexMesh(hexMeshProps);
+                        nHexes = hexMeshRaw.n_logical_cells();
+                        return ret;
+                    })
+           && runStage("smooth_hex_mesh", [&]() { return hexer.smoothSurface(hexMeshProps, smoothIter); })
+           && runStage("write_hex_mesh",
+                       [&]() { return hexer.writeHexMesh(hexMeshProps, outputFile, HexRemesher::VTK_BINARY); });
+}
+
+/**
+ * @brief Keep the fastest run of each stage and the highest peak memory over repetitions
+ */
+void mergeRepetition(vector<StageResult>& best, const vector<StageResult>& rep)
+{
+    for (const auto& result : rep)
+    {
+        auto it = std::find_if(best.begin(),
+                               best.end(),
+                               [&](const StageResult& r) { return r.input == result.input && r.stage == result.stage; });
+        if (it == best.end())
+            best.push_back(result);
+        else
+        {
+            it->success = it->success && result.success;
+            it->converged = it->converged && result.converged;
+            it->seconds = std::min(it->seconds, result.seconds);
+            it->peakRSS = std::max(it->peakRSS, result.peakRSS);
+        }
+    }
+}
+
+const char* statusString(const StageResult& r)
+{
+    return !r.success ? "failed" : (r.converged ? "ok" : "no_convergence");
+}
+
+bool writeResults(const vector<StageResult>& results, std::ostream& os)
+{
+    os << CSV_HEADER << "\n";
+    for (const auto& r : results)
+    {
+        double seconds = std::max(r.seconds, 1e-9);
+        os << r.input << "," << r.stage << "," << statusString(r) << "," << r.seconds << "," << r.tets
+           << "," << r.hexes << "," << r.tets / seconds << "," << r.hexes / seconds << "," << r.peakRSS << "\n";
+    }
+    return os.good();
+}
+
+bool readResults(const std::string& filename, vector<StageResult>& results)
+{
+    std::ifstream is(filename);
+    std::string line;
+    if (!std::getline(is, line) || line != CSV_HEADER)
+    {
+        LOG(ERROR) << filename << " is not a benchmark result file";
+        return false;
+    }
+    while (std::getline(is, line))
+    {
+        if (line.empty())
+            continue;
+        std::stringstream ss(line);
+        vector<std::string> cells;
+        std::string cell;
+        while (std::getline(ss, cell, ','))
+            cells.push_back(cell);
+        bool malformed = cells.size() != 9;
+        StageResult result;
+        if (!malformed)
+        {
+            result.input = cells[0];
+            result.stage = cells[1];
+            result.success = cells[2] != "failed";
+            result.converged = cells[2] != "no_convergence";
+            malformed = cells[2] != statusString(result);
+            try
+            {
+                result.seconds = std::stod(cells[3]);
+                result.tets = std::stoul(cells[4]);
+                result.hexes = std::stoul(cells[5]);
+                result.peakRSS = std::stoul(cells[8]);
+            }
+            catch (const std::logic_error&)
+            {
+                // std::invalid_argument or std::out_of_range
+                malformed = true;
+            }
+        }
+        if (malformed)
+        {
+            LOG(ERROR) << "Malformed line in " << filename << ": " << line;
+            return false;
+        }
+        results.push_back(result);
+    }
+    return true;
+}
+
+/**
+ * @brief Print the relative change of time and peak memory of each stage from \p baseFile to \p newFile
+ *
+ * @return int number of regressions, i.e. stages that got slower/bigger by more than \p threshold, started failing
+ *             or stopped converging (-1 if a file could not be read)
+ */
+int compareResults(const std::string& baseFile, const std::string& newFile, double threshold, double minSeconds)
+{
+    vector<StageResult> base, comp;
+    if (!readResults(baseFile, base) || !readResults(newFile, comp))
+        return -1;
+
+    int nRegressions = 0;
+    std::cout << std::left << std::setw(24) << "input" << std::setw(22) << "stage" << std::right << std::setw(12)
+              << "base [s]" << std::setw(12) << "new [s]" << std::setw(10) << "time" << std::setw(10) << "memory"
+              << "\n";
+    auto relChange = [](double a, double b) { return a > 0 ? (b - a) / a : 0.0; };
+    for (const auto& r : comp)
+    {
+        auto it = std::find_if(base.begin(),
+                               base.end(),
+                               [&](const StageResult& b) { return b.input == r.input && b.stage == r.stage; });
+        std::cout << std::left << std::setw(24) << r.input << std::setw(22) << r.stage << std::right;
+        if (it == base.end())
+        {
+            std::cout << std::setw(12) << "-" << std::setw(12) << r.seconds << "  (new)\n";
+            continue;
+        }
+        double dt = relChange(it->seconds, r.seconds);
+        double dm = relChange(it->peakRSS, r.peakRSS);
+        bool slower = dt > threshold && std::max(it->seconds, r.seconds) >= minSeconds;
+        bool bigger = dm > threshold;
+        bool failing = it->success && !r.success;
+        bool diverging = it->success && r.success && it->converged && !r.converged;
+        std::cout << std::fixed << std::setprecision(3) << std::setw(12) << it->seconds << std::setw(12) << r.seconds
+                  << std::showpos << std::setprecision(1) << std::setw(9) << 100 * dt << "%" << std::setw(9)
+                  << 100 * dm << "%" << std::noshowpos << std::defaultfloat;
+        if (failing || diverging || slower || bigger)
+        {
+            nRegressions++;
+            std::cout << "  REGRESSION" << (failing ? " (failed)" : "") << (diverging ? " (no convergence)" : "");
+        }
+        std::cout << "\n";
+    }
+    for (const auto& b : base)
+        if (std::none_of(comp.begin(),
+                         comp.end(),
+                         [&](const StageResult& r) { return b.input == r.input && b.stage == r.stage; }))
+            std::cout << std::left << std::setw(24) << b.input << std::setw(22) << b.stage << "  (removed)\n";
+    return nRegressions;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"C4Hex benchmark suite"};
+    vector<std::string> inputFiles;
+    bool skipResources = false;
+    vector<int> gridSizes = {4, 8};
+    double jitter = 0.2;
+    double scaling = 1.0;
+    int untanglingIter = 500;
+    int smoothIter = 2;
+    int snapBits = 0;
+    int repetitions = 1;
+    std::string workDir = ".";
+    std::string outputFile = "c4hex_bench.csv";
+    vector<std::string> compareFiles;
+    double threshold = 0.1;
+    double minSeconds = 0.05;
+
+    app.add_option("--input", inputFiles, "Additional .hexex files to benchmark");
+    app.add_flag("--no-resources", skipResources, "Skip the bundled example inputs (hand_q, rockerarm_q, fancy_ring_q)");
+    app.add_option("--grid", gridSizes, "Sizes n of the generated n x n x n parametrized grid meshes (default 4 8)")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--jitter",
+                   jitter,
+                   "Geometric jitter of generated grid vertices relative to the cell size, in [0, 0.25) to keep the "
+                   "grid valid (default 0.2)")
+        ->check(CLI::NonNegativeNumber)
+        ->check(
+            [](const std::string& value)
+            { return std::stod(value) < 0.25 ? std::string() : std::string("Jitter must be less than 0.25"); });
+    app.add_option("--scaling", scaling, "Quantization scaling");
+    app.add_option(
+        "--untangling-iter", untanglingIter, "Number of IGM foldover-removal untangling iterations (default 500)");
+    app.add_option("--smooth-iter", smoothIter, "Surface smoothing iterations of the hex mesh (default 2)");
+    app.add_option("--igm-snap-bits", snapBits, "Snap block-interior IGM coordinates to multiples of 1/2^k");
+    app.add_option("--repetitions", repetitions, "Runs per input, the fastest run of each stage is reported")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--work-dir", workDir, "Directory to write generated inputs and hex meshes to");
+    app.add_option("--output", outputFile, "CSV file to write the results to");
+    app.add_option("--compare",
+                   compareFiles,
+                   "Compare two result files (baseline first) instead of benchmarking. Exits with 1 if any stage "
+                   "regressed")
+        ->expected(2);
+    app.add_option("--threshold", threshold, "Relative change considered a regression in comparison mode")
+        ->check(CLI::NonNegativeNumber);
+    app.add_option("--min-seconds",
+                   minSeconds,
+                   "Stages faster than this are not considered time regressions in comparison mode")
+        ->check(CLI::NonNegativeNumber);
+
+    try
+    {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError& e)
+    {
+        return app.exit(e);
+    }
+
+    if (!compareFiles.empty())
+    {
+        int nRegressions = compareResults(compareFiles[0], compareFiles[1], threshold, minSeconds);
+        if (nRegressions < 0)
+            return 2;
+        std::cout << nRegressions << " regression(s) above " << 100 * threshold << "%\n";
+        return nRegressions == 0 ? 0 : 1;
+    }
+
+    vector<pair<std::string, std::string>> inputs;
+    if (!skipResources)
+        for (std::string name : {"hand_q", "rockerarm_q", "fancy_ring_q"})
+            inputs.emplace_back(name, std::string(C4HEX_BENCH_RESOURCE_DIR) + name + ".hexex");
+    for (const auto& file : inputFiles)
+    {
+        std::string name = file.substr(file.find_last_of("/\\") + 1);
+        inputs.emplace_back(name.substr(0, name.find_last_of('.')), file);
+    }
+    for (int n : gridSizes)
+    {
+        std::string name = "grid_" + std::to_string(n);
+        std::string file = workDir + "/" + name + ".hexex";
+        if (!writeGridMesh(n, jitter, file))
+        {
+            LOG(ERROR) << "Could not write generated mesh " << file;
+            return 1;
+        }
+        inputs.emplace_back(name, file);
+    }
+
+    bool success = true;
+    vector<StageResult> results;
+    for (const auto& input : inputs)
+        for (int rep = 0; rep < repetitions; rep++)
+        {
+            vector<StageResult> repResults;
+            success = runPipeline(input.first,
+                                  input.second,
+                                  workDir + "/" + input.first + "_hex.vtk",
+                                  scaling,
+                                  untanglingIter,
+                                  smoothIter,
+                                  snapBits,
+                                  repResults)
+                      && success;
+            mergeRepetition(results, repResults);
+        }
+
+    writeResults(results, std::cout);
+    long nNotConverged
+        = std::count_if(results.begin(), results.end(), [](const StageResult& r) { return !r.converged; });
+    if (nNotConverged > 0)
+        std::cout << "WARNING: " << nNotConverged << " stage(s) did not converge, see status column\n";
+    std::ofstream os(outputFile);
+    if (!writeResults(results, os))
+    {
+        LOG(ERROR) << "Could not write results to " << outputFile;
+        return 1;
+    }
+
+    return success ? 0 : 1;
+}
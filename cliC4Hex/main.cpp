@@ -16,6 +16,7 @@
 #include <C4Hex/Algorithm/MCCollapser.hpp>
 #include <C4Hex/Interface/HexRemesher.hpp>
 #include <C4Hex/Interface/IGMGenerator.hpp>
+#include <C4Hex/Interface/PipelineReport.hpp>
 
 #include <C4Hex/Algorithm/IGMInitializer.hpp>
 #include <C4Hex/Algorithm/IGMUntangler.hpp>
@@ -38,6 +39,8 @@ using namespace c4hex;
         if (auto _ERROR_CODE_ = call; _ERROR_CODE_ != 0)                                                               \
         {                                                                                                              \
             LOG(ERROR) << stage << " failed with error code " << _ERROR_CODE_ << ", aborting...";                      \
+            report.fail(stage, _ERROR_CODE_);                                                                          \
+            report.write();                                                                                            \
             return (_ERROR_CODE_);                                                                                     \
         }                                                                                                              \
         LOG(INFO) << stage << " was successful!";                                                                      \
@@ -69,8 +72,20 @@ int main(int argc, char** argv)
     int timesMinimalHexes = 100;
     bool randomOrder = false;
     int direction = 0;
+    bool batchCollapses = false;
+    bool parallelBatchChecks = false;
+    bool batchSplits = false;
+    bool wavefrontTracing = false;
+    bool checkMC = false;
 
     bool optimizeBaseMesh = false;
+    bool adaptiveRemeshing = false;
+    int snapBits = 0;
+
+    std::string hexFormat = "ovm";
+    bool streamHex = false;
+
+    std::string reportFile = "";
 
     auto optInput
         = app.add_option("--input", inputFile, "Specify the input mesh & seamless parametrization file.")->required();
@@ -114,15 +129,56 @@ int main(int argc, char** argv)
         "--times-minimal", timesMinimalHexes, "By which factor to scale number of hexes for block structured");
     app.add_flag("--random-order", randomOrder, "Ordering of collapses");
     app.add_option("--collapse-direction", direction, "Direction of collapses");
+    app.add_flag("--batch-collapses",
+                 batchCollapses,
+                 "Collapse batches of 0-arcs with disjoint block neighborhoods between decimation passes");
+    app.add_flag("--parallel-batch-checks",
+                 parallelBatchChecks,
+                 "Like --batch-collapses, but evaluate and check the 0-arcs of each batch on multiple threads "
+                 "(the collapses themselves stay serial)");
+    app.add_flag("--batch-splits",
+                 batchSplits,
+                 "Split all toroidal/selfadjacent blocks at once per round when tracing the MC instead of one by one");
+    app.add_flag("--wavefront-tracing",
+                 wavefrontTracing,
+                 "Trace all motorcycles of equal distance at once when tracing the MC instead of one by one");
+    app.add_flag("--check-mc",
+                 checkMC,
+                 "Check the MC around each collapse/bisection and abort at the first operation producing an "
+                 "inconsistent MC");
     app.add_flag(
         "--optimize-base-mesh",
         optimizeBaseMesh,
         "Optimize the base mesh for IGM generation. More time consuming but better IGM quality and less inversions.");
+    app.add_flag("--adaptive-remesh, !--fixed-remesh",
+                 adaptiveRemeshing,
+                 "Whether remeshing passes during IGM generation are restricted to tangled blocks and scheduled by "
+                 "their measured cost, or follow the fixed schedule");
+    app.add_option("--igm-snap-bits",
+                   snapBits,
+                   "Snap block-interior IGM coordinates to multiples of 1/2^k to speed up exact predicates (0 to "
+                   "disable, default)");
+    auto* hexFormatOption
+        = app.add_option("--hex-format", hexFormat, "File format of the extracted meshes: ovm (default), ovmb or vtk")
+              ->check(CLI::IsMember({"ovm", "ovmb", "vtk"}));
+    app.add_flag("--stream-hex",
+                 streamHex,
+                 "Stream the hex mesh block by block to a binary VTK file instead of building it in memory (only "
+                 "combinable with --hex-format vtk). The MC mesh is written as binary OVM, the poly hex mesh is "
+                 "skipped");
+    app.add_option("--report-json",
+                   reportFile,
+                   "Specify a file to write a JSON report of wall time, peak memory and counters per stage to "
+                   "(optional)");
 
     // Parse cli options
     try
     {
         app.parse(argc, argv);
+        if (streamHex && hexFormatOption->count() > 0 && hexFormat != "vtk")
+            throw CLI::ValidationError("--stream-hex", "only writes binary VTK, but --hex-format is " + hexFormat);
+        if (streamHex)
+            hexFormat = "vtk";
     }
     catch (const CLI::ParseError& e)
     {
@@ -130,32 +186,58 @@ int main(int argc, char** argv)
     }
 
     scaling = std::max(scaling, 0.001);
+    PipelineReport report(reportFile);
+
     // Create base meshes and add property wrapper
     TetMesh meshRaw;
     MCMesh mcMeshRaw;
     TetMeshProps meshProps(meshRaw, mcMeshRaw);
 
+    auto reportMeshSizes = [&]()
+    {
+        report.setCounter("tets", meshRaw.n_logical_cells());
+        report.setCounter("tet_vertices", meshRaw.n_logical_vertices());
+        report.setCounter("mc_blocks", mcMeshRaw.n_logical_cells());
+        report.setCounter("mc_patches", mcMeshRaw.n_logical_faces());
+        report.setCounter("mc_arcs", mcMeshRaw.n_logical_edges());
+        report.setCounter("mc_nodes", mcMeshRaw.n_logical_vertices());
+    };
+
+    report.beginStage("read");
     meshProps.allocate<TOUCHED>(true);
     Reader reader(meshProps, inputFile, forceSanitization);
     if (inputHasMCwalls)
         ASSERT_SUCCESS("Reading precomputed MC walls", reader.readSeamlessParamWithWalls());
     else
         ASSERT_SUCCESS("Reading seamless map", reader.readSeamlessParam());
+    reportMeshSizes();
 
     MCGenerator mcgen(meshProps);
     if (!inputHasMCwalls)
     {
         // For default usage, the interface is simple to use and requires no property management
+        report.beginStage("trace_mc");
         ASSERT_SUCCESS("Tracing and connecting the raw MC",
-                       mcgen.traceMC(true, splitSelfadjacent || doCollapse, simulateBC, !constraintFile.empty()));
+                       mcgen.traceMC(true,
+                                     splitSelfadjacent || doCollapse,
+                                     simulateBC,
+                                     !constraintFile.empty(),
+                                     batchSplits,
+                                     wavefrontTracing));
         MCMeshNavigator(meshProps).assertValidMC(true, true);
+        reportMeshSizes();
         if (!simulateBC)
+        {
+            report.beginStage("reduce_mc");
             ASSERT_SUCCESS("Reducing the raw MC",
                            mcgen.reduceMC(!reduceSingularWalls || doCollapse, splitSelfadjacent || doCollapse, true));
+            reportMeshSizes();
+        }
     }
     else
     {
         LOG(INFO) << "Connecting a precomputed MC";
+        report.beginStage("connect_mc");
 
         // For advanced usage, some property management is required.
         // Required/Generated properties are documented for each callable function
@@ -171,12 +253,8 @@ int main(int argc, char** argv)
 
         if (!constraintFile.empty())
         {
-            meshProps.allocate<CHART_ORIG>();
-            for (CH tet : meshRaw.cells())
-                meshProps.set<CHART_ORIG>(tet, meshProps.ref<CHART>(tet));
-            meshProps.allocate<TRANSITION_ORIG>();
-            for (FH f : meshRaw.faces())
-                meshProps.set<TRANSITION_ORIG>(f, meshProps.ref<TRANSITION>(f));
+            meshProps.takeSnapshot<CHART_ORIG>();
+            meshProps.takeSnapshot<TRANSITION_ORIG>();
         }
 
         MCBuilder builder(meshProps);
@@ -217,9 +295,14 @@ int main(int argc, char** argv)
         ASSERT_SUCCESS("Connecting the MC", builder.connectMCMesh(true, splitSelfadjacent || doCollapse));
 
         MCMeshNavigator(meshProps).assertValidMC(true, true);
+        reportMeshSizes();
         if (!simulateBC)
+        {
+            report.beginStage("reduce_mc");
             ASSERT_SUCCESS("Reducing the raw MC",
                            mcgen.reduceMC(!reduceSingularWalls || doCollapse, splitSelfadjacent || doCollapse));
+            reportMeshSizes();
+        }
     }
 
     MCMeshNavigator(meshProps).assertValidMC(true, true);
@@ -228,12 +311,15 @@ int main(int argc, char** argv)
     if (!inputHasMCwalls)
     {
         LOG(INFO) << "Derefining the base mesh after MC computation...";
+        report.beginStage("derefine_base_mesh");
         meshProps.allocate<TOUCHED>(true);
-        remesher.collapseAllPossibleEdges(true, true, false, false);
+        report.setCounter("edge_collapses", remesher.collapseAllPossibleEdges(true, true, false, false));
+        reportMeshSizes();
     }
 
     if (!wallsFile.empty())
     {
+        report.beginStage("write_walls");
         ASSERT_SUCCESS("Writing walls", Writer(meshProps, wallsFile, exactOutput).writeSeamlessParamAndWalls());
     }
 
@@ -247,10 +333,16 @@ int main(int argc, char** argv)
     int minimalHexes = 1;
     if (!constraintFile.empty() || doCollapse || !outputIGMFile.empty() || !outputHexFile.empty())
     {
+        // Both quantizations share one session: constraints found for the minimal quantization carry over
+        SeparationChecker sep(meshProps);
+        ISPQuantizer quantizer(meshProps, sep);
         {
-            SeparationChecker sep(meshProps);
-            ASSERT_SUCCESS("Quantization", ISPQuantizer(meshProps, sep).quantize(0.0001, lowerBound));
+            report.beginStage("quantize_minimal");
+            ASSERT_SUCCESS("Quantization", quantizer.quantize(0.0001, lowerBound));
             minimalHexes = sep.numHexesInQuantization();
+            report.setCounter("lp_solves", quantizer.nLPSolves());
+            report.setCounter("separation_rounds", quantizer.nSeparationRounds());
+            report.setCounter("hexes", minimalHexes);
             vector<double> aLengths;
             for (auto a : mcMeshRaw.edges())
                 aLengths.emplace_back(meshProps.get<MC_MESH_PROPS>()->get<ARC_DBL_LENGTH>(a));
@@ -262,11 +354,15 @@ int main(int argc, char** argv)
             LOG(INFO) << "To keep " << scaling * 100 << "% of arcs above length 0.5, a scaling factor of " << newScaling
                       << " for collapsing was chosen";
         }
-        SeparationChecker sep(meshProps);
-        ASSERT_SUCCESS("Quantization", ISPQuantizer(meshProps, sep).quantize(newScaling, lowerBound));
+        report.beginStage("quantize");
+        ASSERT_SUCCESS("Quantization", quantizer.quantize(newScaling, lowerBound));
+        report.setCounter("lp_solves", quantizer.nLPSolves());
+        report.setCounter("separation_rounds", quantizer.nSeparationRounds());
+        report.setCounter("hexes", sep.numHexesInQuantization());
         if (doCollapse && !MCCollapser(meshProps).hasZeroLengthArcs())
         {
             LOG(INFO) << "No 0-arcs, nothing to collapse, exiting...";
+            report.write();
             return 0;
         }
         MCCollapser(meshProps).markZeros();
@@ -277,40 +373,86 @@ int main(int argc, char** argv)
         if (optimizeBaseMesh)
         {
             LOG(INFO) << "Optimizing the base mesh before MC collapsing...";
+            report.beginStage("optimize_base_mesh");
             meshProps.allocate<TOUCHED>(true);
-            remesher.collapseAllPossibleEdges(false, true, true, true, 10);
+            report.setCounter("edge_collapses", remesher.collapseAllPossibleEdges(false, true, true, true, 10));
+            reportMeshSizes();
+        }
+        report.beginStage("collapse");
+        MCCollapser collapser(meshProps);
+        collapser.setConsistencyChecks(checkMC);
+        collapser.setParallelBatchChecks(parallelBatchChecks);
+        try
+        {
+            ASSERT_SUCCESS(
+                "Collapsing 0-arcs",
+                collapser.collapseAllZeroElements(
+                    optimizeBaseMesh, randomOrder, direction, batchCollapses || parallelBatchChecks));
         }
-        ASSERT_SUCCESS("Collapsing 0-arcs",
-                       MCCollapser(meshProps).collapseAllZeroElements(optimizeBaseMesh, randomOrder, direction));
+        catch (const std::logic_error& e)
+        {
+            LOG(ERROR) << "Collapsing 0-arcs aborted: " << e.what();
+            report.fail("Collapsing 0-arcs", MCCollapser::COLLAPSE_ERROR);
+            report.write();
+            return MCCollapser::COLLAPSE_ERROR;
+        }
+        report.setCounter("collapsed_arcs", collapser.nCollapsedArcs());
+        report.setCounter("collapse_batches", collapser.nArcBatches());
+        report.setCounter("collapsed_patches", collapser.nCollapsedPatches());
+        report.setCounter("collapsed_blocks", collapser.nCollapsedBlocks());
+        reportMeshSizes();
         if (blockStructured)
         {
+            report.beginStage("quantize_block_structured");
             Q paramVol = 0;
             for (CH tet : meshRaw.cells())
                 paramVol += mcgen.rationalVolumeUVW(tet);
             double optimalScaling = std::pow(timesMinimalHexes * minimalHexes / paramVol.get_d(), 1.0 / 3);
 
             SeparationChecker sep(meshProps);
-            ASSERT_SUCCESS("Quantization block structured", ISPQuantizer(meshProps, sep).quantize(optimalScaling, 1.0));
+            ISPQuantizer quantizer(meshProps, sep);
+            ASSERT_SUCCESS("Quantization block structured", quantizer.quantize(optimalScaling, 1.0));
+            report.setCounter("lp_solves", quantizer.nLPSolves());
+            report.setCounter("separation_rounds", quantizer.nSeparationRounds());
+            report.setCounter("hexes", sep.numHexesInQuantization());
         }
     }
     else if (!constraintFile.empty())
+    {
+        report.beginStage("write_constraints");
         ASSERT_SUCCESS("Writing constraints", ConstraintWriter(meshProps, constraintFile).writeTetPathConstraints());
+    }
 
     if (!outputIGMFile.empty() || !outputHexFile.empty())
     {
+        report.beginStage("generate_igm");
         IGMGenerator igmgen(meshProps);
         LOG(INFO) << "Generating IGM...";
-        auto ret = igmgen.generateBlockwiseIGM(optimizeBaseMesh, untanglingIter, 40);
+        auto ret = igmgen.generateBlockwiseIGM(optimizeBaseMesh,
+                                               untanglingIter,
+                                               40,
+                                               adaptiveRemeshing ? IGMGenerator::RemeshSchedule::ADAPTIVE
+                                                                 : IGMGenerator::RemeshSchedule::FIXED,
+                                               snapBits);
         if (ret == IGMGenerator::SUCCESS)
             LOG(INFO) << "Generating IGM was successful";
         else if (ret == IGMGenerator::NO_CONVERGENCE)
             LOG(INFO) << "Generated IGM has some inversions";
         else
             LOG(ERROR) << "Generating IGM failed with error code " << ret << ", aborting...";
+        report.setCounter("untangling_iterations", igmgen.nUntanglingIterations());
+        reportMeshSizes();
+        if (ret == IGMGenerator::SUCCESS || ret == IGMGenerator::NO_CONVERGENCE)
+        {
+            // Exact inversion sweep, not part of the timed IGM generation
+            report.endStage();
+            report.setCounter("inverted_tets", igmgen.nInvertedTetsIGM());
+        }
 
         if (!outputIGMFile.empty())
         {
             // remesher.remeshToImproveAngles(true, true, TetMeshManipulator::QualityMeasure::VL_RATIO);
+            report.beginStage("write_igm");
             ASSERT_SUCCESS("Writing IGM", Writer(meshProps, outputIGMFile + "_exact.igm", true).writeIGMAndWalls());
             ASSERT_SUCCESS("Writing IGM", Writer(meshProps, outputIGMFile + ".igm", false).writeIGM());
         }
@@ -340,30 +482,61 @@ int main(int argc, char** argv)
             else if (nHexes > 50)
                 nSmooth = 1;
 
+            HexRemesher::FileFormat format = hexFormat == "vtk"    ? HexRemesher::VTK_BINARY
+                                             : hexFormat == "ovmb" ? HexRemesher::OVM_BINARY
+                                                                   : HexRemesher::OVM_ASCII;
+            std::string hexExtension = format == HexRemesher::VTK_BINARY ? ".vtk" : "." + hexFormat;
+            // Poly meshes are always written as OVM, binary unless ASCII was requested
+            HexRemesher::FileFormat polyFormat = format == HexRemesher::OVM_ASCII ? format : HexRemesher::OVM_BINARY;
+            std::string polyExtension = polyFormat == HexRemesher::OVM_ASCII ? ".ovm" : ".ovmb";
+
             HexRemesher hexer(meshProps);
             {
+                report.beginStage("extract_mc_mesh");
                 PolyMesh polyMCMesh;
                 PolyMeshProps polyMCMeshProps(polyMCMesh);
                 ASSERT_SUCCESS("Extracting MC mesh", hexer.extractMCMesh(polyMCMeshProps));
-                ASSERT_SUCCESS("Writing MC mesh", hexer.writePolyHexMesh(polyMCMeshProps, outputHexFile + "_MC.ovm"));
+                ASSERT_SUCCESS("Writing MC mesh",
+                               hexer.writePolyHexMesh(
+                                   polyMCMeshProps, outputHexFile + "_MC" + polyExtension, polyFormat));
             }
 
+            if (streamHex)
             {
+                report.beginStage("stream_hex_mesh");
+                ASSERT_SUCCESS("Streaming hex mesh", hexer.streamHexMesh(outputHexFile + "_hex.vtk"));
+                // The poly hex mesh would have to be built in memory as a whole, which streaming avoids, so skip it
+            }
+            else
+            {
+                report.beginStage("extract_hex_mesh");
                 HexMesh hexMeshRaw;
                 HexMeshProps hexMeshProps(hexMeshRaw);
                 ASSERT_SUCCESS("Extracting hex mesh", hexer.extractHexMesh(hexMeshProps));
                 ASSERT_SUCCESS("Smoothing hex mesh", hexer.smoothSurface(hexMeshProps, 0));
-                ASSERT_SUCCESS("Writing hex mesh", hexer.writeHexMesh(hexMeshProps, outputHexFile + "_hex.ovm"));
+                report.setCounter("hexes", hexMeshRaw.n_logical_cells());
+                report.beginStage("write_hex_mesh");
+                ASSERT_SUCCESS("Writing hex mesh",
+                               hexer.writeHexMesh(hexMeshProps, outputHexFile + "_hex" + hexExtension, format));
+
+                report.beginStage("extract_poly_hex_mesh");
+                PolyMesh polyHexMesh;
+                PolyMeshProps polyMeshProps(polyHexMesh);
+
+                ASSERT_SUCCESS("Extracting poly hex mesh", hexer.extractPolyHexMesh(polyMeshProps, nsub));
+                report.setCounter("subdivisions", nsub);
+                report.beginStage("smooth_poly_hex_mesh");
+                ASSERT_SUCCESS("Smoothing poly hex mesh", hexer.smoothSurface(polyMeshProps, nSmooth));
+                report.setCounter("smoothing_iterations", nSmooth);
+                report.beginStage("write_poly_hex_mesh");
+                ASSERT_SUCCESS("Writing poly hex mesh",
+                               hexer.writePolyHexMesh(
+                                   polyMeshProps, outputHexFile + "_poly" + polyExtension, polyFormat));
             }
-
-            PolyMesh polyHexMesh;
-            PolyMeshProps polyMeshProps(polyHexMesh);
-
-            ASSERT_SUCCESS("Extracting poly hex mesh", hexer.extractPolyHexMesh(polyMeshProps, nsub));
-            ASSERT_SUCCESS("Smoothing poly hex mesh", hexer.smoothSurface(polyMeshProps, nSmooth));
-            ASSERT_SUCCESS("Writing poly hex mesh", hexer.writePolyHexMesh(polyMeshProps, outputHexFile + "_poly.ovm"));
         }
     }
 
+    ASSERT_SUCCESS("Writing pipeline report", report.write());
+
     return 0;
 }
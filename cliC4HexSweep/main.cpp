@@ -0,0 +1,358 @@
+#include <MC3D/Interface/MCGenerator.hpp>
+#include <MC3D/Interface/Reader.hpp>
+
+#include <MC3D/Algorithm/TetRemesher.hpp>
+
+#include <QGP3D/ISP/ISPQuantizer.hpp>
+#include <QGP3D/SeparationChecker.hpp>
+
+#include <C4Hex/Algorithm/MCCollapser.hpp>
+#include <C4Hex/Interface/HexRemesher.hpp>
+#include <C4Hex/Interface/IGMGenerator.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define C4HEX_SWEEP_FORK
+#endif
+
+using namespace mc3d;
+using namespace qgp3d;
+using namespace c4hex;
+
+namespace
+{
+
+/**
+ * @brief One combination of the swept parameters
+ */
+struct SweepConfig
+{
+    double scaling = 0.0;
+    int timesMinimal = 100;
+    int direction = 0;
+    bool randomOrder = false;
+
+    std::string name() const
+    {
+        std::stringstream ss;
+        ss << "s" << scaling << "_t" << timesMinimal << "_d" << direction << "_r" << randomOrder;
+        return ss.str();
+    }
+};
+
+/**
+ * @brief Outcome of one configuration, passed from a forked child to the parent as raw bytes
+ */
+struct SweepResult
+{
+    int errorCode = -1;
+    int hexes = 0;
+    int invertedTets = 0;
+    double seconds = 0.0;
+};
+
+/**
+ * @brief Settings shared by all configurations
+ */
+struct SweepSettings
+{
+    std::string outputPrefix;
+    bool blockStructured = false;
+    int untanglingIter = 500;
+    bool writeHex = true;
+};
+
+/**
+ * @brief Read the input and compute the reduced MC and derefined base mesh, i.e. the state shared by all configurations
+ *
+ * @param meshProps IN/OUT: empty mesh to fill
+ * @param inputFile IN: .hexex file
+ * @return int 0 on success, else error code of the failed step
+ */
+int computeMC(TetMeshProps& meshProps, const std::string& inputFile)
+{
+    meshProps.allocate<TOUCHED>(true);
+    if (auto ret = Reader(meshProps, inputFile).readSeamlessParam(); ret != Reader::SUCCESS)
+        return ret;
+    MCGenerator mcgen(meshProps);
+    if (auto ret = mcgen.traceMC(true, true); ret != MCGenerator::SUCCESS)
+        return ret;
+    if (auto ret = mcgen.reduceMC(true, true, true); ret != MCGenerator::SUCCESS)
+        return ret;
+    meshProps.allocate<TOUCHED>(true);
+    TetRemesher(meshProps).collapseAllPossibleEdges(true, true, false, false);
+    return 0;
+}
+
+/**
+ * @brief Quantize, collapse, generate the IGM and extract the hex mesh for one configuration, as done by c4hex_cli
+ *        with --collapse
+ *
+ * @param meshProps IN/OUT: mesh equipped with the reduced MC, modified by this configuration
+ * @param config IN: swept parameters
+ * @param settings IN: shared parameters
+ * @return SweepResult hex count, inversions and time of this configuration
+ */
+SweepResult runConfig(TetMeshProps& meshProps, const SweepConfig& config, const SweepSettings& settings)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    SweepResult result;
+    const MCMesh& mcMeshRaw = meshProps.get<MC_MESH_PROPS>()->mesh();
+    auto finish = [&](int errorCode)
+    {
+        result.errorCode = errorCode;
+        result.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        return result;
+    };
+
+    int minimalHexes = 1;
+    {
+        SeparationChecker sep(meshProps);
+        ISPQuantizer quantizer(meshProps, sep);
+        if (auto ret = quantizer.quantize(0.0001, 0); ret != ISPQuantizer::SUCCESS)
+            return finish(ret);
+        minimalHexes = sep.numHexesInQuantization();
+
+        // Same choice of scaling as c4hex_cli: keep the given fraction of arcs above length 0.5
+        vector<double> aLengths;
+        for (auto a : mcMeshRaw.edges())
+            aLengths.emplace_back(meshProps.get<MC_MESH_PROPS>()->get<ARC_DBL_LENGTH>(a));
+        std::sort(aLengths.begin(), aLengths.end());
+        double scaling = std::max(config.scaling, 0.001);
+        size_t idx = std::min(aLengths.size() - 1, (size_t)(aLengths.size() * (1.0 - scaling)));
+        if (auto ret = quantizer.quantize(0.4 / aLengths.at(idx), 0); ret != ISPQuantizer::SUCCESS)
+            return finish(ret);
+        result.hexes = sep.numHexesInQuantization();
+    }
+
+    MCCollapser collapser(meshProps);
+    collapser.markZeros();
+    if (collapser.hasZeroLengthArcs())
+    {
+        if (auto ret = collapser.collapseAllZeroElements(false, config.randomOrder, config.direction);
+            ret != MCCollapser::SUCCESS)
+            return finish(ret);
+        if (settings.blockStructured)
+        {
+            MCGenerator mcgen(meshProps);
+            Q paramVol = 0;
+            for (CH tet : meshProps.mesh().cells())
+                paramVol += mcgen.rationalVolumeUVW(tet);
+            double optimalScaling = std::pow(config.timesMinimal * minimalHexes / paramVol.get_d(), 1.0 / 3);
+
+            SeparationChecker sep(meshProps);
+            ISPQuantizer quantizer(meshProps, sep);
+            if (auto ret = quantizer.quantize(optimalScaling, 1.0); ret != ISPQuantizer::SUCCESS)
+                return finish(ret);
+            result.hexes = sep.numHexesInQuantization();
+        }
+    }
+
+    IGMGenerator igmgen(meshProps);
+    auto retIGM = igmgen.generateBlockwiseIGM(false, settings.untanglingIter);
+    if (retIGM != IGMGenerator::SUCCESS && retIGM != IGMGenerator::NO_CONVERGENCE)
+        return finish(retIGM);
+    result.invertedTets = igmgen.nInvertedTetsIGM();
+
+    if (settings.writeHex)
+    {
+        HexRemesher hexer(meshProps);
+        HexMesh hexMeshRaw;
+        HexMeshProps hexMeshProps(hexMeshRaw);
+        if (auto ret = hexer.extractHexMesh(hexMeshProps); ret != HexRemesher::SUCCESS)
+            return finish(ret);
+        result.hexes = hexMeshRaw.n_logical_cells();
+        if (auto ret = hexer.writeHexMesh(
+                hexMeshProps, settings.outputPrefix + "_" + config.name() + "_hex.vtk", HexRemesher::VTK_BINARY);
+            ret != HexRemesher::SUCCESS)
+            return finish(ret);
+    }
+
+    return finish(0);
+}
+
+void printSummary(const vector<SweepConfig>& configs, const vector<SweepResult>& results, std::ostream& os)
+{
+    os << std::left << std::setw(32) << "configuration" << std::right << std::setw(8) << "status" << std::setw(10)
+       << "hexes" << std::setw(10) << "inverted" << std::setw(12) << "time [s]"
+       << "\n";
+    for (size_t i = 0; i < configs.size(); i++)
+        os << std::left << std::setw(32) << configs[i].name() << std::right << std::setw(8) << results[i].errorCode
+           << std::setw(10) << results[i].hexes << std::setw(10) << results[i].invertedTets << std::setw(12)
+           << std::fixed << std::setprecision(2) << results[i].seconds << std::defaultfloat << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"C4Hex parameter sweep"};
+    std::string inputFile = "";
+    vector<double> scalings = {0.0};
+    vector<int> timesMinimals = {100};
+    vector<int> directions = {0};
+    vector<int> randomOrders = {0};
+    SweepSettings settings;
+    settings.outputPrefix = "sweep";
+    int jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::string summaryFile = "";
+
+    app.add_option("--input", inputFile, "Specify the input mesh & seamless parametrization file.")->required();
+    app.add_option("--scaling", scalings, "Values of the relative quantization scaling to sweep (see c4hex_cli)");
+    app.add_option("--times-minimal", timesMinimals, "Values of the block structured hex factor to sweep");
+    app.add_option("--collapse-direction", directions, "Values of the collapse direction to sweep");
+    app.add_option("--random-order", randomOrders, "Values (0/1) of the collapse ordering to sweep");
+    app.add_flag("--block-structured",
+                 settings.blockStructured,
+                 "Whether to collapse first and then requantize to --times-minimal times the minimal amount of hexes");
+    app.add_option(
+        "--untangling-iter", settings.untanglingIter, "Number of IGM foldover-removal untangling iterations");
+    app.add_flag("--hex, !--no-hex", settings.writeHex, "Whether to extract and write a hex mesh per configuration");
+    app.add_option("--output-prefix", settings.outputPrefix, "Prefix of the hex mesh files written per configuration");
+    app.add_option("--jobs", jobs, "Number of configurations processed in parallel")->check(CLI::PositiveNumber);
+    app.add_option("--summary", summaryFile, "Specify a file to write the summary table to (optional)");
+
+    try
+    {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError& e)
+    {
+        return app.exit(e);
+    }
+
+    vector<SweepConfig> configs;
+    for (double scaling : scalings)
+        for (int timesMinimal : timesMinimals)
+            for (int direction : directions)
+                for (int randomOrder : randomOrders)
+                    configs.push_back({scaling, timesMinimal, direction, randomOrder != 0});
+    vector<SweepResult> results(configs.size());
+
+    TetMesh meshRaw;
+    MCMesh mcMeshRaw;
+    TetMeshProps meshProps(meshRaw, mcMeshRaw);
+
+#ifdef C4HEX_SWEEP_FORK
+    // The MC is computed once, each configuration runs in a forked process that shares the pages of the MC state
+    // copy-on-write with the parent and only copies what it modifies
+    LOG(INFO) << "Computing the MC shared by " << configs.size() << " configurations...";
+    if (int ret = computeMC(meshProps, inputFile); ret != 0)
+    {
+        LOG(ERROR) << "Computing the MC failed with error code " << ret << ", aborting...";
+        return ret;
+    }
+    std::cout.flush();
+
+    map<pid_t, pair<size_t, int>> running; // child -> (config index, read end of result pipe)
+    auto reapOne = [&]()
+    {
+        int status = 0;
+        pid_t pid = -1;
+        do
+            pid = waitpid(-1, &status, 0);
+        while (pid < 0 && errno == EINTR);
+        if (pid < 0)
+        {
+            // No children left to wait for (ECHILD), so none of the remaining ones will report a result
+            LOG(ERROR) << "Waiting for configurations failed: " << std::strerror(errno);
+            for (auto& kv : running)
+            {
+                LOG(ERROR) << "Configuration " << configs[kv.second.first].name() << " terminated abnormally";
+                close(kv.second.second);
+            }
+            running.clear();
+            return;
+        }
+        auto it = running.find(pid);
+        if (it == running.end())
+            return;
+        auto [i, fd] = it->second;
+        SweepResult result;
+        if (read(fd, &result, sizeof(result)) == (ssize_t)sizeof(result))
+            results[i] = result;
+        else
+            LOG(ERROR) << "Configuration " << configs[i].name() << " terminated abnormally";
+        close(fd);
+        running.erase(it);
+    };
+
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        while ((int)running.size() >= jobs)
+            reapOne();
+        int fds[2];
+        if (pipe(fds) != 0)
+        {
+            LOG(ERROR) << "Could not create pipe for configuration " << configs[i].name();
+            continue;
+        }
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(fds[0]);
+            LOG(INFO) << "Running configuration " << configs[i].name();
+            SweepResult result = runConfig(meshProps, configs[i], settings);
+            ssize_t written = write(fds[1], &result, sizeof(result));
+            close(fds[1]);
+            _exit(written == (ssize_t)sizeof(result) ? 0 : 1);
+        }
+        close(fds[1]);
+        if (pid < 0)
+        {
+            LOG(ERROR) << "Could not fork for configuration " << configs[i].name();
+            close(fds[0]);
+            continue;
+        }
+        running[pid] = {i, fds[0]};
+    }
+    while (!running.empty())
+        reapOne();
+#else
+    // Without fork, the MC is recomputed for each configuration
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        TetMesh meshRawConfig;
+        MCMesh mcMeshRawConfig;
+        TetMeshProps meshPropsConfig(meshRawConfig, mcMeshRawConfig);
+        if (int ret = computeMC(meshPropsConfig, inputFile); ret != 0)
+        {
+            results[i].errorCode = ret;
+            continue;
+        }
+        results[i] = runConfig(meshPropsConfig, configs[i], settings);
+    }
+#endif
+
+    printSummary(configs, results, std::cout);
+    if (!summaryFile.empty())
+    {
+        std::ofstream os(summaryFile);
+        printSummary(configs, results, os);
+        if (!os.good())
+        {
+            LOG(ERROR) << "Could not write summary to " << summaryFile;
+            return 1;
+        }
+    }
+
+    // Report failure if any configuration failed
+    bool anyFailed = std::any_of(
+        results.begin(), results.end(), [](const SweepResult& result) { return result.errorCode != 0; });
+    return anyFailed ? 1 : 0;
+}
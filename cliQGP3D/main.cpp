@@ -137,12 +137,8 @@ int main(int argc, char** argv)
             meshProps.allocate<IS_ORIGINAL_V>(false);
             for (auto v : meshRaw.vertices())
                 meshProps.set<IS_ORIGINAL_V>(v, true);
-            meshProps.allocate<CHART_ORIG>();
-            for (auto tet : meshRaw.cells())
-                meshProps.set<CHART_ORIG>(tet, meshProps.ref<CHART>(tet));
-            meshProps.allocate<TRANSITION_ORIG>();
-            for (auto f : meshRaw.faces())
-                meshProps.set<TRANSITION_ORIG>(f, meshProps.ref<TRANSITION>(f));
+            meshProps.takeSnapshot<CHART_ORIG>();
+            meshProps.takeSnapshot<TRANSITION_ORIG>();
         }
 
         MCBuilder builder(meshProps);
@@ -199,7 +195,8 @@ int main(int argc, char** argv)
         if (iqpTimeLimit > 0)
             ASSERT_SUCCESS("Quantization (Exact)", IQPQuantizer(meshProps, sep).quantize(scaling, -DBL_MAX, iqpTimeLimit));
 #endif
-        ASSERT_SUCCESS("Writing constraints", ConstraintWriter(meshProps, constraintFile).writeTetPathConstraints());
+        ASSERT_SUCCESS("Writing constraints",
+                       ConstraintWriter(meshProps, constraintFile).writeTetPathConstraints(sep.constraintContext()));
     }
 
     return 0;
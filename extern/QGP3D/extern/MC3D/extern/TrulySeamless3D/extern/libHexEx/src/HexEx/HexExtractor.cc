@@ -29,6 +29,10 @@
 #include <queue>
 #include <algorithm>
 
+#ifdef HEXEX_WITH_OPENMP
+#include <omp.h>
+#endif
+
 #include "Utils.hh"
 #include "ExactPredicates.hh"
 
@@ -40,6 +44,63 @@
 using namespace OpenVolumeMesh;
 using namespace HexEx;
 
+namespace
+{
+
+// Per cell visited marks that can be reset in constant time by advancing a generation counter.
+class CellMarks
+{
+public:
+    void reset(size_t nCells)
+    {
+        if (stamps.size() < nCells)
+            stamps.resize(nCells, 0u);
+        if (++generation == 0u)
+        {
+            std::fill(stamps.begin(), stamps.end(), 0u);
+            generation = 1u;
+        }
+    }
+
+    bool isMarked(CellHandle ch) const { return stamps[ch.idx()] == generation; }
+    void mark(CellHandle ch) { stamps[ch.idx()] = generation; }
+    void unmark(CellHandle ch) { stamps[ch.idx()] = 0u; }
+
+private:
+    std::vector<unsigned int> stamps;
+    unsigned int generation = 0u;
+};
+
+// A hex vertex found inside an element of the input mesh, before it is added to the intermediate hex mesh.
+struct HVertexCandidate
+{
+    Position position;
+    Parameter parameter;
+    CellHandle incidentCell;
+    int incidentElementId;
+};
+
+// Calls collect(i, buffer) for all i in [0, n) and returns the per thread buffers.
+// With a static schedule every thread processes one contiguous range of indices, in the order of the thread
+// numbers, so traversing the buffers front to back yields the collected items in the order of a serial loop.
+template <typename T, typename CollectFunction>
+std::vector<std::vector<T>> collectInParallel(int n, CollectFunction collect)
+{
+#ifdef HEXEX_WITH_OPENMP
+    auto buffers = std::vector<std::vector<T>>(omp_get_max_threads());
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+        collect(i, buffers[omp_get_thread_num()]);
+#else
+    auto buffers = std::vector<std::vector<T>>(1);
+    for (int i = 0; i < n; ++i)
+        collect(i, buffers.front());
+#endif
+    return buffers;
+}
+
+}
+
 // const Transition HexExtractor::identity = Transition();
 
 HexExtractor::HexExtractor()
@@ -63,8 +124,8 @@ HexExtractor::HexExtractor()
       differenceBetweenInvertedAndProperDartsPerCell(intermediateHexMesh.request_cell_property<int>()),
       differenceBetweenInvertedAndProperDartsPerHalfface(intermediateHexMesh.request_halfface_property<int>()),
       incidentElementId(intermediateHexMesh.request_vertex_property<int>()),
-      darts(intermediateHexMesh.request_vertex_property<std::vector<std::shared_ptr<Dart>>>()),
-      secondaryDarts(intermediateHexMesh.request_vertex_property<std::vector<std::shared_ptr<Dart>>>()),
+      darts(intermediateHexMesh.request_vertex_property<std::vector<Dart*>>()),
+      secondaryDarts(intermediateHexMesh.request_vertex_property<std::vector<Dart*>>()),
       localUVs(intermediateHexMesh.request_vertex_property<Parameter>()),
       localCellUVs(intermediateHexMesh.request_cell_property<VertexMapProp<Parameter>>()),
       equivalenceClassIds(intermediateHexMesh.request_vertex_property<int>()),
@@ -140,6 +201,10 @@ void HexExtractor::extractHVertices()
 {
     intermediateHexMesh.clear(false);
 
+    // the cell types are cached on first use, compute them before they are queried concurrently
+    if (!cellTypesComputed)
+        computeCellTypes();
+
     for (auto vh : inputMesh.vertices())
         incidentVerticesPerVertex[vh] = VertexHandle();
     for (auto eh : inputMesh.edges())
@@ -178,38 +243,65 @@ void HexExtractor::extractHVertices()
         }
     }
 
+    // edges, faces and cells are searched for integer points in parallel, the candidates are added to the
+    // intermediate hex mesh in the order of a serial traversal, so the resulting vertex handles do not change
+    auto addHVertices = [&](const std::vector<std::vector<HVertexCandidate>>& candidates, HVertexType type)
+    {
+        for (auto& buffer : candidates)
+            for (auto& candidate : buffer)
+            {
+                auto vh = intermediateHexMesh.add_vertex(candidate.position);
+                vertexTypes[vh] = type;
+                incidentCellInInputMesh[vh] = candidate.incidentCell;
+                hexvertexParameter[vh] = candidate.parameter;
+                incidentElementId[vh] = candidate.incidentElementId;
+                if (type == EHVertex)
+                    incidentVerticesPerEdge[EdgeHandle(candidate.incidentElementId)].push_back(vh);
+                else if (type == FHVertex)
+                    incidentVerticesPerFace[FaceHandle(candidate.incidentElementId)].push_back(vh);
+                else if (type == CHVertex)
+                    incidentVerticesPerCell[CellHandle(candidate.incidentElementId)].push_back(vh);
+            }
+    };
+
     HEXEX_DEBUG_ONLY(std::cout << "Extraction vertices on edges" << std::endl;)
 
-    for (auto e_it = inputMesh.edges_begin(); e_it != inputMesh.edges_end(); ++e_it)
+    // a NaN in the parametrization stops the extraction at the first edge it is found on
+    auto nEdges = (int)inputMesh.n_edges();
+    auto nanVertex = VertexHandle();
+    for (auto i = 0; i < nEdges && !nanVertex.is_valid(); ++i)
     {
+        auto eh = EdgeHandle(i);
+        auto e = inputMesh.edge(eh);
+        auto adjacentCell = *inputMesh.hec_iter(inputMesh.halfedge_handle(eh,0));
+
+        for (auto vh : {e.from_vertex(), e.to_vertex()})
+        {
+            auto u = parameter(adjacentCell, vh);
+            if (std::isnan(u[0]) ||  std::isnan(u[1]) ||  std::isnan(u[2]))
+            {
+                nanVertex = vh;
+                nEdges = i;
+                break;
+            }
+        }
+    }
 
-        HEXEX_DEBUG_ONLY(if ((e_it->idx() % 10000) == 0)
-          std::cout << "Processing edge " << e_it->idx() << " of " <<  inputMesh.n_edges() << std::endl;)
+    auto edgeCandidates = collectInParallel<HVertexCandidate>(nEdges, [&](int idx, std::vector<HVertexCandidate>& candidates)
+    {
+        HEXEX_DEBUG_ONLY(if ((idx % 10000) == 0)
+          std::cout << "Processing edge " << idx << " of " <<  inputMesh.n_edges() << std::endl;)
 
-        auto e = inputMesh.edge(*e_it);
-        auto he = inputMesh.halfedge_handle(*e_it,0);
+        auto eh = EdgeHandle(idx);
+        auto e = inputMesh.edge(eh);
+        auto he = inputMesh.halfedge_handle(eh,0);
         auto adjacentCell = *inputMesh.hec_iter(he);
 
         auto p = inputPosition(e.from_vertex());
         auto q = inputPosition(e.to_vertex());
 
-//        p = inputMesh.vertex(e.from_vertex());
-//        q = inputMesh.vertex(e.to_vertex());
-
         auto u = parameter(adjacentCell, e.from_vertex());
         auto v = parameter(adjacentCell, e.to_vertex());
-        if (std::isnan(u[0]) ||  std::isnan(u[1]) ||  std::isnan(u[2]))
-        {
-            std::cerr << "hexex: NaN in parameterisation of vertex "
-                << e.from_vertex().idx() << "." << std::endl;
-            return; // or completely abort?
-        }
-        if (std::isnan(v[0]) ||  std::isnan(v[1]) ||  std::isnan(v[2]))
-        {
-            std::cerr << "hexex: NaN in parameterisation of vertex "
-                << e.to_vertex().idx() << "." << std::endl;
-            return; // or completely abort?
-        }
 
         double start = -1;
         double end = -1;
@@ -233,7 +325,7 @@ void HexExtractor::extractHVertices()
         if (start == end)
         {
             // skip degenerated edge
-            continue;
+            return;
         }
 
         for (int i = ceil(start); i <= floor(end); ++i)
@@ -245,31 +337,33 @@ void HexExtractor::extractHVertices()
                 auto roundW = roundVector(w);
 
 //                if (isOnLine(u,v,roundW))
-                if (isOnEdge(adjacentCell,*e_it,roundW))
+                if (isOnEdge(adjacentCell,eh,roundW))
                 {
                     auto pos = (1-alpha) * p + alpha * q;
-                    auto vh = intermediateHexMesh.add_vertex(pos);
-                    vertexTypes[vh] = EHVertex;
-                    incidentCellInInputMesh[vh] = adjacentCell;
-                    hexvertexParameter[vh] = roundW;
-                    incidentElementId[vh] = e_it->idx();
-                    incidentVerticesPerEdge[*e_it].push_back(vh);
+                    candidates.push_back({pos, roundW, adjacentCell, eh.idx()});
                 }
             }
 
         }
+    });
+    addHVertices(edgeCandidates, EHVertex);
 
+    if (nanVertex.is_valid())
+    {
+        std::cerr << "hexex: NaN in parameterisation of vertex "
+            << nanVertex.idx() << "." << std::endl;
+        return; // or completely abort?
     }
 
     HEXEX_DEBUG_ONLY(std::cout << "Extraction vertices on faces" << std::endl;)
 
-    for (auto f_it = inputMesh.faces_begin(); f_it != inputMesh.faces_end(); ++f_it)
+    auto faceCandidates = collectInParallel<HVertexCandidate>((int)inputMesh.n_faces(), [&](int idx, std::vector<HVertexCandidate>& candidates)
     {
-        HEXEX_DEBUG_ONLY(if ((f_it->idx() % 1000) == 0)
-          std::cout << "Processing face " << f_it->idx() << " of " <<  inputMesh.n_faces() << std::endl;)
-
+        HEXEX_DEBUG_ONLY(if ((idx % 1000) == 0)
+          std::cout << "Processing face " << idx << " of " <<  inputMesh.n_faces() << std::endl;)
 
-        auto hfh = inputMesh.halfface_handle(*f_it, 0);
+        auto fh = FaceHandle(idx);
+        auto hfh = inputMesh.halfface_handle(fh, 0);
         if (inputMesh.is_boundary(hfh))
             hfh = inputMesh.opposite_halfface_handle(hfh);
         auto adjacentCell = inputMesh.incident_cell(hfh);
@@ -280,10 +374,6 @@ void HexExtractor::extractHVertices()
         auto q = inputPosition(vertices[1]);
         auto r = inputPosition(vertices[2]);
 
-//        p = inputMesh.vertex(vertices[0]);
-//        q = inputMesh.vertex(vertices[1]);
-//        r = inputMesh.vertex(vertices[2]);
-
         auto u = parameter(adjacentCell, vertices[0]);
         auto v = parameter(adjacentCell, vertices[1]);
         auto w = parameter(adjacentCell, vertices[2]);
@@ -304,35 +394,30 @@ void HexExtractor::extractHVertices()
                     auto intPara = Parameter(x,y,z);
 //                    if (isInside(u,v,w, intPara))
                     if (isInFace(hfh, intPara))
-                    {
-                        auto vh = intermediateHexMesh.add_vertex(invParametrization.transform_point(intPara));
-                        vertexTypes[vh] = FHVertex;
-                        incidentCellInInputMesh[vh] = adjacentCell;
-                        hexvertexParameter[vh] = intPara;
-                        incidentElementId[vh] = f_it->idx();
-                        incidentVerticesPerFace[*f_it].push_back(vh);
-                    }
+                        candidates.push_back({invParametrization.transform_point(intPara), intPara, adjacentCell, fh.idx()});
                 }
-    }
+    });
+    addHVertices(faceCandidates, FHVertex);
 
     HEXEX_DEBUG_ONLY(std::cout << "Extraction vertices on cells" << std::endl;)
 
-    for (auto c_it = inputMesh.cells_begin(); c_it != inputMesh.cells_end(); ++c_it)
+    auto cellCandidates = collectInParallel<HVertexCandidate>((int)inputMesh.n_cells(), [&](int idx, std::vector<HVertexCandidate>& candidates)
     {
-        HEXEX_DEBUG_ONLY(if ((c_it->idx() % 1000) == 0)
-          std::cout << "Processing cell " << c_it->idx() << " of " <<  inputMesh.n_cells() << std::endl;)
+        HEXEX_DEBUG_ONLY(if ((idx % 1000) == 0)
+          std::cout << "Processing cell " << idx << " of " <<  inputMesh.n_cells() << std::endl;)
 
-        auto vertices = cellVertices[*c_it];
+        auto ch = CellHandle(idx);
+        auto& vertices = cellVertices[ch];
 
         auto p = inputPosition(vertices[0]);
         auto q = inputPosition(vertices[1]);
         auto r = inputPosition(vertices[2]);
         auto s = inputPosition(vertices[3]);
 
-        auto u = parameter(*c_it, vertices[0]);
-        auto v = parameter(*c_it, vertices[1]);
-        auto w = parameter(*c_it, vertices[2]);
-        auto t = parameter(*c_it, vertices[3]);
+        auto u = parameter(ch, vertices[0]);
+        auto v = parameter(ch, vertices[1]);
+        auto w = parameter(ch, vertices[2]);
+        auto t = parameter(ch, vertices[3]);
 
         double left   = std::min(std::min(std::min(u[0], v[0]), w[0]), t[0]);
         double right  = std::max(std::max(std::max(u[0], v[0]), w[0]), t[0]);
@@ -351,18 +436,11 @@ void HexExtractor::extractHVertices()
 
 //                    if ((!flipped && isInside(u,v,w,t,intPara)) ||
 //                        ( flipped && isInside(u,v,t,w,intPara)))
-                    if (isInCell(*c_it, intPara))
-                    {
-                        auto vh = intermediateHexMesh.add_vertex(invParametrization.transform_point(intPara));
-                        vertexTypes[vh] = CHVertex;
-                        incidentCellInInputMesh[vh] = *c_it;
-                        hexvertexParameter[vh] = intPara;
-                        incidentElementId[vh] = c_it->idx();
-                        incidentVerticesPerCell[*c_it].push_back(vh);
-                    }
+                    if (isInCell(ch, intPara))
+                        candidates.push_back({invParametrization.transform_point(intPara), intPara, ch, ch.idx()});
                 }
-
-    }
+    });
+    addHVertices(cellCandidates, CHVertex);
 
     HEXEX_DEBUG_ONLY(std::cout << "finished cell extraction..." << std::endl;)
 }
@@ -381,22 +459,69 @@ void HexExtractor::enumerateHPorts()
 
     HEXEX_DEBUG_ONLY(std::cout << "Enumerating ports" << std::endl;)
 
+    // everything cached on first use has to be available before the vertices are processed concurrently
+    if (!cellTypesComputed)
+        computeCellTypes();
+    if (!transitionFunctionsComputed)
+        extractTransitionFunctions();
+    // the face types are cached by whichever halfface is queried first, so query every halfface the vertices below
+    // will test (via pointsIntoFace and pointsAlongFace) in the serial order
     for (auto v_it = intermediateHexMesh.vertices_begin(); v_it != intermediateHexMesh.vertices_end(); ++v_it)
     {
-        HEXEX_DEBUG_ONLY(if ((v_it->idx() % 1000) == 0)
-          std::cout << "processing vertex " << v_it->idx() << " of " << intermediateHexMesh.n_vertices() << std::endl;)
-
         if (vertexTypes[*v_it] == VHVertex)
-            enumerateVertexHPorts(*v_it);
+        {
+            auto ivh = VertexHandle(incidentElementId[*v_it]);
+            for (auto vc_it = inputMesh.vc_iter(ivh); vc_it.valid(); ++vc_it)
+                for (auto hfh : getIncidentHalfFaces(inputMesh, *vc_it, ivh))
+                    isFaceDegenerate(hfh);
+        }
         else if (vertexTypes[*v_it] == EHVertex)
-            enumerateEdgeHPorts(*v_it);
+        {
+            auto eh = EdgeHandle(incidentElementId[*v_it]);
+            for (auto hec_it = inputMesh.hec_iter(inputMesh.halfedge_handle(eh, 0)); hec_it.valid(); ++hec_it)
+            {
+                auto incidentCell = *hec_it;
+                if (incidentCell.is_valid())
+                    for (auto hfh : getIncidentHalfFaces(inputMesh, incidentCell, eh))
+                        isFaceDegenerate(hfh);
+            }
+        }
         else if (vertexTypes[*v_it] == FHVertex)
-            enumerateFaceHPorts(*v_it);
-        else if (vertexTypes[*v_it] == CHVertex)
-            enumerateCellHPorts(*v_it);
+        {
+            auto fh = FaceHandle(incidentElementId[*v_it]);
+            for (auto hfh : {inputMesh.halfface_handle(fh, 0), inputMesh.halfface_handle(fh, 1)})
+                if (inputMesh.incident_cell(hfh).is_valid())
+                    isFaceDegenerate(hfh);
+        }
+    }
+
+    // the ports of each vertex only depend on the cells around it
+    auto n = (int)intermediateHexMesh.n_vertices();
+#ifdef HEXEX_WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (auto i = 0; i < n; ++i)
+    {
+        HEXEX_DEBUG_ONLY(if ((i % 1000) == 0)
+          std::cout << "processing vertex " << i << " of " << n << std::endl;)
+
+        auto vh = VertexHandle(i);
+        if (vertexTypes[vh] == VHVertex)
+            enumerateVertexHPorts(vh);
+        else if (vertexTypes[vh] == EHVertex)
+            enumerateEdgeHPorts(vh);
+        else if (vertexTypes[vh] == FHVertex)
+            enumerateFaceHPorts(vh);
+        else if (vertexTypes[vh] == CHVertex)
+            enumerateCellHPorts(vh);
         else
             assert(false);
     }
+
+    // distribute the ports to their cells in vertex order, as the dart tracing depends on that order
+    for (auto v_it = intermediateHexMesh.vertices_begin(); v_it != intermediateHexMesh.vertices_end(); ++v_it)
+        for (auto& port : hPortsOnVertex[*v_it])
+            hPortsInCell[port.cell()].push_back(port);
 }
 
 void HexExtractor::enumerateVertexHPorts(VertexHandle hexVh)
@@ -421,8 +546,6 @@ void HexExtractor::enumerateVertexHPorts(VertexHandle hexVh)
                 {
                     auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, EdgeHPort, inputMesh.edge_handle(heh).idx()));
                     hPortsOnVertex[hexVh].push_back(port);
-
-                    hPortsInCell[incidentCell].push_back(port);
                 }
             }
         }
@@ -439,7 +562,6 @@ void HexExtractor::enumerateVertexHPorts(VertexHandle hexVh)
                 {
                     auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, FaceHPort, hfh.idx()));
                     hPortsOnVertex[hexVh].push_back(port);
-                    hPortsInCell[incidentCell].push_back(port);
                 }
             }
         }
@@ -453,7 +575,6 @@ void HexExtractor::enumerateVertexHPorts(VertexHandle hexVh)
                 {
                     auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, CellHPort, incidentCell.idx()));
                     hPortsOnVertex[hexVh].push_back(port);
-                    hPortsInCell[incidentCell].push_back(port);
                 }
         }
     }
@@ -487,7 +608,6 @@ void HexExtractor::enumerateEdgeHPorts(VertexHandle hexVh)
             {
                 auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, EdgeHPort, eh.idx()));
                 hPortsOnVertex[hexVh].push_back(port);
-                hPortsInCell[incidentCell].push_back(port);
             }
         }
 
@@ -501,7 +621,6 @@ void HexExtractor::enumerateEdgeHPorts(VertexHandle hexVh)
                 {
                     auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, FaceHPort, hfh.idx()));
                     hPortsOnVertex[hexVh].push_back(port);
-                    hPortsInCell[incidentCell].push_back(port);
                 }
             }
         }
@@ -516,7 +635,6 @@ void HexExtractor::enumerateEdgeHPorts(VertexHandle hexVh)
                 {
                     auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, CellHPort, incidentCell.idx()));
                     hPortsOnVertex[hexVh].push_back(port);
-                    hPortsInCell[incidentCell].push_back(port);
                 }
             }
         }
@@ -550,7 +668,6 @@ void HexExtractor::enumerateFaceHPorts(VertexHandle hexVh)
             {
                 auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, FaceHPort, hfh.idx()));
                 hPortsOnVertex[hexVh].push_back(port);
-                hPortsInCell[incidentCell].push_back(port);
             }
         }
 
@@ -564,7 +681,6 @@ void HexExtractor::enumerateFaceHPorts(VertexHandle hexVh)
                 {
                     auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, CellHPort, incidentCell.idx()));
                     hPortsOnVertex[hexVh].push_back(port);
-                    hPortsInCell[incidentCell].push_back(port);
                 }
             }
         }
@@ -588,7 +704,6 @@ void HexExtractor::enumerateCellHPorts(VertexHandle hexVh)
     {
         auto port = HPortHandle(std::make_shared<HPort>(dir, param, hexVh, incidentCell, CellHPort, incidentCell.idx()));
         hPortsOnVertex[hexVh].push_back(port);
-        hPortsInCell[incidentCell].push_back(port);
     }
 }
 
@@ -713,11 +828,18 @@ void HexExtractor::enumerateDarts(HPortHandle port, bool secondary)
 
 
     auto ds = &darts[port.vertex()];
+    auto arena = &dartArena;
     if (secondary)
+    {
         ds = &secondaryDarts[port.vertex()];
+        arena = &secondaryDartArena;
+    }
 
     for (auto& d : res)
-        ds->push_back(std::shared_ptr<Dart>(new Dart(d)));
+    {
+        arena->push_back(d);
+        ds->push_back(&arena->back());
+    }
 
 }
 
@@ -733,6 +855,7 @@ void HexExtractor::enumerateDarts()
             continue;
         darts[vh].clear();
     }
+    dartArena.clear();
 
 
     HEXEX_DEBUG_ONLY(std::cout << "Enumerating darts" << std::endl;)
@@ -777,6 +900,7 @@ void HexExtractor::enumerateSecondaryDarts()
             continue;
         secondaryDarts[vh].clear();
     }
+    secondaryDartArena.clear();
 
 
 //#pragma omp parallel for
@@ -913,7 +1037,7 @@ bool HexExtractor::traceDart2(Dart& dart)
 
     // rotate around trace dir from ref dir to normal dir
 //    while (!isDartInCell(currentCell, hexVh, currentParameter, nextTraceDir, nextRefDir, nextNormalDir))
-    while (getSecondaryDart(currentCell, endParam, nextTraceDir, nextRefDir, nextNormalDir).get() == nullptr)
+    while (getSecondaryDart(currentCell, endParam, nextTraceDir, nextRefDir, nextNormalDir) == nullptr)
     {
         HEXEX_DEBUG_ONLY(if (i > 9000)
             std::cout << "ohoh" << std::endl;)
@@ -965,9 +1089,9 @@ bool HexExtractor::traceDart2(Dart& dart)
 
     auto partnerSecondaryDart = getSecondaryDart(currentCell, endParam, nextTraceDir, nextRefDir, nextNormalDir);
 
-    if (partnerSecondaryDart.get() != nullptr)
+    if (partnerSecondaryDart != nullptr)
     {
-        dart.connectAlpha<0>(partnerSecondaryDart.get());
+        dart.connectAlpha<0>(partnerSecondaryDart);
 //        assert(portFound);
         return true;
     }
@@ -1004,7 +1128,7 @@ bool HexExtractor::connectDartToPreviousSecondaryDart(Dart& dart)
 
     auto lastFace = HalfFaceHandle();
 
-    while (getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir).get() == nullptr)
+    while (getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir) == nullptr)
     {
 
         if (i++ > 10000)
@@ -1046,7 +1170,7 @@ bool HexExtractor::connectDartToPreviousSecondaryDart(Dart& dart)
 
     auto previousDart = getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir);
 
-    dart.connectAlpha<1>(previousDart.get());
+    dart.connectAlpha<1>(previousDart);
     return true;
 }
 
@@ -1098,7 +1222,7 @@ bool HexExtractor::connectDartToNeighborSecondaryDart2(Dart& dart)
 
     auto lastFace = HalfFaceHandle();
 
-    while (getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir).get() == nullptr)
+    while (getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir) == nullptr)
     {
 
         if (i++ > 10000)
@@ -1144,7 +1268,7 @@ bool HexExtractor::connectDartToNeighborSecondaryDart2(Dart& dart)
 
     auto neighborDart = getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir);
 
-    dart.connectAlpha<2>(neighborDart.get());
+    dart.connectAlpha<2>(neighborDart);
     return true;
 
 }
@@ -1195,7 +1319,7 @@ bool HexExtractor::connectDartToOppositeSecondaryDart(Dart& dart)
     int i = 0;
     int j = 0;
 
-    while (getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir).get() == nullptr)
+    while (getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir) == nullptr)
     {
 
         j++;
@@ -1241,10 +1365,10 @@ bool HexExtractor::connectDartToOppositeSecondaryDart(Dart& dart)
 
     auto oppositeDart = getSecondaryDart(currentCell, currentParameter, nextTraceDir, nextRefDir, nextNormalDir);
 
-    if (oppositeDart.get() == nullptr)
+    if (oppositeDart == nullptr)
         connectDartToOppositeSecondaryDart(dart);
 
-    dart.connectAlpha<3>(oppositeDart.get());
+    dart.connectAlpha<3>(oppositeDart);
     return true;
 }
 
@@ -1748,7 +1872,7 @@ HalfFaceHandle HexExtractor::alpha3NextFace(HalfFaceHandle prevFace, CellHandle
     return HalfFaceHandle();
 }
 
-std::shared_ptr<Dart> HexExtractor::getDart(CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir)
+Dart* HexExtractor::getDart(CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir)
 {
     int i = 0;
 
@@ -1772,10 +1896,10 @@ std::shared_ptr<Dart> HexExtractor::getDart(CellHandle ch, Parameter param, Dire
 
 
     assert(false);
-    return std::shared_ptr<Dart>(nullptr);
+    return nullptr;
 }
 
-std::shared_ptr<Dart> HexExtractor::getSecondaryDart(CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir)
+Dart* HexExtractor::getSecondaryDart(CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir)
 {
     int i = 0;
 
@@ -1799,7 +1923,7 @@ std::shared_ptr<Dart> HexExtractor::getSecondaryDart(CellHandle ch, Parameter pa
 
 
 //    assert(false);
-    return std::shared_ptr<Dart>(nullptr);
+    return nullptr;
 }
 
 
@@ -1869,10 +1993,10 @@ void HexExtractor::mergeEquivalenceClassesOfAllDarts()
             continue;
         auto& ds = darts[vh];
         for (auto& d : ds)
-            mergeEquivalenceClasses(d.get());
+            mergeEquivalenceClasses(d);
         auto& ds2 = secondaryDarts[vh];
         for (auto& d : ds2)
-            mergeEquivalenceClasses(d.get());
+            mergeEquivalenceClasses(d);
     }
 }
 
@@ -2010,7 +2134,7 @@ bool HexExtractor::fixProblems1(bool mergeVertices)
             if (d->getAlpha<0>() != nullptr)
                 if (d->isAnti() != d->getAlpha<0>()->isAnti())
                 {
-                    fixProblem1(d.get(), mergeVertices);
+                    fixProblem1(d, mergeVertices);
                     changes = true;
                 }
     }
@@ -2051,7 +2175,7 @@ bool HexExtractor::fixProblems2(bool mergeVertices)
 //                        joinEquivalenceClasses(d->getVertex(), d->getAlpha<1>()->getAlpha<0>()->getVertex());
 
 //                    joinEquivalenceClasses(d->getVertex(), d->getAlpha<1>()->getVertex());
-                    fixProblem2(d.get(), mergeVertices);
+                    fixProblem2(d, mergeVertices);
                     changes = true;
                 }
     }
@@ -2088,7 +2212,7 @@ bool HexExtractor::fixProblems3(bool mergeVertices)
                 {
 //                    joinEquivalenceClasses(d->getVertex(), d->getAlpha<2>()->getVertex());
 //                    joinEquivalenceClasses(d->getVertex(), d->getAlpha<2>()->getAlpha<1>()->getVertex());
-                    fixProblem3(d.get(), mergeVertices);
+                    fixProblem3(d, mergeVertices);
                     changes = true;
                 }
     }
@@ -2127,7 +2251,7 @@ bool HexExtractor::fixProblems4(bool mergeVertices)
                 {
 //                    joinEquivalenceClasses(d->getVertex(), d->getAlpha<3>()->getVertex());
 //                    joinEquivalenceClasses(d->getVertex(), d->getAlpha<3>()->getAlpha<1>()->getVertex());
-                    fixProblem4(d.get(), mergeVertices);
+                    fixProblem4(d, mergeVertices);
                     changes = true;
                 }
     }
@@ -2499,7 +2623,7 @@ void HexExtractor::extractFacesFromDarts()
         for (auto d: ds)
         {
             if (!d->getHalfface().is_valid())
-                extractFaceFromSecondaryDarts(d.get());
+                extractFaceFromSecondaryDarts(d);
         }
     }
 
@@ -3429,7 +3553,7 @@ void HexExtractor::checkThisOneProperty()
         for (auto& d : ds)
             if (d->isPrimary())
             {
-                auto ds2 = getDartsBetweenDarts12(d.get(), d.get());
+                auto ds2 = getDartsBetweenDarts12(d, d);
 
                 auto posDarts = 0;
                 auto negDarts = 0;
@@ -3732,96 +3856,112 @@ Parameter HexExtractor::projectedParam(Parameter param, CellHandle ch, HalfEdgeH
 
 }
 
-void HexExtractor::propagateVertexParameterRecursive(Parameter param, VertexHandle vh, CellHandle ch, std::set<CellHandle>& visited)
+void HexExtractor::propagateVertexParameter(Parameter parameter, VertexHandle vh, CellHandle startCell)
 {
-    visited.insert(ch);
+    // depth first traversal over the cells around vh with an explicit stack, visiting cells in the same order
+    // as a recursion would and stopping as soon as every cell around vh received its parameter
+    static thread_local CellMarks toBeProcessed;
+    toBeProcessed.reset(inputMesh.n_cells());
 
-    parameter(ch, vh) = param;
+    auto nToBeProcessed = 0u;
+    for (auto vc_it = inputMesh.vc_iter(vh); vc_it.valid(); ++vc_it)
+    {
+        toBeProcessed.mark(*vc_it);
+        ++nToBeProcessed;
+    }
 
-    auto halffaces = getIncidentHalfFaces(inputMesh, ch, vh);
-    for (auto hfh : halffaces)
+    auto process = [&](CellHandle ch, const Parameter& param)
     {
-        auto oppHfh = inputMesh.opposite_halfface_handle(hfh);
-        auto oppCh = inputMesh.incident_cell(oppHfh);
-        if (!oppCh.is_valid())
-            continue;
-        if (visited.count(oppCh) < 1)
+        if (toBeProcessed.isMarked(ch))
         {
-            auto newParameter = getTransitionFunction(hfh).transform_point(param);
-            propagateVertexParameterRecursive(newParameter, vh, oppCh, visited);
+            toBeProcessed.unmark(ch);
+            --nToBeProcessed;
         }
-    }
-}
-
-void HexExtractor::propagateVertexParameterRecursive2(Parameter param, VertexHandle vh, CellHandle ch, std::set<CellHandle>& toBeProcessed)
-{
-    toBeProcessed.erase(ch);
-
-    parameter(ch, vh) = param;
+        this->parameter(ch, vh) = param;
+    };
 
-    if (toBeProcessed.empty())
+    process(startCell, parameter);
+    if (nToBeProcessed == 0)
         return;
 
-    auto c = inputMesh.cell(ch);
-    auto& halffaces = c.halffaces();
+    struct Frame
+    {
+        CellHandle ch;
+        Parameter param;
+        unsigned int i;
+    };
+    auto stack = std::vector<Frame>{{startCell, parameter, 0u}};
 
-    for (auto hfh : halffaces)
+    while (!stack.empty())
     {
+        auto& frame = stack.back();
+        auto& halffaces = inputMesh.cell(frame.ch).halffaces();
+        if (frame.i == halffaces.size())
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        auto hfh = halffaces[frame.i++];
         auto oppHfh = inputMesh.opposite_halfface_handle(hfh);
         auto oppCh = inputMesh.incident_cell(oppHfh);
-        if (!oppCh.is_valid())
+        if (!oppCh.is_valid() || !toBeProcessed.isMarked(oppCh))
             continue;
-        if (toBeProcessed.count(oppCh) == 1)
-        {
-            auto newParameter = getTransitionFunction(hfh).transform_point(param);
-            propagateVertexParameterRecursive2(newParameter, vh, oppCh, toBeProcessed);
 
-            if (toBeProcessed.empty())
-                return;
-        }
+        auto newParameter = getTransitionFunction(hfh).transform_point(frame.param);
+        process(oppCh, newParameter);
+        if (nToBeProcessed == 0)
+            return;
+        stack.push_back({oppCh, newParameter, 0u});
     }
 }
 
-void HexExtractor::propagateVertexParameter(Parameter parameter, VertexHandle vh, CellHandle startCell)
+Transition HexExtractor::getTransitionFunction(CellHandle fromCell, CellHandle toCell, VertexHandle vh)
 {
-    auto toBeProcessed = std::set<CellHandle>();
-    for (auto vc_it = inputMesh.vc_iter(vh); vc_it.valid(); ++vc_it)
-        toBeProcessed.insert(*vc_it);
+    if (fromCell == toCell)
+        return identity;
 
-    propagateVertexParameterRecursive2(parameter, vh, startCell, toBeProcessed);
-}
+    // depth first search over the cells around vh, composing transitions along the current path
+    static thread_local CellMarks visited;
+    visited.reset(inputMesh.n_cells());
+    visited.mark(fromCell);
 
-Transition HexExtractor::getTransitionFunctionRecursive(CellHandle currentCell, CellHandle toCell, VertexHandle vh, Transition tranFun, std::set<CellHandle>& visited)
-{
-    visited.insert(currentCell);
-
-    if (currentCell == toCell)
-        return tranFun;
+    struct Frame
+    {
+        CellHandle ch;
+        Transition tranFun;
+        unsigned int i;
+    };
+    auto stack = std::vector<Frame>{{fromCell, identity, 0u}};
 
-    auto halffaces = getIncidentHalfFaces(inputMesh, currentCell, vh);
-    for (auto hfh : halffaces)
+    while (!stack.empty())
     {
+        auto& frame = stack.back();
+        auto& halffaces = inputMesh.cell(frame.ch).halffaces();
+        if (frame.i == halffaces.size())
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        auto hfh = halffaces[frame.i++];
+        if (!containsVertex(inputMesh.get_halfface_vertices(hfh), vh))
+            continue;
         auto oppHfh = inputMesh.opposite_halfface_handle(hfh);
         auto oppCh = inputMesh.incident_cell(oppHfh);
-        if (!oppCh.is_valid())
+        if (!oppCh.is_valid() || visited.isMarked(oppCh))
             continue;
-        if (visited.count(oppCh) < 1)
-        {
-            auto newTranFun = tranFun;
-            doTransition(hfh, newTranFun);
 
-            auto finalTranFun = getTransitionFunctionRecursive(oppCh, toCell, vh, newTranFun, visited);
-            if (visited.count(toCell) >= 1)
-                return finalTranFun;
-        }
+        auto newTranFun = frame.tranFun;
+        doTransition(hfh, newTranFun);
+        if (oppCh == toCell)
+            return newTranFun;
+
+        visited.mark(oppCh);
+        stack.push_back({oppCh, newTranFun, 0u});
     }
-    return identity;
-}
 
-Transition HexExtractor::getTransitionFunction(CellHandle fromCell, CellHandle toCell, VertexHandle vh)
-{
-    auto visited = std::set<CellHandle>();
-    return getTransitionFunctionRecursive(fromCell, toCell, vh, identity, visited);
+    return identity;
 }
 
 Transition HexExtractor::getTransitionFunction(CellHandle fromCell, CellHandle toCell, EdgeHandle eh)
@@ -4560,34 +4700,56 @@ bool HexExtractor::isSingularEdge(EdgeHandle eh)
     return edgeSingularity[eh];
 }
 
-bool HexExtractor::isFixPointRecursive(Parameter param, CellHandle ch, VertexHandle vh, std::set<CellHandle> visited)
+bool HexExtractor::isFixPoint(Parameter parameter, CellHandle ch, VertexHandle vh)
 {
-    if ((visited.count(ch) > 0) || visited.size() > 15)
-        return param == parameter(ch, vh);
+    // walks all paths of at most 16 cells around vh, a path ends when it closes a cycle
+    // and the parameter transported along it has to agree with the one stored in its last cell
+    static thread_local CellMarks onPath;
+    onPath.reset(inputMesh.n_cells());
+    onPath.mark(ch);
 
-    visited.insert(ch);
+    struct Frame
+    {
+        CellHandle ch;
+        Parameter param;
+        unsigned int i;
+    };
+    auto stack = std::vector<Frame>{{ch, parameter, 0u}};
 
-    auto halffaces = getIncidentHalfFaces(inputMesh, ch, vh);
-    for (auto hfh : halffaces)
+    while (!stack.empty())
     {
+        auto& frame = stack.back();
+        auto& halffaces = inputMesh.cell(frame.ch).halffaces();
+        if (frame.i == halffaces.size())
+        {
+            onPath.unmark(frame.ch);
+            stack.pop_back();
+            continue;
+        }
+
+        auto hfh = halffaces[frame.i++];
+        if (!containsVertex(inputMesh.get_halfface_vertices(hfh), vh))
+            continue;
         auto oppHfh = inputMesh.opposite_halfface_handle(hfh);
         auto oppCh = inputMesh.incident_cell(oppHfh);
         if (!oppCh.is_valid())
             continue;
 
-        auto newParameter = getTransitionFunction(hfh).transform_point(param);
-        if (!isFixPointRecursive(newParameter, oppCh, vh, visited))
-            return false;
+        auto newParameter = getTransitionFunction(hfh).transform_point(frame.param);
+        if (onPath.isMarked(oppCh) || stack.size() > 15)
+        {
+            if (!(newParameter == this->parameter(oppCh, vh)))
+                return false;
+            continue;
+        }
+
+        onPath.mark(oppCh);
+        stack.push_back({oppCh, newParameter, 0u});
     }
 
     return true;
 }
 
-bool HexExtractor::isFixPoint(Parameter parameter, CellHandle ch, VertexHandle vh)
-{
-    return isFixPointRecursive(parameter, ch, vh, std::set<CellHandle>());
-}
-
 /*
 HalfFaceHandle HexExtractor::rotateAroundHalfedge(CellHandle startCell, HalfEdgeHandle currentEdge, bool ccw)
 {
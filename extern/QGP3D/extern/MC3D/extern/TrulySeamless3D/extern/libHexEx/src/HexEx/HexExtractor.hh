@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+
 #include "HPort.hh"
 #include "Typedefs.hh"
 #include "Dart.hh"
@@ -295,8 +298,8 @@ private:
     HalfFaceHandle alpha3NextFace(HalfFaceHandle prevFace, CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir);
 
 
-    std::shared_ptr<Dart> getDart(CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir);
-    std::shared_ptr<Dart> getSecondaryDart(CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir);
+    Dart* getDart(CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir);
+    Dart* getSecondaryDart(CellHandle ch, Parameter param, Direction traceDir, Direction refDir, Direction normalDir);
 
     HalfEdgeHandle addEdge(HPortHandle p1, HPortHandle p2);
 
@@ -656,7 +659,6 @@ private:
     bool isSingularVertex(VertexHandle vh);
     bool isSingularEdge(EdgeHandle eh);
 
-    bool isFixPointRecursive(Parameter parameter, CellHandle ch, VertexHandle vh, std::set<CellHandle> visited);
     bool isFixPoint(Parameter parameter, CellHandle ch, VertexHandle vh);
 
     // end predicates
@@ -763,8 +765,6 @@ private:
     void fixSingularityPoint(VertexHandle vh, CellHandle& ch);
     void projectBoundaryFaces();
 
-    void propagateVertexParameterRecursive(Parameter param, VertexHandle vh, CellHandle ch, std::set<CellHandle>& visited);
-    void propagateVertexParameterRecursive2(Parameter param, VertexHandle vh, CellHandle ch, std::set<CellHandle>& toBeProcessed);
     void propagateVertexParameter(Parameter parameter, VertexHandle vh, CellHandle startCell);
 
     const Transition& getTransitionFunction(HalfFaceHandle hfh);
@@ -774,7 +774,6 @@ private:
     }
 
     Transition getTransitionFunctionAroundHalfedge(CellHandle ch, HalfEdgeHandle heh);
-    Transition getTransitionFunctionRecursive(CellHandle currentCell, CellHandle toCell, VertexHandle vh, Transition tranFun, std::set<CellHandle>& visited);
     Transition getTransitionFunction(CellHandle fromCell, CellHandle toCell, VertexHandle vh);
 
     Transition getTransitionFunction(CellHandle fromCell, CellHandle toCell, EdgeHandle eh);
@@ -929,8 +928,11 @@ private:
     CellProperty<int> differenceBetweenInvertedAndProperDartsPerCell;
     HalfFaceProperty<int> differenceBetweenInvertedAndProperDartsPerHalfface;
     VertexProperty<int> incidentElementId;
-    VertexProperty<std::vector<std::shared_ptr<Dart>>> darts;
-    VertexProperty<std::vector<std::shared_ptr<Dart>>> secondaryDarts;
+    // darts are owned by the arenas, deques keep the pointers stored in alphas and per vertex lists stable
+    std::deque<Dart> dartArena;
+    std::deque<Dart> secondaryDartArena;
+    VertexProperty<std::vector<Dart*>> darts;
+    VertexProperty<std::vector<Dart*>> secondaryDarts;
     VertexProperty<Parameter> localUVs;
     PerCellVertexProperty<Parameter> localCellUVs;
     VertexProperty<int> equivalenceClassIds;
@@ -956,9 +958,10 @@ private:
 
 
 
-    long isCellFlippedCalls;
-    long isCellDegenerateCalls;
-    long isFaceDegenerateCalls;
+    // atomic as the predicates are evaluated concurrently during hex vertex and port enumeration
+    std::atomic<long> isCellFlippedCalls;
+    std::atomic<long> isCellDegenerateCalls;
+    std::atomic<long> isFaceDegenerateCalls;
 
     CellProperty<CellType> cellTypes;
     FaceProperty<CellType> faceTypes;
@@ -997,7 +1000,6 @@ namespace OpenVolumeMesh
     NO_INPUT_OPERATOR(HexEx::HexExtractor::CellType)
     NO_INPUT_OPERATOR(HexEx::HPortHandle)
     NO_INPUT_OPERATOR(HexEx::GridIsomorphism)
-    NO_INPUT_OPERATOR(std::shared_ptr<HexEx::Dart>)
     NO_INPUT_OPERATOR(HexEx::Dart*)
 
 #undef NO_INPUT_OPERATOR
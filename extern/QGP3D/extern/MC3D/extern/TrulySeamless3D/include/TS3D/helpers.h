@@ -21,12 +21,19 @@ void divideRowByGCD(SparseMatrixi& C);
 
 void divideRow(SparseMatrixd& C, int i);
 
+// Dense reference implementation of the elimination, sparseIRREF is used for the seamlessness constraints
 void IREF(SparseMatrixi& C, VectorXd& b, VectorXi& indexC, VectorXi& indexR, bool gcd_division, double& total_time);
 void IRREF(SparseMatrixi& C, VectorXd& b, VectorXi indexC, bool gcd_division, double& total_time);
-VectorXd
-evaluate(SparseMatrixi C, VectorXd X_bar, VectorXd b, double M, double uv_max, VectorXi indexC, VectorXi indexR);
-
-double safeDotProd(vector<pair<int, double>> S, double M);
+void sparseIRREF(SparseMatrixi& C, VectorXd& b, VectorXi& indexC, VectorXi& indexR, double& total_time);
+VectorXd evaluate(const SparseMatrixi& C,
+                  const VectorXd& X_bar,
+                  const VectorXd& b,
+                  double M,
+                  double uv_max,
+                  const VectorXi& indexC,
+                  const VectorXi& indexR);
+
+double safeDotProd(const vector<pair<int, double>>& S, double M);
 double makeDiv(double x, vector<int> D, double& f_max);
 double fixedPrec(double x, double& f_max);
 double fixedPrec(VectorXd& X_bar, int k, double& f_max);
@@ -1,6 +1,11 @@
 #include "TS3D/helpers.h"
 
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <gmpxx.h>
 #include <math.h>
+#include <numeric>
 #include <stack>
 
 void divideRowByGCD(SparseMatrixi& C)
@@ -319,8 +324,368 @@ void IRREF(SparseMatrixi& C, VectorXd& b, VectorXi indexC, bool gcd_division, do
 #endif
 }
 
+namespace
+{
+// Row of a sparse integer matrix as (column, value) pairs sorted by column, without explicit zeros.
+// A row whose gcd-reduced coefficients do not fit into an int is held in arbitrary precision instead.
+struct SparseRowi
+{
+    vector<pair<int, int>> entries;          // coefficients, if !isBig
+    vector<pair<int, mpz_class>> bigEntries; // coefficients, if isBig
+    bool isBig = false;                      // whether the row needs arbitrary precision
+
+    size_t size() const
+    {
+        return isBig ? bigEntries.size() : entries.size();
+    }
+};
+
+// INT_MIN is excluded, so that a * x - c * y of four int coefficients cannot overflow 64 bit
+bool fitsRow(int64_t v)
+{
+    return v >= -INT_MAX && v <= INT_MAX;
+}
+
+bool fitsRow(const mpz_class& v)
+{
+    return v.fits_sint_p() && v >= -INT_MAX;
+}
+
+// mpz_class has no 64 bit constructor where long is 32 bit
+mpz_class toMpz(int64_t v)
+{
+    mpz_class result((int)(v >> 32));
+    result <<= 32;
+    result += (unsigned int)(v & 0xffffffff);
+    return result;
+}
+
+template <typename T>
+typename vector<pair<int, T>>::const_iterator findColumn(const vector<pair<int, T>>& entries, int j)
+{
+    auto it = lower_bound(
+        entries.begin(), entries.end(), j, [](const pair<int, T>& jv, int col) { return jv.first < col; });
+    return (it != entries.end() && it->first == j) ? it : entries.end();
+}
+
+bool rowContains(const SparseRowi& row, int j)
+{
+    return row.isBig ? findColumn(row.bigEntries, j) != row.bigEntries.end()
+                     : findColumn(row.entries, j) != row.entries.end();
+}
+
+mpz_class rowCoeff(const SparseRowi& row, int j)
+{
+    if (row.isBig)
+    {
+        auto it = findColumn(row.bigEntries, j);
+        return it != row.bigEntries.end() ? it->second : mpz_class(0);
+    }
+    auto it = findColumn(row.entries, j);
+    return it != row.entries.end() ? mpz_class(it->second) : mpz_class(0);
+}
+
+vector<pair<int, mpz_class>> bigEntriesOf(const SparseRowi& row)
+{
+    if (row.isBig)
+        return row.bigEntries;
+    vector<pair<int, mpz_class>> bigEntries;
+    for (auto& jv : row.entries)
+        bigEntries.emplace_back(jv.first, jv.second);
+    return bigEntries;
+}
+
+/* Row update row_i <- (a * row_i - c * row_k) / gcd of two int rows, dropping column jDrop.
+ * Intermediate values are computed in 64 bit. Returns false and leaves row_i untouched if the gcd-reduced row does
+ * not fit into an int. Otherwise, columns that were not present in row_i before are appended to fill. */
+bool combineIntRows(vector<pair<int, int>>& rowI,
+                    int a,
+                    const vector<pair<int, int>>& rowK,
+                    int c,
+                    int jDrop,
+                    int64_t& g,
+                    vector<pair<int, int64_t>>& tmp,
+                    vector<int>& fill)
+{
+    tmp.clear();
+    fill.clear();
+    g = 0;
+
+    auto itI = rowI.begin();
+    auto itK = rowK.begin();
+    while (itI != rowI.end() || itK != rowK.end())
+    {
+        int ix = itI != rowI.end() ? itI->first : INT_MAX;
+        int kx = itK != rowK.end() ? itK->first : INT_MAX;
+        int j = min(ix, kx);
+
+        if (j != jDrop)
+        {
+            int64_t Cij = ix == j ? itI->second : 0;
+            int64_t Ckj = kx == j ? itK->second : 0;
+            int64_t v = (int64_t)a * Cij - (int64_t)c * Ckj;
+            if (v != 0)
+            {
+                tmp.emplace_back(j, v);
+                g = std::gcd(g, v);
+                if (ix != j)
+                    fill.push_back(j);
+            }
+        }
+
+        if (ix == j)
+            ++itI;
+        if (kx == j)
+            ++itK;
+    }
+
+    if (g == 0)
+        g = 1;
+    for (auto& jv : tmp)
+        if (!fitsRow(jv.second / g))
+            return false;
+    rowI.clear();
+    for (auto& jv : tmp)
+        rowI.emplace_back(jv.first, (int)(jv.second / g));
+    return true;
+}
+
+/* Same row update as combineIntRows() in arbitrary precision, for rows that overflow in 64 bit or after reduction.
+ * Row_i is stored as int row again if its reduced coefficients fit. */
+mpz_class combineBigRows(SparseRowi& rowI,
+                         const mpz_class& a,
+                         const SparseRowi& rowK,
+                         const mpz_class& c,
+                         int jDrop,
+                         vector<int>& fill)
+{
+    fill.clear();
+    mpz_class g = 0;
+
+    vector<pair<int, mpz_class>> bigI = bigEntriesOf(rowI);
+    vector<pair<int, mpz_class>> bigK = bigEntriesOf(rowK);
+    vector<pair<int, mpz_class>> combined;
+    auto itI = bigI.begin();
+    auto itK = bigK.begin();
+    while (itI != bigI.end() || itK != bigK.end())
+    {
+        int ix = itI != bigI.end() ? itI->first : INT_MAX;
+        int kx = itK != bigK.end() ? itK->first : INT_MAX;
+        int j = min(ix, kx);
+
+        if (j != jDrop)
+        {
+            mpz_class v = 0;
+            if (ix == j)
+                v += a * itI->second;
+            if (kx == j)
+                v -= c * itK->second;
+            if (v != 0)
+            {
+                g = gcd(g, v);
+                combined.emplace_back(j, v);
+                if (ix != j)
+                    fill.push_back(j);
+            }
+        }
+
+        if (ix == j)
+            ++itI;
+        if (kx == j)
+            ++itK;
+    }
+
+    if (g == 0)
+        g = 1;
+    rowI.isBig = false;
+    for (auto& jv : combined)
+    {
+        mpz_divexact(jv.second.get_mpz_t(), jv.second.get_mpz_t(), g.get_mpz_t());
+        if (!fitsRow(jv.second))
+            rowI.isBig = true;
+    }
+    rowI.entries.clear();
+    rowI.bigEntries.clear();
+    if (rowI.isBig)
+        rowI.bigEntries = std::move(combined);
+    else
+        for (auto& jv : combined)
+            rowI.entries.emplace_back(jv.first, (int)jv.second.get_si());
+    return g;
+}
+
+/* Fraction-free row update row_i <- (a * row_i - c * row_k) / gcd and b_i <- (a * b_i - c * b_k) / gcd, dropping
+ * column jDrop. Columns that were not present in row_i before are appended to fill. The update runs on int rows in
+ * 64 bit and falls back to GMP for rows that overflow. */
+void combineRows(SparseRowi& rowI,
+                 mpz_class& bI,
+                 const mpz_class& a,
+                 const SparseRowi& rowK,
+                 const mpz_class& bK,
+                 const mpz_class& c,
+                 int jDrop,
+                 vector<pair<int, int64_t>>& tmp,
+                 vector<int>& fill)
+{
+    if (!rowI.isBig && !rowK.isBig && fitsRow(a) && fitsRow(c))
+    {
+        int64_t g;
+        if (combineIntRows(rowI.entries, (int)a.get_si(), rowK.entries, (int)c.get_si(), jDrop, g, tmp, fill))
+        {
+            bI = (a * bI - c * bK) / toMpz(g);
+            return;
+        }
+    }
+    mpz_class g = combineBigRows(rowI, a, rowK, c, jDrop, fill);
+    bI = (a * bI - c * bK) / g;
+}
+} // namespace
+
+/* Algorithm 1+2 IRREF by fraction-free Gauss-Jordan elimination on row lists.
+ * Pivot columns are chosen left to right as in IREF. Since the reduced row echelon form is unique, the reduced rows
+ * agree with IREF + IRREF with gcd division up to sign whenever both succeed. Among the candidate rows of a pivot
+ * column, the shortest one is chosen as pivot row to reduce fill, so the intermediate rows differ from IREF. Rows that
+ * overflow int during elimination are carried in arbitrary precision, b is expected to hold integers as in IREF.
+ * Throws std::runtime_error if a row of the result does not fit into an int. */
+void sparseIRREF(SparseMatrixi& C, VectorXd& b, VectorXi& indexC, VectorXi& indexR, double& total_time)
+{
+    auto start = std::chrono::high_resolution_clock::now();
 
-double getIntFactor(VectorXd& X_bar, double M, double uv_max)
+    int nRows = C.rows();
+    int nCols = C.cols();
+
+    vector<SparseRowi> rows(nRows);
+    vector<mpz_class> bExact(nRows);
+    vector<vector<int>> colRows(nCols);
+    for (int i = 0; i < nRows; i++)
+    {
+        for (SparseMatrixi::InnerIterator it(C, i); it; ++it)
+            if (it.value() != 0)
+            {
+                rows[i].entries.emplace_back(it.index(), it.value());
+                colRows[it.index()].push_back(i);
+            }
+        if (any_of(rows[i].entries.begin(),
+                   rows[i].entries.end(),
+                   [](const pair<int, int>& jv) { return !fitsRow(jv.second); }))
+        {
+            rows[i].bigEntries = bigEntriesOf(rows[i]);
+            rows[i].entries.clear();
+            rows[i].isBig = true;
+        }
+        bExact[i] = b(i);
+    }
+
+    vector<int> pivotCol(nRows, -1); // pivot column of each row
+    vector<int> pivotRow(nCols, -1); // pivot row of each column
+    vector<int> pivotRows;           // pivot rows in order of their pivot columns
+    vector<int> stamp(nRows, -1);
+    vector<int> candidates;
+    vector<pair<int, int64_t>> tmp;
+    vector<int> fill;
+    const SparseRowi noRow;
+
+    // Forward elimination (IREF)
+    for (int j = 0; j < nCols && (int)pivotRows.size() < nRows; j++)
+    {
+        candidates.clear();
+        for (int i : colRows[j])
+            if (pivotCol[i] == -1 && stamp[i] != j && rowContains(rows[i], j))
+            {
+                stamp[i] = j;
+                candidates.push_back(i);
+            }
+        vector<int>().swap(colRows[j]);
+        if (candidates.empty())
+            continue;
+
+        int k = candidates.front();
+        for (int i : candidates)
+            if (rows[i].size() < rows[k].size() || (rows[i].size() == rows[k].size() && i < k))
+                k = i;
+        pivotCol[k] = j;
+        pivotRow[j] = k;
+        pivotRows.push_back(k);
+
+        mpz_class Ckj = rowCoeff(rows[k], j);
+        for (int i : candidates)
+        {
+            if (i == k)
+                continue;
+            combineRows(rows[i], bExact[i], Ckj, rows[k], bExact[k], rowCoeff(rows[i], j), j, tmp, fill);
+            for (int jFill : fill)
+                colRows[jFill].push_back(i);
+        }
+    }
+
+    // Back substitution (IRREF), fill only occurs in non-pivot columns here
+    for (int k : pivotRows)
+    {
+        if (rows[k].isBig)
+        {
+            for (auto& jv : rows[k].bigEntries)
+                if (pivotRow[jv.first] != -1 && jv.first != pivotCol[k])
+                    colRows[jv.first].push_back(k);
+        }
+        else
+        {
+            for (auto& jv : rows[k].entries)
+                if (pivotRow[jv.first] != -1 && jv.first != pivotCol[k])
+                    colRows[jv.first].push_back(k);
+        }
+    }
+
+    for (auto itK = pivotRows.rbegin(); itK != pivotRows.rend(); ++itK)
+    {
+        int k = *itK;
+        int l = pivotCol[k];
+
+        combineRows(rows[k], bExact[k], 1, noRow, 0, 0, -1, tmp, fill);
+
+        mpz_class Ckl = rowCoeff(rows[k], l);
+        for (int i : colRows[l])
+            if (rowContains(rows[i], l))
+                combineRows(rows[i], bExact[i], Ckl, rows[k], bExact[k], rowCoeff(rows[i], l), l, tmp, fill);
+    }
+
+    // Write back with rows ordered by pivot column, zero rows last
+    indexC = VectorXi::Constant(nRows, -1);
+    indexR = VectorXi::Constant(nCols, -1);
+    VectorXd bPermuted = VectorXd::Zero(nRows);
+    vector<Triplet<int>> triplets;
+    for (int t = 0; t < (int)pivotRows.size(); t++)
+    {
+        int k = pivotRows[t];
+        if (rows[k].isBig)
+        {
+#ifndef TRULYSEAMLESS_SILENT
+            cerr << "ERROR MESSAGE : overflow in sparse elimination! Row " << k << " does not fit into int" << endl;
+#endif
+            throw std::runtime_error("Overflow in sparse integer elimination");
+        }
+        indexC(t) = pivotCol[k];
+        indexR(pivotCol[k]) = t;
+        bPermuted(t) = bExact[k].get_d();
+        for (auto& jv : rows[k].entries)
+            triplets.emplace_back(t, jv.first, jv.second);
+    }
+    for (int i = 0, t = pivotRows.size(); i < nRows; i++)
+        if (pivotCol[i] == -1)
+        {
+            assert(rows[i].size() == 0);
+            bPermuted(t++) = bExact[i].get_d();
+        }
+    C.setZero();
+    C.setFromTriplets(triplets.begin(), triplets.end());
+    b = bPermuted;
+
+    total_time = subtractTimes(start);
+#ifndef TRULYSEAMLESS_SILENT
+    cout << "running time: " << total_time << " ms" << endl;
+#endif
+}
+
+double getIntFactor(const VectorXd& X_bar, double M, double uv_max)
 {
     if (X_bar.size() <= 0)
         return 1.0;
@@ -344,8 +709,13 @@ double getIntFactor(VectorXd& X_bar, double M, double uv_max)
 }
 
 /* Algorithm 3 Evaluation */
-VectorXd
-evaluate(SparseMatrixi C, VectorXd X_bar, VectorXd b, double M, double uv_max, VectorXi indexC, VectorXi indexR)
+VectorXd evaluate(const SparseMatrixi& C,
+                  const VectorXd& X_bar,
+                  const VectorXd& b,
+                  double M,
+                  double uv_max,
+                  const VectorXi& indexC,
+                  const VectorXi& indexR)
 {
 #ifndef TRULYSEAMLESS_SILENT
     auto start = std::chrono::high_resolution_clock::now();
@@ -357,6 +727,9 @@ evaluate(SparseMatrixi C, VectorXd X_bar, VectorXd b, double M, double uv_max, V
     double f_max = getIntFactor(X_bar, M, uv_max);
     size_t max_S_size = 0;
 
+    // Column access for the free variables
+    SparseMatrix<int, ColMajor> Ccols = C;
+
     for (int k = C.innerSize() - 1; k > -1; k--)
     {
         if (indexR(k) == -1)
@@ -364,9 +737,9 @@ evaluate(SparseMatrixi C, VectorXd X_bar, VectorXd b, double M, double uv_max, V
             vector<int> D;
             D.resize(0);
 
-            for (int i = 0; i < min((int)C.outerSize(), k + 1); i++)
-                if (C.coeff(i, k) != 0 && indexC(i) != -1)
-                    D.push_back(C.coeff(i, indexC(i)));
+            for (SparseMatrix<int, ColMajor>::InnerIterator it(Ccols, k); it && it.row() <= k; ++it)
+                if (it.value() != 0 && indexC(it.row()) != -1)
+                    D.push_back(C.coeff(it.row(), indexC(it.row())));
 
             // X(k) = makeDiv(fixedPrec(X_bar, k, f_max),D);
             X(k) = makeDiv(X_bar(k), D, f_max);
@@ -400,7 +773,7 @@ evaluate(SparseMatrixi C, VectorXd X_bar, VectorXd b, double M, double uv_max, V
 }
 
 /* Algorithm 4 safeDotProd */
-double safeDotProd(vector<pair<int, double>> S, double M)
+double safeDotProd(const vector<pair<int, double>>& S, double M)
 {
     stack<pair<int, double>> P;
     stack<pair<int, double>> N;
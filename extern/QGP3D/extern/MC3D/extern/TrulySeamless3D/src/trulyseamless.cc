@@ -1369,15 +1369,10 @@ void TrulySeamless3D::computeSeamlessnessVariables()
 
     double total_time = 0.0;
 
-#ifndef TRULYSEAMLESS_SILENT
-    cout << "IREF:" << endl;
-#endif
-    IREF(C, b, indexC, indexR, true, total_time);
-
 #ifndef TRULYSEAMLESS_SILENT
     cout << "IRREF:" << endl;
 #endif
-    IRREF(C, b, indexC, true, total_time);
+    sparseIRREF(C, b, indexC, indexR, total_time);
 
     statistic(C, indexC);
 
@@ -63,6 +63,17 @@ class MCBuilder : public virtual TetMeshManipulator
      */
     RetCode updateSingleBlock(const CH& tetStart);
 
+    /**
+     * @brief Updates the temporary block data mapping for all blocks containing any of the given tets (by flood
+     *        filling). Blocks that were split into several parts are assigned one new block id per additional part.
+     *
+     * Requires Props: MC_BLOCK_ID, MC_BLOCK_DATA, IS_WALL, TRANSITION, CHART
+     *
+     * @param tetsStart IN: Tets from which to start floodfilling, usually those incident to newly traced walls
+     * @return RetCode SUCCESS or INVALID_WALLS
+     */
+    RetCode updateBlocks(const vector<CH>& tetsStart);
+
     /**
      * @brief Actually connects the mapped elements to form an MC meta mesh.
      *
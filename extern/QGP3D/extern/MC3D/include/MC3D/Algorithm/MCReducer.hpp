@@ -21,6 +21,12 @@ class MCReducer : public virtual MCMeshManipulator
      */
     MCReducer(TetMeshProps& meshProps);
 
+    /**
+     * @brief Materializes MC_BLOCK for block merges that are still pending (see removeNextPatch())
+     *
+     */
+    ~MCReducer();
+
     /**
      * @brief Initialize internal structures necessary for reduction. This depends on the mesh
      *        state so you should use it only just before actually starting the reduction.
@@ -46,6 +52,9 @@ class MCReducer : public virtual MCMeshManipulator
      * Requires all MC props
      * Requires MC_NODE, MC_ARC, MC_PATCH, MC_BLOCK, WALL DIST, CHART, TRANSITION, IS_ARC, IS_WALL
      *
+     * BLOCK_MESH_TETS is spliced instead of copied and MC_BLOCK of the merged tets is only rewritten once the
+     * reduction is exhausted (isReducible() returns false), or by calling materializeBlockOwnership().
+     *
      */
     void removeNextPatch();
 
@@ -58,6 +58,16 @@ class MotorcycleSpawner : public virtual TetMeshManipulator
      */
     RetCode spawnTorusSplitMotorcycle();
 
+    /**
+     * @brief Insert one motorcycle per toroidal block into the queue, so that tracing them all at once splits every
+     *        currently toroidal block.
+     *
+     * Requires props: MC_BLOCK_ID, MC_BLOCK_DATA, IS_ARC, CHART, TRANSITION
+     *
+     * @return RetCode SUCCESS or UNSPLITTABLE_BLOCK
+     */
+    RetCode spawnTorusSplitMotorcycles();
+
     /**
      * @brief Insert a single motorcycle into the queue that when fully traced splits a selfadjacent block.
      *
@@ -67,7 +77,81 @@ class MotorcycleSpawner : public virtual TetMeshManipulator
      */
     RetCode spawnSelfadjacencySplitMotorcycle();
 
+    /**
+     * @brief Insert one motorcycle per selfadjacent block into the queue, so that tracing them all at once splits every
+     *        currently selfadjacent block.
+     *
+     * Requires props: MC_BLOCK_ID, MC_BLOCK_DATA, IS_ARC, CHART, TRANSITION
+     *
+     * @return RetCode SUCCESS or UNSPLITTABLE_BLOCK
+     */
+    RetCode spawnSelfadjacencySplitMotorcycles();
+
   private:
+    /**
+     * @brief Insert a motorcycle that splits the toroidal block \p data, splitting an edge on its hull if necessary
+     *
+     * @param data IN: toroidal block
+     * @return true if a motorcycle was spawned
+     * @return false else
+     */
+    bool spawnTorusSplitMotorcycle(const BlockData& data);
+
+    /**
+     * @brief Try to insert a motorcycle splitting the toroidal block \p data from an edge of \p tet on the block hull
+     *
+     * @param data IN: toroidal block
+     * @param tet IN: tet of the block
+     * @param onlyArcs IN: whether only arc edges are considered as source
+     * @return true if a motorcycle was spawned
+     * @return false else
+     */
+    bool spawnTorusSplitMotorcycle(const BlockData& data, const CH& tet, bool onlyArcs);
+
+    /**
+     * @brief Split an edge of a hull face of \p tet to create a source for a motorcycle splitting the toroidal block
+     *        \p data and insert that motorcycle
+     *
+     * @param data IN: toroidal block
+     * @param tet IN: tet of the block
+     * @return true if an edge was split and a motorcycle was spawned
+     * @return false if no edge of \p tet was splittable
+     */
+    bool splitAndSpawnTorusSplitMotorcycle(const BlockData& data, const CH& tet);
+
+    /**
+     * @brief Insert a motorcycle that splits the selfadjacent block \p data, splitting an edge on its hull if
+     *        necessary
+     *
+     * @param data IN: selfadjacent block
+     * @return true if a motorcycle was spawned
+     * @return false else
+     */
+    bool spawnSelfadjacencySplitMotorcycle(const BlockData& data);
+
+    /**
+     * @brief Try to insert a motorcycle splitting the selfadjacent block \p data from an edge of \p tet on the block
+     *        hull
+     *
+     * @param data IN: selfadjacent block
+     * @param tet IN: tet of the block
+     * @param onlyArcs IN: whether only arc edges are considered as source
+     * @return true if a motorcycle was spawned
+     * @return false else
+     */
+    bool spawnSelfadjacencySplitMotorcycle(const BlockData& data, const CH& tet, bool onlyArcs);
+
+    /**
+     * @brief Split an edge of a hull face of \p tet to create a source for a motorcycle splitting the selfadjacent
+     *        block \p data and insert that motorcycle
+     *
+     * @param data IN: selfadjacent block
+     * @param tet IN: tet of the block
+     * @return true if an edge was split and a motorcycle was spawned
+     * @return false if no edge of \p tet was splittable
+     */
+    bool splitAndSpawnSelfadjacencySplitMotorcycle(const BlockData& data, const CH& tet);
+
     /**
      * @brief Checks all the prerequisites and if all are met, inserts a new motorcycle into the internal queue
      *
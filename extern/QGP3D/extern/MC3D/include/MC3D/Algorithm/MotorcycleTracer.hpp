@@ -32,8 +32,10 @@ class MotorcycleTracer : public virtual TetMeshManipulator
      * @param mQ IN: initial motorcycles to trace, OUT: motorcycles left after tracing operations (possibly empty)
      * @param simulateBC IN: whether the BC (base complex) should be traced instead of the MC. WARNING: BC may take much
      *                       longer and consume much more memory!
+     * @param wavefront IN: whether traceAllMotorcycles() should trace wavefront by wavefront (see traceNextWavefront())
+     *                      instead of motorcycle by motorcycle
      */
-    MotorcycleTracer(TetMeshProps& meshProps, MotorcycleQueue& mQ, bool simulateBC = false);
+    MotorcycleTracer(TetMeshProps& meshProps, MotorcycleQueue& mQ, bool simulateBC = false, bool wavefront = false);
 
     /**
      * @brief Successively trace all motorcycles and their children until queue exhaustion
@@ -53,6 +55,18 @@ class MotorcycleTracer : public virtual TetMeshManipulator
      */
     RetCode traceNextMotorcycle();
 
+    /**
+     * @brief Trace all motorcycles of the next wavefront, i.e. all queued motorcycles sharing the shortest distance.
+     *        The edge cuts required by these motorcycles are computed upfront and performed in one bulk subdivision,
+     *        then the motorcycles are traced in queue order as in traceNextMotorcycle(), so that walls are marked with
+     *        the same priorities. Followup motorcycles (even if of equal distance) belong to later wavefronts.
+     *
+     * Requires props: CHART, TRANSITION, IS_WALL, IS_SINGULAR, WALL_DIST, CHILD_CELLS, CHILD_EDGES, CHILD_FACES
+     *
+     * @return RetCode SUCCESS or DEGENERATE_CHART
+     */
+    RetCode traceNextWavefront();
+
     /**
      * @brief Clear the walls internally registered as marked since the last clearNewWalls() call
      *
@@ -70,6 +84,21 @@ class MotorcycleTracer : public virtual TetMeshManipulator
     vector<FH> getNewWalls();
 
   private:
+    /**
+     * @brief Trace all motorcycles in the local queue, including those inserted during tracing
+     *
+     * @return RetCode SUCCESS or DEGENERATE_CHART
+     */
+    RetCode traceLocalQueue();
+
+    /**
+     * @brief Register the edge cut needed for tracing \p mot (if its wall does not pass through an isofacet)
+     *
+     * @param mot IN: motorcycle whose tet and edge have not been split
+     * @param eCuts IN/OUT: edges to cut, each with its relative cut distances (see TetMeshManipulator::splitAll())
+     */
+    void collectEdgeCut(const Motorcycle& mot, map<EH, set<Q>>& eCuts) const;
+
     /**
      * @brief Insert a followup motorcycle of \p mot into the queue, that propagates from \p he into a tet to be
      * determined
@@ -114,6 +143,7 @@ class MotorcycleTracer : public virtual TetMeshManipulator
 
     list<FH> newWalls; // list of recently marked wall faces
     bool _simulateBC;               // whether to simulate base complex
+    bool _wavefront;                // whether to trace wavefront by wavefront
 };
 
 } // namespace mc3d
@@ -42,12 +42,15 @@ class TetRemesher : public virtual TetMeshManipulator
      * 180
      * @param angleBound IN: only used if considerAngles is true. maximum allowed closeness of resulting angles to 0 or
      * 180
+     * @param blockedBlocks IN: which blocks' tets should not be touched
+     * @return int number of collapsed halfedges
      */
-    void collapseAllPossibleEdges(bool onlyNonOriginals = true,
-                                  bool keepImportantShape = true,
-                                  bool keepInjectivity = true,
-                                  bool considerAngles = true,
-                                  double qualityBound = 5.0);
+    int collapseAllPossibleEdges(bool onlyNonOriginals = true,
+                                 bool keepImportantShape = true,
+                                 bool keepInjectivity = true,
+                                 bool considerAngles = true,
+                                 double qualityBound = 5.0,
+                                 const set<CH>& blockedBlocks = {});
 
     /**
      * @brief Remesh the tetmesh using edge-splits, edge-collapses, edge-"flips" (split->collapse)
@@ -59,12 +62,13 @@ class TetRemesher : public virtual TetMeshManipulator
      * @param stage IN: 0: perform one run without vertex shifts and another one including them, 1: perform only one run
      *                  with vertex shifts
      * @param blockedBlocks IN: which blocks' vertices should not be touched
+     * @return int number of operations (splits, flips, collapses and shifts) performed
      */
-    void remeshToImproveAngles(bool keepImportantShape = true,
-                               bool includingUVW = false,
-                               QualityMeasure quality = QualityMeasure::ANGLES,
-                               int stage = 0,
-                               const set<CH>& blockedBlocks = {});
+    int remeshToImproveAngles(bool keepImportantShape = true,
+                              bool includingUVW = false,
+                              QualityMeasure quality = QualityMeasure::ANGLES,
+                              int stage = 0,
+                              const set<CH>& blockedBlocks = {});
 
     /**
      * @brief Struct to gather relevant statistics concerning a single remesh operation
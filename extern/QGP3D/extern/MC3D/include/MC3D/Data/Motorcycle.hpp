@@ -122,7 +122,68 @@ struct Motorcycle
     };
 };
 
-using MotorcycleQueue = std::priority_queue<Motorcycle, std::deque<Motorcycle>, Motorcycle::ShorterDistFIFOTieBreak>;
+/**
+ * @brief Priority queue of motorcycles, ordered like a priority queue with ShorterDistFIFOTieBreak.
+ *
+ * Motorcycles are stored in a pool of reusable slots (so their rational members keep their allocated limbs),
+ * while the heap only holds small entries consisting of a slot index, the motorcycle ID and a double key of the
+ * motorcycle's distance. The double key is obtained by truncation (mpq_get_d), which is monotonic, so two keys that
+ * differ already imply the exact order of the distances. Only for equal keys the exact rational distances are compared.
+ *
+ */
+class MotorcycleQueue
+{
+  public:
+    /**
+     * @brief Insert a motorcycle into the queue
+     *
+     * @param mot IN: motorcycle to insert
+     */
+    void push(Motorcycle mot);
+
+    /**
+     * @brief Get the motorcycle of highest priority (shortest distance, smallest ID among equal distances)
+     *
+     * @return const Motorcycle& highest priority motorcycle (invalidated by the next push or pop)
+     */
+    const Motorcycle& top() const;
+
+    /**
+     * @brief Remove the motorcycle of highest priority
+     *
+     */
+    void pop();
+
+    /**
+     * @brief Whether no motorcycles are left in the queue
+     *
+     */
+    bool empty() const;
+
+    /**
+     * @brief Number of motorcycles in the queue
+     *
+     */
+    size_t size() const;
+
+  private:
+    struct Entry
+    {
+        double distKey; // truncated distance (never larger in magnitude than exact distance)
+        size_t ID;      // ID of the motorcycle (for FIFO tiebreak)
+        size_t slot;    // slot in _pool where the motorcycle is stored
+    };
+
+    /**
+     * @brief Heap comparator, true if \p a has lower priority than \p b
+     *
+     */
+    bool lowerPriority(const Entry& a, const Entry& b) const;
+
+    vector<Motorcycle> _pool;  // pooled motorcycle storage, addressed by slot index
+    vector<size_t> _freeSlots; // slots of _pool that may be overwritten
+    vector<Entry> _heap;       // binary max-heap (w.r.t. priority) of entries
+};
 
 } // namespace mc3d
 
@@ -37,15 +37,26 @@ class MCGenerator : public TetMeshManipulator
      *                       MC_MESH_PROPS, MC_BLOCK, MC_PATCH, MC_ARC, MC_NODE
      * Allocates all MCMesh properties.
      *
-     * If keepOrigProps is true, allocates CHART_ORIG, TRANSITION_ORIG, IS_ORIGINAL_V
+     * If keepOrigProps is true, allocates CHART_ORIG, TRANSITION_ORIG (as snapshots of CHART, TRANSITION, see
+     * MeshPropsInterface::takeSnapshot()), IS_ORIGINAL_V
      *
      * @param splitTori IN: whether to split toroidal blocks
      * @param splitSelfadjacency IN: whether to split self-adjacent blocks
      * @param simulateBC IN: whether the BC (base complex) should be traced instead of the MC. WARNING: BC may take much
      *                       longer and consume much more memory!
+     * @param keepOrigProps IN: whether to keep the original parametrization and transitions
+     * @param batchSplits IN: whether to split all toroidal/selfadjacent blocks at once in each round (one motorcycle
+     *                        per block, traced together) instead of one block at a time
+     * @param wavefront IN: whether to trace all motorcycles of equal distance at once (see
+     *                      MotorcycleTracer::traceNextWavefront()) instead of one motorcycle at a time
      * @return RetCode SUCCESS or errorcode
      */
-    RetCode traceMC(bool splitTori, bool splitSelfadjacency, bool simulateBC = false, bool keepOrigProps = false);
+    RetCode traceMC(bool splitTori,
+                    bool splitSelfadjacency,
+                    bool simulateBC = false,
+                    bool keepOrigProps = false,
+                    bool batchSplits = false,
+                    bool wavefront = false);
 
     /**
      * @brief Reduce the motorcycle complex for the given mesh.
@@ -4,6 +4,7 @@
 #include "MC3D/Mesh/TetMeshManipulator.hpp"
 #include "MC3D/Mesh/TetMeshProps.hpp"
 
+#include <cstdint>
 #include <fstream>
 #include <string>
 
@@ -28,6 +29,7 @@ class Reader : public TetMeshManipulator
     /**
      * @brief Create a reader, that reads a mesh with parametrization in .hexex format
      *  from \p fileName and writes it into \p meshProps.
+     *  Files in the binary encoding of Writer are detected automatically.
      *
      * @param meshProps OUT: this will contain the read mesh
      * @param fileName IN: file to read
@@ -62,6 +64,9 @@ class Reader : public TetMeshManipulator
     std::ifstream _is;
     bool _forceSanitization;
     bool _exactInput = false;
+    bool _binary = false;
+    uint32_t _binaryFlags = 0;
+    std::streamoff _binaryEnd = 0;
 
     /**
      * @brief Check if file is readable
@@ -70,6 +75,51 @@ class Reader : public TetMeshManipulator
      */
     RetCode checkFile();
 
+    /**
+     * @brief Detect the binary encoding written by Writer and consume its header, rewind otherwise
+     *
+     * @return RetCode SUCCESS or FILE_INACCESSIBLE
+     */
+    RetCode readHeader();
+
+    /**
+     * @brief Read the raw bytes of \p value from internal stream
+     *
+     * @param value OUT: trivially copyable value
+     * @return true if the stream is still good
+     */
+    template <typename T>
+    bool readBinary(T& value)
+    {
+        _is.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return _is.good();
+    }
+
+    /**
+     * @brief Read a binary GMP integer (int32 signed limb count + uint64 limbs) from internal stream
+     *
+     * @param z OUT: integer
+     * @return true if the stream is still good
+     */
+    bool readBinaryInteger(mpz_class& z);
+
+    /**
+     * @brief Read a binary uint64 element count from internal stream. Counts that do not fit into an int or that
+     *        would need more than the remaining bytes of the file put the stream into a failed state.
+     *
+     * @param n OUT: element count
+     * @param minBytesPerElement IN: lower bound for the number of bytes each counted element occupies
+     * @return true if the stream is still good
+     */
+    bool readBinaryCount(int& n, size_t minBytesPerElement);
+
+    /**
+     * @brief Get the number of bytes between the current read position and the end of a binary file
+     *
+     * @return number of unread bytes
+     */
+    uint64_t remainingBinaryBytes();
+
     /**
      * @brief Read vertices from internal stream
      *
@@ -3,6 +3,7 @@
 
 #include "MC3D/Mesh/TetMeshNavigator.hpp"
 
+#include <cstdint>
 #include <fstream>
 #include <map>
 #include <string>
@@ -31,8 +32,25 @@ class Writer : public TetMeshNavigator
      *                               (may be "numerator/denominator" or "integer"). Rationals are stored
      *                               via the stringification of mpq_class. otherwise double precision floating
      *                               values are used for the parametrization.
+     * @param binary IN: whether to write the binary encoding of the .hexex content instead of text.
+     *                   The file starts with BINARY_MAGIC and a uint32 of BinaryFlags, followed by the same
+     *                   sections as the text format. Counts are uint64, vertex indices int32, positions, doubles
+     *                   and wall distances double. Exact rationals are stored as numerator and denominator, each as
+     *                   an int32 limb count (negative for negative numbers) followed by that many uint64 limbs.
+     *                   Everything is in native byte order. Reader detects this encoding automatically.
      */
-    Writer(const TetMeshProps& meshProps, const std::string& fileName, bool exactRationalParam = false);
+    Writer(const TetMeshProps& meshProps,
+           const std::string& fileName,
+           bool exactRationalParam = false,
+           bool binary = false);
+
+    static constexpr char BINARY_MAGIC[8] = {'H', 'E', 'X', 'E', 'X', 'B', 'I', 'N'};
+
+    enum BinaryFlags : uint32_t
+    {
+        BINARY_EXACT = 1, // Parametrization is stored as exact rationals
+        BINARY_WALLS = 2, // File contains a wall section
+    };
 
     /**
      * @brief Write the mesh with parameterization to the given file.
@@ -69,6 +87,11 @@ class Writer : public TetMeshNavigator
     const std::string _fileName;
     std::ofstream _os;
     bool _exact;
+    bool _binary;
+
+    vector<char> _streamBuffer; // Backing buffer of _os, lines are never flushed individually
+    std::string _digits;        // Reusable digit buffer for GMP numerators and denominators
+    vector<uint64_t> _limbs;    // Reusable limb buffer for binary GMP integers
 
     map<int, int> _vtx2idx; // Internal map of vtx mesh idx to vtx output idx
 
@@ -79,6 +102,53 @@ class Writer : public TetMeshNavigator
      */
     RetCode checkFile() const;
 
+    /**
+     * @brief Open the file with a large stream buffer and write the header of the binary encoding, if requested
+     *
+     * @param walls IN: whether a wall section will be written
+     * @return RetCode SUCCESS or FILE_INACCESSIBLE
+     */
+    RetCode openFile(bool walls);
+
+    /**
+     * @brief Flush and close the file
+     *
+     * @return RetCode SUCCESS or FILE_INACCESSIBLE
+     */
+    RetCode closeFile();
+
+    /**
+     * @brief Write the raw bytes of \p value to internal stream
+     *
+     * @param value IN: trivially copyable value
+     */
+    template <typename T>
+    void writeBinary(const T& value)
+    {
+        _os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /**
+     * @brief Write a vertex index (text: followed by a space)
+     *
+     * @param idx IN: output vertex index
+     */
+    void writeIndex(int idx);
+
+    /**
+     * @brief Write a parametrization value, either as double or exact rational (text: followed by a space)
+     *
+     * @param q IN: value
+     */
+    void writeParam(const Q& q);
+
+    /**
+     * @brief Write a GMP integer, in text via the reusable digit buffer
+     *
+     * @param z IN: integer
+     */
+    void writeInteger(const mpz_class& z);
+
     /**
      * @brief Write vertex position to internal stream
      *
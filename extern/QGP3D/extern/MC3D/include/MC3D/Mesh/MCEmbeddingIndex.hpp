@@ -0,0 +1,205 @@
+#ifndef MC3D_MCEMBEDDINGINDEX_HPP
+#define MC3D_MCEMBEDDINGINDEX_HPP
+
+#include "MC3D/Mesh/MCMeshProps.hpp"
+
+namespace mc3d
+{
+
+/**
+ * @brief Compact, read-optimized copy of the embedding of an MC into its tet mesh, i.e. of the properties
+ *        BLOCK_MESH_TETS, PATCH_MESH_HALFFACES and ARC_MESH_HALFEDGES, stored in compressed sparse row format.
+ *
+ *        Tets and halffaces are stored sorted (as in the set-valued properties), halfedges in the order of the arc.
+ *        The properties remain the authoritative data. The index registers itself with the MCMeshProps it was
+ *        created for (which must outlive it). Every non-const access to an embedding property through the property
+ *        manager marks the accessed block/patch/arc as dirty, and the MC3D mesh manipulators additionally mark
+ *        deleted elements (see MCMeshProps::markEmbeddingDirty()). update() re-reads dirty entries only and copies
+ *        the ranges of clean entries.
+ *
+ *        Entries are only valid for reading while the index is up to date (i.e. after update()).
+ */
+class MCEmbeddingIndex
+{
+  public:
+    /**
+     * @brief Contiguous, read-only range of embedding elements
+     *
+     * @tparam HANDLE_T CH, HFH or HEH
+     */
+    template <typename HANDLE_T>
+    class Range
+    {
+      public:
+        Range(const HANDLE_T* begin, const HANDLE_T* end) : _begin(begin), _end(end)
+        {
+        }
+
+        const HANDLE_T* begin() const
+        {
+            return _begin;
+        }
+
+        const HANDLE_T* end() const
+        {
+            return _end;
+        }
+
+        size_t size() const
+        {
+            return _end - _begin;
+        }
+
+        bool empty() const
+        {
+            return _begin == _end;
+        }
+
+        const HANDLE_T& operator[](size_t i) const
+        {
+            return _begin[i];
+        }
+
+      private:
+        const HANDLE_T* _begin;
+        const HANDLE_T* _end;
+    };
+
+    /**
+     * @brief Create an index of the embedding stored in \p mcMeshProps and register it for dirty tracking.
+     *        The index is built immediately.
+     *
+     * @param mcMeshProps IN: MC whose embedding properties to index
+     */
+    MCEmbeddingIndex(MCMeshProps& mcMeshProps);
+
+    MCEmbeddingIndex(const MCEmbeddingIndex&) = delete;
+    MCEmbeddingIndex& operator=(const MCEmbeddingIndex&) = delete;
+
+    ~MCEmbeddingIndex();
+
+    /**
+     * @brief Rebuild the entries of all dirty (or newly created) blocks, patches and arcs.
+     *        Clean entries are copied as contiguous ranges.
+     */
+    void update();
+
+    /**
+     * @brief Mark the tets of block \p b as outdated
+     */
+    void markDirty(const CH& b);
+
+    /**
+     * @brief Mark the halffaces of patch \p p as outdated
+     */
+    void markDirty(const FH& p);
+
+    /**
+     * @brief Mark the halfedges of arc \p a as outdated
+     */
+    void markDirty(const EH& a);
+
+    /**
+     * @brief Mark all entries as outdated (e.g. after garbage collection of the MC)
+     */
+    void markAllDirty();
+
+    /**
+     * @brief Whether any entry is outdated
+     *
+     * @return true if update() has to be called before reading
+     * @return false else
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Tets of \p b, sorted by handle
+     *
+     * @param b IN: block (must be clean)
+     * @return Range<CH> tets of \p b
+     */
+    Range<CH> blockTets(const CH& b) const;
+
+    /**
+     * @brief Halffaces of \p p, sorted by handle
+     *
+     * @param p IN: patch (must be clean)
+     * @return Range<HFH> halffaces of \p p
+     */
+    Range<HFH> patchHalffaces(const FH& p) const;
+
+    /**
+     * @brief Halfedges of \p a, ordered from the first to the second node of \p a
+     *
+     * @param a IN: arc (must be clean)
+     * @return Range<HEH> halfedges of \p a
+     */
+    Range<HEH> arcHalfedges(const EH& a) const;
+
+    /**
+     * @brief Compare all clean entries against the embedding properties (expensive, for debugging)
+     *
+     * @return true if all clean entries match the properties
+     * @return false else
+     */
+    bool isConsistent() const;
+
+    /**
+     * @brief Heap memory occupied by the index
+     *
+     * @return size_t bytes
+     */
+    size_t memoryFootprint() const;
+
+    /**
+     * @brief Estimate of the heap memory occupied by the set/list-based embedding properties
+     *        (assuming one allocation per tree/list node, with glibc malloc chunk sizes)
+     *
+     * @return size_t bytes
+     */
+    size_t propertyMemoryFootprint() const;
+
+  private:
+    template <typename PROP>
+    struct Table
+    {
+        using owner_t = typename PROP::handle_t;
+        using elem_t = typename PROP::value_t::value_type;
+
+        vector<int> offsets{0}; // Size: nOwners + 1
+        vector<elem_t> elems;
+        vector<bool> dirty;
+        int nDirty = 0;
+    };
+
+    template <typename PROP>
+    void updateTable(Table<PROP>& table, size_t nOwners);
+
+    template <typename PROP>
+    bool isDirty(const Table<PROP>& table, size_t nOwners) const;
+
+    template <typename PROP>
+    static void markDirtyIn(Table<PROP>& table, int idx);
+
+    template <typename PROP>
+    Range<typename Table<PROP>::elem_t> entry(const Table<PROP>& table, int idx) const;
+
+    template <typename PROP>
+    bool isConsistent(const Table<PROP>& table) const;
+
+    template <typename PROP>
+    static size_t memoryFootprint(const Table<PROP>& table);
+
+    template <typename PROP>
+    size_t propertyMemoryFootprint(size_t nodeSize) const;
+
+    MCMeshProps& _mcMeshProps;
+
+    Table<BLOCK_MESH_TETS> _blockTets;
+    Table<PATCH_MESH_HALFFACES> _patchHalffaces;
+    Table<ARC_MESH_HALFEDGES> _arcHalfedges;
+};
+
+} // namespace mc3d
+
+#endif
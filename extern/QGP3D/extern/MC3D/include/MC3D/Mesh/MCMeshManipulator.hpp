@@ -127,6 +127,34 @@ class MCMeshManipulator : public virtual TetMeshManipulator, public virtual MCMe
      */
     CH mergeBlocks(const CH& b1, const CH& b2, const FH& p);
 
+    /**
+     * @brief Set whether mergeBlocks() should defer relabeling MC_BLOCK of the merged tets.
+     *        While deferred, BLOCK_MESH_TETS stays exact but MC_BLOCK of a tet may still name a block
+     *        that has since been merged. The owning block is then tracked by a union-find over the merged
+     *        blocks and MC_BLOCK is only rewritten by materializeBlockOwnership().
+     *        Disabling the deferral materializes pending ownership.
+     *
+     * @param defer IN: whether to defer MC_BLOCK updates of block merges
+     */
+    void setDeferredBlockOwnership(bool defer);
+
+    /**
+     * @brief Rewrite MC_BLOCK of all tets whose block was merged while ownership was deferred.
+     *        No-op if no merge is pending.
+     */
+    void materializeBlockOwnership();
+
+    /**
+     * @brief Query whether MC_BLOCK of some tets is outdated because of deferred block merges
+     *
+     * @return true if materializeBlockOwnership() has work to do
+     * @return false else
+     */
+    bool hasDeferredBlockOwnership() const
+    {
+        return !_mergedInto.empty();
+    }
+
     /**
      * @brief Transform the coordinate system inside \p b by appling \p trans .
      *        It is expected that \p b is already transition-free and all its patches are transition-uniform.
@@ -264,6 +292,18 @@ class MCMeshManipulator : public virtual TetMeshManipulator, public virtual MCMe
   private:
     MCMeshProps& _mcMeshProps;
 
+    /**
+     * @brief Find the block that \p b was (transitively) merged into, compressing the path on the way
+     *
+     * @param b IN: block, possibly already merged
+     * @return CH block that currently owns the tets of \p b
+     */
+    CH findMergedBlock(const CH& b);
+
+    bool _deferBlockOwnership = false;
+    // Union-find parent of each merged block (by index), -1 for blocks that were not merged
+    vector<int> _mergedInto;
+
   protected:
     /**
      * @brief Split \p a on a mesh connectivity level. Deletes \p a . Assumes \p n is isolated.
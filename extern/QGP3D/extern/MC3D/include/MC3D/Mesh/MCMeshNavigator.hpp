@@ -306,6 +306,18 @@ class MCMeshNavigator : public virtual TetMeshNavigator
      */
     void assertValidMC(bool reducibility, bool exhaustive) const;
 
+    /**
+     * @brief Check the MC locally: the blocks in \p blocks, their patches, arcs and nodes, and the tet mesh elements
+     *        embedding them. In contrast to assertValidMC() this is also active in release builds, and its cost is
+     *        proportional to the size of the checked region, so it can be run after every single MC modification.
+     *        Deleted blocks in \p blocks are skipped. The first violation found is logged.
+     *
+     * @param blocks IN: blocks to check
+     * @return true if no violation was found
+     * @return false else
+     */
+    bool checkLocalMC(const set<CH>& blocks) const;
+
     /**
      * @brief Check whether arc a is a manifold curve (aside from possible selfadjacency).
      *        Does nothing if not compiled without NDEBUG flag.
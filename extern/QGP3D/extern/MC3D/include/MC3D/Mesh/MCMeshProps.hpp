@@ -8,6 +8,8 @@
 
 namespace mc3d
 {
+class MCEmbeddingIndex;
+
 // clang-format off
 MC3D_PROPERTY(BLOCK_CORNER_NODES,   Cell,     MC3D_ARG(map<UVWDir, VH>));
 MC3D_PROPERTY(BLOCK_EDGE_ARCS,      Cell,     MC3D_ARG(map<UVWDir, set<EH>>));
@@ -45,6 +47,39 @@ MC3D_MAP_PROPERTY(CHILD_HALFFACES,  HalfFace, vector<HFH>);
 
 // clang-format on
 
+// Together with the singularity tags, the feature tags define the critical elements of the MC
+// (see MCMeshProps::revision())
+template <>
+struct notifies_changes<IS_FEATURE_V, MCMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<IS_FEATURE_E, MCMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<IS_FEATURE_F, MCMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<IS_SINGULAR, MCMesh> : std::true_type
+{
+};
+
+// Writes to the embedding mark the affected entries of all MCEmbeddingIndex instances as dirty
+template <>
+struct notifies_changes<BLOCK_MESH_TETS, MCMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<PATCH_MESH_HALFFACES, MCMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<ARC_MESH_HALFEDGES, MCMesh> : std::true_type
+{
+};
+
 using MCMeshPropsBase = MeshPropsInterface<MCMesh,
                                            CHILD_CELLS,
                                            CHILD_EDGES,
@@ -91,6 +126,14 @@ class MCMeshProps : public MCMeshPropsBase
      */
     MCMeshProps(MCMesh& mcMesh);
 
+    // Registered MCEmbeddingIndex instances point to this object, so it must stay in place
+    MCMeshProps(const MCMeshProps&) = delete;
+    MCMeshProps(MCMeshProps&&) = delete;
+    MCMeshProps& operator=(const MCMeshProps&) = delete;
+    MCMeshProps& operator=(MCMeshProps&&) = delete;
+
+    ~MCMeshProps();
+
     /**
      * @brief Get the directed transition for a given halfpatch, i.e. the transition
      *        from the block incident on \p hp to the block incident to the opposite
@@ -183,6 +226,71 @@ class MCMeshProps : public MCMeshPropsBase
      * @return NodeType type of \p n (regarding regularity/singularity)
      */
     NodeType nodeType(const VH& n) const;
+
+    /**
+     * @brief Mark the BLOCK_MESH_TETS entry of \p b as outdated in all registered MCEmbeddingIndex instances.
+     *        Writes through set()/ref() etc. do this automatically, call this after modifying the embedding of \p b
+     *        in other ways (e.g. deleting \p b).
+     *
+     * @param b IN: block
+     */
+    void markEmbeddingDirty(const CH& b);
+
+    /**
+     * @brief Mark the PATCH_MESH_HALFFACES entry of \p p as outdated in all registered MCEmbeddingIndex instances.
+     *        Writes through set()/ref() etc. do this automatically, call this after modifying the embedding of \p p
+     *        in other ways (e.g. deleting \p p).
+     *
+     * @param p IN: patch
+     */
+    void markEmbeddingDirty(const FH& p);
+
+    /**
+     * @brief Mark the ARC_MESH_HALFEDGES entry of \p a as outdated in all registered MCEmbeddingIndex instances.
+     *        Writes through set()/ref() etc. do this automatically, call this after modifying the embedding of \p a
+     *        in other ways (e.g. deleting \p a).
+     *
+     * @param a IN: arc
+     */
+    void markEmbeddingDirty(const EH& a);
+
+    /**
+     * @brief Mark all embedding entries as outdated in all registered MCEmbeddingIndex instances
+     */
+    void markEmbeddingDirty();
+
+    /**
+     * @brief Get the revision of the MC structure. It is advanced by every topological modification
+     *        (see MCMeshManipulator), by every modification of the singularity or feature tags and when the MC is
+     *        cleared. Caches of data derived from the MC structure can compare it to detect that they are outdated.
+     *        Revisions are drawn from a process-wide counter, so no two MCs (not even one created at the address of
+     *        a destroyed one) ever share a revision.
+     *
+     * @return size_t current revision
+     */
+    size_t revision() const
+    {
+        return _revision;
+    }
+
+    /**
+     * @brief Advance the revision of the MC structure (see revision()).
+     *        Call this after modifying the MC structure in ways not covered by revision().
+     */
+    void advanceRevision();
+
+  protected:
+    void onPropertyChanged(size_t prop, const VH& n) override;
+    void onPropertyChanged(size_t prop, const EH& a) override;
+    void onPropertyChanged(size_t prop, const FH& p) override;
+    void onPropertyChanged(size_t prop, const CH& b) override;
+    void onPropertyChanged(size_t prop) override;
+
+  private:
+    friend class MCEmbeddingIndex;
+
+    vector<MCEmbeddingIndex*> _embeddingIndices; // Indices to notify about embedding changes
+    size_t _revision;                            // Revision of the MC structure
 };
 
 } // namespace mc3d
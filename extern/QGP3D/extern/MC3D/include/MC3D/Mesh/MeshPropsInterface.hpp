@@ -130,6 +130,56 @@ struct no_dupe<>
     };
 };
 
+/**
+ * @brief Trait for properties whose modification through a property manager of mesh type \p Mesh should be reported
+ *        to it via onPropertyChanged(), e.g. so that the manager can maintain caches derived from the property.
+ *        Managers of other mesh types managing the same property are not notified.
+ *        Specialize as std::true_type next to the property manager that maintains such a cache.
+ *
+ * @tparam Prop property
+ * @tparam Mesh mesh type of the notified property manager
+ */
+template <typename Prop, typename Mesh>
+struct notifies_changes : std::false_type
+{
+};
+
+/**
+ * @brief Trait for properties that lazily snapshot the values of another (source) property. After takeSnapshot(),
+ *        each element shares its value with the source property until the element is detached, which happens
+ *        right before its source value or its snapshot value is first modified through the property manager.
+ *        Detached elements are flagged in a bool property of the same entity type.
+ *        Specialize directly after declaring the properties, defining source_t and detached_t.
+ *
+ * @tparam Prop property
+ */
+template <typename Prop>
+struct snapshot_of
+{
+    using source_t = void;
+    using detached_t = void;
+};
+
+/**
+ * @brief The snapshot property of \p Source among \p Ps (void if there is none)
+ *
+ * @tparam Source source property
+ * @tparam Ps list of properties to search
+ */
+template <typename Source, typename... Ps>
+struct find_snapshot
+{
+    using type = void;
+};
+
+template <typename Source, typename Head, typename... Tail>
+struct find_snapshot<Source, Head, Tail...>
+{
+    using type = typename std::conditional<std::is_same<typename snapshot_of<Head>::source_t, Source>::value,
+                                           Head,
+                                           typename find_snapshot<Source, Tail...>::type>::type;
+};
+
 template <typename T, typename... Ts>
 struct Index;
 
@@ -244,7 +294,7 @@ class MeshPropsInterface
     {
     }
 
-    ~MeshPropsInterface()
+    virtual ~MeshPropsInterface()
     {
         clearRecurse<0>();
     }
@@ -317,6 +367,7 @@ class MeshPropsInterface
             release<Prop>();
         }
         setDefault<Prop>(def);
+        notifyChanged<Prop>();
         return allocateProp<Prop>(std::get<Index<Prop, Props...>::value>(_props).ptr, def);
     }
 
@@ -351,8 +402,59 @@ class MeshPropsInterface
         if (!isAllocated<Prop>())
             LOG(WARNING) << "Tried to release a non-allocated property";
         else
+        {
+            notifyChanged<Prop>();
+            if constexpr (!std::is_void<typename snapshot_of<Prop>::detached_t>::value)
+            {
+                // The snapshot is discarded, nothing to preserve
+                if (isAllocated<typename snapshot_of<Prop>::detached_t>())
+                    release<typename snapshot_of<Prop>::detached_t>();
+            }
+            else
+                detachSnapshot<Prop>();
             clearProp<Prop>(std::get<Index<Prop, Props...>::value>(_props).ptr,
                             std::get<Index<Prop, Props...>::value>(_props).def);
+        }
+    }
+
+    /**
+     * @brief Allocate snapshot property \p Snap (see snapshot_of) so that it holds the current values of its source
+     *        property. No values are copied, each element shares the source value until it is detached.
+     *        If \p Snap is already allocated, its previous values are discarded.
+     *
+     * @tparam Snap snapshot property to allocate
+     */
+    template <typename Snap>
+    void takeSnapshot()
+    {
+        static_assert(!std::is_void<typename snapshot_of<Snap>::source_t>::value, "PROPERTY IS NOT A SNAPSHOT");
+        assert(isAllocated<typename snapshot_of<Snap>::source_t>());
+        if (isAllocated<Snap>())
+            release<Snap>();
+        allocate<Snap>();
+        allocate<typename snapshot_of<Snap>::detached_t>(false);
+    }
+
+    /**
+     * @brief Query whether the value of snapshot property \p Snap for element \p handle is still shared with its
+     *        source property
+     *
+     * @tparam Snap snapshot property to query
+     * @param handle IN: element to query
+     * @return true if the snapshot value of \p handle is the source value of \p handle
+     * @return false else
+     */
+    template <typename Snap>
+    bool isSnapshotShared(const typename Snap::handle_t& handle) const
+    {
+        using Detached = typename snapshot_of<Snap>::detached_t;
+        if constexpr (std::is_void<Detached>::value)
+        {
+            (void)handle;
+            return false;
+        }
+        else
+            return isAllocated<Detached>() && !get<Detached>(handle);
     }
 
     /**
@@ -387,7 +489,9 @@ class MeshPropsInterface
     template <typename Prop>
     typename Prop::prop_t& prop()
     {
-        return getProp<Prop>(std::get<Index<Prop, Props...>::value>(_props).ptr);
+        notifyChanged<Prop>();
+        detachSnapshot<Prop>();
+        return storage<Prop>();
     }
 
     /**
@@ -402,6 +506,9 @@ class MeshPropsInterface
     {
         static_assert(is_any_of<Prop, Props...>::value, "NO SUCH PROPERTY MANAGED BY THIS CLASS");
         assert(handle.is_valid());
+        if constexpr (!std::is_void<typename snapshot_of<Prop>::source_t>::value)
+            if (isSnapshotShared<Prop>(handle))
+                return get<typename snapshot_of<Prop>::source_t>(handle);
         const typename Prop::prop_t& p = prop<Prop>();
         auto it = p.find(handle);
         return it == p.end() ? std::get<Index<Prop, Props...>::value>(_props).def : it->second;
@@ -417,6 +524,9 @@ class MeshPropsInterface
     template <typename Prop, typename std::enable_if<!Prop::IS_MAPPED, int>::type = 0>
     typename Prop::value_t get(const typename Prop::handle_t& handle) const
     {
+        if constexpr (!std::is_void<typename snapshot_of<Prop>::source_t>::value)
+            if (isSnapshotShared<Prop>(handle))
+                return get<typename snapshot_of<Prop>::source_t>(handle);
         return prop<Prop>()[handle];
     }
 
@@ -445,7 +555,29 @@ class MeshPropsInterface
     typename Prop::ref_t ref(const typename Prop::handle_t& handle)
     {
         assert(handle.is_valid());
-        return prop<Prop>()[handle];
+        detachSnapshot<Prop>(handle, false);
+        notifyChanged<Prop>(handle);
+        return storage<Prop>()[handle];
+    }
+
+    /**
+     * @brief Like ref(), but the snapshot of \p Prop (see snapshot_of) is not detached for \p handle, i.e. if it
+     *        still shares the value, the modification applies to the snapshot as well. Use this only for
+     *        modifications that the snapshot would undergo identically, e.g. when inheriting values during a split.
+     *        For snapshot properties themselves, this is the same as ref().
+     *
+     * @tparam Prop property to query
+     * @param handle IN: element for which the property value should be retrieved
+     * @return Prop::ref_t reference to property value of \p handle
+     */
+    template <typename Prop>
+    typename Prop::ref_t refShared(const typename Prop::handle_t& handle)
+    {
+        assert(handle.is_valid());
+        if constexpr (!std::is_void<typename snapshot_of<Prop>::source_t>::value)
+            detachSnapshot<Prop>(handle, false);
+        notifyChanged<Prop>(handle);
+        return storage<Prop>()[handle];
     }
 
     /**
@@ -460,6 +592,9 @@ class MeshPropsInterface
     typename Prop::const_ref_t ref(const typename Prop::handle_t& handle) const
     {
         assert(handle.is_valid());
+        if constexpr (!std::is_void<typename snapshot_of<Prop>::source_t>::value)
+            if (isSnapshotShared<Prop>(handle))
+                return ref<typename snapshot_of<Prop>::source_t>(handle);
         return prop<Prop>()[handle];
     }
 
@@ -474,6 +609,9 @@ class MeshPropsInterface
     typename Prop::const_ref_t ref(const typename Prop::handle_t& handle) const
     {
         assert(handle.is_valid());
+        if constexpr (!std::is_void<typename snapshot_of<Prop>::source_t>::value)
+            if (isSnapshotShared<Prop>(handle))
+                return ref<typename snapshot_of<Prop>::source_t>(handle);
         return prop<Prop>().at(handle);
     }
 
@@ -511,35 +649,29 @@ class MeshPropsInterface
      * @param handle IN: element for which the property value should be set
      * @param val IN: value to set the property of \p handle to
      */
-    template <typename Prop, typename std::enable_if<Prop::IS_MAPPED, int>::type = 0>
+    template <typename Prop>
     void set(const typename Prop::handle_t& handle, const typename Prop::value_t& val)
     {
-        static_assert(is_any_of<Prop, Props...>::value, "NO SUCH PROPERTY MANAGED BY THIS CLASS");
-        assert(handle.is_valid());
-        if (val == std::get<Index<Prop, Props...>::value>(_props).def)
-        {
-            typename Prop::prop_t& p = prop<Prop>();
-            auto it = p.find(handle);
-            if (it != p.end())
-                p.erase(it);
-        }
-        else
-        {
-            prop<Prop>()[handle] = val;
-        }
+        detachSnapshot<Prop>(handle, true);
+        setValue<Prop>(handle, val);
     }
 
     /**
-     * @brief Set the mapped property value of prop \p Prop for element \p handle
+     * @brief Like set(), but the snapshot of \p Prop (see snapshot_of) is not detached for \p handle, i.e. if it
+     *        still shares the value, it is set for the snapshot as well. Use this only for values that the snapshot
+     *        would be set to identically, e.g. when inheriting values during a split.
+     *        For snapshot properties themselves, this is the same as set().
      *
      * @tparam Prop property to set
      * @param handle IN: element for which the property value should be set
      * @param val IN: value to set the property of \p handle to
      */
-    template <typename Prop, typename std::enable_if<!Prop::IS_MAPPED, int>::type = 0>
-    void set(const typename Prop::handle_t& handle, const typename Prop::value_t& val)
+    template <typename Prop>
+    void setShared(const typename Prop::handle_t& handle, const typename Prop::value_t& val)
     {
-        prop<Prop>()[handle] = val;
+        if constexpr (!std::is_void<typename snapshot_of<Prop>::source_t>::value)
+            detachSnapshot<Prop>(handle, true);
+        setValue<Prop>(handle, val);
     }
 
     /**
@@ -580,29 +712,44 @@ class MeshPropsInterface
     }
 
     /**
-     * @brief Copy the mapped property value of prop \p Prop from element \p from to \p to
-     *
-     * @tparam Prop property to copy
-     * @param from IN: element to copy property from
-     * @param to IN: element to copy property to
-     */
-    template <typename Prop, typename std::enable_if<Prop::IS_MAPPED, int>::type = 0>
-    void clone(const typename Prop::handle_t& from, const typename Prop::handle_t& to)
-    {
-        set<Prop>(to, get<Prop>(from));
-    }
-
-    /**
-     * @brief Copy the mapped property value of prop \p Prop from element \p from to \p to
+     * @brief Copy the mapped property value of prop \p Prop from element \p from to \p to .
+     *        If \p Prop is the source of a snapshot or a snapshot itself, the snapshot state is copied as well,
+     *        so that \p to shares its snapshot value if \p from does.
      *
      * @tparam Prop property to copy
      * @param from IN: element to copy property from
      * @param to IN: element to copy property to
      */
-    template <typename Prop, typename std::enable_if<!Prop::IS_MAPPED, int>::type = 0>
+    template <typename Prop>
     void clone(const typename Prop::handle_t& from, const typename Prop::handle_t& to)
     {
-        set<Prop>(to, ref<Prop>(from));
+        using Snap = typename std::conditional<std::is_void<typename snapshot_of<Prop>::source_t>::value,
+                                               typename find_snapshot<Prop, Props...>::type,
+                                               Prop>::type;
+        if constexpr (!std::is_void<Snap>::value)
+        {
+            using Detached = typename snapshot_of<Snap>::detached_t;
+            if (isAllocated<Detached>())
+            {
+                if (isSnapshotShared<Snap>(from))
+                {
+                    setValue<Snap>(to, std::get<Index<Snap, Props...>::value>(_props).def);
+                    setValue<Detached>(to, false);
+                }
+                else
+                {
+                    setValue<Snap>(to, get<Snap>(from));
+                    setValue<Detached>(to, true);
+                }
+                if constexpr (!std::is_same<Snap, Prop>::value)
+                    setValue<Prop>(to, storage<Prop>()[from]);
+                return;
+            }
+        }
+        if constexpr (Prop::IS_MAPPED)
+            set<Prop>(to, get<Prop>(from));
+        else
+            set<Prop>(to, storage<Prop>()[from]);
     }
 
     /**
@@ -641,13 +788,108 @@ class MeshPropsInterface
     }
 
   protected:
+    /**
+     * @brief Position of property \p Prop in the list of managed properties, used to identify the changed property
+     *        in onPropertyChanged()
+     *
+     * @tparam Prop property
+     * @return constexpr size_t position of \p Prop
+     */
+    template <typename Prop>
+    static constexpr size_t propIndex()
+    {
+        static_assert(is_any_of<Prop, Props...>::value, "NO SUCH PROPERTY MANAGED BY THIS CLASS");
+        return Index<Prop, Props...>::value;
+    }
+
+    /**
+     * @brief Called before a property marked by notifies_changes is modified for vertex \p v
+     *
+     * @param prop IN: changed property (see propIndex())
+     * @param v IN: vertex
+     */
+    virtual void onPropertyChanged(size_t prop, const VH& v)
+    {
+        (void)prop;
+        (void)v;
+    }
+
+    /**
+     * @brief Called before a property marked by notifies_changes is modified for edge \p e
+     *
+     * @param prop IN: changed property (see propIndex())
+     * @param e IN: edge
+     */
+    virtual void onPropertyChanged(size_t prop, const EH& e)
+    {
+        (void)prop;
+        (void)e;
+    }
+
+    /**
+     * @brief Called before a property marked by notifies_changes is modified for face \p f
+     *
+     * @param prop IN: changed property (see propIndex())
+     * @param f IN: face
+     */
+    virtual void onPropertyChanged(size_t prop, const FH& f)
+    {
+        (void)prop;
+        (void)f;
+    }
+
+    /**
+     * @brief Called before a property marked by notifies_changes is modified for cell \p c
+     *
+     * @param prop IN: changed property (see propIndex())
+     * @param c IN: cell
+     */
+    virtual void onPropertyChanged(size_t prop, const CH& c)
+    {
+        (void)prop;
+        (void)c;
+    }
+
+    /**
+     * @brief Called before a property marked by notifies_changes is allocated, released or handed out as a whole
+     *
+     * @param prop IN: changed property (see propIndex())
+     */
+    virtual void onPropertyChanged(size_t prop)
+    {
+        (void)prop;
+    }
+
+    template <typename Prop>
+    void notifyChanged(const typename Prop::handle_t& handle)
+    {
+        if constexpr (notifies_changes<Prop, Mesh>::value)
+            onPropertyChanged(propIndex<Prop>(), handle);
+        else
+            (void)handle;
+    }
+
+    template <typename Prop>
+    void notifyChanged()
+    {
+        if constexpr (notifies_changes<Prop, Mesh>::value)
+            onPropertyChanged(propIndex<Prop>());
+    }
+
     template <size_t I = 0, typename std::enable_if<(I < sizeof...(Props)), int>::type = 0>
     void clearRecurse()
     {
         using Prop = typename std::tuple_element<I, std::tuple<Props...>>::type;
+        using Snap = typename find_snapshot<Prop, Props...>::type;
 
         if (isAllocated<Prop>())
+        {
+            // Drop the snapshot first, it would otherwise be detached in vain
+            if constexpr (!std::is_void<Snap>::value)
+                if (isAllocated<Snap>())
+                    release<Snap>();
             release<Prop>();
+        }
 
         clearRecurse<I + 1>();
     }
@@ -743,6 +985,92 @@ class MeshPropsInterface
     {
     }
 
+    template <typename Prop>
+    typename Prop::prop_t& storage() const
+    {
+        return getProp<Prop>(std::get<Index<Prop, Props...>::value>(_props).ptr);
+    }
+
+    template <typename Prop>
+    void setValue(const typename Prop::handle_t& handle, typename Prop::value_t val)
+    {
+        static_assert(is_any_of<Prop, Props...>::value, "NO SUCH PROPERTY MANAGED BY THIS CLASS");
+        assert(handle.is_valid());
+        notifyChanged<Prop>(handle);
+        typename Prop::prop_t& p = storage<Prop>();
+        if constexpr (Prop::IS_MAPPED)
+        {
+            if (val == std::get<Index<Prop, Props...>::value>(_props).def)
+            {
+                auto it = p.find(handle);
+                if (it != p.end())
+                    p.erase(it);
+                return;
+            }
+        }
+        p[handle] = std::move(val);
+    }
+
+    /**
+     * @brief Detach \p handle from the snapshot that \p Prop is the source of or is itself, before \p Prop is
+     *        modified for \p handle . Pass \p overwritten if the current value of \p handle will be discarded.
+     */
+    template <typename Prop>
+    void detachSnapshot(const typename Prop::handle_t& handle, bool overwritten)
+    {
+        using Snap = typename find_snapshot<Prop, Props...>::type;
+        if constexpr (!std::is_void<typename snapshot_of<Prop>::source_t>::value)
+        {
+            if (isSnapshotShared<Prop>(handle))
+            {
+                if (!overwritten)
+                    setValue<Prop>(handle, get<typename snapshot_of<Prop>::source_t>(handle));
+                setValue<typename snapshot_of<Prop>::detached_t>(handle, true);
+            }
+        }
+        else if constexpr (!std::is_void<Snap>::value)
+        {
+            if (isSnapshotShared<Snap>(handle))
+            {
+                // Preserve the value in the snapshot, the source value is not needed anymore if overwritten
+                if constexpr (Prop::IS_MAPPED)
+                    setValue<Snap>(handle, get<Prop>(handle));
+                else if (overwritten)
+                    setValue<Snap>(handle, std::move(storage<Prop>()[handle]));
+                else
+                    setValue<Snap>(handle, storage<Prop>()[handle]);
+                setValue<typename snapshot_of<Snap>::detached_t>(handle, true);
+            }
+        }
+        else
+        {
+            (void)handle;
+            (void)overwritten;
+        }
+    }
+
+    /**
+     * @brief Detach all elements from the snapshot that \p Prop is the source of or is itself, before \p Prop is
+     *        modified as a whole. The snapshot becomes a regular property.
+     */
+    template <typename Prop>
+    void detachSnapshot()
+    {
+        using Snap = typename std::conditional<std::is_void<typename snapshot_of<Prop>::source_t>::value,
+                                               typename find_snapshot<Prop, Props...>::type,
+                                               Prop>::type;
+        if constexpr (!std::is_void<Snap>::value)
+        {
+            using Detached = typename snapshot_of<Snap>::detached_t;
+            if (isAllocated<Detached>())
+            {
+                for (size_t i = 0; i < mesh().template n<typename Snap::entity_t>(); i++)
+                    detachSnapshot<Snap>(typename Snap::handle_t((int)i), false);
+                release<Detached>();
+            }
+        }
+    }
+
     template <typename Prop>
     bool propIsAllocated(const std::unique_ptr<typename Prop::prop_t>& ptr) const
     {
@@ -133,6 +133,31 @@ class TetMeshManipulator : public virtual TetMeshNavigator
      */
     VH splitTet(const CH& tet, const Vec4Q& barCoords);
 
+    /**
+     * @brief Split all edges in \p es at their midpoints and then all faces in \p fs at their barycenters.
+     *        Yields the same mesh as calling splitHalfEdge(halfedge_handle(e, 0), *ec_iter(e), 1/2) for each edge
+     *        and splitFace(f, {1/3, 1/3, 1/3}) for each face in order, but reserves space for the new elements
+     *        upfront and updates the MC embedding once for all splits instead of once per split.
+     *        Faces deleted by preceding edge splits are skipped.
+     *
+     * @param es IN: edges to split
+     * @param fs IN: faces to split
+     * @return int number of performed splits
+     */
+    int splitAll(const set<EH>& es, const set<FH>& fs);
+
+    /**
+     * @brief Cut each edge in \p eCuts at each of its associated relative distances, which are given from vertex 0 to
+     *        vertex 1 of halfedge_handle(e, 0) and must lie strictly between 0 and 1.
+     *        Yields the same mesh as cutting each edge via splitHalfEdge() at its smallest distance first and then
+     *        cutting the respective remaining subedge, but reserves space for the new elements upfront and updates
+     *        the MC embedding once for all splits instead of once per split (see splitAll() above).
+     *
+     * @param eCuts IN: edges to cut, each with its relative cut distances
+     * @return int number of performed splits
+     */
+    int splitAll(const map<EH, set<Q>>& eCuts);
+
     /**
      * @brief Make all blocks internally transitionfree by pushing transitions to block boundaries.
      *        Also makes patches are transition-uniform in the process.
@@ -171,8 +196,40 @@ class TetMeshManipulator : public virtual TetMeshNavigator
     }
 
   private:
+    /**
+     * @brief Count the elements added by splitting \p e \p nCuts times (see splitAll())
+     *
+     * @param e IN: edge to split
+     * @param nCuts IN: number of splits of \p e (and its child edges)
+     * @param nVs IN/OUT: number of added vertices
+     * @param nEs IN/OUT: number of added edges
+     * @param nFs IN/OUT: number of added faces
+     * @param nTets IN/OUT: number of added tets
+     */
+    void countEdgeSplitElements(const EH& e, size_t nCuts, size_t& nVs, size_t& nEs, size_t& nFs, size_t& nTets) const;
+
+    /**
+     * @brief Update the MC mapping for all parent-child relations collected while deferring (see splitAll())
+     */
+    void applyDeferredMCMapping();
+
+    /**
+     * @brief Parent-child relations collected while the MC mapping update is deferred
+     */
+    struct DeferredMCMapping
+    {
+        map<HEH, vector<HEH>> he2heChildren;
+        map<EH, vector<EH>> e2eChildren;
+        map<HFH, vector<HFH>> hf2hfChildren;
+        map<FH, vector<FH>> f2fChildren;
+        map<CH, vector<CH>> tet2tetChildren;
+    };
+
     TetMeshProps& _meshProps;
 
+    bool _deferMCMapping = false;         // Whether updateMCMapping() only collects relations (see splitAll())
+    DeferredMCMapping _deferredMCMapping; // Relations collected while deferring
+
     /**
      * @brief Used to temporarily store associations of mesh elements, so that properties can be reconstructed and
      *        reassigned after splitting a halfedge \p heSplit (and deleting/creating mesh elements in the process)
@@ -258,6 +315,19 @@ class TetMeshManipulator : public virtual TetMeshNavigator
                                                map<FH, vector<FH>>& f2childFs,
                                                map<CH, vector<CH>>& tet2childTets);
 
+    /**
+     * @brief Check whether the CHART_T chart of \p tet parametrizes all of \p vs
+     *
+     * @tparam CHART_T the chart property to read from (CHART, CHART_ORIG or CHART_IGM)
+     *
+     * @param tet IN: tet
+     * @param vs IN: vertices to look up in the chart of \p tet
+     * @return true if CHART_T is allocated and the chart of \p tet contains all of \p vs
+     * @return false else
+     */
+    template <typename CHART_T>
+    bool chartContains(const CH& tet, std::initializer_list<VH> vs) const;
+
     /**
      * @brief Walk around the halfedge \p heSplit and calculate the CHART_T value at relative distance \p t for each of
      * the adjacent tets starting from reference tet \p tet
@@ -297,10 +367,25 @@ class TetMeshManipulator : public virtual TetMeshNavigator
      * @param tet2chartValuenew IN: the chart values of the new vertex per tet
      * @param tet2tetChildren IN: parent child relations
      * @param vN new vertex
+     * @param tetsSharingOrig IN: parents whose children keep sharing their original chart with their chart (see
+     *                        tetsSharingOrigChart()), skipped for CHART_ORIG
      */
     template <typename CHART_T>
-    void
-    inheritCharts(const map<CH, Vec3Q>& tet2chartValuenew, const map<CH, vector<CH>>& tet2tetChildren, const VH vN);
+    void inheritCharts(const map<CH, Vec3Q>& tet2chartValuenew,
+                       const map<CH, vector<CH>>& tet2tetChildren,
+                       const VH vN,
+                       const set<CH>& tetsSharingOrig = {});
+
+    /**
+     * @brief Collect the tets whose original chart (CHART_ORIG) is still shared with their chart (CHART) and
+     *        whose new vertex gets the same value in both, so that their children can keep sharing it.
+     *
+     * @param tet2chartValuenew IN: the CHART values of the new vertex per tet
+     * @param tet2chartValueOrignew IN: the CHART_ORIG values of the new vertex per tet
+     * @return set<CH> tets whose children can keep sharing their original chart
+     */
+    set<CH> tetsSharingOrigChart(const map<CH, Vec3Q>& tet2chartValuenew,
+                                 const map<CH, Vec3Q>& tet2chartValueOrignew) const;
 
     /**
      * @brief Clone the properties of parent elements to their child elements.
@@ -329,6 +414,8 @@ class TetMeshManipulator : public virtual TetMeshNavigator
     /**
      * @brief Update the mapping of MC elements to tet mesh elements by replacing references
      *        to split elements by their new sub-elements.
+     *        While deferred, the relations are only collected. As children always have larger handles than their
+     *        parents, replacing in handle order resolves chains of splits when the collection is applied at once.
      *
      * @param he2childHes IN: mapping of halfedges to child halfedges
      * @param e2childEs IN: mapping of edges to child edges
@@ -16,6 +16,7 @@ class MCMeshProps;
 MC3D_PROPERTY(CHART,           Cell, MC3D_ARG(map<VH, Vec3Q>));
 MC3D_PROPERTY(CHART_ORIG,      Cell, MC3D_ARG(map<VH, Vec3Q>));
 MC3D_PROPERTY(CHART_IGM,       Cell, MC3D_ARG(map<VH, Vec3Q>));
+MC3D_PROPERTY(CHART_ORIG_DETACHED, Cell, bool);
 MC3D_PROPERTY(IS_ARC,          Edge, bool);
 MC3D_PROPERTY(IS_WALL,         Face, bool);
 MC3D_PROPERTY(IS_ORIGINAL_F,   Face, bool);
@@ -38,18 +39,65 @@ MC3D_MAP_PROPERTY(WALL_DIST,       Face, float);
 MC3D_MAP_PROPERTY(TRANSITION,      Face, Transition);
 MC3D_MAP_PROPERTY(TRANSITION_ORIG, Face, Transition);
 MC3D_MAP_PROPERTY(TRANSITION_IGM,  Face, Transition);
+MC3D_MAP_PROPERTY(TRANSITION_ORIG_DETACHED, Face, bool);
 MC3D_MAP_PROPERTY(MC_PATCH,        Face, FH);
 MC3D_MAP_PROPERTY(MC_ARC,          Edge, EH);
 MC3D_MAP_PROPERTY(MC_NODE,         Vertex, VH);
 // clang-format on
 
+// Properties that determine the cached vertex/edge classification of TetMeshProps
+template <>
+struct notifies_changes<IS_ARC, TetMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<IS_WALL, TetMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<MC_PATCH, TetMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<MC_ARC, TetMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<MC_NODE, TetMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<IS_FEATURE_V, TetMesh> : std::true_type
+{
+};
+template <>
+struct notifies_changes<IS_FEATURE_E, TetMesh> : std::true_type
+{
+};
+
+// Original charts and transitions share the current ones until modified (see takeSnapshot())
+template <>
+struct snapshot_of<CHART_ORIG>
+{
+    using source_t = CHART;
+    using detached_t = CHART_ORIG_DETACHED;
+};
+template <>
+struct snapshot_of<TRANSITION_ORIG>
+{
+    using source_t = TRANSITION;
+    using detached_t = TRANSITION_ORIG_DETACHED;
+};
+
 using TetMeshPropsBase = MeshPropsInterface<TetMesh,
                                             CHART,
                                             CHART_ORIG,
                                             CHART_IGM,
+                                            CHART_ORIG_DETACHED,
                                             TRANSITION,
                                             TRANSITION_ORIG,
                                             TRANSITION_IGM,
+                                            TRANSITION_ORIG_DETACHED,
                                             IS_SINGULAR,
                                             IS_WALL,
                                             IS_ORIGINAL_F,
@@ -80,6 +128,15 @@ using TetMeshPropsBase = MeshPropsInterface<TetMesh,
 /**
  * @brief Class/struct to manage predefined properties of a raw tet mesh
  *
+ *        Whether a vertex/edge lies within a patch or arc, is a node or is a feature is cached per vertex/edge.
+ *        Modifications of the classifying properties (IS_WALL, IS_ARC, MC_PATCH, MC_ARC, MC_NODE, IS_FEATURE_V,
+ *        IS_FEATURE_E) invalidate the affected entries automatically, connectivity changes have to be announced via
+ *        invalidateClassification() (TetMeshManipulator does so for all splits and collapses). Outdated entries are
+ *        recomputed lazily on the next query.
+ *
+ *        The lazy recomputation writes to the cache, so the const classification queries (isInArc(), isInPatch(),
+ *        isNode(), isFeature()) are NOT thread-safe in general. Before issuing them from multiple threads, call
+ *        updateClassification(): until the next modification, queries then only read the cache.
  */
 class TetMeshProps : public TetMeshPropsBase
 {
@@ -141,6 +198,20 @@ class TetMeshProps : public TetMeshPropsBase
         setTransition<TRANSITION_T>(f, (hf.idx() % 2) == 0 ? trans : trans.invert());
     }
 
+    /**
+     * @brief Like setTransition(), but if the snapshot of \p TRANSITION_T (TRANSITION_ORIG for TRANSITION) still
+     *        shares the transition of \p hf , it is set for the snapshot as well (see MeshPropsInterface::setShared()).
+     *
+     * @param hf IN: halfface
+     * @param trans IN: transition to set
+     */
+    template <typename TRANSITION_T>
+    void setTransitionShared(const HFH& hf, const Transition& trans)
+    {
+        FH f = mesh().face_handle(hf);
+        setShared<TRANSITION_T>(f, (hf.idx() % 2) == 0 ? trans : trans.invert());
+    }
+
     /**
      * @brief Check whether \p f is a block boundary
      *
@@ -240,6 +311,55 @@ class TetMeshProps : public TetMeshPropsBase
      */
     bool touchesPatch(const CH& tet) const;
 
+    /**
+     * @brief Whether vertex is the embedding of an MC node
+     */
+    bool isNode(const VH& v) const;
+    /**
+     * @brief Whether vertex is a feature vertex
+     */
+    bool isFeature(const VH& v) const;
+    /**
+     * @brief Whether edge is a feature edge
+     */
+    bool isFeature(const EH& e) const;
+
+    /**
+     * @brief Mark the cached classification of all vertices and edges of \p tet as outdated.
+     *        Call this before changing the connectivity of \p tet (e.g. splitting or collapsing it),
+     *        as vertices and edges are classified by their incident elements.
+     *
+     * @param tet IN: tet whose vertices and edges to reclassify
+     */
+    void invalidateClassification(const CH& tet);
+
+    /**
+     * @brief Mark the cached classification of all vertices and edges as outdated
+     */
+    void invalidateClassification();
+
+    /**
+     * @brief Classify all vertices and edges whose cached classification is outdated. Queries on an
+     *        up-to-date cache do not write to it and may thus be issued concurrently.
+     */
+    void updateClassification() const;
+
+    /**
+     * @brief Check whether no cached classification is outdated, i.e. whether queries are currently read-only
+     *
+     * @return true if all vertices and edges have an up-to-date classification
+     * @return false else
+     */
+    bool isClassificationUpToDate() const;
+
+    /**
+     * @brief Compare all cached classifications against the classifying properties (expensive, for debugging)
+     *
+     * @return true if all up-to-date entries match the properties
+     * @return false else
+     */
+    bool isClassificationConsistent() const;
+
     /**
      * @brief Replace instances with children according to CHILD_TETS property
      *
@@ -338,6 +458,35 @@ class TetMeshProps : public TetMeshPropsBase
      * @return array<VH, 3> tet vertices
      */
     array<VH, 4> get_tet_vertices(const CH& tet) const;
+
+  protected:
+    void onPropertyChanged(size_t prop, const VH& v) override;
+    void onPropertyChanged(size_t prop, const EH& e) override;
+    void onPropertyChanged(size_t prop, const FH& f) override;
+    void onPropertyChanged(size_t prop) override;
+
+  private:
+    enum ClassificationFlag : uint8_t
+    {
+        CLASSIFIED = 1,
+        IN_PATCH = 2,
+        IN_ARC = 4,
+        IS_NODE = 8,
+        IS_FEATURE = 16,
+    };
+
+    uint8_t classification(const VH& v) const;
+    uint8_t classification(const EH& e) const;
+
+    uint8_t classify(const VH& v) const;
+    uint8_t classify(const EH& e) const;
+
+    bool isArcEdge(const EH& e) const;
+
+    static void invalidate(vector<uint8_t>& cache, int idx);
+
+    mutable vector<uint8_t> _vClassification;
+    mutable vector<uint8_t> _eClassification;
 };
 
 } // namespace mc3d
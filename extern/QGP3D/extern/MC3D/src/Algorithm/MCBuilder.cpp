@@ -2,6 +2,8 @@
 
 #include "MC3D/Mesh/MCMeshManipulator.hpp"
 
+#include <utility>
+
 namespace mc3d
 {
 
@@ -500,7 +502,7 @@ MCBuilder::RetCode MCBuilder::createAndMapPatches()
                     {
                         if (a != UNASSIGNED_CIRCULAR_ARC)
                         {
-                            const auto& hesA = mcMeshProps.ref<ARC_MESH_HALFEDGES>(a);
+                            const auto& hesA = std::as_const(mcMeshProps).ref<ARC_MESH_HALFEDGES>(a);
                             HEH ha = mcMeshProps.mesh().halfedge_handle(a, 0);
                             if (std::find(hesA.begin(), hesA.end(), he) == hesA.end())
                                 ha = mcMeshProps.mesh().opposite_halfedge_handle(ha);
@@ -631,7 +633,8 @@ MCBuilder::RetCode MCBuilder::createAndMapBlocks()
                                              FH patch = meshProps().get<MC_PATCH>(f);
                                              assert(patch.is_valid());
                                              HFH hp = mcMeshProps.mesh().halfface_handle(patch, 0);
-                                             const auto& hfsP = mcMeshProps.ref<PATCH_MESH_HALFFACES>(patch);
+                                             const auto& hfsP
+                                                 = std::as_const(mcMeshProps).ref<PATCH_MESH_HALFFACES>(patch);
                                              if (hfsP.find(hf) == hfsP.end())
                                                  hp = mcMeshProps.mesh().opposite_halfface_handle(hp);
                                              hpsB.insert(hp);
@@ -765,7 +768,7 @@ MCBuilder::RetCode MCBuilder::createAndMapBlocks()
             blockAllArcs[dim1dir] = {};
         for (EH a : mcMesh.cell_edges(b))
         {
-            HEH he = *mcMeshProps.ref<ARC_MESH_HALFEDGES>(a).begin();
+            HEH he = *std::as_const(mcMeshProps).ref<ARC_MESH_HALFEDGES>(a).begin();
 
             bool flip = he.idx() % 2 != 0;
 
@@ -841,6 +844,47 @@ MCBuilder::RetCode MCBuilder::updateSingleBlock(const CH& tetStart)
     return SUCCESS;
 }
 
+MCBuilder::RetCode MCBuilder::updateBlocks(const vector<CH>& tetsStart)
+{
+    vector<bool> tetVisited(meshProps().mesh().n_cells(), false);
+
+    auto& blockData = meshProps().ref<MC_BLOCK_DATA>();
+
+    // Clear all affected blocks first, each id is then reused by the first part of its block that is floodfilled
+    set<int> staleIds;
+    for (CH tet : tetsStart)
+        staleIds.insert(meshProps().get<MC_BLOCK_ID>(tet));
+    for (int id : staleIds)
+    {
+        auto& data = blockData.at(id);
+        data.toroidal = false;
+        data.selfadjacent = false;
+        data.tets.clear();
+        data.halffaces.clear();
+        data.edges.clear();
+        data.corners.clear();
+    }
+
+    for (CH tetStart : tetsStart)
+    {
+        if (tetVisited[tetStart.idx()])
+            continue;
+        int id = meshProps().get<MC_BLOCK_ID>(tetStart);
+        if (staleIds.erase(id) == 0)
+        {
+            // Another part of the same block was already floodfilled
+            id = blockData.rbegin()->first + 1;
+            blockData[id] = BlockData(id);
+        }
+        auto ret = gatherBlockData(tetStart, tetVisited, blockData.at(id));
+        if (ret != SUCCESS)
+            return ret;
+    }
+    assert(staleIds.empty());
+
+    return SUCCESS;
+}
+
 size_t MCBuilder::nToroidalBlocks() const
 {
     size_t n = 0;
@@ -2,6 +2,7 @@
 #include "MC3D/Algorithm/MCBuilder.hpp"
 
 #include <queue>
+#include <utility>
 
 namespace mc3d
 {
@@ -12,8 +13,16 @@ MCReducer::MCReducer(TetMeshProps& meshProps)
 {
 }
 
+MCReducer::~MCReducer()
+{
+    materializeBlockOwnership();
+}
+
 void MCReducer::init(bool preserveSingularPatches, bool avoidSelfadjacency, bool preserveFeatures)
 {
+    // Tet ownership of merged blocks is tracked lazily until the reduction is exhausted
+    setDeferredBlockOwnership(true);
+
     _preserveSingularPatches = preserveSingularPatches;
     _avoidSelfadjacency = avoidSelfadjacency;
     _preserveFeatures = preserveFeatures;
@@ -63,7 +72,7 @@ void MCReducer::removeNextPatch()
 
     if (meshProps().isAllocated<TOUCHED>())
     {
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
         {
             for (VH v : meshProps().mesh().halfface_vertices(hf))
             {
@@ -94,6 +103,7 @@ void MCReducer::skipUnremovablePatches()
         else
             return;
     }
+    materializeBlockOwnership();
 }
 
 void MCReducer::removeRemovableArcs(set<EH>& possiblyRemovableArcs, set<VH>& possiblyRemovableNodes)
@@ -114,7 +124,7 @@ void MCReducer::removeRemovableArcs(set<EH>& possiblyRemovableArcs, set<VH>& pos
 
             if (meshProps().isAllocated<TOUCHED>())
             {
-                for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(a))
+                for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a))
                 {
                     meshProps().set<TOUCHED>(meshProps().mesh().from_vertex_handle(he), true);
                     for (VH v2 : meshProps().mesh().vertex_vertices(meshProps().mesh().from_vertex_handle(he)))
@@ -3,6 +3,8 @@
 #include "MC3D/Algorithm/MCBuilder.hpp"
 #include "MC3D/Mesh/TetMeshNavigator.hpp"
 
+#include <utility>
+
 namespace mc3d
 {
 
@@ -114,9 +116,9 @@ MotorcycleSpawner::RetCode MotorcycleSpawner::spawnFeatureMotorcycles()
                             heOpp = tetMesh.next_halfedge_in_halfface(he, hf);
                             break;
                         }
-                    Vec3Q pos1 = meshProps().ref<CHART>(tet).at(v);
-                    Vec3Q pos2 = meshProps().ref<CHART>(tet).at(tetMesh.from_vertex_handle(heOpp));
-                    Vec3Q pos3 = meshProps().ref<CHART>(tet).at(tetMesh.to_vertex_handle(heOpp));
+                    Vec3Q pos1 = std::as_const(meshProps()).ref<CHART>(tet).at(v);
+                    Vec3Q pos2 = std::as_const(meshProps()).ref<CHART>(tet).at(tetMesh.from_vertex_handle(heOpp));
+                    Vec3Q pos3 = std::as_const(meshProps()).ref<CHART>(tet).at(tetMesh.to_vertex_handle(heOpp));
 
                     int normalCoord = -1;
                     for (int coord = 0; coord < 3; coord++)
@@ -171,7 +173,7 @@ MotorcycleSpawner::RetCode MotorcycleSpawner::spawnFeatureMotorcycles()
                         Vec3Q barCoords;
                         if (barycentricCoords2D<CHART>((hfOpp.idx() % 2) == 0 ? hfOpp
                                                                               : tetMesh.opposite_halfface_handle(hfOpp),
-                                                       meshProps().ref<CHART>(tet).at(v),
+                                                       std::as_const(meshProps()).ref<CHART>(tet).at(v),
                                                        constCoord,
                                                        barCoords))
                         {
@@ -204,7 +206,6 @@ MotorcycleSpawner::RetCode MotorcycleSpawner::spawnFeatureMotorcycles()
 
 MotorcycleSpawner::RetCode MotorcycleSpawner::spawnTorusSplitMotorcycle()
 {
-    const TetMesh& tetMesh = meshProps().mesh();
     const auto& blockData = meshProps().ref<MC_BLOCK_DATA>();
 
     // Find properly aligned source arc on the hull of a block THEN fallback to any aligned edge inside of the block
@@ -213,24 +214,9 @@ MotorcycleSpawner::RetCode MotorcycleSpawner::spawnTorusSplitMotorcycle()
         {
             auto& data = kv.second;
             if (data.toroidal)
-            {
                 for (CH tet : data.tets)
-                {
-                    int wallIsoCoord = toCoord(data.axis);
-                    for (EH e : tetMesh.cell_edges(tet))
-                    {
-                        if (onlyArcs && !meshProps().get<IS_ARC>(e))
-                            continue;
-                        bool onBoundary = false;
-                        for (FH f : tetMesh.edge_faces(e))
-                            if (meshProps().isBlockBoundary(f))
-                                onBoundary = true;
-                        if (onBoundary)
-                            if (spawnMotorcycle(e, tet, wallIsoCoord))
-                                return SUCCESS;
-                    }
-                }
-            }
+                    if (spawnTorusSplitMotorcycle(data, tet, onlyArcs))
+                        return SUCCESS;
         }
 
     // THEN fallback to Splitting something on the hull of a block
@@ -238,52 +224,103 @@ MotorcycleSpawner::RetCode MotorcycleSpawner::spawnTorusSplitMotorcycle()
     {
         auto& data = kv.second;
         if (data.toroidal)
-        {
-            int wallIsoCoord = toCoord(data.axis);
             for (CH tet : data.tets)
+                if (splitAndSpawnTorusSplitMotorcycle(data, tet))
+                    return SUCCESS;
+    }
+
+    return UNSPLITTABLE_BLOCK;
+}
+
+MotorcycleSpawner::RetCode MotorcycleSpawner::spawnTorusSplitMotorcycles()
+{
+    const auto& blockData = meshProps().ref<MC_BLOCK_DATA>();
+
+    for (auto& kv : blockData)
+        if (kv.second.toroidal && !spawnTorusSplitMotorcycle(kv.second))
+            return UNSPLITTABLE_BLOCK;
+
+    return SUCCESS;
+}
+
+bool MotorcycleSpawner::spawnTorusSplitMotorcycle(const BlockData& data)
+{
+    // Same order of preference as when spawning a single motorcycle, but restricted to this block
+    for (bool onlyArcs : {true, false})
+        for (CH tet : data.tets)
+            if (spawnTorusSplitMotorcycle(data, tet, onlyArcs))
+                return true;
+
+    // Splitting modifies data.tets, so this has to return right after the first split
+    for (CH tet : data.tets)
+        if (splitAndSpawnTorusSplitMotorcycle(data, tet))
+            return true;
+
+    return false;
+}
+
+bool MotorcycleSpawner::spawnTorusSplitMotorcycle(const BlockData& data, const CH& tet, bool onlyArcs)
+{
+    const TetMesh& tetMesh = meshProps().mesh();
+
+    int wallIsoCoord = toCoord(data.axis);
+    for (EH e : tetMesh.cell_edges(tet))
+    {
+        if (onlyArcs && !meshProps().get<IS_ARC>(e))
+            continue;
+        bool onBoundary = false;
+        for (FH f : tetMesh.edge_faces(e))
+            if (meshProps().isBlockBoundary(f))
+                onBoundary = true;
+        if (onBoundary)
+            if (spawnMotorcycle(e, tet, wallIsoCoord))
+                return true;
+    }
+    return false;
+}
+
+bool MotorcycleSpawner::splitAndSpawnTorusSplitMotorcycle(const BlockData& data, const CH& tet)
+{
+    const TetMesh& tetMesh = meshProps().mesh();
+
+    int wallIsoCoord = toCoord(data.axis);
+    for (HFH hf : tetMesh.cell_halffaces(tet))
+    {
+        if (!meshProps().isBlockBoundary(hf))
+            continue;
+        // Find any edge that is splittable
+        for (HEH he : tetMesh.halfface_halfedges(hf))
+        {
+            UVWDir dir = edgeDirection(tetMesh.edge_handle(he), tet);
+            if ((he.idx() % 2) != 0)
+                dir = -dir;
+            if (dim(data.axis & dir) != 1)
+                continue;
+            // Edge is correctly aligned
+            vector<VH> vs;
+            for (VH v : tetMesh.halfedge_vertices(he))
+                vs.emplace_back(v);
+            vs.emplace_back(tetMesh.to_vertex_handle(tetMesh.next_halfedge_in_halfface(he, hf)));
+            vector<Vec3Q> uvws;
+            for (VH v : vs)
+                uvws.emplace_back(meshProps().get<CHART>(tet).at(v));
+            Q t = (uvws[2][wallIsoCoord] - uvws[0][wallIsoCoord]) / (uvws[1][wallIsoCoord] - uvws[0][wallIsoCoord]);
+            if (t <= 0 || t >= 1)
+                continue;
+            // edge is splittable
+            VH vNew = splitHalfEdge(he, tet, t);
+            EH eSplit = tetMesh.edge_handle(tetMesh.find_halfedge(vNew, vs[2]));
+            for (CH tetSplit : tetMesh.edge_cells(eSplit))
             {
-                for (HFH hf : tetMesh.cell_halffaces(tet))
-                {
-                    if (!meshProps().isBlockBoundary(hf))
-                        continue;
-                    // Find any edge that is splittable
-                    for (HEH he : tetMesh.halfface_halfedges(hf))
-                    {
-                        UVWDir dir = edgeDirection(tetMesh.edge_handle(he), tet);
-                        if ((he.idx() % 2) != 0)
-                            dir = -dir;
-                        if (dim(data.axis & dir) != 1)
-                            continue;
-                        // Edge is correctly aligned
-                        vector<VH> vs;
-                        for (VH v : tetMesh.halfedge_vertices(he))
-                            vs.emplace_back(v);
-                        vs.emplace_back(tetMesh.to_vertex_handle(tetMesh.next_halfedge_in_halfface(he, hf)));
-                        vector<Vec3Q> uvws;
-                        for (VH v : vs)
-                            uvws.emplace_back(meshProps().get<CHART>(tet).at(v));
-                        Q t = (uvws[2][wallIsoCoord] - uvws[0][wallIsoCoord])
-                              / (uvws[1][wallIsoCoord] - uvws[0][wallIsoCoord]);
-                        if (t <= 0 || t >= 1)
-                            continue;
-                        // edge is splittable
-                        VH vNew = splitHalfEdge(he, tet, t);
-                        EH eSplit = tetMesh.edge_handle(tetMesh.find_halfedge(vNew, vs[2]));
-                        for (CH tetSplit : tetMesh.edge_cells(eSplit))
-                        {
-                            // In same block?
-                            bool sameBlock = meshProps().get<MC_BLOCK_ID>(tetSplit) == data.id;
-                            if (sameBlock && spawnMotorcycle(eSplit, tetSplit, wallIsoCoord))
-                                return SUCCESS;
-                        }
-                        throw std::logic_error("Created aligned edge but could not spawn motorcycle on it");
-                    }
-                }
+                // In same block?
+                bool sameBlock = meshProps().get<MC_BLOCK_ID>(tetSplit) == data.id;
+                if (sameBlock && spawnMotorcycle(eSplit, tetSplit, wallIsoCoord))
+                    return true;
             }
+            throw std::logic_error("Created aligned edge but could not spawn motorcycle on it");
         }
     }
-
-    return UNSPLITTABLE_BLOCK;
+    return false;
 }
 
 MotorcycleSpawner::RetCode MotorcycleSpawner::spawnSelfadjacencySplitMotorcycle()
@@ -297,81 +334,118 @@ MotorcycleSpawner::RetCode MotorcycleSpawner::spawnSelfadjacencySplitMotorcycle(
         for (CH tet : tetMesh.cells())
         {
             const auto& data = blockData.at(meshProps().get<MC_BLOCK_ID>(tet));
-            if (data.selfadjacent)
-            {
-                int wallIsoCoord = toCoord(data.axis);
-
-                for (EH e : meshProps().mesh().cell_edges(tet))
-                {
-                    if (onlyArcs && !meshProps().get<IS_ARC>(e))
-                        continue;
-                    bool onBoundary = false;
-                    bool onWrongBoundary = false;
-                    for (HFH hf : meshProps().mesh().edge_halffaces(e))
-                        if (meshProps().isBlockBoundary(hf))
-                        {
-                            onBoundary = true;
-                            if (dim(data.axis | normalDirUVW(hf)) == 1)
-                                onWrongBoundary = true;
-                        }
-                    if (onBoundary && !onWrongBoundary && spawnMotorcycle(e, tet, wallIsoCoord))
-                        return SUCCESS;
-                }
-            }
+            if (data.selfadjacent && spawnSelfadjacencySplitMotorcycle(data, tet, onlyArcs))
+                return SUCCESS;
         }
 
     // THEN fallback to Splitting something on the hull of a block
     for (CH tet : tetMesh.cells())
     {
         const auto& data = blockData.at(meshProps().get<MC_BLOCK_ID>(tet));
-        if (data.selfadjacent)
-        {
-            int wallIsoCoord = toCoord(data.axis);
-            for (HFH hf : tetMesh.cell_halffaces(tet))
+        if (data.selfadjacent && splitAndSpawnSelfadjacencySplitMotorcycle(data, tet))
+            return SUCCESS;
+    }
+
+    return UNSPLITTABLE_BLOCK;
+}
+
+MotorcycleSpawner::RetCode MotorcycleSpawner::spawnSelfadjacencySplitMotorcycles()
+{
+    const auto& blockData = meshProps().ref<MC_BLOCK_DATA>();
+
+    for (auto& kv : blockData)
+        if (kv.second.selfadjacent && !spawnSelfadjacencySplitMotorcycle(kv.second))
+            return UNSPLITTABLE_BLOCK;
+
+    return SUCCESS;
+}
+
+bool MotorcycleSpawner::spawnSelfadjacencySplitMotorcycle(const BlockData& data)
+{
+    // Same order of preference as when spawning a single motorcycle, but restricted to this block
+    for (bool onlyArcs : {true, false})
+        for (CH tet : data.tets)
+            if (spawnSelfadjacencySplitMotorcycle(data, tet, onlyArcs))
+                return true;
+
+    // Splitting modifies data.tets, so this has to return right after the first split
+    for (CH tet : data.tets)
+        if (splitAndSpawnSelfadjacencySplitMotorcycle(data, tet))
+            return true;
+
+    return false;
+}
+
+bool MotorcycleSpawner::spawnSelfadjacencySplitMotorcycle(const BlockData& data, const CH& tet, bool onlyArcs)
+{
+    const TetMesh& tetMesh = meshProps().mesh();
+
+    int wallIsoCoord = toCoord(data.axis);
+    for (EH e : tetMesh.cell_edges(tet))
+    {
+        if (onlyArcs && !meshProps().get<IS_ARC>(e))
+            continue;
+        bool onBoundary = false;
+        bool onWrongBoundary = false;
+        for (HFH hf : tetMesh.edge_halffaces(e))
+            if (meshProps().isBlockBoundary(hf))
             {
-                if (!meshProps().isBlockBoundary(hf) || dim(data.axis | normalDirUVW(hf)) == 1)
-                    continue;
-                // Find any edge that is splittable
-                for (HEH he : tetMesh.halfface_halfedges(hf))
-                {
-                    UVWDir dir = edgeDirection(tetMesh.edge_handle(he), tet);
-                    if ((he.idx() % 2) != 0)
-                        dir = -dir;
-                    if (dim(data.axis & dir) != 1)
-                        continue;
+                onBoundary = true;
+                if (dim(data.axis | normalDirUVW(hf)) == 1)
+                    onWrongBoundary = true;
+            }
+        if (onBoundary && !onWrongBoundary && spawnMotorcycle(e, tet, wallIsoCoord))
+            return true;
+    }
+    return false;
+}
 
-                    // Edge is correctly aligned
-                    vector<VH> vs;
-                    for (VH v : tetMesh.halfedge_vertices(he))
-                        vs.emplace_back(v);
-                    vs.emplace_back(tetMesh.to_vertex_handle(tetMesh.next_halfedge_in_halfface(he, hf)));
-                    vector<Vec3Q> uvws;
-                    for (VH v : vs)
-                        uvws.emplace_back(meshProps().get<CHART>(tet).at(v));
-                    Q t = (uvws[2][wallIsoCoord] - uvws[0][wallIsoCoord])
-                          / (uvws[1][wallIsoCoord] - uvws[0][wallIsoCoord]);
-                    if (t <= 0 || t >= 1)
-                        continue;
+bool MotorcycleSpawner::splitAndSpawnSelfadjacencySplitMotorcycle(const BlockData& data, const CH& tet)
+{
+    const TetMesh& tetMesh = meshProps().mesh();
 
-                    // edge is splittable
-                    VH vNew = splitHalfEdge(he, tet, t);
-                    EH eSplit = tetMesh.edge_handle(tetMesh.find_halfedge(vNew, vs[2]));
-                    for (CH tetSplit : tetMesh.edge_cells(eSplit))
-                    {
-                        if (dim(edgeDirection(eSplit, tetSplit)) != 1)
-                            throw std::logic_error("Created aligned edge is not aligned");
-                        // In same block?
-                        bool sameBlock = meshProps().get<MC_BLOCK_ID>(tetSplit) == data.id;
-                        if (sameBlock && spawnMotorcycle(eSplit, tetSplit, wallIsoCoord))
-                            return SUCCESS;
-                    }
-                    throw std::logic_error("Created aligned edge but could not spawn motorcycle on it");
-                }
+    int wallIsoCoord = toCoord(data.axis);
+    for (HFH hf : tetMesh.cell_halffaces(tet))
+    {
+        if (!meshProps().isBlockBoundary(hf) || dim(data.axis | normalDirUVW(hf)) == 1)
+            continue;
+        // Find any edge that is splittable
+        for (HEH he : tetMesh.halfface_halfedges(hf))
+        {
+            UVWDir dir = edgeDirection(tetMesh.edge_handle(he), tet);
+            if ((he.idx() % 2) != 0)
+                dir = -dir;
+            if (dim(data.axis & dir) != 1)
+                continue;
+
+            // Edge is correctly aligned
+            vector<VH> vs;
+            for (VH v : tetMesh.halfedge_vertices(he))
+                vs.emplace_back(v);
+            vs.emplace_back(tetMesh.to_vertex_handle(tetMesh.next_halfedge_in_halfface(he, hf)));
+            vector<Vec3Q> uvws;
+            for (VH v : vs)
+                uvws.emplace_back(meshProps().get<CHART>(tet).at(v));
+            Q t = (uvws[2][wallIsoCoord] - uvws[0][wallIsoCoord]) / (uvws[1][wallIsoCoord] - uvws[0][wallIsoCoord]);
+            if (t <= 0 || t >= 1)
+                continue;
+
+            // edge is splittable
+            VH vNew = splitHalfEdge(he, tet, t);
+            EH eSplit = tetMesh.edge_handle(tetMesh.find_halfedge(vNew, vs[2]));
+            for (CH tetSplit : tetMesh.edge_cells(eSplit))
+            {
+                if (dim(edgeDirection(eSplit, tetSplit)) != 1)
+                    throw std::logic_error("Created aligned edge is not aligned");
+                // In same block?
+                bool sameBlock = meshProps().get<MC_BLOCK_ID>(tetSplit) == data.id;
+                if (sameBlock && spawnMotorcycle(eSplit, tetSplit, wallIsoCoord))
+                    return true;
             }
+            throw std::logic_error("Created aligned edge but could not spawn motorcycle on it");
         }
     }
-
-    return UNSPLITTABLE_BLOCK;
+    return false;
 }
 
 bool MotorcycleSpawner::spawnMotorcycle(const EH& e, const CH& tet, int wallIsoCoord)
@@ -391,7 +465,7 @@ bool MotorcycleSpawner::spawnMotorcycle(const EH& e, const CH& tet, int wallIsoC
         if (i != wallIsoCoord && i != edgeDirCoord)
             wallPropagationCoord = i;
 
-    const auto& chart = meshProps().ref<CHART>(tet);
+    const auto& chart = std::as_const(meshProps()).ref<CHART>(tet);
     auto evs = meshProps().mesh().edge_vertices(e);
 
     for (HFH hf : meshProps().mesh().cell_halffaces(tet))
@@ -1,11 +1,13 @@
 #include "MC3D/Algorithm/MotorcycleTracer.hpp"
 
+#include <utility>
+
 namespace mc3d
 {
 
-MotorcycleTracer::MotorcycleTracer(TetMeshProps& meshProps, MotorcycleQueue& mQ, bool simulateBC)
+MotorcycleTracer::MotorcycleTracer(TetMeshProps& meshProps, MotorcycleQueue& mQ, bool simulateBC, bool wavefront)
     : TetMeshNavigator(meshProps), TetMeshManipulator(meshProps), _mQ(mQ), _qPops(0), _eSplits(0),
-      _simulateBC(simulateBC)
+      _simulateBC(simulateBC), _wavefront(wavefront)
 {
 }
 
@@ -17,7 +19,7 @@ MotorcycleTracer::RetCode MotorcycleTracer::traceAllMotorcycles()
         maxDist = std::max(maxDist, _mQ.top().dist.get_d());
         DLOG_IF(INFO, _qPops % 10000 == 0)
             << "After " << _qPops << " queue pops: " << _eSplits << " edges split, queue size is " << _mQ.size();
-        auto ret = traceNextMotorcycle();
+        auto ret = _wavefront ? traceNextWavefront() : traceNextMotorcycle();
         if (ret != SUCCESS)
             return ret;
     }
@@ -32,6 +34,44 @@ MotorcycleTracer::RetCode MotorcycleTracer::traceNextMotorcycle()
     _mQ.pop();
     _qPops++;
 
+    return traceLocalQueue();
+}
+
+MotorcycleTracer::RetCode MotorcycleTracer::traceNextWavefront()
+{
+    Q dist = _mQ.top().dist;
+    vector<Motorcycle> wavefront;
+    while (!_mQ.empty() && _mQ.top().dist == dist)
+    {
+        wavefront.push_back(_mQ.top());
+        _mQ.pop();
+        _qPops++;
+    }
+
+    // Cut all edges crossed by the wavefront at once
+    map<EH, set<Q>> eCuts;
+    for (const Motorcycle& mot : wavefront)
+    {
+        if (!meshProps().mesh().is_deleted(mot.tet))
+            collectEdgeCut(mot, eCuts);
+        else
+            forEachChildMotorcycle(mot, [this, &eCuts](const Motorcycle& child) { collectEdgeCut(child, eCuts); });
+    }
+    _eSplits += TetMeshManipulator::splitAll(eCuts);
+
+    // Trace in queue order, now mostly through the newly created isofacets
+    for (const Motorcycle& mot : wavefront)
+    {
+        _localQ.push(mot);
+        auto ret = traceLocalQueue();
+        if (ret != SUCCESS)
+            return ret;
+    }
+    return SUCCESS;
+}
+
+MotorcycleTracer::RetCode MotorcycleTracer::traceLocalQueue()
+{
     while (!_localQ.empty())
     {
         Motorcycle mot = _localQ.top();
@@ -46,7 +86,7 @@ MotorcycleTracer::RetCode MotorcycleTracer::traceNextMotorcycle()
         else
         {
             // Tet (and possibly edge) split -> find and trace all children
-            RetCode ret;
+            RetCode ret = SUCCESS;
             forEachChildMotorcycle(mot,
                                    [this, &ret](const Motorcycle& child)
                                    {
@@ -149,8 +189,9 @@ MotorcycleTracer::RetCode MotorcycleTracer::traceMotorcycle(const Motorcycle& mo
     TetElements elems(TetMeshNavigator::getTetElements(mot.tet, mot.edge));
 
     // Determine if propagation direction passes through mot.tet
-    Vec3Q uvwA = meshProps().get<CHART>(mot.tet).at(elems.vA);
-    Vec3Q uvwD = meshProps().get<CHART>(mot.tet).at(elems.vD);
+    const auto& chart = std::as_const(meshProps()).ref<CHART>(mot.tet);
+    Vec3Q uvwA = chart.at(elems.vA);
+    Vec3Q uvwD = chart.at(elems.vD);
 
     int wallIsoCoord = mot.isoCoord();
     Q deltaA = uvwA[wallIsoCoord] - Q(mot.isoValue);
@@ -212,6 +253,27 @@ MotorcycleTracer::RetCode MotorcycleTracer::traceMotorcycle(const Motorcycle& mo
     return SUCCESS;
 }
 
+void MotorcycleTracer::collectEdgeCut(const Motorcycle& mot, map<EH, set<Q>>& eCuts) const
+{
+    const TetMesh& tetMesh = meshProps().mesh();
+
+    TetElements elems(TetMeshNavigator::getTetElements(mot.tet, mot.edge));
+
+    int wallIsoCoord = mot.isoCoord();
+    const auto& chart = meshProps().ref<CHART>(mot.tet);
+    Q deltaA = chart.at(elems.vA)[wallIsoCoord] - Q(mot.isoValue);
+    Q deltaD = chart.at(elems.vD)[wallIsoCoord] - Q(mot.isoValue);
+
+    // No cut needed if propagating through an isofacet (degenerate cases are reported when tracing)
+    if (deltaA * deltaD >= 0)
+        return;
+
+    // Same cut as in traceMotorcycle(), but relative to the first halfedge of the edge
+    Q t = deltaA / (deltaA - deltaD);
+    EH e = tetMesh.edge_handle(elems.heAD);
+    eCuts[e].insert(elems.heAD == tetMesh.halfedge_handle(e, 0) ? t : Q(1 - t));
+}
+
 void MotorcycleTracer::propagateAcrossEdge(const Motorcycle& mot, const HEH& he, const HFH& hfWall)
 {
     const TetMesh& tetMesh = meshProps().mesh();
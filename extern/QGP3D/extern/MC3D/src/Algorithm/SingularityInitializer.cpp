@@ -12,17 +12,16 @@ SingularityInitializer::RetCode SingularityInitializer::initTransitions()
 {
     int n = 0;
     meshProps().allocate<TRANSITION>();
-    meshProps().allocate<TRANSITION_ORIG>();
     for (FH f : meshProps().mesh().faces())
     {
         Transition trans = calcTransition(f);
         if (!trans.isIdentity())
         {
-            meshProps().setTransition<TRANSITION>(f, calcTransition(f));
-            meshProps().setTransition<TRANSITION_ORIG>(f, trans);
+            meshProps().setTransition<TRANSITION>(f, trans);
             n++;
         }
     }
+    meshProps().takeSnapshot<TRANSITION_ORIG>();
     LOG(INFO) << "Determined nonzero transition functions for " << n << " of " << meshProps().mesh().n_faces()
               << " faces";
     return SUCCESS;
@@ -1,5 +1,7 @@
 #include "MC3D/Algorithm/TetRemesher.hpp"
 
+#include <utility>
+
 namespace mc3d
 {
 TetRemesher::TetRemesher(TetMeshProps& meshProps) : TetMeshNavigator(meshProps), TetMeshManipulator(meshProps)
@@ -211,8 +213,8 @@ TetRemesher::CollapseStats TetRemesher::collapseStats(
             }
         }
 
-        Vec3Q uvwTo = (hasLocalChartIGM ? meshProps().ref<CHART_IGM>(*collapsedTets.begin())
-                                        : meshProps().ref<CHART>(*collapsedTets.begin()))
+        Vec3Q uvwTo = (hasLocalChartIGM ? std::as_const(meshProps()).ref<CHART_IGM>(*collapsedTets.begin())
+                                        : std::as_const(meshProps()).ref<CHART>(*collapsedTets.begin()))
                           .at(vTo);
         auto tet2trans = hasLocalChartIGM
                              ? determineTransitionsAroundVertex<TRANSITION_IGM>(vFrom, *collapsedTets.begin())
@@ -222,7 +224,8 @@ TetRemesher::CollapseStats TetRemesher::collapseStats(
         Q negVolUVW = 0.0;
         for (CH tet : shiftedTets)
         {
-            auto& chart = hasLocalChartIGM ? meshProps().ref<CHART_IGM>(tet) : meshProps().ref<CHART>(tet);
+            const auto& chart = hasLocalChartIGM ? std::as_const(meshProps()).ref<CHART_IGM>(tet)
+                                                 : std::as_const(meshProps()).ref<CHART>(tet);
             vector<Vec3Q> UVWs;
             for (VH v : tetMesh.tet_vertices(tet))
                 if (v == vFrom)
@@ -976,8 +979,12 @@ struct LeastComp
     }
 };
 
-void TetRemesher::collapseAllPossibleEdges(
-    bool onlyNonOriginals, bool keepImportantShape, bool keepInjectivity, bool considerQuality, double qualityBound)
+int TetRemesher::collapseAllPossibleEdges(bool onlyNonOriginals,
+                                          bool keepImportantShape,
+                                          bool keepInjectivity,
+                                          bool considerQuality,
+                                          double qualityBound,
+                                          const set<CH>& blockedBlocks)
 {
     using HEQueue = std::priority_queue<EdgeHeuristic, std::deque<EdgeHeuristic>, LeastComp<EdgeHeuristic>>;
     TetMesh& tetMesh = meshProps().mesh();
@@ -1015,6 +1022,11 @@ void TetRemesher::collapseAllPossibleEdges(
         if (tetMesh.is_deleted(he))
             continue;
 
+        if (!blockedBlocks.empty()
+            && containsMatching(tetMesh.vertex_cells(tetMesh.from_vertex_handle(he)),
+                                [&](const CH& tet) { return blockedBlocks.count(meshProps().get<MC_BLOCK>(tet)) != 0; }))
+            continue;
+
         auto stats = collapseStats(he, keepInjectivity, onlyNonOriginals, QualityMeasure::ANGLES, keepImportantShape);
         if (!stats.valid)
             continue;
@@ -1051,6 +1063,7 @@ void TetRemesher::collapseAllPossibleEdges(
     }
     LOG(INFO) << (onlyNonOriginals ? "Collapsed " : "Derefined ") << nCollapse << " halfedges, mesh has "
               << tetMesh.n_logical_cells() << " remaining tets";
+    return nCollapse;
 }
 
 struct OpHeuristic
@@ -1063,11 +1076,11 @@ struct OpHeuristic
     int timeStamp = INT_MIN;
 };
 
-void TetRemesher::remeshToImproveAngles(
+int TetRemesher::remeshToImproveAngles(
     bool keepImportantShape, bool includingUVW, QualityMeasure quality, int stage, const set<CH>& blockedBlocks)
 {
     if (stage >= 2)
-        return;
+        return 0;
     TetMesh& tetMesh = meshProps().mesh();
     using OPQueue = std::priority_queue<OpHeuristic, std::deque<OpHeuristic>, LeastComp<OpHeuristic>>;
 
@@ -1293,14 +1306,16 @@ void TetRemesher::remeshToImproveAngles(
             if (std::find(lastMeshSizes.begin(), lastMeshSizes.end(), sizes) != lastMeshSizes.end())
             {
                 LOG(WARNING) << "Cycle in remeshing encountered, aborting...";
+                int nOpsNextStage = 0;
                 if (stage == 0)
                 {
-                    remeshToImproveAngles(keepImportantShape, includingUVW, quality, stage + 1, blockedBlocks);
+                    nOpsNextStage
+                        = remeshToImproveAngles(keepImportantShape, includingUVW, quality, stage + 1, blockedBlocks);
                     LOG(INFO) << "Remeshing done, edges split: " << nSplit << ", flipped: " << nFlip
                               << ", collapsed: " << nCollapse << ", shifted: " << nShift << " mesh has "
                               << tetMesh.n_logical_cells() << " remaining tets";
                 }
-                return;
+                return nSplit + nFlip + nCollapse + nShift + nOpsNextStage;
             }
             else
             {
@@ -1423,12 +1438,14 @@ void TetRemesher::remeshToImproveAngles(
             }
     }
 
+    int nOpsNextStage = 0;
     if (stage == 0)
     {
-        remeshToImproveAngles(keepImportantShape, includingUVW, quality, stage + 1, blockedBlocks);
+        nOpsNextStage = remeshToImproveAngles(keepImportantShape, includingUVW, quality, stage + 1, blockedBlocks);
         LOG(INFO) << "Remeshing done, edges split: " << nSplit << ", flipped: " << nFlip << ", collapsed: " << nCollapse
                   << ", shifted: " << nShift << " mesh has " << tetMesh.n_logical_cells() << " remaining tets";
     }
+    return nSplit + nFlip + nCollapse + nShift + nOpsNextStage;
 }
 
 } // namespace mc3d
@@ -1,5 +1,7 @@
 #include "MC3D/Data/Motorcycle.hpp"
 
+#include <algorithm>
+
 namespace mc3d
 {
 
@@ -74,4 +76,61 @@ bool Motorcycle::ShorterDistLIFOTieBreak::operator()(const Motorcycle& a, const
     return a.dist > b.dist || (a.dist == b.dist && a.ID < b.ID);
 }
 
+void MotorcycleQueue::push(Motorcycle mot)
+{
+    Entry entry{mot.dist.get_d(), mot.ID, 0};
+    if (_freeSlots.empty())
+    {
+        entry.slot = _pool.size();
+        _pool.emplace_back(std::move(mot));
+    }
+    else
+    {
+        entry.slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _pool[entry.slot] = std::move(mot);
+    }
+    _heap.push_back(entry);
+    std::push_heap(
+        _heap.begin(), _heap.end(), [this](const Entry& a, const Entry& b) { return lowerPriority(a, b); });
+}
+
+const Motorcycle& MotorcycleQueue::top() const
+{
+    assert(!_heap.empty());
+    return _pool[_heap.front().slot];
+}
+
+void MotorcycleQueue::pop()
+{
+    assert(!_heap.empty());
+    std::pop_heap(
+        _heap.begin(), _heap.end(), [this](const Entry& a, const Entry& b) { return lowerPriority(a, b); });
+    _freeSlots.push_back(_heap.back().slot);
+    _heap.pop_back();
+}
+
+bool MotorcycleQueue::empty() const
+{
+    return _heap.empty();
+}
+
+size_t MotorcycleQueue::size() const
+{
+    return _heap.size();
+}
+
+bool MotorcycleQueue::lowerPriority(const Entry& a, const Entry& b) const
+{
+    // Truncation is monotonic: distinct keys imply distinct exact distances in the same order
+    if (a.distKey != b.distKey)
+        return a.distKey > b.distKey;
+    // Keys are within the (truncation) error bound of each other -> resolve exactly
+    const Q& distA = _pool[a.slot].dist;
+    const Q& distB = _pool[b.slot].dist;
+    if (distA != distB)
+        return distA > distB;
+    return a.ID > b.ID;
+}
+
 } // namespace mc3d
@@ -13,7 +13,12 @@ MCGenerator::MCGenerator(TetMeshProps& meshProps) : TetMeshNavigator(meshProps),
 {
 }
 
-MCGenerator::RetCode MCGenerator::traceMC(bool splitTori, bool splitSelfadjacency, bool simulateBC, bool keepOrigProps)
+MCGenerator::RetCode MCGenerator::traceMC(bool splitTori,
+                                          bool splitSelfadjacency,
+                                          bool simulateBC,
+                                          bool keepOrigProps,
+                                          bool batchSplits,
+                                          bool wavefront)
 {
     SingularityInitializer init(meshProps());
     if (init.initTransitions() != SingularityInitializer::SUCCESS
@@ -23,7 +28,7 @@ MCGenerator::RetCode MCGenerator::traceMC(bool splitTori, bool splitSelfadjacenc
 
     MotorcycleQueue mQ;
     MotorcycleSpawner spawner(meshProps(), mQ);
-    MotorcycleTracer tracer(meshProps(), mQ, simulateBC);
+    MotorcycleTracer tracer(meshProps(), mQ, simulateBC, wavefront);
 
     meshProps().allocate<IS_WALL>(false);
     if (meshProps().isAllocated<IS_FEATURE_F>())
@@ -39,18 +44,11 @@ MCGenerator::RetCode MCGenerator::traceMC(bool splitTori, bool splitSelfadjacenc
     meshProps().allocate<CHILD_FACES>({});
     if (keepOrigProps)
     {
+        // Originals share the storage of the current charts/transitions until these are modified
         if (!meshProps().isAllocated<CHART_ORIG>())
-        {
-            meshProps().allocate<CHART_ORIG>();
-            for (CH tet : meshProps().mesh().cells())
-                meshProps().set<CHART_ORIG>(tet, meshProps().ref<CHART>(tet));
-        }
+            meshProps().takeSnapshot<CHART_ORIG>();
         if (!meshProps().isAllocated<TRANSITION_ORIG>())
-        {
-            meshProps().allocate<TRANSITION_ORIG>();
-            for (FH f : meshProps().mesh().faces())
-                meshProps().set<TRANSITION_ORIG>(f, meshProps().ref<TRANSITION>(f));
-        }
+            meshProps().takeSnapshot<TRANSITION_ORIG>();
         if (!meshProps().isAllocated<IS_ORIGINAL_V>())
         {
             meshProps().allocate<IS_ORIGINAL_V>(false);
@@ -76,18 +74,37 @@ MCGenerator::RetCode MCGenerator::traceMC(bool splitTori, bool splitSelfadjacenc
     if (builder.discoverBlocks() != MCBuilder::SUCCESS)
         return BUILDING_MC_FAILED;
 
+    // Tets on both sides of the walls traced since the last update, from which the affected blocks are regathered
+    auto newWallTets = [this, &tracer]()
+    {
+        vector<CH> tets;
+        for (FH f : tracer.getNewWalls())
+            for (CH tet : meshProps().mesh().face_cells(f))
+                if (tet.is_valid())
+                    tets.emplace_back(tet);
+        return tets;
+    };
+
     for (size_t n = builder.nToroidalBlocks(); splitTori && n > 0; n = builder.nToroidalBlocks())
     {
         LOG(INFO) << "Splitting toroidal blocks. " << n << " remaining";
-        if (spawner.spawnTorusSplitMotorcycle() != MotorcycleSpawner::SUCCESS)
+        if ((batchSplits ? spawner.spawnTorusSplitMotorcycles() : spawner.spawnTorusSplitMotorcycle())
+            != MotorcycleSpawner::SUCCESS)
             return SPAWNING_FAILED;
         tracer.clearNewWalls();
         if (tracer.traceAllMotorcycles() != MotorcycleTracer::SUCCESS)
             return TRACING_FAILED;
 
-        auto newWalls = tracer.getNewWalls();
-        HFH hfAny = meshProps().mesh().halfface_handle(newWalls.front(), 0);
-        if (builder.updateSingleBlock(meshProps().mesh().incident_cell(hfAny)) != MCBuilder::SUCCESS)
+        MCBuilder::RetCode ret;
+        if (batchSplits)
+            ret = builder.updateBlocks(newWallTets());
+        else
+        {
+            auto newWalls = tracer.getNewWalls();
+            HFH hfAny = meshProps().mesh().halfface_handle(newWalls.front(), 0);
+            ret = builder.updateSingleBlock(meshProps().mesh().incident_cell(hfAny));
+        }
+        if (ret != MCBuilder::SUCCESS)
         {
             meshProps().clearMC();
             return SPLITTING_FAILED;
@@ -97,17 +114,26 @@ MCGenerator::RetCode MCGenerator::traceMC(bool splitTori, bool splitSelfadjacenc
     for (size_t n = builder.nSelfadjacentBlocks(); splitSelfadjacency && n > 0; n = builder.nSelfadjacentBlocks())
     {
         LOG(INFO) << "Splitting selfadjacent blocks. " << n << " remaining";
-        if (spawner.spawnSelfadjacencySplitMotorcycle() != MotorcycleSpawner::SUCCESS)
+        if ((batchSplits ? spawner.spawnSelfadjacencySplitMotorcycles() : spawner.spawnSelfadjacencySplitMotorcycle())
+            != MotorcycleSpawner::SUCCESS)
             return SPAWNING_FAILED;
         tracer.clearNewWalls();
         if (tracer.traceAllMotorcycles() != MotorcycleTracer::SUCCESS)
             return TRACING_FAILED;
 
-        auto newWalls = tracer.getNewWalls();
-        HFH hfAny = meshProps().mesh().halfface_handle(newWalls.front(), 0);
-        HFH hfAnyOpp = meshProps().mesh().halfface_handle(newWalls.front(), 1);
-        if (builder.updateSingleBlock(meshProps().mesh().incident_cell(hfAny)) != MCBuilder::SUCCESS
-            || builder.updateSingleBlock(meshProps().mesh().incident_cell(hfAnyOpp)) != MCBuilder::SUCCESS)
+        MCBuilder::RetCode ret;
+        if (batchSplits)
+            ret = builder.updateBlocks(newWallTets());
+        else
+        {
+            auto newWalls = tracer.getNewWalls();
+            HFH hfAny = meshProps().mesh().halfface_handle(newWalls.front(), 0);
+            HFH hfAnyOpp = meshProps().mesh().halfface_handle(newWalls.front(), 1);
+            ret = builder.updateSingleBlock(meshProps().mesh().incident_cell(hfAny));
+            if (ret == MCBuilder::SUCCESS)
+                ret = builder.updateSingleBlock(meshProps().mesh().incident_cell(hfAnyOpp));
+        }
+        if (ret != MCBuilder::SUCCESS)
         {
             meshProps().clearMC();
             return SPLITTING_FAILED;
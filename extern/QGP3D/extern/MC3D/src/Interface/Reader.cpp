@@ -1,16 +1,19 @@
 #include "MC3D/Interface/Reader.hpp"
+#include "MC3D/Interface/Writer.hpp"
 
 #define HEXEX_TESTING
 #include <TS3D/trulyseamless.h>
 #undef HEXEX_TESTING
 
+#include <limits>
 #include <utility>
 
 namespace mc3d
 {
 
 Reader::Reader(TetMeshProps& meshProps, const std::string& fileName, bool forceSanitization)
-    : TetMeshNavigator(meshProps), TetMeshManipulator(meshProps), _fileName(fileName), _is(fileName),
+    : TetMeshNavigator(meshProps), TetMeshManipulator(meshProps), _fileName(fileName),
+      _is(fileName, std::ios::in | std::ios::binary),
       _forceSanitization(forceSanitization)
 {
 }
@@ -20,6 +23,9 @@ Reader::RetCode Reader::readSeamlessParam()
     meshProps().mesh().clear(false);
 
     auto ret = checkFile();
+    if (ret != SUCCESS)
+        return ret;
+    ret = readHeader();
     if (ret != SUCCESS)
         return ret;
 
@@ -39,6 +45,14 @@ Reader::RetCode Reader::readSeamlessParam()
         return ret;
     }
 
+    // Binary files state whether they contain walls, which are skipped here
+    if (_binary && (_binaryFlags & Writer::BINARY_WALLS))
+    {
+        int NW = 0;
+        if (readBinaryCount(NW, 3 * sizeof(int32_t) + sizeof(double)))
+            _is.seekg(NW * (3 * sizeof(int32_t) + sizeof(double)), std::ios::cur);
+    }
+
     if (ret != INVALID_CHART)
     {
         ret = readFeatures();
@@ -65,6 +79,9 @@ Reader::RetCode Reader::readSeamlessParamWithWalls()
     meshProps().mesh().clear(false);
 
     auto ret = checkFile();
+    if (ret != SUCCESS)
+        return ret;
+    ret = readHeader();
     if (ret != SUCCESS)
         return ret;
 
@@ -124,12 +141,81 @@ Reader::RetCode Reader::checkFile()
     return SUCCESS;
 }
 
+Reader::RetCode Reader::readHeader()
+{
+    char magic[sizeof(Writer::BINARY_MAGIC)] = {};
+    _is.read(magic, sizeof(magic));
+    _binary = _is.good() && std::equal(magic, magic + sizeof(magic), Writer::BINARY_MAGIC);
+    if (_binary)
+    {
+        if (!readBinary(_binaryFlags))
+            return FILE_INACCESSIBLE;
+        auto pos = _is.tellg();
+        _is.seekg(0, std::ios::end);
+        _binaryEnd = _is.tellg();
+        _is.seekg(pos);
+        LOG(INFO) << "File " << _fileName << " is binary encoded";
+    }
+    else
+    {
+        _is.clear();
+        _is.seekg(0);
+    }
+    return checkFile();
+}
+
+bool Reader::readBinaryInteger(mpz_class& z)
+{
+    int32_t count = 0;
+    if (!readBinary(count))
+        return false;
+    if (count == std::numeric_limits<int32_t>::min()
+        || uint64_t(std::abs(count)) > remainingBinaryBytes() / sizeof(uint64_t))
+    {
+        LOG(ERROR) << "Invalid limb count " << count << " in file " << _fileName;
+        _is.setstate(std::ios::failbit);
+        return false;
+    }
+    vector<uint64_t> limbs(std::abs(count));
+    _is.read(reinterpret_cast<char*>(limbs.data()), limbs.size() * sizeof(uint64_t));
+    mpz_import(z.get_mpz_t(), limbs.size(), -1, sizeof(uint64_t), 0, 0, limbs.data());
+    if (count < 0)
+        z = -z;
+    return _is.good();
+}
+
+bool Reader::readBinaryCount(int& n, size_t minBytesPerElement)
+{
+    uint64_t count = 0;
+    if (!readBinary(count))
+        return false;
+    if (count > uint64_t(std::numeric_limits<int>::max()) || count > remainingBinaryBytes() / minBytesPerElement)
+    {
+        LOG(ERROR) << "Invalid element count " << count << " in file " << _fileName;
+        _is.setstate(std::ios::failbit);
+        return false;
+    }
+    n = (int)count;
+    return true;
+}
+
+uint64_t Reader::remainingBinaryBytes()
+{
+    auto pos = _is.tellg();
+    if (pos < 0 || pos > _binaryEnd)
+        return 0;
+    return uint64_t(_binaryEnd - pos);
+}
+
 Reader::RetCode Reader::readVertices()
 {
     TetMesh& tetMesh = meshProps().mesh();
 
     int NV = 0;
-    _is >> NV;
+    if (_binary)
+        readBinaryCount(NV, 3 * sizeof(double));
+    else
+        _is >> NV;
     if (!_is.good())
     {
         LOG(ERROR) << "Could not read number of vertices in file " << _fileName;
@@ -140,7 +226,14 @@ Reader::RetCode Reader::readVertices()
     for (int vtx = 0; vtx < NV; vtx++)
     {
         double x{0.0}, y{0.0}, z{0.0};
-        _is >> x >> y >> z;
+        if (_binary)
+        {
+            readBinary(x);
+            readBinary(y);
+            readBinary(z);
+        }
+        else
+            _is >> x >> y >> z;
         if (!_is.good())
         {
             LOG(ERROR) << "Could not read vertex XYZ in file " << _fileName;
@@ -163,7 +256,10 @@ Reader::RetCode Reader::readTetsAndCharts()
     meshProps().allocate<CHART>();
 
     int NC = 0;
-    _is >> NC;
+    if (_binary)
+        readBinaryCount(NC, 4 * sizeof(int32_t) + 4 * 3 * sizeof(double));
+    else
+        _is >> NC;
     if (!_is.good())
     {
         LOG(ERROR) << "Could not read number of tets in file " << _fileName;
@@ -171,12 +267,20 @@ Reader::RetCode Reader::readTetsAndCharts()
     }
     LOG(INFO) << "Mesh has " << NC << " tets";
 
-    _exactInput = false;
+    _exactInput = _binary && (_binaryFlags & Writer::BINARY_EXACT);
     std::stringstream stringToDouble;
     for (int cell = 0; cell < NC; cell++)
     {
         vector<int> vtx(4);
-        _is >> vtx[0] >> vtx[1] >> vtx[2] >> vtx[3];
+        if (_binary)
+            for (int corner = 0; corner < 4; corner++)
+            {
+                int32_t idx = -1;
+                readBinary(idx);
+                vtx[corner] = idx;
+            }
+        else
+            _is >> vtx[0] >> vtx[1] >> vtx[2] >> vtx[3];
         if (!_is.good())
         {
             LOG(ERROR) << "Could not read tet vertices in file " << _fileName;
@@ -198,6 +302,33 @@ Reader::RetCode Reader::readTetsAndCharts()
         {
             std::string uvw[3];
             Vec3Q uvwQ(0, 0, 0);
+            if (_binary)
+            {
+                for (int i = 0; i < 3; i++)
+                {
+                    bool good = false;
+                    if (_exactInput)
+                    {
+                        good = readBinaryInteger(uvwQ[i].get_num()) && readBinaryInteger(uvwQ[i].get_den())
+                               && uvwQ[i].get_den() != 0;
+                        if (good)
+                            uvwQ[i].canonicalize();
+                    }
+                    else
+                    {
+                        double d = 0.0;
+                        good = readBinary(d);
+                        uvwQ[i] = d;
+                    }
+                    if (!good)
+                    {
+                        LOG(ERROR) << "Could not read vtx UVW per tet in file " << _fileName;
+                        return MISSING_CHART;
+                    }
+                }
+                newChart[VH{vtx[corner]}] = uvwQ;
+                continue;
+            }
             for (int i = 0; i < 3; i++)
             {
                 _is >> uvw[i];
@@ -276,7 +407,14 @@ Reader::RetCode Reader::readFeatures()
 
     int n_ftv(0), n_fte(0), n_ftf(0);
 
-    _is >> n_ftv;
+    if (_binary)
+    {
+        readBinaryCount(n_ftv, sizeof(int32_t));
+        readBinaryCount(n_fte, 2 * sizeof(int32_t));
+        readBinaryCount(n_ftf, 3 * sizeof(int32_t));
+    }
+    else
+        _is >> n_ftv;
     if (_is.eof())
     {
         LOG(INFO) << "No features specified";
@@ -287,7 +425,8 @@ Reader::RetCode Reader::readFeatures()
         LOG(INFO) << "Error reading features";
         return INVALID_WALLS;
     }
-    _is >> n_fte >> n_ftf;
+    if (!_binary)
+        _is >> n_fte >> n_ftf;
     if (!_is.good())
     {
         LOG(INFO) << "Error reading number of features";
@@ -307,7 +446,14 @@ Reader::RetCode Reader::readFeatures()
     for (int i = 0; i < n_ftv; ++i)
     {
         int vidx;
-        _is >> vidx;
+        if (_binary)
+        {
+            int32_t idx = -1;
+            readBinary(idx);
+            vidx = idx;
+        }
+        else
+            _is >> vidx;
         if (!_is.good())
         {
             LOG(INFO) << "Error reading features";
@@ -323,7 +469,15 @@ Reader::RetCode Reader::readFeatures()
     for (int i = 0; i < n_fte; ++i)
     {
         int v0idx, v1idx;
-        _is >> v0idx >> v1idx;
+        if (_binary)
+        {
+            int32_t idx[2] = {-1, -1};
+            readBinary(idx);
+            v0idx = idx[0];
+            v1idx = idx[1];
+        }
+        else
+            _is >> v0idx >> v1idx;
         if (!_is.good())
         {
             LOG(INFO) << "Error reading features vertices";
@@ -346,7 +500,16 @@ Reader::RetCode Reader::readFeatures()
     for (int i = 0; i < n_ftf; ++i)
     {
         int v0idx, v1idx, v2idx;
-        _is >> v0idx >> v1idx >> v2idx;
+        if (_binary)
+        {
+            int32_t idx[3] = {-1, -1, -1};
+            readBinary(idx);
+            v0idx = idx[0];
+            v1idx = idx[1];
+            v2idx = idx[2];
+        }
+        else
+            _is >> v0idx >> v1idx >> v2idx;
         if (!_is.good())
         {
             LOG(INFO) << "Error reading feature faces";
@@ -424,8 +587,17 @@ Reader::RetCode Reader::readWalls()
     meshProps().allocate<IS_WALL>(false);
     meshProps().allocate<WALL_DIST>(0.0);
 
+    if (_binary && !(_binaryFlags & Writer::BINARY_WALLS))
+    {
+        LOG(ERROR) << "Binary file " << _fileName << " contains no walls";
+        return MISSING_WALLS;
+    }
+
     int NW = 0;
-    _is >> NW;
+    if (_binary)
+        readBinaryCount(NW, 3 * sizeof(int32_t) + sizeof(double));
+    else
+        _is >> NW;
     if (!_is.good())
     {
         LOG(ERROR) << "Could not read number of walls in file " << _fileName;
@@ -436,13 +608,20 @@ Reader::RetCode Reader::readWalls()
     for (int i = 0; i < NW; i++)
     {
         std::vector<int> idx(3);
-        _is >> idx[0] >> idx[1] >> idx[2];
+        double wallDist;
+        if (_binary)
+        {
+            int32_t idxBinary[3] = {-1, -1, -1};
+            readBinary(idxBinary);
+            std::copy(idxBinary, idxBinary + 3, idx.begin());
+            readBinary(wallDist);
+        }
+        else
+            _is >> idx[0] >> idx[1] >> idx[2] >> wallDist;
         VH v0(idx[0]);
         VH v1(idx[1]);
         VH v2(idx[2]);
 
-        double wallDist;
-        _is >> wallDist;
         if (!_is.good())
         {
             LOG(ERROR) << "Could not read wall dist of wall " << i << " in file " << _fileName;
@@ -480,7 +659,7 @@ Reader::RetCode Reader::sanitizeInput()
         TS3D::TrulySeamless3D sanitizer(tetMesh);
         for (CH tet : tetMesh.cells())
             for (VH v : tetMesh.tet_vertices(tet))
-                sanitizer.setParam(tet, v, Vec3Q2d(meshProps().ref<CHART>(tet).at(v)));
+                sanitizer.setParam(tet, v, Vec3Q2d(std::as_const(meshProps()).ref<CHART>(tet).at(v)));
 
         if (meshProps().isAllocated<IS_FEATURE_E>())
         {
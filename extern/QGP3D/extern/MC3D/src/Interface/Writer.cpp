@@ -5,18 +5,16 @@
 namespace mc3d
 {
 
-Writer::Writer(const TetMeshProps& meshProps, const std::string& fileName, bool exactRationalParam)
-    : TetMeshNavigator(meshProps), _fileName(fileName), _os(), _exact(exactRationalParam)
+Writer::Writer(const TetMeshProps& meshProps, const std::string& fileName, bool exactRationalParam, bool binary)
+    : TetMeshNavigator(meshProps), _fileName(fileName), _os(), _exact(exactRationalParam), _binary(binary)
 {
 }
 
 Writer::RetCode Writer::writeSeamlessParam()
 {
-    _os = std::ofstream(_fileName);
-    auto ret = checkFile();
+    auto ret = openFile(false);
     if (ret != RetCode::SUCCESS)
         return ret;
-    _os << std::setprecision(std::numeric_limits<double>::max_digits10);
 
     LOG(INFO) << "Writing parametrized tet mesh with MC wall markers to " << _fileName;
 
@@ -30,16 +28,14 @@ Writer::RetCode Writer::writeSeamlessParam()
     if (ret != RetCode::SUCCESS)
         return ret;
 
-    return SUCCESS;
+    return closeFile();
 }
 
 Writer::RetCode Writer::writeSeamlessParamAndWalls()
 {
-    _os = std::ofstream(_fileName);
-    auto ret = checkFile();
+    auto ret = openFile(true);
     if (ret != RetCode::SUCCESS)
         return ret;
-    _os << std::setprecision(std::numeric_limits<double>::max_digits10);
 
     ret = writeVertices();
     if (ret != RetCode::SUCCESS)
@@ -54,16 +50,14 @@ Writer::RetCode Writer::writeSeamlessParamAndWalls()
     if (ret != RetCode::SUCCESS)
         return ret;
 
-    return SUCCESS;
+    return closeFile();
 }
 
 Writer::RetCode Writer::writeIGMAndWalls()
 {
-    _os = std::ofstream(_fileName);
-    auto ret = checkFile();
+    auto ret = openFile(true);
     if (ret != RetCode::SUCCESS)
         return ret;
-    _os << std::setprecision(std::numeric_limits<double>::max_digits10);
 
     ret = writeVertices();
     if (ret != RetCode::SUCCESS)
@@ -78,16 +72,14 @@ Writer::RetCode Writer::writeIGMAndWalls()
     if (ret != RetCode::SUCCESS)
         return ret;
 
-    return SUCCESS;
+    return closeFile();
 }
 
 Writer::RetCode Writer::writeIGM()
 {
-    _os = std::ofstream(_fileName);
-    auto ret = checkFile();
+    auto ret = openFile(false);
     if (ret != RetCode::SUCCESS)
         return ret;
-    _os << std::setprecision(std::numeric_limits<double>::max_digits10);
 
     LOG(INFO) << "Writing parametrized tet mesh with MC wall markers to " << _fileName;
 
@@ -101,7 +93,7 @@ Writer::RetCode Writer::writeIGM()
     if (ret != RetCode::SUCCESS)
         return ret;
 
-    return SUCCESS;
+    return closeFile();
 }
 
 Writer::RetCode Writer::checkFile() const
@@ -114,16 +106,110 @@ Writer::RetCode Writer::checkFile() const
     return SUCCESS;
 }
 
+Writer::RetCode Writer::openFile(bool walls)
+{
+    _os = std::ofstream();
+    // The buffer has to be installed before opening to take effect
+    _streamBuffer.resize(1 << 20);
+    _os.rdbuf()->pubsetbuf(_streamBuffer.data(), _streamBuffer.size());
+    _os.open(_fileName, _binary ? std::ios::out | std::ios::binary : std::ios::out);
+    _vtx2idx.clear();
+
+    auto ret = checkFile();
+    if (ret != RetCode::SUCCESS)
+        return ret;
+
+    if (_binary)
+    {
+        _os.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        writeBinary<uint32_t>((_exact ? uint32_t(BINARY_EXACT) : 0u) | (walls ? uint32_t(BINARY_WALLS) : 0u));
+    }
+    else
+        _os << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+    return checkFile();
+}
+
+Writer::RetCode Writer::closeFile()
+{
+    _os.close();
+    if (_os.fail())
+    {
+        LOG(ERROR) << "Could not write to file " << _fileName;
+        return FILE_INACCESSIBLE;
+    }
+    return SUCCESS;
+}
+
+void Writer::writeIndex(int idx)
+{
+    if (_binary)
+        writeBinary<int32_t>(idx);
+    else
+        _os << idx << ' ';
+}
+
+void Writer::writeParam(const Q& q)
+{
+    if (!_exact)
+    {
+        if (_binary)
+            writeBinary<double>(q.get_d());
+        else
+            _os << q.get_d() << ' ';
+        return;
+    }
+
+    writeInteger(q.get_num());
+    if (_binary)
+        writeInteger(q.get_den());
+    else
+    {
+        if (q.get_den() != 1)
+        {
+            _os << '/';
+            writeInteger(q.get_den());
+        }
+        _os << ' ';
+    }
+}
+
+void Writer::writeInteger(const mpz_class& z)
+{
+    if (_binary)
+    {
+        _limbs.resize((mpz_sizeinbase(z.get_mpz_t(), 2) + 63) / 64);
+        size_t count = 0;
+        mpz_export(_limbs.data(), &count, -1, sizeof(uint64_t), 0, 0, z.get_mpz_t());
+        writeBinary<int32_t>(sgn(z) < 0 ? -(int32_t)count : (int32_t)count);
+        _os.write(reinterpret_cast<const char*>(_limbs.data()), count * sizeof(uint64_t));
+    }
+    else
+    {
+        // Digits + sign + terminating zero
+        _digits.resize(mpz_sizeinbase(z.get_mpz_t(), 10) + 2);
+        mpz_get_str(_digits.data(), 10, z.get_mpz_t());
+        _os << _digits.c_str();
+    }
+}
+
 Writer::RetCode Writer::writeVertices()
 {
     const TetMesh& tetMesh = meshProps().mesh();
 
     // Write nVertices + vertices
     size_t idx = 0;
-    _os << tetMesh.n_logical_vertices() << std::endl;
+    if (_binary)
+        writeBinary<uint64_t>(tetMesh.n_logical_vertices());
+    else
+        _os << tetMesh.n_logical_vertices() << '\n';
     for (VH v : tetMesh.vertices())
     {
-        _os << tetMesh.vertex(v) << std::endl;
+        if (_binary)
+            for (int i = 0; i < 3; i++)
+                writeBinary<double>(tetMesh.vertex(v)[i]);
+        else
+            _os << tetMesh.vertex(v) << '\n';
         _vtx2idx[v.idx()] = idx++;
     }
     return checkFile();
@@ -140,19 +226,23 @@ Writer::RetCode Writer::writeTetsAndCharts(bool IGM)
     const TetMesh& tetMesh = meshProps().mesh();
 
     // Write nTets + tets
-    _os << tetMesh.n_logical_cells() << std::endl;
+    if (_binary)
+        writeBinary<uint64_t>(tetMesh.n_logical_cells());
+    else
+        _os << tetMesh.n_logical_cells() << '\n';
     for (CH c : tetMesh.cells())
     {
         const auto& chart = IGM ? meshProps().ref<CHART_IGM>(c) : meshProps().ref<CHART>(c);
         for (VH v : tetMesh.tet_vertices(c))
-            _os << _vtx2idx.at(v.idx()) << " ";
+            writeIndex(_vtx2idx.at(v.idx()));
         for (VH v : tetMesh.tet_vertices(c))
+        {
+            const auto& uvw = chart.at(v);
             for (int i = 0; i < 3; i++)
-                if (_exact)
-                    _os << chart.at(v)[i].get_str() << " ";
-                else
-                    _os << chart.at(v)[i].get_d() << " ";
-        _os << std::endl;
+                writeParam(uvw[i]);
+        }
+        if (!_binary)
+            _os << '\n';
     }
     return checkFile();
 }
@@ -174,7 +264,10 @@ Writer::RetCode Writer::writeWalls()
     for (FH f : tetMesh.faces())
         if (meshProps().get<IS_WALL>(f))
             nWallFaces++;
-    _os << nWallFaces << std::endl;
+    if (_binary)
+        writeBinary<uint64_t>(nWallFaces);
+    else
+        _os << nWallFaces << '\n';
 
     // Write wallFaces
     for (FH f : tetMesh.faces())
@@ -182,9 +275,12 @@ Writer::RetCode Writer::writeWalls()
         if (meshProps().get<IS_WALL>(f))
         {
             for (VH v : tetMesh.face_vertices(f))
-                _os << _vtx2idx.at(v.idx()) << " ";
-            _os << (meshProps().isAllocated<WALL_DIST>() ? meshProps().get<WALL_DIST>(f) : 0.0);
-            _os << std::endl;
+                writeIndex(_vtx2idx.at(v.idx()));
+            double dist = meshProps().isAllocated<WALL_DIST>() ? meshProps().get<WALL_DIST>(f) : 0.0;
+            if (_binary)
+                writeBinary<double>(dist);
+            else
+                _os << dist << '\n';
         }
     }
 
@@ -220,13 +316,29 @@ Writer::RetCode Writer::writeFeatures()
                 ffs.push_back({_vtx2idx.at(hfvs[0].idx()), _vtx2idx.at(hfvs[1].idx()), _vtx2idx.at(hfvs[2].idx())});
             }
 
-    _os << fvs.size() << " " << fes.size() << " " << ffs.size() << std::endl;
+    if (_binary)
+    {
+        writeBinary<uint64_t>(fvs.size());
+        writeBinary<uint64_t>(fes.size());
+        writeBinary<uint64_t>(ffs.size());
+        for (auto v : fvs)
+            writeBinary<int32_t>(v);
+        for (auto& e : fes)
+            for (int v : e)
+                writeBinary<int32_t>(v);
+        for (auto& f : ffs)
+            for (int v : f)
+                writeBinary<int32_t>(v);
+        return checkFile();
+    }
+
+    _os << fvs.size() << " " << fes.size() << " " << ffs.size() << '\n';
     for (auto v : fvs)
-        _os << v << std::endl;
+        _os << v << '\n';
     for (auto e : fes)
-        _os << e[0] << " " << e[1] << std::endl;
+        _os << e[0] << " " << e[1] << '\n';
     for (auto f : ffs)
-        _os << f[0] << " " << f[1] << " " << f[2] << std::endl;
+        _os << f[0] << " " << f[1] << " " << f[2] << '\n';
 
     // TODO change file format
     // vector<vector<int>> fvs;
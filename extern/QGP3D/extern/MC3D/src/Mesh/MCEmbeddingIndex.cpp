@@ -0,0 +1,237 @@
+#include "MC3D/Mesh/MCEmbeddingIndex.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace mc3d
+{
+
+MCEmbeddingIndex::MCEmbeddingIndex(MCMeshProps& mcMeshProps) : _mcMeshProps(mcMeshProps)
+{
+    _mcMeshProps._embeddingIndices.push_back(this);
+    update();
+}
+
+MCEmbeddingIndex::~MCEmbeddingIndex()
+{
+    auto& indices = _mcMeshProps._embeddingIndices;
+    indices.erase(std::remove(indices.begin(), indices.end(), this), indices.end());
+}
+
+void MCEmbeddingIndex::update()
+{
+    const MCMesh& mcMesh = _mcMeshProps.mesh();
+    updateTable(_blockTets, mcMesh.n_cells());
+    updateTable(_patchHalffaces, mcMesh.n_faces());
+    updateTable(_arcHalfedges, mcMesh.n_edges());
+}
+
+void MCEmbeddingIndex::markDirty(const CH& b)
+{
+    markDirtyIn(_blockTets, b.idx());
+}
+
+void MCEmbeddingIndex::markDirty(const FH& p)
+{
+    markDirtyIn(_patchHalffaces, p.idx());
+}
+
+void MCEmbeddingIndex::markDirty(const EH& a)
+{
+    markDirtyIn(_arcHalfedges, a.idx());
+}
+
+void MCEmbeddingIndex::markAllDirty()
+{
+    for (int b = 0; b < (int)_blockTets.dirty.size(); b++)
+        markDirtyIn(_blockTets, b);
+    for (int p = 0; p < (int)_patchHalffaces.dirty.size(); p++)
+        markDirtyIn(_patchHalffaces, p);
+    for (int a = 0; a < (int)_arcHalfedges.dirty.size(); a++)
+        markDirtyIn(_arcHalfedges, a);
+}
+
+bool MCEmbeddingIndex::isDirty() const
+{
+    const MCMesh& mcMesh = _mcMeshProps.mesh();
+    return isDirty(_blockTets, mcMesh.n_cells()) || isDirty(_patchHalffaces, mcMesh.n_faces())
+           || isDirty(_arcHalfedges, mcMesh.n_edges());
+}
+
+MCEmbeddingIndex::Range<CH> MCEmbeddingIndex::blockTets(const CH& b) const
+{
+    return entry(_blockTets, b.idx());
+}
+
+MCEmbeddingIndex::Range<HFH> MCEmbeddingIndex::patchHalffaces(const FH& p) const
+{
+    return entry(_patchHalffaces, p.idx());
+}
+
+MCEmbeddingIndex::Range<HEH> MCEmbeddingIndex::arcHalfedges(const EH& a) const
+{
+    return entry(_arcHalfedges, a.idx());
+}
+
+bool MCEmbeddingIndex::isConsistent() const
+{
+    return isConsistent(_blockTets) && isConsistent(_patchHalffaces) && isConsistent(_arcHalfedges);
+}
+
+size_t MCEmbeddingIndex::memoryFootprint() const
+{
+    return memoryFootprint(_blockTets) + memoryFootprint(_patchHalffaces) + memoryFootprint(_arcHalfedges);
+}
+
+size_t MCEmbeddingIndex::propertyMemoryFootprint() const
+{
+    // Red-black tree nodes carry color, parent, left and right, list nodes prev and next
+    return propertyMemoryFootprint<BLOCK_MESH_TETS>(4 * sizeof(void*) + sizeof(CH))
+           + propertyMemoryFootprint<PATCH_MESH_HALFFACES>(4 * sizeof(void*) + sizeof(HFH))
+           + propertyMemoryFootprint<ARC_MESH_HALFEDGES>(2 * sizeof(void*) + sizeof(HEH));
+}
+
+template <typename PROP>
+void MCEmbeddingIndex::updateTable(Table<PROP>& table, size_t nOwners)
+{
+    using owner_t = typename Table<PROP>::owner_t;
+    using elem_t = typename Table<PROP>::elem_t;
+
+    if (!_mcMeshProps.isAllocated<PROP>())
+    {
+        table = Table<PROP>();
+        return;
+    }
+
+    // Fewer owners than before means the MC was garbage collected, so all handles may have changed
+    if (nOwners < table.dirty.size())
+    {
+        table.dirty.assign(table.dirty.size(), true);
+        table.nDirty = table.dirty.size();
+    }
+    int nOld = std::min(table.dirty.size(), nOwners);
+    table.nDirty += nOwners - nOld;
+    table.dirty.resize(nOwners, true);
+    if (table.nDirty == 0)
+        return;
+
+    const MCMesh& mcMesh = _mcMeshProps.mesh();
+    vector<int> offsets(nOwners + 1, 0);
+    vector<elem_t> elems;
+    elems.reserve(table.elems.size());
+
+    int i = 0;
+    while (i < (int)nOwners)
+    {
+        if (table.dirty[i])
+        {
+            offsets[i] = elems.size();
+            owner_t owner(i);
+            if (!mcMesh.is_deleted(owner))
+            {
+                const auto& val = std::as_const(_mcMeshProps).ref<PROP>(owner);
+                elems.insert(elems.end(), val.begin(), val.end());
+            }
+            i++;
+            continue;
+        }
+        // Copy the maximal run of clean entries [i, j) in one go
+        int j = i;
+        while (j < nOld && !table.dirty[j])
+            j++;
+        int shift = (int)elems.size() - table.offsets[i];
+        elems.insert(elems.end(), table.elems.begin() + table.offsets[i], table.elems.begin() + table.offsets[j]);
+        for (; i < j; i++)
+            offsets[i] = table.offsets[i] + shift;
+    }
+    offsets[nOwners] = elems.size();
+
+    DLOG(INFO) << "Rebuilt " << table.nDirty << "/" << nOwners << " entries of " << PROP::name() << " index";
+
+    table.offsets = std::move(offsets);
+    table.elems = std::move(elems);
+    table.dirty.assign(nOwners, false);
+    table.nDirty = 0;
+}
+
+template <typename PROP>
+bool MCEmbeddingIndex::isDirty(const Table<PROP>& table, size_t nOwners) const
+{
+    if (!_mcMeshProps.isAllocated<PROP>())
+        return !table.elems.empty();
+    return table.nDirty != 0 || table.dirty.size() != nOwners;
+}
+
+template <typename PROP>
+void MCEmbeddingIndex::markDirtyIn(Table<PROP>& table, int idx)
+{
+    // Entries beyond the current size are implicitly dirty
+    if (idx < 0 || idx >= (int)table.dirty.size() || table.dirty[idx])
+        return;
+    table.dirty[idx] = true;
+    table.nDirty++;
+}
+
+template <typename PROP>
+MCEmbeddingIndex::Range<typename MCEmbeddingIndex::Table<PROP>::elem_t>
+MCEmbeddingIndex::entry(const Table<PROP>& table, int idx) const
+{
+    assert(idx >= 0 && idx < (int)table.dirty.size());
+    assert(!table.dirty[idx]);
+    return {table.elems.data() + table.offsets[idx], table.elems.data() + table.offsets[idx + 1]};
+}
+
+template <typename PROP>
+bool MCEmbeddingIndex::isConsistent(const Table<PROP>& table) const
+{
+    using owner_t = typename Table<PROP>::owner_t;
+
+    if (!_mcMeshProps.isAllocated<PROP>())
+        return table.elems.empty();
+
+    const MCMesh& mcMesh = _mcMeshProps.mesh();
+    for (int i = 0; i < (int)table.dirty.size(); i++)
+    {
+        owner_t owner(i);
+        if (table.dirty[i] || mcMesh.is_deleted(owner))
+            continue;
+        const auto& val = std::as_const(_mcMeshProps).ref<PROP>(owner);
+        auto range = entry(table, i);
+        if (range.size() != val.size() || !std::equal(range.begin(), range.end(), val.begin()))
+        {
+            LOG(ERROR) << PROP::name() << " index entry " << i << " does not match the property";
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename PROP>
+size_t MCEmbeddingIndex::memoryFootprint(const Table<PROP>& table)
+{
+    return table.offsets.capacity() * sizeof(int) + table.elems.capacity() * sizeof(typename Table<PROP>::elem_t)
+           + table.dirty.capacity() / 8;
+}
+
+template <typename PROP>
+size_t MCEmbeddingIndex::propertyMemoryFootprint(size_t nodeSize) const
+{
+    using owner_t = typename PROP::handle_t;
+
+    if (!_mcMeshProps.isAllocated<PROP>())
+        return 0;
+
+    // glibc malloc: 8 bytes of chunk overhead, 16 byte alignment, 32 bytes minimum
+    size_t chunkSize = std::max<size_t>(32, (nodeSize + 8 + 15) / 16 * 16);
+
+    const MCMesh& mcMesh = _mcMeshProps.mesh();
+    size_t nOwners = std::is_same<owner_t, CH>::value   ? mcMesh.n_cells()
+                     : std::is_same<owner_t, FH>::value ? mcMesh.n_faces()
+                                                        : mcMesh.n_edges();
+    size_t bytes = nOwners * sizeof(typename PROP::value_t);
+    for (size_t i = 0; i < nOwners; i++)
+        bytes += std::as_const(_mcMeshProps).ref<PROP>(owner_t(i)).size() * chunkSize;
+    return bytes;
+}
+
+} // namespace mc3d
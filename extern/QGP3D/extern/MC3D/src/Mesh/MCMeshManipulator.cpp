@@ -1,5 +1,7 @@
 #include "MC3D/Mesh/MCMeshManipulator.hpp"
 
+#include <utility>
+
 namespace mc3d
 {
 
@@ -87,7 +89,7 @@ vector<EH> MCMeshManipulator::splitArc(const EH& a, const VH& n, set<FH>& affect
         partitionArcEdgesAtNode(
             a, n, mcMeshProps().ref<ARC_MESH_HALFEDGES>(asChild[0]), mcMeshProps().ref<ARC_MESH_HALFEDGES>(asChild[1]));
         for (int i = 0; i < 2; i++)
-            for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(asChild[i]))
+            for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(asChild[i]))
                 meshProps().set<MC_ARC>(tetMesh.edge_handle(he), asChild[i]);
     }
 
@@ -96,7 +98,7 @@ vector<EH> MCMeshManipulator::splitArc(const EH& a, const VH& n, set<FH>& affect
         for (EH aChild : asChild)
         {
             double length = 0.0;
-            for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(aChild))
+            for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(aChild))
                 length += edgeLengthUVW<CHART>(tetMesh.edge_handle(he));
             mcMeshProps().set<ARC_DBL_LENGTH>(aChild, length);
         }
@@ -115,6 +117,10 @@ vector<EH> MCMeshManipulator::splitArc(const EH& a, const VH& n, set<FH>& affect
         mcMeshProps().set<CHILD_HALFEDGES>(has[1], {hasChild1[0], hasChild1[1]});
     }
 
+    mcMeshProps().markEmbeddingDirty(a);
+    for (EH aChild : asChild)
+        mcMeshProps().markEmbeddingDirty(aChild);
+
     _nBisectionsA++;
     return asChild;
 }
@@ -182,7 +188,7 @@ vector<FH> MCMeshManipulator::splitPatch(const FH& p, const EH& a, set<CH>& affe
         for (int i = 0; i < 2; i++)
         {
             float minDist = FLT_MAX;
-            for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(psChild[i]))
+            for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(psChild[i]))
             {
                 minDist = std::min(minDist, meshProps().get<WALL_DIST>(tetMesh.face_handle(hf)));
                 meshProps().set<MC_PATCH>(tetMesh.face_handle(hf), psChild[i]);
@@ -204,6 +210,10 @@ vector<FH> MCMeshManipulator::splitPatch(const FH& p, const EH& a, set<CH>& affe
         mcMeshProps().set<CHILD_HALFFACES>(hps[1], {hpsChild1[0], hpsChild1[1]});
     }
 
+    mcMeshProps().markEmbeddingDirty(p);
+    for (FH pChild : psChild)
+        mcMeshProps().markEmbeddingDirty(pChild);
+
     _nBisectionsP++;
     return psChild;
 }
@@ -230,7 +240,7 @@ vector<CH> MCMeshManipulator::splitBlock(const CH& b, const FH& p)
                               mcMeshProps().ref<BLOCK_MESH_TETS>(bsChild[0]),
                               mcMeshProps().ref<BLOCK_MESH_TETS>(bsChild[1]));
     for (unsigned char i = 0; i < 2; i++)
-        for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(bsChild[i]))
+        for (CH tet : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(bsChild[i]))
             meshProps().set<MC_BLOCK>(tet, bsChild[i]);
 
     mcMeshProps().resetAll(b);
@@ -239,6 +249,10 @@ vector<CH> MCMeshManipulator::splitBlock(const CH& b, const FH& p)
     if (mcMeshProps().isAllocated<CHILD_CELLS>())
         mcMeshProps().set<CHILD_CELLS>(b, {bsChild[0], bsChild[1]});
 
+    mcMeshProps().markEmbeddingDirty(b);
+    for (CH bChild : bsChild)
+        mcMeshProps().markEmbeddingDirty(bChild);
+
     _nBisectionsB++;
     return bsChild;
 }
@@ -316,7 +330,7 @@ EH MCMeshManipulator::mergeArcs(const EH& a1, const EH& a2, const VH& n, set<FH>
     {
         joinArcEdgesAtNode(a1, a2, n, mcMeshProps().ref<ARC_MESH_HALFEDGES>(a));
 
-        for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(a))
+        for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a))
             meshProps().set<MC_ARC>(tetMesh.edge_handle(he), a);
     }
 
@@ -341,6 +355,10 @@ EH MCMeshManipulator::mergeArcs(const EH& a1, const EH& a2, const VH& n, set<FH>
         mcMeshProps().set<CHILD_HALFEDGES>(has2[1], {flipArcDir2 ? hasChild[0] : hasChild[1]});
     }
 
+    mcMeshProps().markEmbeddingDirty(a1);
+    mcMeshProps().markEmbeddingDirty(a2);
+    mcMeshProps().markEmbeddingDirty(a);
+
     return a;
 }
 
@@ -399,7 +417,7 @@ FH MCMeshManipulator::mergePatches(const FH& p1, const FH& p2, const EH& a, set<
     // UPDATE GEOMETRIC EMBEDDING
     {
         std::swap(mergedHfs, mcMeshProps().ref<PATCH_MESH_HALFFACES>(p));
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
             meshProps().set<MC_PATCH>(tetMesh.face_handle(hf), p);
     }
 
@@ -424,6 +442,10 @@ FH MCMeshManipulator::mergePatches(const FH& p1, const FH& p2, const EH& a, set<
         mcMeshProps().set<CHILD_HALFFACES>(hps2[1], {flipHp2 ? hpsChild[0] : hpsChild[1]});
     }
 
+    mcMeshProps().markEmbeddingDirty(p1);
+    mcMeshProps().markEmbeddingDirty(p2);
+    mcMeshProps().markEmbeddingDirty(p);
+
     return p;
 }
 
@@ -443,6 +465,12 @@ CH MCMeshManipulator::mergeBlocks(const CH& b1, const CH& b2, const FH& p)
 
     applyTransitionToBlock(trans2to1, b2);
 
+    // Take the embeddings out of b1 and b2, so that cloning b1 does not copy its tets
+    set<CH> bTets;
+    set<CH> b2Tets;
+    bTets.swap(mcMeshProps().ref<BLOCK_MESH_TETS>(b1));
+    b2Tets.swap(mcMeshProps().ref<BLOCK_MESH_TETS>(b2));
+
     // This keeps the halfface normal of halfface[p, 0] equal to that of halfface[p1, 0]
     CH b = mergeBlocksTopologically(b1, b2, p);
 
@@ -452,15 +480,25 @@ CH MCMeshManipulator::mergeBlocks(const CH& b1, const CH& b2, const FH& p)
     // MERGE REFERENCING PROPERTIES BETWEEN b1, b2
     updateMergedBlockReferences(b1, b2, b, p);
 
-    // MERGE EMBEDDING (MESH_TETS) between b1, b2
+    // MERGE EMBEDDING (MESH_TETS) between b1, b2 by splicing the nodes of the smaller set into the larger one
     {
-        auto& bTets = mcMeshProps().ref<BLOCK_MESH_TETS>(b);
-        const auto& b1tets = mcMeshProps().ref<BLOCK_MESH_TETS>(b1);
-        const auto& b2tets = mcMeshProps().ref<BLOCK_MESH_TETS>(b2);
-        bTets = b1tets;
-        bTets.insert(b2tets.begin(), b2tets.end());
-        for (CH tet : bTets)
-            meshProps().set<MC_BLOCK>(tet, b);
+        if (bTets.size() < b2Tets.size())
+            bTets.swap(b2Tets);
+        bTets.merge(b2Tets);
+        assert(b2Tets.empty());
+
+        if (_deferBlockOwnership)
+        {
+            if (_mergedInto.size() < mcMeshProps().mesh().n_cells())
+                _mergedInto.resize(mcMeshProps().mesh().n_cells(), -1);
+            _mergedInto[b1.idx()] = b.idx();
+            _mergedInto[b2.idx()] = b.idx();
+        }
+        else
+            for (CH tet : bTets)
+                meshProps().set<MC_BLOCK>(tet, b);
+
+        mcMeshProps().ref<BLOCK_MESH_TETS>(b).swap(bTets);
     }
 
     mcMeshProps().resetAll(b1);
@@ -472,9 +510,51 @@ CH MCMeshManipulator::mergeBlocks(const CH& b1, const CH& b2, const FH& p)
         mcMeshProps().set<CHILD_CELLS>(b2, {b});
     }
 
+    mcMeshProps().markEmbeddingDirty(b1);
+    mcMeshProps().markEmbeddingDirty(b2);
+    mcMeshProps().markEmbeddingDirty(b);
+
     return b;
 }
 
+void MCMeshManipulator::setDeferredBlockOwnership(bool defer)
+{
+    _deferBlockOwnership = defer;
+    if (!defer)
+        materializeBlockOwnership();
+}
+
+void MCMeshManipulator::materializeBlockOwnership()
+{
+    if (_mergedInto.empty())
+        return;
+
+    for (CH tet : meshProps().mesh().cells())
+    {
+        CH b = meshProps().get<MC_BLOCK>(tet);
+        if (b.is_valid() && (size_t)b.idx() < _mergedInto.size() && _mergedInto[b.idx()] != -1)
+            meshProps().set<MC_BLOCK>(tet, findMergedBlock(b));
+    }
+    _mergedInto.clear();
+}
+
+CH MCMeshManipulator::findMergedBlock(const CH& b)
+{
+    int root = b.idx();
+    while ((size_t)root < _mergedInto.size() && _mergedInto[root] != -1)
+        root = _mergedInto[root];
+
+    // Path compression
+    int current = b.idx();
+    while ((size_t)current < _mergedInto.size() && _mergedInto[current] != -1)
+    {
+        int next = _mergedInto[current];
+        _mergedInto[current] = root;
+        current = next;
+    }
+    return CH(root);
+}
+
 // Assumes b is transitionfree in itself (only transitions at block boundary, i.e. patches)
 // Assumes identity transitions at mcMesh boundary
 void MCMeshManipulator::applyTransitionToBlock(const Transition& trans, const CH& b, bool rotate)
@@ -485,7 +565,7 @@ void MCMeshManipulator::applyTransitionToBlock(const Transition& trans, const CH
     MCMesh& mcMesh = mcMeshProps().mesh();
 
     // APPLY TO EACH TET CHART
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b))
         for (auto& kv : meshProps().ref<CHART>(tet))
         {
             auto& v = kv.first;
@@ -505,7 +585,7 @@ void MCMeshManipulator::applyTransitionToBlock(const Transition& trans, const CH
         transToB = transToB.chain(trans);
         mcMeshProps().setHpTransition<PATCH_TRANSITION>(hpOpp, transToB);
         bool first = (hpOpp.idx() % 2) == 0;
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(mcMesh.face_handle(hp)))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(mcMesh.face_handle(hp)))
             meshProps().setTransition<TRANSITION>(hf, (first ? transToB : transToB.invert()));
     }
 
@@ -532,7 +612,7 @@ void MCMeshManipulator::applyTransitionIGMToBlock(const Transition& trans, const
     MCMesh& mcMesh = mcMeshProps().mesh();
 
     // APPLY TO EACH TET CHART
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b))
         for (auto& kv : meshProps().ref<CHART_IGM>(tet))
         {
             auto& v = kv.first;
@@ -552,7 +632,7 @@ void MCMeshManipulator::applyTransitionIGMToBlock(const Transition& trans, const
         transToB = transToB.chain(trans);
         mcMeshProps().setHpTransition<PATCH_IGM_TRANSITION>(hpOpp, transToB);
         bool first = (hpOpp.idx() % 2) == 0;
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(mcMesh.face_handle(hp)))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(mcMesh.face_handle(hp)))
             meshProps().setTransition<TRANSITION_IGM>(hf, (first ? transToB : transToB.invert()));
     }
 
@@ -616,7 +696,7 @@ void MCMeshManipulator::reembedAndResetProps(const VH& nOld, const VH& nNew)
 
 void MCMeshManipulator::reembedAndResetProps(const EH& aOld, const EH& aNew)
 {
-    for (const auto& he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(aOld))
+    for (const auto& he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(aOld))
         if (aNew.is_valid())
             meshProps().set<MC_ARC>(meshProps().mesh().edge_handle(he), aNew);
         else
@@ -625,11 +705,12 @@ void MCMeshManipulator::reembedAndResetProps(const EH& aOld, const EH& aNew)
             meshProps().reset<IS_ARC>(meshProps().mesh().edge_handle(he));
         }
     mcMeshProps().resetAll(aOld);
+    mcMeshProps().markEmbeddingDirty(aOld);
 }
 
 void MCMeshManipulator::reembedAndResetProps(const FH& pOld, const FH& pNew)
 {
-    for (const auto& hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(pOld))
+    for (const auto& hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(pOld))
         if (pNew.is_valid())
             meshProps().set<MC_PATCH>(meshProps().mesh().face_handle(hf), pNew);
         else
@@ -638,16 +719,18 @@ void MCMeshManipulator::reembedAndResetProps(const FH& pOld, const FH& pNew)
             meshProps().reset<IS_WALL>(meshProps().mesh().face_handle(hf));
         }
     mcMeshProps().resetAll(pOld);
+    mcMeshProps().markEmbeddingDirty(pOld);
 }
 
 void MCMeshManipulator::reembedAndResetProps(const CH& bOld, const CH& bNew)
 {
-    for (const auto& tet : mcMeshProps().ref<BLOCK_MESH_TETS>(bOld))
+    for (const auto& tet : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(bOld))
         if (bNew.is_valid())
             meshProps().set<MC_BLOCK>(tet, bNew);
         else
             meshProps().reset<MC_BLOCK>(tet);
     mcMeshProps().resetAll(bOld);
+    mcMeshProps().markEmbeddingDirty(bOld);
 }
 
 // Deletes aSplit
@@ -656,6 +739,7 @@ vector<EH>
 MCMeshManipulator::splitArcTopologically(const EH& aSplit, const VH& n, set<FH>& affectedPs, set<CH>& affectedBs)
 {
     MCMesh& mcMesh = mcMeshProps().mesh();
+    mcMeshProps().advanceRevision();
     assert(!mcMesh.ve_iter(n)->is_valid());
 
     affectedPs.clear();
@@ -692,6 +776,7 @@ MCMeshManipulator::splitArcTopologically(const EH& aSplit, const VH& n, set<FH>&
 vector<FH> MCMeshManipulator::splitPatchTopologically(const FH& p, const EH& a, set<CH>& affectedBs)
 {
     MCMesh& mcMesh = mcMeshProps().mesh();
+    mcMeshProps().advanceRevision();
 
     affectedBs.clear();
     for (CH b : mcMesh.face_cells(p))
@@ -751,7 +836,7 @@ vector<FH> MCMeshManipulator::splitPatchTopologically(const FH& p, const EH& a,
             set<HFH> p1hfs, p2hfs;
             vector<bool> hfVisited(meshProps().mesh().n_halffaces());
             int i = 0;
-            for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+            for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
                 if (!hfVisited[hf.idx()])
                 {
                     auto& pSplitHfs = (i++ == 0 ? p1hfs : p2hfs);
@@ -818,6 +903,7 @@ vector<FH> MCMeshManipulator::splitPatchTopologically(const FH& p, const EH& a,
 vector<CH> MCMeshManipulator::splitBlockTopologically(const CH& b, const FH& p)
 {
     MCMesh& mcMesh = mcMeshProps().mesh();
+    mcMeshProps().advanceRevision();
 
     HFH hp0 = mcMesh.halfface_handle(p, 0);
     HFH hp1 = mcMesh.halfface_handle(p, 1);
@@ -904,6 +990,7 @@ EH MCMeshManipulator::mergeArcsTopologically(
 {
     assert(a1 != a2);
     MCMesh& mcMesh = mcMeshProps().mesh();
+    mcMeshProps().advanceRevision();
 
     affectedPs.clear();
     affectedBs.clear();
@@ -947,6 +1034,7 @@ EH MCMeshManipulator::mergeArcsTopologically(
 FH MCMeshManipulator::mergePatchesTopologically(const FH& p1, const FH& p2, const EH& a, set<CH>& affectedBs)
 {
     MCMesh& mcMesh = mcMeshProps().mesh();
+    mcMeshProps().advanceRevision();
 
     affectedBs.clear();
     for (CH b : mcMesh.face_cells(p1))
@@ -1005,6 +1093,7 @@ CH MCMeshManipulator::mergeBlocksTopologically(const CH& b1, const CH& b2, const
 {
     assert(b1 != b2);
     MCMesh& mcMesh = mcMeshProps().mesh();
+    mcMeshProps().advanceRevision();
 
     vector<HFH> bhps;
 
@@ -1366,6 +1366,154 @@ void MCMeshNavigator::assertValidMC(bool minimality, bool exhaustive) const
 #endif
 }
 
+#define MC3D_CHECK_LOCAL(condition, message)                                                                         \
+    if (!(condition))                                                                                                  \
+    {                                                                                                                  \
+        LOG(ERROR) << "Local MC check failed: " << message << " (" << #condition << ")";                               \
+        return false;                                                                                                  \
+    }
+
+bool MCMeshNavigator::checkLocalMC(const set<CH>& blocks) const
+{
+    const MCMesh& mcMesh = mcMeshProps().mesh();
+    const TetMesh& tetMesh = meshProps().mesh();
+
+    auto aliveBlock = [&](const CH& b) { return b.is_valid() && b.uidx() < mcMesh.n_cells() && !mcMesh.is_deleted(b); };
+    auto alivePatch = [&](const FH& p) { return p.is_valid() && p.uidx() < mcMesh.n_faces() && !mcMesh.is_deleted(p); };
+    auto aliveArc = [&](const EH& a) { return a.is_valid() && a.uidx() < mcMesh.n_edges() && !mcMesh.is_deleted(a); };
+    auto aliveNode
+        = [&](const VH& n) { return n.is_valid() && n.uidx() < mcMesh.n_vertices() && !mcMesh.is_deleted(n); };
+
+    set<FH> patches;
+    set<EH> arcs;
+    set<VH> nodes;
+    for (CH b : blocks)
+    {
+        if (!aliveBlock(b))
+            continue;
+
+        set<FH> blockPatches;
+        set<EH> blockArcs;
+        set<HEH> patchHalfarcs;
+        for (FH p : mcMesh.cell_faces(b))
+            blockPatches.insert(p);
+        for (EH a : mcMesh.cell_edges(b))
+            blockArcs.insert(a);
+        for (VH n : mcMesh.cell_vertices(b))
+            nodes.insert(n);
+        for (HFH hp : mcMesh.cell_halffaces(b))
+            for (HEH ha : mcMesh.halfface_halfedges(hp))
+                patchHalfarcs.insert(ha);
+        for (EH a : blockArcs)
+            for (HEH ha : mcMesh.edge_halfedges(a))
+                MC3D_CHECK_LOCAL(patchHalfarcs.count(ha) != 0, "halfarc " << ha << " missing in block " << b);
+        patches.insert(blockPatches.begin(), blockPatches.end());
+        arcs.insert(blockArcs.begin(), blockArcs.end());
+
+        const auto& cornerNodes = mcMeshProps().ref<BLOCK_CORNER_NODES>(b);
+        MC3D_CHECK_LOCAL(cornerNodes.size() == DIM_3_DIRS.size(), "corner nodes of block " << b);
+        for (const auto& kv : cornerNodes)
+            MC3D_CHECK_LOCAL(aliveNode(kv.second), "corner node " << kv.second << " of block " << b);
+        const auto& edgeArcs = mcMeshProps().ref<BLOCK_EDGE_ARCS>(b);
+        MC3D_CHECK_LOCAL(edgeArcs.size() == DIM_2_DIRS.size(), "edge arcs of block " << b);
+        for (const auto& kv : edgeArcs)
+            for (EH a : kv.second)
+                MC3D_CHECK_LOCAL(aliveArc(a) && blockArcs.count(a) != 0, "edge arc " << a << " of block " << b);
+        const auto& facePatches = mcMeshProps().ref<BLOCK_FACE_PATCHES>(b);
+        MC3D_CHECK_LOCAL(facePatches.size() == DIM_1_DIRS.size(), "face patches of block " << b);
+        for (const auto& kv : facePatches)
+            for (FH p : kv.second)
+                MC3D_CHECK_LOCAL(alivePatch(p) && blockPatches.count(p) != 0,
+                                 "face patch " << p << " of block " << b);
+
+        // Tet neighborhood: tets map back to the block, block boundary faces are exactly the patch faces
+        const auto& tets = mcMeshProps().ref<BLOCK_MESH_TETS>(b);
+        MC3D_CHECK_LOCAL(!tets.empty(), "block " << b << " has no tets");
+        for (CH tet : tets)
+        {
+            MC3D_CHECK_LOCAL(tet.is_valid() && tet.uidx() < tetMesh.n_cells() && !tetMesh.is_deleted(tet),
+                             "tet " << tet << " of block " << b);
+            MC3D_CHECK_LOCAL(meshProps().get<MC_BLOCK>(tet) == b, "tet " << tet << " of block " << b);
+            for (FH f : tetMesh.cell_faces(tet))
+            {
+                FH p = meshProps().get<MC_PATCH>(f);
+                MC3D_CHECK_LOCAL(p.is_valid() == meshProps().isBlockBoundary(f), "face " << f << " of block " << b);
+                if (!p.is_valid())
+                    continue;
+                MC3D_CHECK_LOCAL(alivePatch(p) && blockPatches.count(p) != 0,
+                                 "patch " << p << " of face " << f << " in block " << b);
+                const auto& hfs = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p);
+                MC3D_CHECK_LOCAL(hfs.count(tetMesh.halfface_handle(f, 0)) != 0
+                                     || hfs.count(tetMesh.halfface_handle(f, 1)) != 0,
+                                 "face " << f << " missing in patch " << p);
+            }
+        }
+    }
+
+    for (FH p : patches)
+    {
+        set<CH> bs;
+        set<CH> bsCheck;
+        for (CH b : mcMesh.face_cells(p))
+            if (b.is_valid())
+                bs.insert(b);
+        const auto& hfs = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p);
+        MC3D_CHECK_LOCAL(!hfs.empty(), "patch " << p << " has no halffaces");
+        for (HFH hf : hfs)
+        {
+            MC3D_CHECK_LOCAL(hf.is_valid() && hf.uidx() < tetMesh.n_halffaces() && !tetMesh.is_deleted(hf),
+                             "halfface " << hf << " of patch " << p);
+            MC3D_CHECK_LOCAL(meshProps().get<MC_PATCH>(tetMesh.face_handle(hf)) == p,
+                             "halfface " << hf << " of patch " << p);
+            MC3D_CHECK_LOCAL(meshProps().hfTransition<TRANSITION>(hf) == mcMeshProps().ref<PATCH_TRANSITION>(p),
+                             "transition of halfface " << hf << " of patch " << p);
+            for (CH tet : tetMesh.face_cells(tetMesh.face_handle(hf)))
+                if (tet.is_valid())
+                    bsCheck.insert(meshProps().get<MC_BLOCK>(tet));
+        }
+        MC3D_CHECK_LOCAL(bs == bsCheck, "blocks of patch " << p);
+    }
+
+    for (EH a : arcs)
+    {
+        HEH ha = mcMesh.halfedge_handle(a, 0);
+        const auto& hes = mcMeshProps().ref<ARC_MESH_HALFEDGES>(a);
+        MC3D_CHECK_LOCAL(!hes.empty(), "arc " << a << " has no halfedges");
+        VH vPrev = mcMeshProps().get<NODE_MESH_VERTEX>(mcMesh.from_vertex_handle(ha));
+        for (HEH he : hes)
+        {
+            MC3D_CHECK_LOCAL(he.is_valid() && he.uidx() < tetMesh.n_halfedges() && !tetMesh.is_deleted(he),
+                             "halfedge " << he << " of arc " << a);
+            MC3D_CHECK_LOCAL(meshProps().get<MC_ARC>(tetMesh.edge_handle(he)) == a,
+                             "halfedge " << he << " of arc " << a);
+            MC3D_CHECK_LOCAL(tetMesh.from_vertex_handle(he) == vPrev, "halfedge " << he << " of arc " << a);
+            vPrev = tetMesh.to_vertex_handle(he);
+        }
+        MC3D_CHECK_LOCAL(vPrev == mcMeshProps().get<NODE_MESH_VERTEX>(mcMesh.to_vertex_handle(ha)),
+                         "end of arc " << a);
+    }
+
+    for (VH n : nodes)
+    {
+        VH v = mcMeshProps().get<NODE_MESH_VERTEX>(n);
+        MC3D_CHECK_LOCAL(v.is_valid() && v.uidx() < tetMesh.n_vertices() && !tetMesh.is_deleted(v),
+                         "vertex " << v << " of node " << n);
+        MC3D_CHECK_LOCAL(meshProps().get<MC_NODE>(v) == n, "vertex " << v << " of node " << n);
+        set<EH> as;
+        set<EH> asCheck;
+        for (EH a : mcMesh.vertex_edges(n))
+            as.insert(a);
+        for (EH e : tetMesh.vertex_edges(v))
+            if (meshProps().isInArc(e))
+                asCheck.insert(meshProps().get<MC_ARC>(e));
+        MC3D_CHECK_LOCAL(as == asCheck, "arcs of node " << n);
+    }
+
+    return true;
+}
+
+#undef MC3D_CHECK_LOCAL
+
 void MCMeshNavigator::assertManifoldArc(const EH& a) const
 {
     (void)a;
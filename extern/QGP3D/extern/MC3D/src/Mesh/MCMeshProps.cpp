@@ -1,12 +1,26 @@
 #include "MC3D/Mesh/MCMeshProps.hpp"
 
+#include "MC3D/Mesh/MCEmbeddingIndex.hpp"
+
+#include <atomic>
 #include <iomanip>
 
 namespace mc3d
 {
 
-MCMeshProps::MCMeshProps(MCMesh& mcMesh) : MCMeshPropsBase(mcMesh)
+namespace
+{
+std::atomic<size_t> lastRevision(0); // Last revision handed out to any MC
+} // namespace
+
+MCMeshProps::MCMeshProps(MCMesh& mcMesh) : MCMeshPropsBase(mcMesh), _revision(++lastRevision)
+{
+}
+
+MCMeshProps::~MCMeshProps()
 {
+    // An index outliving its MC would unregister from a dangling object
+    assert(_embeddingIndices.empty());
 }
 
 list<HEH> MCMeshProps::haHalfedges(const HEH& ha) const
@@ -107,4 +121,71 @@ NodeType MCMeshProps::nodeType(const VH& n) const
     return type;
 }
 
+void MCMeshProps::markEmbeddingDirty(const CH& b)
+{
+    for (MCEmbeddingIndex* index : _embeddingIndices)
+        index->markDirty(b);
+}
+
+void MCMeshProps::markEmbeddingDirty(const FH& p)
+{
+    for (MCEmbeddingIndex* index : _embeddingIndices)
+        index->markDirty(p);
+}
+
+void MCMeshProps::markEmbeddingDirty(const EH& a)
+{
+    for (MCEmbeddingIndex* index : _embeddingIndices)
+        index->markDirty(a);
+}
+
+void MCMeshProps::markEmbeddingDirty()
+{
+    for (MCEmbeddingIndex* index : _embeddingIndices)
+        index->markAllDirty();
+}
+
+void MCMeshProps::advanceRevision()
+{
+    _revision = ++lastRevision;
+}
+
+void MCMeshProps::onPropertyChanged(size_t prop, const VH& n)
+{
+    (void)prop;
+    (void)n;
+    advanceRevision();
+}
+
+void MCMeshProps::onPropertyChanged(size_t prop, const EH& a)
+{
+    if (prop == propIndex<ARC_MESH_HALFEDGES>())
+        markEmbeddingDirty(a);
+    else
+        advanceRevision();
+}
+
+void MCMeshProps::onPropertyChanged(size_t prop, const FH& p)
+{
+    if (prop == propIndex<PATCH_MESH_HALFFACES>())
+        markEmbeddingDirty(p);
+    else
+        advanceRevision();
+}
+
+void MCMeshProps::onPropertyChanged(size_t prop, const CH& b)
+{
+    (void)prop;
+    markEmbeddingDirty(b);
+}
+
+void MCMeshProps::onPropertyChanged(size_t prop)
+{
+    if (prop == propIndex<BLOCK_MESH_TETS>() || prop == propIndex<PATCH_MESH_HALFFACES>()
+        || prop == propIndex<ARC_MESH_HALFEDGES>())
+        markEmbeddingDirty();
+    else
+        advanceRevision();
+}
+
 } // namespace mc3d
@@ -4,6 +4,8 @@
 
 #include "MC3D/Util.hpp"
 
+#include <utility>
+
 namespace mc3d
 {
 
@@ -464,6 +466,10 @@ void TetMeshManipulator::collapseHalfEdge(const HEH& he)
     VH vFrom = tetMesh.from_vertex_handle(he);
     VH vTo = tetMesh.to_vertex_handle(he);
 
+    // Everything incident on the star of vFrom is reconnected
+    for (CH tet : tetMesh.vertex_cells(vFrom))
+        meshProps().invalidateClassification(tet);
+
     set<CH> collapsedTets;
     for (CH tet : tetMesh.halfedge_cells(he))
         collapsedTets.insert(tet);
@@ -475,24 +481,13 @@ void TetMeshManipulator::collapseHalfEdge(const HEH& he)
 
     CH tetAny = *tetMesh.hec_iter(he);
 
-    bool hasLocalChart
-        = meshProps().isAllocated<CHART>()
-          && meshProps().ref<CHART>(tetAny).find(tetMesh.from_vertex_handle(he)) != meshProps().ref<CHART>(tetAny).end()
-          && meshProps().ref<CHART>(tetAny).find(tetMesh.to_vertex_handle(he)) != meshProps().ref<CHART>(tetAny).end();
-    bool hasLocalChartOrig = meshProps().isAllocated<CHART_ORIG>()
-                             && meshProps().ref<CHART_ORIG>(tetAny).find(tetMesh.from_vertex_handle(he))
-                                    != meshProps().ref<CHART_ORIG>(tetAny).end()
-                             && meshProps().ref<CHART_ORIG>(tetAny).find(tetMesh.to_vertex_handle(he))
-                                    != meshProps().ref<CHART_ORIG>(tetAny).end();
-    bool hasLocalChartIGM = meshProps().isAllocated<CHART_IGM>()
-                            && meshProps().ref<CHART_IGM>(tetAny).find(tetMesh.from_vertex_handle(he))
-                                   != meshProps().ref<CHART_IGM>(tetAny).end()
-                            && meshProps().ref<CHART_IGM>(tetAny).find(tetMesh.to_vertex_handle(he))
-                                   != meshProps().ref<CHART_IGM>(tetAny).end();
+    bool hasLocalChart = chartContains<CHART>(tetAny, {vFrom, vTo});
+    bool hasLocalChartOrig = chartContains<CHART_ORIG>(tetAny, {vFrom, vTo});
+    bool hasLocalChartIGM = chartContains<CHART_IGM>(tetAny, {vFrom, vTo});
 
     if (hasLocalChart)
     {
-        Vec3Q uvwTo = meshProps().ref<CHART>(*collapsedTets.begin()).at(vTo);
+        Vec3Q uvwTo = std::as_const(meshProps()).ref<CHART>(*collapsedTets.begin()).at(vTo);
         auto tet2trans = determineTransitionsAroundVertex<TRANSITION>(vFrom, *collapsedTets.begin());
         for (CH tet : shiftedTets)
         {
@@ -503,7 +498,7 @@ void TetMeshManipulator::collapseHalfEdge(const HEH& he)
     }
     if (hasLocalChartOrig)
     {
-        Vec3Q uvwTo = meshProps().ref<CHART_ORIG>(*collapsedTets.begin()).at(vTo);
+        Vec3Q uvwTo = std::as_const(meshProps()).ref<CHART_ORIG>(*collapsedTets.begin()).at(vTo);
         auto tet2trans = determineTransitionsAroundVertex<TRANSITION_ORIG>(vFrom, *collapsedTets.begin());
         for (CH tet : shiftedTets)
         {
@@ -767,6 +762,9 @@ VH TetMeshManipulator::splitHalfEdge(const HEH& heAD, const CH& tetStart, const
 {
     TetMesh& tetMesh = meshProps().mesh();
 
+    for (CH tet : tetMesh.halfedge_cells(heAD))
+        meshProps().invalidateClassification(tet);
+
     // store some relations to reconstruct child<->parent
     map<HEH, HFH> he2parentHf;
     map<VH, FH> vXOppositeOfAD2parentFace;
@@ -774,21 +772,11 @@ VH TetMeshManipulator::splitHalfEdge(const HEH& heAD, const CH& tetStart, const
     storeParentChildReconstructors(heAD, he2parentHf, vXOppositeOfAD2parentFace, heOppositeOfAD2parentTet);
 
     // Calculate uvw of new vtx for each tet incident to heAD
-    bool hasLocalChart = meshProps().isAllocated<CHART>()
-                         && meshProps().ref<CHART>(tetStart).find(tetMesh.from_vertex_handle(heAD))
-                                != meshProps().ref<CHART>(tetStart).end()
-                         && meshProps().ref<CHART>(tetStart).find(tetMesh.to_vertex_handle(heAD))
-                                != meshProps().ref<CHART>(tetStart).end();
-    bool hasLocalChartOrig = meshProps().isAllocated<CHART_ORIG>()
-                             && meshProps().ref<CHART_ORIG>(tetStart).find(tetMesh.from_vertex_handle(heAD))
-                                    != meshProps().ref<CHART_ORIG>(tetStart).end()
-                             && meshProps().ref<CHART_ORIG>(tetStart).find(tetMesh.to_vertex_handle(heAD))
-                                    != meshProps().ref<CHART_ORIG>(tetStart).end();
-    bool hasLocalChartIGM = meshProps().isAllocated<CHART_IGM>()
-                            && meshProps().ref<CHART_IGM>(tetStart).find(tetMesh.from_vertex_handle(heAD))
-                                   != meshProps().ref<CHART_IGM>(tetStart).end()
-                            && meshProps().ref<CHART_IGM>(tetStart).find(tetMesh.to_vertex_handle(heAD))
-                                   != meshProps().ref<CHART_IGM>(tetStart).end();
+    VH vA = tetMesh.from_vertex_handle(heAD);
+    VH vD = tetMesh.to_vertex_handle(heAD);
+    bool hasLocalChart = chartContains<CHART>(tetStart, {vA, vD});
+    bool hasLocalChartOrig = chartContains<CHART_ORIG>(tetStart, {vA, vD});
+    bool hasLocalChartIGM = chartContains<CHART_IGM>(tetStart, {vA, vD});
     map<CH, Vec3Q> tet2uvwnew;
     if (hasLocalChart)
         tet2uvwnew = calculateNewVtxChart<CHART>(heAD, tetStart, t);
@@ -799,9 +787,11 @@ VH TetMeshManipulator::splitHalfEdge(const HEH& heAD, const CH& tetStart, const
     if (hasLocalChartIGM)
         tet2igmnew = calculateNewVtxChart<CHART_IGM>(heAD, tetStart, t);
 
+#ifndef NDEBUG
     map<CH, double> tet2volXYZ;
     for (CH tet : tetMesh.halfedge_cells(heAD))
         tet2volXYZ[tet] = doubleVolumeXYZ(tet);
+#endif
 
     // PERFORM THE EDGE SPLIT and reconstruct parent/child relations
     map<HEH, vector<HEH>> he2heChildren;
@@ -824,10 +814,11 @@ VH TetMeshManipulator::splitHalfEdge(const HEH& heAD, const CH& tetStart, const
     cloneParentsToChildren(he2heChildren, e2eChildren, hf2hfChildren, f2fChildren, tet2tetChildren);
 
     // Special handling of CHARTS
+    set<CH> tetsSharingOrig = tetsSharingOrigChart(tet2uvwnew, tet2uvworignew);
     if (hasLocalChart)
-        inheritCharts<CHART>(tet2uvwnew, tet2tetChildren, vN);
+        inheritCharts<CHART>(tet2uvwnew, tet2tetChildren, vN, tetsSharingOrig);
     if (hasLocalChartOrig)
-        inheritCharts<CHART_ORIG>(tet2uvworignew, tet2tetChildren, vN);
+        inheritCharts<CHART_ORIG>(tet2uvworignew, tet2tetChildren, vN, tetsSharingOrig);
     if (hasLocalChartIGM)
         inheritCharts<CHART_IGM>(tet2igmnew, tet2tetChildren, vN);
 
@@ -837,6 +828,7 @@ VH TetMeshManipulator::splitHalfEdge(const HEH& heAD, const CH& tetStart, const
     // Update MC mapping
     updateMCMapping(he2heChildren, e2eChildren, hf2hfChildren, f2fChildren, tet2tetChildren);
 
+#ifndef NDEBUG
     for (auto& kv : tet2tetChildren)
         if (tet2volXYZ[kv.first] > 0)
             for (CH child : kv.second)
@@ -846,6 +838,7 @@ VH TetMeshManipulator::splitHalfEdge(const HEH& heAD, const CH& tetStart, const
                     DLOG(WARNING) << "Split of tet " << kv.first << " with vol " << tet2volXYZ[kv.first]
                                   << " caused child tet " << child << " to numerically flip, vol: " << vol;
             }
+#endif
 
     return vN;
 }
@@ -864,30 +857,26 @@ VH TetMeshManipulator::splitFace(const FH& f, const Vec3Q& barCoords)
         tetStart = tetMesh.incident_cell(hf);
         assert(tetStart.is_valid());
     }
+#ifndef NDEBUG
     map<CH, double> tet2volXYZ;
+#endif
     for (CH tet : tetMesh.face_cells(f))
         if (tet.is_valid())
+        {
+#ifndef NDEBUG
             tet2volXYZ[tet] = doubleVolumeXYZ(tet);
+#endif
+            meshProps().invalidateClassification(tet);
+        }
 
     // store some relations to reconstruct child<->parent
     map<HEH, std::pair<HFH, CH>> he2parentHfAndTet;
     storeParentChildReconstructors(f, he2parentHfAndTet);
 
     // Calculate uvw of new vtx for each tet incident to heAD
-    bool hasLocalChart = meshProps().isAllocated<CHART>()
-                         && meshProps().ref<CHART>(tetStart).find(vsHf[0]) != meshProps().ref<CHART>(tetStart).end()
-                         && meshProps().ref<CHART>(tetStart).find(vsHf[1]) != meshProps().ref<CHART>(tetStart).end()
-                         && meshProps().ref<CHART>(tetStart).find(vsHf[2]) != meshProps().ref<CHART>(tetStart).end();
-    bool hasLocalChartOrig
-        = meshProps().isAllocated<CHART_ORIG>()
-          && meshProps().ref<CHART_ORIG>(tetStart).find(vsHf[0]) != meshProps().ref<CHART_ORIG>(tetStart).end()
-          && meshProps().ref<CHART_ORIG>(tetStart).find(vsHf[1]) != meshProps().ref<CHART_ORIG>(tetStart).end()
-          && meshProps().ref<CHART_ORIG>(tetStart).find(vsHf[2]) != meshProps().ref<CHART_ORIG>(tetStart).end();
-    bool hasLocalChartIGM
-        = meshProps().isAllocated<CHART_IGM>()
-          && meshProps().ref<CHART_IGM>(tetStart).find(vsHf[0]) != meshProps().ref<CHART_IGM>(tetStart).end()
-          && meshProps().ref<CHART_IGM>(tetStart).find(vsHf[1]) != meshProps().ref<CHART_IGM>(tetStart).end()
-          && meshProps().ref<CHART_IGM>(tetStart).find(vsHf[2]) != meshProps().ref<CHART_IGM>(tetStart).end();
+    bool hasLocalChart = chartContains<CHART>(tetStart, {vsHf[0], vsHf[1], vsHf[2]});
+    bool hasLocalChartOrig = chartContains<CHART_ORIG>(tetStart, {vsHf[0], vsHf[1], vsHf[2]});
+    bool hasLocalChartIGM = chartContains<CHART_IGM>(tetStart, {vsHf[0], vsHf[1], vsHf[2]});
     map<CH, Vec3Q> tet2uvwnew;
     if (hasLocalChart)
         tet2uvwnew = calculateNewVtxChart<CHART>(tetStart, hf, barCoords);
@@ -909,10 +898,11 @@ VH TetMeshManipulator::splitFace(const FH& f, const Vec3Q& barCoords)
     cloneParentsToChildren({}, {}, hf2hfChildren, f2fChildren, tet2tetChildren);
 
     // Special handling of CHARTS
+    set<CH> tetsSharingOrig = tetsSharingOrigChart(tet2uvwnew, tet2uvworignew);
     if (hasLocalChart)
-        inheritCharts<CHART>(tet2uvwnew, tet2tetChildren, vN);
+        inheritCharts<CHART>(tet2uvwnew, tet2tetChildren, vN, tetsSharingOrig);
     if (hasLocalChartOrig)
-        inheritCharts<CHART_ORIG>(tet2uvworignew, tet2tetChildren, vN);
+        inheritCharts<CHART_ORIG>(tet2uvworignew, tet2tetChildren, vN, tetsSharingOrig);
     if (hasLocalChartIGM)
         inheritCharts<CHART_IGM>(tet2igmnew, tet2tetChildren, vN);
 
@@ -922,6 +912,7 @@ VH TetMeshManipulator::splitFace(const FH& f, const Vec3Q& barCoords)
     // Update MC mapping
     updateMCMapping({}, {}, hf2hfChildren, f2fChildren, tet2tetChildren);
 
+#ifndef NDEBUG
     for (auto& kv : tet2tetChildren)
         if (tet2volXYZ[kv.first] > 0)
             for (CH child : kv.second)
@@ -931,10 +922,121 @@ VH TetMeshManipulator::splitFace(const FH& f, const Vec3Q& barCoords)
                     DLOG(WARNING) << "Split of tet " << kv.first << " with vol " << tet2volXYZ[kv.first]
                                   << " caused child tet " << child << " to numerically flip, vol: " << vol;
             }
+#endif
 
     return vN;
 }
 
+int TetMeshManipulator::splitAll(const set<EH>& es, const set<FH>& fs)
+{
+    TetMesh& tetMesh = meshProps().mesh();
+
+    if (es.empty() && fs.empty())
+        return 0;
+
+    // Splitting an edge with n incident tets (m incident faces) adds 1 vertex, 2+m edges, 2m+n faces and 2n tets,
+    // splitting a face with n incident tets adds 1 vertex, 3+n edges, 3+3n faces and 3n tets
+    size_t nVs = 0, nEs = 0, nFs = 0, nTets = 0;
+    for (EH e : es)
+        countEdgeSplitElements(e, 1, nVs, nEs, nFs, nTets);
+    for (FH f : fs)
+    {
+        size_t nIncidentTets = tetMesh.is_boundary(f) ? 1 : 2;
+        nVs++;
+        nEs += 3 + nIncidentTets;
+        nFs += 3 + 3 * nIncidentTets;
+        nTets += 3 * nIncidentTets;
+    }
+    tetMesh.reserve_vertices(tetMesh.n_vertices() + nVs);
+    tetMesh.reserve_edges(tetMesh.n_edges() + nEs);
+    tetMesh.reserve_faces(tetMesh.n_faces() + nFs);
+    tetMesh.reserve_cells(tetMesh.n_cells() + nTets);
+
+    _deferMCMapping = true;
+    int nSplits = 0;
+    for (EH e : es)
+    {
+        splitHalfEdge(tetMesh.halfedge_handle(e, 0), *tetMesh.ec_iter(e), Q(1, 2));
+        nSplits++;
+    }
+    for (FH f : fs)
+        if (!tetMesh.is_deleted(f))
+        {
+            splitFace(f, {Q(1, 3), Q(1, 3), Q(1, 3)});
+            nSplits++;
+        }
+    _deferMCMapping = false;
+    applyDeferredMCMapping();
+
+    return nSplits;
+}
+
+int TetMeshManipulator::splitAll(const map<EH, set<Q>>& eCuts)
+{
+    TetMesh& tetMesh = meshProps().mesh();
+
+    if (eCuts.empty())
+        return 0;
+
+    // Each cut splits a subedge with the same incident elements as the original edge
+    size_t nVs = 0, nEs = 0, nFs = 0, nTets = 0;
+    for (auto& kv : eCuts)
+        countEdgeSplitElements(kv.first, kv.second.size(), nVs, nEs, nFs, nTets);
+    tetMesh.reserve_vertices(tetMesh.n_vertices() + nVs);
+    tetMesh.reserve_edges(tetMesh.n_edges() + nEs);
+    tetMesh.reserve_faces(tetMesh.n_faces() + nFs);
+    tetMesh.reserve_cells(tetMesh.n_cells() + nTets);
+
+    _deferMCMapping = true;
+    int nSplits = 0;
+    for (auto& [e, ts] : eCuts)
+    {
+        HEH he = tetMesh.halfedge_handle(e, 0);
+        VH vD = tetMesh.to_vertex_handle(he);
+        // Cut from vertex 0 towards vertex 1, rescaling the distances to the remaining subedge
+        Q tPrev = 0;
+        for (const Q& t : ts)
+        {
+            assert(t > tPrev && t < 1);
+            VH vN = splitHalfEdge(he, *tetMesh.hec_iter(he), (t - tPrev) / (1 - tPrev));
+            he = tetMesh.find_halfedge(vN, vD);
+            tPrev = t;
+            nSplits++;
+        }
+    }
+    _deferMCMapping = false;
+    applyDeferredMCMapping();
+
+    return nSplits;
+}
+
+void TetMeshManipulator::countEdgeSplitElements(
+    const EH& e, size_t nCuts, size_t& nVs, size_t& nEs, size_t& nFs, size_t& nTets) const
+{
+    const TetMesh& tetMesh = meshProps().mesh();
+
+    size_t nIncidentTets = 0, nIncidentFs = 0;
+    for (auto it = tetMesh.ec_iter(e); it.valid(); ++it)
+        nIncidentTets++;
+    for (auto it = tetMesh.ef_iter(e); it.valid(); ++it)
+        nIncidentFs++;
+    nVs += nCuts;
+    nEs += nCuts * (2 + nIncidentFs);
+    nFs += nCuts * (2 * nIncidentFs + nIncidentTets);
+    nTets += nCuts * 2 * nIncidentTets;
+}
+
+void TetMeshManipulator::applyDeferredMCMapping()
+{
+    DeferredMCMapping deferred;
+    std::swap(deferred, _deferredMCMapping);
+    updateMCMapping(deferred.he2heChildren,
+                    deferred.e2eChildren,
+                    deferred.hf2hfChildren,
+                    deferred.f2fChildren,
+                    deferred.tet2tetChildren);
+}
+
 VH TetMeshManipulator::splitTet(const CH& tet, const Vec4Q& barCoords)
 {
     TetMesh& tetMesh = meshProps().mesh();
@@ -942,37 +1044,26 @@ VH TetMeshManipulator::splitTet(const CH& tet, const Vec4Q& barCoords)
     vector<VH> vs;
     for (VH v : tetMesh.tet_vertices(tet))
         vs.push_back(v);
+    meshProps().invalidateClassification(tet);
 
     double volPre = doubleVolumeXYZ(tet);
     // Calculate uvw of new vtx for each tet incident to heAD
-    bool hasLocalChart = meshProps().isAllocated<CHART>()
-                         && meshProps().ref<CHART>(tet).find(vs[0]) != meshProps().ref<CHART>(tet).end()
-                         && meshProps().ref<CHART>(tet).find(vs[1]) != meshProps().ref<CHART>(tet).end()
-                         && meshProps().ref<CHART>(tet).find(vs[2]) != meshProps().ref<CHART>(tet).end()
-                         && meshProps().ref<CHART>(tet).find(vs[3]) != meshProps().ref<CHART>(tet).end();
-    bool hasLocalChartOrig = meshProps().isAllocated<CHART_ORIG>()
-                             && meshProps().ref<CHART_ORIG>(tet).find(vs[0]) != meshProps().ref<CHART_ORIG>(tet).end()
-                             && meshProps().ref<CHART_ORIG>(tet).find(vs[1]) != meshProps().ref<CHART_ORIG>(tet).end()
-                             && meshProps().ref<CHART_ORIG>(tet).find(vs[2]) != meshProps().ref<CHART_ORIG>(tet).end()
-                             && meshProps().ref<CHART_ORIG>(tet).find(vs[3]) != meshProps().ref<CHART_ORIG>(tet).end();
-    bool hasLocalChartIGM = meshProps().isAllocated<CHART_IGM>()
-                            && meshProps().ref<CHART_IGM>(tet).find(vs[0]) != meshProps().ref<CHART_IGM>(tet).end()
-                            && meshProps().ref<CHART_IGM>(tet).find(vs[1]) != meshProps().ref<CHART_IGM>(tet).end()
-                            && meshProps().ref<CHART_IGM>(tet).find(vs[2]) != meshProps().ref<CHART_IGM>(tet).end()
-                            && meshProps().ref<CHART_IGM>(tet).find(vs[3]) != meshProps().ref<CHART_IGM>(tet).end();
+    bool hasLocalChart = chartContains<CHART>(tet, {vs[0], vs[1], vs[2], vs[3]});
+    bool hasLocalChartOrig = chartContains<CHART_ORIG>(tet, {vs[0], vs[1], vs[2], vs[3]});
+    bool hasLocalChartIGM = chartContains<CHART_IGM>(tet, {vs[0], vs[1], vs[2], vs[3]});
 
     Vec3Q uvwNew(0, 0, 0);
     if (hasLocalChart)
         for (int i = 0; i < 4; i++)
-            uvwNew += barCoords[i] * meshProps().ref<CHART>(tet).at(vs[i]);
+            uvwNew += barCoords[i] * std::as_const(meshProps()).ref<CHART>(tet).at(vs[i]);
     Vec3Q uvwOrigNew(0, 0, 0);
     if (hasLocalChartOrig)
         for (int i = 0; i < 4; i++)
-            uvwNew += barCoords[i] * meshProps().ref<CHART_ORIG>(tet).at(vs[i]);
+            uvwOrigNew += barCoords[i] * std::as_const(meshProps()).ref<CHART_ORIG>(tet).at(vs[i]);
     Vec3Q igmNew(0, 0, 0);
     if (hasLocalChartIGM)
         for (int i = 0; i < 4; i++)
-            uvwNew += barCoords[i] * meshProps().ref<CHART_IGM>(tet).at(vs[i]);
+            igmNew += barCoords[i] * std::as_const(meshProps()).ref<CHART_IGM>(tet).at(vs[i]);
 
     // PERFORM THE EDGE SPLIT and reconstruct parent/child relations
     map<CH, vector<CH>> tet2tetChildren;
@@ -1264,36 +1355,76 @@ VH TetMeshManipulator::splitAndReconstructParentChildRelations(const CH& tetSpli
 template <typename CHART_T>
 void TetMeshManipulator::inheritCharts(const map<CH, Vec3Q>& tet2chartnew,
                                        const map<CH, vector<CH>>& tet2tetChildren,
-                                       const VH vN)
+                                       const VH vN,
+                                       const set<CH>& tetsSharingOrig)
 {
     auto& tetMesh = meshProps().mesh();
     for (const auto& kv : tet2tetChildren)
     {
         auto& tetParent = kv.first;
         auto& tetChildren = kv.second;
+        // The shared original chart is inherited along with CHART
+        bool sharesOrig = tetsSharingOrig.count(tetParent) != 0;
+        if (sharesOrig && std::is_same<CHART_T, CHART_ORIG>::value)
+            continue;
         for (CH tetChild : tetChildren)
         {
             auto vs = tetMesh.get_cell_vertices(tetChild);
-            auto& chart = meshProps().ref<CHART_T>(tetChild);
+            auto& chart = sharesOrig ? meshProps().refShared<CHART_T>(tetChild) : meshProps().ref<CHART_T>(tetChild);
             chart.erase(findMatching(chart,
                                      [&](const pair<const VH, Vec3Q>& v2uvw)
                                      { return !contains(tetMesh.tet_vertices(tetChild), v2uvw.first); })
                             .first);
             chart[vN] = tet2chartnew.at(tetParent);
         }
-        meshProps().reset<CHART_T>(tetParent);
+        if (sharesOrig)
+            meshProps().refShared<CHART_T>(tetParent).clear();
+        else
+            meshProps().reset<CHART_T>(tetParent);
     }
 }
 
 template void TetMeshManipulator::inheritCharts<CHART>(const map<CH, Vec3Q>& tet2chartnew,
                                                        const map<CH, vector<CH>>& tet2tetChildren,
-                                                       const VH vN);
+                                                       const VH vN,
+                                                       const set<CH>& tetsSharingOrig);
 template void TetMeshManipulator::inheritCharts<CHART_ORIG>(const map<CH, Vec3Q>& tet2chartnew,
                                                             const map<CH, vector<CH>>& tet2tetChildren,
-                                                            const VH vN);
+                                                            const VH vN,
+                                                            const set<CH>& tetsSharingOrig);
 template void TetMeshManipulator::inheritCharts<CHART_IGM>(const map<CH, Vec3Q>& tet2chartnew,
                                                            const map<CH, vector<CH>>& tet2tetChildren,
-                                                           const VH vN);
+                                                           const VH vN,
+                                                           const set<CH>& tetsSharingOrig);
+
+set<CH> TetMeshManipulator::tetsSharingOrigChart(const map<CH, Vec3Q>& tet2chartnew,
+                                                 const map<CH, Vec3Q>& tet2chartorignew) const
+{
+    set<CH> tets;
+    for (const auto& kv : tet2chartnew)
+    {
+        // Face splits also map the (possibly invalid) cell beyond boundary faces
+        if (!kv.first.is_valid())
+            continue;
+        auto it = tet2chartorignew.find(kv.first);
+        if (it != tet2chartorignew.end() && it->second == kv.second
+            && meshProps().isSnapshotShared<CHART_ORIG>(kv.first))
+            tets.insert(kv.first);
+    }
+    return tets;
+}
+
+template <typename CHART_T>
+bool TetMeshManipulator::chartContains(const CH& tet, std::initializer_list<VH> vs) const
+{
+    if (!meshProps().isAllocated<CHART_T>())
+        return false;
+    const auto& chart = meshProps().ref<CHART_T>(tet);
+    for (VH v : vs)
+        if (chart.find(v) == chart.end())
+            return false;
+    return true;
+}
 
 template <typename CHART_T>
 map<CH, Vec3Q>
@@ -1301,7 +1432,7 @@ TetMeshManipulator::calculateNewVtxChart(const CH& tetStart, const HFH& hfSplit,
 {
     auto& tetMesh = meshProps().mesh();
     map<CH, Vec3Q> tet2chartnew;
-    auto& chart = meshProps().ref<CHART_T>(tetStart);
+    const auto& chart = meshProps().ref<CHART_T>(tetStart);
     auto vsHf = meshProps().get_halfface_vertices(hfSplit);
     Vec3Q& localUVW = (tet2chartnew[tetStart] = Vec3Q(0, 0, 0));
     for (int i = 0; i < 3; i++)
@@ -1322,13 +1453,20 @@ TetMeshManipulator::calculateNewVtxChart<CHART_IGM>(const CH& tetStart, const HF
 
 void TetMeshManipulator::inheritTransitions(const map<HFH, vector<HFH>>& hf2hfChildren)
 {
+    auto& tetMesh = meshProps().mesh();
+    // Children of faces whose original transition is shared keep sharing it, as it is inherited identically
     if (meshProps().isAllocated<TRANSITION>())
         for (const auto& kv : hf2hfChildren)
         {
             auto& hfParent = kv.first;
             auto& hfChildren = kv.second;
+            bool sharesOrig = meshProps().isSnapshotShared<TRANSITION_ORIG>(tetMesh.face_handle(hfParent));
             for (HFH hfChild : hfChildren)
-                meshProps().setTransition<TRANSITION>(hfChild, meshProps().hfTransition<TRANSITION>(hfParent));
+                if (sharesOrig)
+                    meshProps().setTransitionShared<TRANSITION>(hfChild,
+                                                                meshProps().hfTransition<TRANSITION>(hfParent));
+                else
+                    meshProps().setTransition<TRANSITION>(hfChild, meshProps().hfTransition<TRANSITION>(hfParent));
         }
     if (meshProps().isAllocated<TRANSITION_IGM>())
         for (const auto& kv : hf2hfChildren)
@@ -1343,6 +1481,8 @@ void TetMeshManipulator::inheritTransitions(const map<HFH, vector<HFH>>& hf2hfCh
         {
             auto& hfParent = kv.first;
             auto& hfChildren = kv.second;
+            if (meshProps().isSnapshotShared<TRANSITION_ORIG>(tetMesh.face_handle(hfParent)))
+                continue;
             for (HFH hfChild : hfChildren)
                 meshProps().setTransition<TRANSITION_ORIG>(hfChild,
                                                            meshProps().hfTransition<TRANSITION_ORIG>(hfParent));
@@ -1382,6 +1522,16 @@ void TetMeshManipulator::updateMCMapping(const map<HEH, vector<HEH>>& he2heChild
                                          const map<FH, vector<FH>>& f2fChildren,
                                          const map<CH, vector<CH>>& tet2tetChildren)
 {
+    if (_deferMCMapping)
+    {
+        _deferredMCMapping.he2heChildren.insert(he2heChildren.begin(), he2heChildren.end());
+        _deferredMCMapping.e2eChildren.insert(e2eChildren.begin(), e2eChildren.end());
+        _deferredMCMapping.hf2hfChildren.insert(hf2hfChildren.begin(), hf2hfChildren.end());
+        _deferredMCMapping.f2fChildren.insert(f2fChildren.begin(), f2fChildren.end());
+        _deferredMCMapping.tet2tetChildren.insert(tet2tetChildren.begin(), tet2tetChildren.end());
+        return;
+    }
+
 #define FIND_ERASE_REPLACE(MAP, SET)                                                                                   \
     for (const auto& kv : MAP)                                                                                         \
     {                                                                                                                  \
@@ -52,7 +52,7 @@ void TetMeshProps::clearMC()
 
 bool TetMeshProps::isInArc(const EH& e) const
 {
-    return (isAllocated<MC_ARC>() && get<MC_ARC>(e).is_valid()) || (isAllocated<IS_ARC>() && get<IS_ARC>(e));
+    return (classification(e) & IN_ARC) != 0;
 }
 
 bool TetMeshProps::isInArc(const HEH& he) const
@@ -62,7 +62,7 @@ bool TetMeshProps::isInArc(const HEH& he) const
 
 bool TetMeshProps::isInArc(const VH& v) const
 {
-    return containsMatching(mesh().vertex_edges(v), [this](const EH& e) { return isInArc(e); });
+    return (classification(v) & IN_ARC) != 0;
 }
 
 bool TetMeshProps::isInPatch(const FH& f) const
@@ -77,17 +77,17 @@ bool TetMeshProps::isInPatch(const HFH& hf) const
 
 bool TetMeshProps::isInPatch(const EH& e) const
 {
-    return containsMatching(mesh().edge_faces(e), [this](const FH& f) { return isInPatch(f); });
+    return (classification(e) & IN_PATCH) != 0;
 }
 
 bool TetMeshProps::isInPatch(const HEH& he) const
 {
-    return containsMatching(mesh().halfedge_faces(he), [this](const FH& f) { return isInPatch(f); });
+    return isInPatch(mesh().edge_handle(he));
 }
 
 bool TetMeshProps::isInPatch(const VH& v) const
 {
-    return containsMatching(mesh().vertex_faces(v), [this](const FH& f) { return isInPatch(f); });
+    return (classification(v) & IN_PATCH) != 0;
 }
 
 bool TetMeshProps::touchesArc(const EH& e) const
@@ -140,6 +140,167 @@ bool TetMeshProps::touchesPatch(const CH& tet) const
     return containsMatching(mesh().cell_vertices(tet), [this](const VH& v) { return isInPatch(v); });
 }
 
+bool TetMeshProps::isNode(const VH& v) const
+{
+    return (classification(v) & IS_NODE) != 0;
+}
+
+bool TetMeshProps::isFeature(const VH& v) const
+{
+    return (classification(v) & IS_FEATURE) != 0;
+}
+
+bool TetMeshProps::isFeature(const EH& e) const
+{
+    return (classification(e) & IS_FEATURE) != 0;
+}
+
+void TetMeshProps::invalidateClassification(const CH& tet)
+{
+    for (VH v : mesh().tet_vertices(tet))
+        invalidate(_vClassification, v.idx());
+    for (EH e : mesh().cell_edges(tet))
+        invalidate(_eClassification, e.idx());
+}
+
+void TetMeshProps::invalidateClassification()
+{
+    _vClassification.clear();
+    _eClassification.clear();
+}
+
+void TetMeshProps::updateClassification() const
+{
+    for (VH v : mesh().vertices())
+        classification(v);
+    for (EH e : mesh().edges())
+        classification(e);
+}
+
+bool TetMeshProps::isClassificationUpToDate() const
+{
+    if (_vClassification.size() != mesh().n_vertices() || _eClassification.size() != mesh().n_edges())
+        return false;
+    return !containsMatching(mesh().vertices(), [this](const VH& v) { return _vClassification[v.idx()] == 0; })
+           && !containsMatching(mesh().edges(), [this](const EH& e) { return _eClassification[e.idx()] == 0; });
+}
+
+bool TetMeshProps::isClassificationConsistent() const
+{
+    for (int i = 0; i < (int)std::min<size_t>(_vClassification.size(), mesh().n_vertices()); i++)
+        if (_vClassification[i] != 0 && _vClassification[i] != classify(VH(i)))
+        {
+            LOG(ERROR) << "Cached classification of vertex " << i << " is outdated";
+            return false;
+        }
+    for (int i = 0; i < (int)std::min<size_t>(_eClassification.size(), mesh().n_edges()); i++)
+        if (_eClassification[i] != 0 && _eClassification[i] != classify(EH(i)))
+        {
+            LOG(ERROR) << "Cached classification of edge " << i << " is outdated";
+            return false;
+        }
+    return true;
+}
+
+void TetMeshProps::onPropertyChanged(size_t prop, const VH& v)
+{
+    (void)prop;
+    invalidate(_vClassification, v.idx());
+}
+
+void TetMeshProps::onPropertyChanged(size_t prop, const EH& e)
+{
+    (void)prop;
+    if (e.idx() >= (int)mesh().n_edges())
+        return;
+    invalidate(_eClassification, e.idx());
+    for (VH v : mesh().edge_vertices(e))
+        invalidate(_vClassification, v.idx());
+}
+
+void TetMeshProps::onPropertyChanged(size_t prop, const FH& f)
+{
+    (void)prop;
+    if (f.idx() >= (int)mesh().n_faces())
+        return;
+    for (HEH he : mesh().face(f).halfedges())
+    {
+        invalidate(_eClassification, mesh().edge_handle(he).idx());
+        invalidate(_vClassification, mesh().from_vertex_handle(he).idx());
+    }
+}
+
+void TetMeshProps::onPropertyChanged(size_t prop)
+{
+    (void)prop;
+    invalidateClassification();
+}
+
+uint8_t TetMeshProps::classification(const VH& v) const
+{
+    // Fewer vertices than cached means the mesh was cleared or garbage collected
+    if (_vClassification.size() > mesh().n_vertices())
+        _vClassification.clear();
+    if (v.idx() >= (int)_vClassification.size())
+        _vClassification.resize(mesh().n_vertices(), 0);
+    uint8_t& flags = _vClassification[v.idx()];
+    if (flags == 0)
+        flags = classify(v);
+    assert(flags == classify(v));
+    return flags;
+}
+
+uint8_t TetMeshProps::classification(const EH& e) const
+{
+    if (_eClassification.size() > mesh().n_edges())
+        _eClassification.clear();
+    if (e.idx() >= (int)_eClassification.size())
+        _eClassification.resize(mesh().n_edges(), 0);
+    uint8_t& flags = _eClassification[e.idx()];
+    if (flags == 0)
+        flags = classify(e);
+    assert(flags == classify(e));
+    return flags;
+}
+
+uint8_t TetMeshProps::classify(const VH& v) const
+{
+    uint8_t flags = CLASSIFIED;
+    if (containsMatching(mesh().vertex_faces(v), [this](const FH& f) { return isInPatch(f); }))
+        flags |= IN_PATCH;
+    if (containsMatching(mesh().vertex_edges(v), [this](const EH& e) { return isArcEdge(e); }))
+        flags |= IN_ARC;
+    if (isAllocated<MC_NODE>() && get<MC_NODE>(v).is_valid())
+        flags |= IS_NODE;
+    if (isAllocated<IS_FEATURE_V>() && get<IS_FEATURE_V>(v) != 0)
+        flags |= IS_FEATURE;
+    return flags;
+}
+
+uint8_t TetMeshProps::classify(const EH& e) const
+{
+    uint8_t flags = CLASSIFIED;
+    if (containsMatching(mesh().edge_faces(e), [this](const FH& f) { return isInPatch(f); }))
+        flags |= IN_PATCH;
+    if (isArcEdge(e))
+        flags |= IN_ARC;
+    if (isAllocated<IS_FEATURE_E>() && get<IS_FEATURE_E>(e) != 0)
+        flags |= IS_FEATURE;
+    return flags;
+}
+
+bool TetMeshProps::isArcEdge(const EH& e) const
+{
+    return (isAllocated<MC_ARC>() && get<MC_ARC>(e).is_valid()) || (isAllocated<IS_ARC>() && get<IS_ARC>(e));
+}
+
+void TetMeshProps::invalidate(vector<uint8_t>& cache, int idx)
+{
+    // Entries beyond the current size are implicitly outdated
+    if (idx >= 0 && idx < (int)cache.size())
+        cache[idx] = 0;
+}
+
 #define REPLACE_DELETED_SET(SET, PROPERTY_NAME)                                                                        \
     do                                                                                                                 \
     {                                                                                                                  \
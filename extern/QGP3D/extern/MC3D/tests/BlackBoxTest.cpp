@@ -16,6 +16,30 @@ class BlackBoxSuccessTest : public FullToolChainTest
     }
 };
 
+class BlackBoxBatchSplitTest : public FullToolChainTest
+{
+  protected:
+    void run()
+    {
+        ASSERT_EQ(reader.readSeamlessParam(), Reader::SUCCESS);
+        ASSERT_EQ(mcgen.traceMC(true, true, false, false, true), MCGenerator::SUCCESS);
+        assertValidMC(false);
+        ASSERT_EQ(mcgen.reduceMC(false, true), MCGenerator::SUCCESS);
+    }
+};
+
+class BlackBoxWavefrontTest : public FullToolChainTest
+{
+  protected:
+    void run()
+    {
+        ASSERT_EQ(reader.readSeamlessParam(), Reader::SUCCESS);
+        ASSERT_EQ(mcgen.traceMC(true, true, false, false, true, true), MCGenerator::SUCCESS);
+        assertValidMC(false);
+        ASSERT_EQ(mcgen.reduceMC(false, true), MCGenerator::SUCCESS);
+    }
+};
+
 TEST_P(BlackBoxSuccessTest, ItSucceeds)
 {
     run();
@@ -28,3 +52,21 @@ INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel, BlackBoxSuccessTest, ::test
 INSTANTIATE_TEST_SUITE_P(ForEachValidDequantizedModel, BlackBoxSuccessTest, ::testing::ValuesIn(dequantizedModelNames));
 
 INSTANTIATE_TEST_SUITE_P(ForEachValidAlgohexModel, BlackBoxSuccessTest, ::testing::ValuesIn(algohexModelNames));
+
+TEST_P(BlackBoxBatchSplitTest, ItSucceeds)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, BlackBoxBatchSplitTest, ::testing::ValuesIn(minimalModelNames));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel, BlackBoxBatchSplitTest, ::testing::ValuesIn(quantizedModelNames));
+
+TEST_P(BlackBoxWavefrontTest, ItSucceeds)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, BlackBoxWavefrontTest, ::testing::ValuesIn(minimalModelNames));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel, BlackBoxWavefrontTest, ::testing::ValuesIn(quantizedModelNames));
@@ -0,0 +1,124 @@
+#include "./TestUtils.hpp"
+
+#include "MC3D/Algorithm/SingularityInitializer.hpp"
+#include "MC3D/Algorithm/MCBuilder.hpp"
+#include "MC3D/Algorithm/MCReducer.hpp"
+#include "MC3D/Mesh/MCEmbeddingIndex.hpp"
+#include "MC3D/Mesh/TetMeshManipulator.hpp"
+
+#include <utility>
+
+class MCEmbeddingIndexTest : public FullToolChainTest
+{
+  public:
+    MCEmbeddingIndexTest() : FullToolChainTest(), init(meshProps), builder(meshProps)
+    {
+    }
+
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(reader.readSeamlessParamWithWalls(), Reader::SUCCESS);
+        ASSERT_EQ(init.initTransitions(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(init.initSingularities(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(init.makeFeaturesConsistent(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(builder.discoverBlocks(), MCBuilder::SUCCESS);
+        ASSERT_EQ(builder.connectMCMesh(true, true), MCBuilder::SUCCESS);
+    }
+
+    void assertMatchesProperties(const MCEmbeddingIndex& index)
+    {
+        const MCMeshProps& mcMeshProps = *meshProps.get<MC_MESH_PROPS>();
+        ASSERT_FALSE(index.isDirty());
+        ASSERT_TRUE(index.isConsistent());
+        for (CH b : mcMeshRaw.cells())
+            ASSERT_EQ(index.blockTets(b).size(), mcMeshProps.ref<BLOCK_MESH_TETS>(b).size());
+        for (FH p : mcMeshRaw.faces())
+            ASSERT_EQ(index.patchHalffaces(p).size(), mcMeshProps.ref<PATCH_MESH_HALFFACES>(p).size());
+        for (EH a : mcMeshRaw.edges())
+        {
+            auto hes = index.arcHalfedges(a);
+            ASSERT_TRUE(std::equal(
+                hes.begin(), hes.end(), mcMeshProps.ref<ARC_MESH_HALFEDGES>(a).begin(),
+                mcMeshProps.ref<ARC_MESH_HALFEDGES>(a).end()));
+        }
+    }
+
+    SingularityInitializer init;
+    MCBuilder builder;
+};
+
+class MCEmbeddingIndexSuccessTest : public MCEmbeddingIndexTest
+{
+  protected:
+    void run()
+    {
+        MCMeshProps& mcMeshProps = *meshProps.get<MC_MESH_PROPS>();
+        MCEmbeddingIndex index(mcMeshProps);
+        assertMatchesProperties(index);
+
+        LOG(INFO) << "Embedding of " << mcMeshRaw.n_logical_cells() << " blocks: " << index.memoryFootprint()
+                  << " bytes as CSR, approx. " << index.propertyMemoryFootprint() << " bytes as sets/lists";
+        ASSERT_LT(index.memoryFootprint(), index.propertyMemoryFootprint());
+
+        // Direct writes to the embedding properties have to be tracked by the index, const reads must not be
+        CH bDirect = *mcMeshRaw.cells().first;
+        FH pDirect = *mcMeshRaw.faces().first;
+        EH aDirect = *mcMeshRaw.edges().first;
+        auto tets = mcMeshProps.get<BLOCK_MESH_TETS>(bDirect);
+        auto hfs = mcMeshProps.get<PATCH_MESH_HALFFACES>(pDirect);
+        auto hes = mcMeshProps.get<ARC_MESH_HALFEDGES>(aDirect);
+        ASSERT_EQ(std::as_const(mcMeshProps).ref<BLOCK_MESH_TETS>(bDirect).size(), tets.size());
+        ASSERT_EQ(std::as_const(mcMeshProps).ref<PATCH_MESH_HALFFACES>(pDirect).size(), hfs.size());
+        ASSERT_EQ(std::as_const(mcMeshProps).ref<ARC_MESH_HALFEDGES>(aDirect).size(), hes.size());
+        ASSERT_FALSE(index.isDirty());
+        mcMeshProps.set<BLOCK_MESH_TETS>(bDirect, {});
+        mcMeshProps.ref<PATCH_MESH_HALFFACES>(pDirect).clear();
+        mcMeshProps.ref<ARC_MESH_HALFEDGES>(aDirect).clear();
+        ASSERT_TRUE(index.isDirty());
+        index.update();
+        ASSERT_TRUE(index.blockTets(bDirect).empty());
+        ASSERT_TRUE(index.patchHalffaces(pDirect).empty());
+        ASSERT_TRUE(index.arcHalfedges(aDirect).empty());
+        mcMeshProps.set<BLOCK_MESH_TETS>(bDirect, tets);
+        mcMeshProps.set<PATCH_MESH_HALFFACES>(pDirect, hfs);
+        mcMeshProps.set<ARC_MESH_HALFEDGES>(aDirect, hes);
+        ASSERT_TRUE(index.isDirty());
+        index.update();
+        assertMatchesProperties(index);
+
+        // Tet refinement has to be tracked by the index
+        TetMeshManipulator tetManipulator(meshProps);
+        CH b = *mcMeshRaw.cells().first;
+        tetManipulator.splitTet(*index.blockTets(b).begin(), Vec4Q(Q(1, 4), Q(1, 4), Q(1, 4), Q(1, 4)));
+        EH a = *mcMeshRaw.edges().first;
+        HEH he = *index.arcHalfedges(a).begin();
+        tetManipulator.splitHalfEdge(he, *meshRaw.hec_iter(he), Q(1, 2));
+        ASSERT_TRUE(index.isDirty());
+        index.update();
+        assertMatchesProperties(index);
+
+        // Merges performed by the reducer have to be tracked by the index
+        reducer.init(false, true, true);
+        while (reducer.isReducible())
+        {
+            reducer.removeNextPatch();
+            ASSERT_TRUE(index.isDirty());
+            index.update();
+        }
+        assertMatchesProperties(index);
+    }
+};
+
+TEST_P(MCEmbeddingIndexSuccessTest, ItTracksReduction)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel,
+                         MCEmbeddingIndexSuccessTest,
+                         ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         MCEmbeddingIndexSuccessTest,
+                         ::testing::ValuesIn(quantizedModelNamesOut));
@@ -0,0 +1,103 @@
+#include "./TestUtils.hpp"
+
+#include "MC3D/Algorithm/SingularityInitializer.hpp"
+#include "MC3D/Algorithm/MCBuilder.hpp"
+#include "MC3D/Algorithm/MCReducer.hpp"
+
+class MCLocalCheckTest : public FullToolChainTest
+{
+  public:
+    MCLocalCheckTest() : FullToolChainTest(), init(meshProps), builder(meshProps)
+    {
+    }
+
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(reader.readSeamlessParamWithWalls(), Reader::SUCCESS);
+        ASSERT_EQ(init.initTransitions(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(init.initSingularities(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(init.makeFeaturesConsistent(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(builder.discoverBlocks(), MCBuilder::SUCCESS);
+        ASSERT_EQ(builder.connectMCMesh(true, true), MCBuilder::SUCCESS);
+    }
+
+    set<CH> allBlocks() const
+    {
+        set<CH> bs;
+        for (CH b : mcMeshRaw.cells())
+            bs.insert(b);
+        return bs;
+    }
+
+    SingularityInitializer init;
+    MCBuilder builder;
+};
+
+class MCLocalCheckSuccessTest : public MCLocalCheckTest
+{
+  protected:
+    void run()
+    {
+        MCMeshNavigator nav(meshProps);
+        ASSERT_TRUE(nav.checkLocalMC(allBlocks()));
+
+        // The check has to pass around every merge of the reducer
+        reducer.init(false, true, true);
+        while (reducer.isReducible())
+        {
+            reducer.removeNextPatch();
+            // MC_BLOCK is only relabeled lazily by the reducer
+            reducer.materializeBlockOwnership();
+            ASSERT_TRUE(nav.checkLocalMC(allBlocks()));
+        }
+    }
+};
+
+class MCLocalCheckFailureTest : public MCLocalCheckTest
+{
+  protected:
+    void run()
+    {
+        MCMeshNavigator nav(meshProps);
+        MCMeshProps& mcMeshProps = *meshProps.get<MC_MESH_PROPS>();
+        CH b = *mcMeshRaw.cells().first;
+
+        // Tet of the block embedding assigned to another block
+        CH tet = *mcMeshProps.ref<BLOCK_MESH_TETS>(b).begin();
+        meshProps.set<MC_BLOCK>(tet, CH(mcMeshRaw.n_cells()));
+        ASSERT_FALSE(nav.checkLocalMC({b}));
+        meshProps.set<MC_BLOCK>(tet, b);
+        ASSERT_TRUE(nav.checkLocalMC({b}));
+
+        // Arc embedding not ending in the node of the arc
+        EH a = *mcMeshRaw.cell_edges(b).first;
+        HEH he = mcMeshProps.ref<ARC_MESH_HALFEDGES>(a).back();
+        mcMeshProps.ref<ARC_MESH_HALFEDGES>(a).pop_back();
+        ASSERT_FALSE(nav.checkLocalMC({b}));
+        mcMeshProps.ref<ARC_MESH_HALFEDGES>(a).push_back(he);
+        ASSERT_TRUE(nav.checkLocalMC({b}));
+    }
+};
+
+TEST_P(MCLocalCheckSuccessTest, ItAcceptsValidMCs)
+{
+    run();
+}
+
+TEST_P(MCLocalCheckFailureTest, ItDetectsInconsistencies)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, MCLocalCheckSuccessTest, ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         MCLocalCheckSuccessTest,
+                         ::testing::ValuesIn(quantizedModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, MCLocalCheckFailureTest, ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         MCLocalCheckFailureTest,
+                         ::testing::ValuesIn(quantizedModelNamesOut));
@@ -34,6 +34,19 @@ class MCReducerTest : public FullToolChainTest
         ASSERT_TRUE(meshProps.isAllocated<TRANSITION>());
     }
 
+    void assertBlockOwnership()
+    {
+        const MCMeshProps& mcMeshProps = *meshProps.get<MC_MESH_PROPS>();
+        size_t nTets = 0;
+        for (CH b : mcMeshRaw.cells())
+            for (CH tet : mcMeshProps.ref<BLOCK_MESH_TETS>(b))
+            {
+                ASSERT_EQ(meshProps.get<MC_BLOCK>(tet), b);
+                nTets++;
+            }
+        ASSERT_EQ(nTets, meshRaw.n_logical_cells());
+    }
+
     SingularityInitializer init;
     MCBuilder builder;
 };
@@ -66,11 +79,18 @@ class MCReducerSuccessTest : public MCReducerTest
             while (reducer.isReducible())
             {
                 assertPatchesReducible(true, preserveSingularWalls, avoidSelfadjacency);
+                // Each reduction step modifies the MC, which has to invalidate revision-keyed caches
+                size_t revision = meshProps.get<MC_MESH_PROPS>()->revision();
                 reducer.removeNextPatch();
+                ASSERT_GT(meshProps.get<MC_MESH_PROPS>()->revision(), revision);
                 assertArcsReducible(false);
                 assertNodesReducible(false);
             }
 
+            // Deferred MC_BLOCK relabeling has to be materialized once the reduction is exhausted
+            ASSERT_FALSE(reducer.hasDeferredBlockOwnership());
+            assertBlockOwnership();
+
             assertValidWalls();
             assertTransitionFreeBlocks();
             assertValidMC();
@@ -99,3 +119,56 @@ INSTANTIATE_TEST_SUITE_P(ForEachValidDequantizedModel,
 INSTANTIATE_TEST_SUITE_P(ForEachValidAlgohexModel,
                          MCReducerSuccessTest,
                          ::testing::ValuesIn(algohexModelNamesOut));
+
+class MCRevisionTest : public MCReducerTest
+{
+  protected:
+    void run()
+    {
+        MCMeshProps& mcMeshProps = *meshProps.get<MC_MESH_PROPS>();
+        size_t revision = mcMeshProps.revision();
+
+        // Reading the MC or writing anything but its structure keeps revision-keyed caches valid
+        for (VH n : mcMeshRaw.vertices())
+            mcMeshProps.nodeType(n);
+        CH b = *mcMeshRaw.cells().first;
+        mcMeshProps.set<BLOCK_MESH_TETS>(b, mcMeshProps.get<BLOCK_MESH_TETS>(b));
+        EH e = *meshRaw.edges().first;
+        meshProps.set<IS_SINGULAR>(e, meshProps.get<IS_SINGULAR>(e));
+        ASSERT_EQ(mcMeshProps.revision(), revision);
+
+        // Modifying the singularity tags of the MC invalidates them
+        EH a = *mcMeshRaw.edges().first;
+        mcMeshProps.set<IS_SINGULAR>(a, mcMeshProps.get<IS_SINGULAR>(a));
+        ASSERT_GT(mcMeshProps.revision(), revision);
+        revision = mcMeshProps.revision();
+
+        // A new MC never matches the revision of another one, even if created at the same address
+        size_t otherRevision = revision;
+        for (int i = 0; i < 2; i++)
+        {
+            MCMesh otherMeshRaw;
+            MCMeshProps other(otherMeshRaw);
+            ASSERT_GT(other.revision(), otherRevision);
+            otherRevision = other.revision();
+        }
+        ASSERT_EQ(mcMeshProps.revision(), revision);
+
+        // Topological modifications invalidate them
+        reducer.init(false, true, true);
+        if (reducer.isReducible())
+        {
+            reducer.removeNextPatch();
+            ASSERT_GT(mcMeshProps.revision(), revision);
+        }
+    }
+};
+
+TEST_P(MCRevisionTest, ItTracksModifications)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, MCRevisionTest, ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel, MCRevisionTest, ::testing::ValuesIn(quantizedModelNamesOut));
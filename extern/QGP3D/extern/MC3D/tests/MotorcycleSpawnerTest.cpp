@@ -1,10 +1,13 @@
 #include "./TestUtils.hpp"
 
+#include "MC3D/Algorithm/MCBuilder.hpp"
 #include "MC3D/Algorithm/MotorcycleSpawner.hpp"
+#include "MC3D/Algorithm/MotorcycleTracer.hpp"
 #include "MC3D/Algorithm/SingularityInitializer.hpp"
 
 #include <fstream>
 #include <limits>
+#include <tuple>
 #include <vector>
 
 class MotorcycleSpawningTest : public FullToolChainTest
@@ -92,6 +95,95 @@ class MotorcycleSpawningSuccessTest : public MotorcycleSpawningTest
     }
 };
 
+class MotorcycleBatchSpawningTest : public MotorcycleSpawningTest
+{
+  protected:
+    using MotorcycleKey = std::tuple<int, int, int, int, int, Q, Q>;
+    using SpawnFunc = MotorcycleSpawner::RetCode (MotorcycleSpawner::*)();
+
+    set<MotorcycleKey> drain(MotorcycleQueue& q)
+    {
+        set<MotorcycleKey> keys;
+        while (!q.empty())
+        {
+            const Motorcycle& mot = q.top();
+            keys.insert({mot.tet.idx(),
+                          mot.edge.idx(),
+                          mot.encodedCoords[0],
+                          mot.encodedCoords[1],
+                          mot.encodedCoords[2],
+                          mot.isoValue,
+                          mot.startValue});
+            q.pop();
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Spawn a splitting motorcycle for each block flagged by \p flag one block at a time (by hiding the flag
+     *        of all other blocks) and once for all blocks in batch mode, and check that both yield the same
+     *        motorcycles. Only meaningful as long as no block needs a fallback split, which modifies the mesh.
+     */
+    void assertBatchMatchesSingle(bool BlockData::*flag, SpawnFunc single, SpawnFunc batch)
+    {
+        auto& blockData = meshProps.ref<MC_BLOCK_DATA>();
+        vector<int> flagged;
+        for (auto& kv : blockData)
+            if (kv.second.*flag)
+                flagged.emplace_back(kv.first);
+
+        size_t nTets = meshRaw.n_cells();
+        set<MotorcycleKey> keysSingle;
+        for (int id : flagged)
+        {
+            for (int other : flagged)
+                blockData.at(other).*flag = other == id;
+            MotorcycleQueue q;
+            MotorcycleSpawner singleSpawner(meshProps, q);
+            ASSERT_EQ((singleSpawner.*single)(), MotorcycleSpawner::SUCCESS);
+            ASSERT_EQ(q.size(), 1u);
+            ASSERT_EQ(meshRaw.n_cells(), nTets);
+            auto keys = drain(q);
+            keysSingle.insert(keys.begin(), keys.end());
+        }
+        for (int id : flagged)
+            blockData.at(id).*flag = true;
+
+        MotorcycleQueue q;
+        MotorcycleSpawner batchSpawner(meshProps, q);
+        ASSERT_EQ((batchSpawner.*batch)(), MotorcycleSpawner::SUCCESS);
+        ASSERT_EQ(q.size(), flagged.size());
+        ASSERT_EQ(meshRaw.n_cells(), nTets);
+        ASSERT_EQ(drain(q), keysSingle);
+    }
+
+    void run()
+    {
+        for (FH f : meshRaw.faces())
+            if (meshRaw.is_boundary(f) || (meshProps.isAllocated<IS_FEATURE_F>() && meshProps.get<IS_FEATURE_F>(f)))
+                meshProps.set<IS_WALL>(f, true);
+        ASSERT_EQ(spawner.spawnSingularityMotorcycles(), MotorcycleSpawner::SUCCESS);
+        if (meshProps.isAllocated<IS_FEATURE_E>() || meshProps.isAllocated<IS_FEATURE_F>()
+            || meshProps.isAllocated<IS_FEATURE_V>())
+        {
+            ASSERT_EQ(spawner.spawnFeatureMotorcycles(), MotorcycleSpawner::SUCCESS);
+        }
+        MotorcycleTracer tracer(meshProps, mQ, false);
+        ASSERT_EQ(tracer.traceAllMotorcycles(), MotorcycleTracer::SUCCESS);
+        MCBuilder builder(meshProps);
+        ASSERT_EQ(builder.discoverBlocks(), MCBuilder::SUCCESS);
+
+        LOG(INFO) << builder.nToroidalBlocks() << " toroidal and " << builder.nSelfadjacentBlocks()
+                  << " selfadjacent blocks";
+        assertBatchMatchesSingle(&BlockData::toroidal,
+                                 &MotorcycleSpawner::spawnTorusSplitMotorcycle,
+                                 &MotorcycleSpawner::spawnTorusSplitMotorcycles);
+        assertBatchMatchesSingle(&BlockData::selfadjacent,
+                                 &MotorcycleSpawner::spawnSelfadjacencySplitMotorcycle,
+                                 &MotorcycleSpawner::spawnSelfadjacencySplitMotorcycles);
+    }
+};
+
 TEST_P(MotorcycleSpawningFailureTest, ItFails)
 {
     run();
@@ -119,3 +211,14 @@ INSTANTIATE_TEST_SUITE_P(ForEachValidDequantizedModel,
 INSTANTIATE_TEST_SUITE_P(ForEachValidAlgohexModel,
                          MotorcycleSpawningSuccessTest,
                          ::testing::ValuesIn(algohexModelNames));
+
+TEST_P(MotorcycleBatchSpawningTest, ItSpawnsTheSameMotorcyclesPerBlock)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, MotorcycleBatchSpawningTest, ::testing::ValuesIn(minimalModelNames));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         MotorcycleBatchSpawningTest,
+                         ::testing::ValuesIn(quantizedModelNames));
@@ -5,6 +5,7 @@
 #include "MC3D/Algorithm/MotorcycleTracer.hpp"
 #include "MC3D/Algorithm/MCBuilder.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
 #include <vector>
@@ -24,14 +25,7 @@ class MotorcycleTracingTest : public FullToolChainTest
         ASSERT_EQ(init.initSingularities(), SingularityInitializer::SUCCESS);
         ASSERT_EQ(init.makeFeaturesConsistent(), SingularityInitializer::SUCCESS);
 
-        meshProps.allocate<IS_WALL>();
-        for (FH f : meshRaw.faces())
-            if (meshRaw.is_boundary(f))
-                meshProps.set<IS_WALL>(f, true);
-        meshProps.allocate<WALL_DIST>();
-        meshProps.allocate<CHILD_CELLS>();
-        meshProps.allocate<CHILD_EDGES>();
-        meshProps.allocate<CHILD_FACES>();
+        allocateTracingProps(meshProps);
 
         ASSERT_TRUE(meshProps.isAllocated<CHART>());
         ASSERT_TRUE(meshProps.isAllocated<CHILD_EDGES>());
@@ -44,6 +38,18 @@ class MotorcycleTracingTest : public FullToolChainTest
         ASSERT_EQ(spawner.spawnSingularityMotorcycles(), MotorcycleSpawner::SUCCESS);
     }
 
+    void allocateTracingProps(TetMeshProps& mp)
+    {
+        mp.allocate<IS_WALL>();
+        for (FH f : mp.mesh().faces())
+            if (mp.mesh().is_boundary(f))
+                mp.set<IS_WALL>(f, true);
+        mp.allocate<WALL_DIST>();
+        mp.allocate<CHILD_CELLS>();
+        mp.allocate<CHILD_EDGES>();
+        mp.allocate<CHILD_FACES>();
+    }
+
     SingularityInitializer init;
     MotorcycleQueue mQ;
     MotorcycleSpawner spawner;
@@ -100,12 +106,113 @@ class MotorcycleTracingSuccessTest : public MotorcycleTracingTest
             ASSERT_EQ(tracer.traceNextMotorcycle(), MotorcycleTracer::SUCCESS);
         }
         if (isQuantized())
+        {
+            ASSERT_EQ(nTetsPre, meshRaw.n_cells());
+        }
+        assertValidCharts();
+        assertValidTransitions();
+        assertValidSingularities();
+        assertValidWalls();
+        ASSERT_EQ(MCBuilder(meshProps).discoverBlocks(), MCBuilder::SUCCESS);
+    }
+};
+
+class MotorcycleTracingWavefrontTest : public MotorcycleTracingTest
+{
+  protected:
+    void run()
+    {
+        size_t nTetsPre = meshRaw.n_cells();
+        MotorcycleTracer wavefrontTracer(meshProps, mQ, false, true);
+        while (!mQ.empty())
+        {
+            Q dist = mQ.top().dist;
+            ASSERT_EQ(wavefrontTracer.traceNextWavefront(), MotorcycleTracer::SUCCESS);
+            // Followups of the wavefront are queued behind it
+            ASSERT_TRUE(mQ.empty() || mQ.top().dist >= dist);
+        }
+        if (isQuantized())
+        {
             ASSERT_EQ(nTetsPre, meshRaw.n_cells());
+        }
         assertValidCharts();
         assertValidTransitions();
         assertValidSingularities();
         assertValidWalls();
         ASSERT_EQ(MCBuilder(meshProps).discoverBlocks(), MCBuilder::SUCCESS);
+
+        // Tracing motorcycle by motorcycle has to yield the same blocks
+        TetMesh meshRawRef;
+        MCMesh mcMeshRawRef;
+        TetMeshProps meshPropsRef(meshRawRef, mcMeshRawRef);
+        ASSERT_EQ(Reader(meshPropsRef, inputFile()).readSeamlessParam(), Reader::SUCCESS);
+        SingularityInitializer initRef(meshPropsRef);
+        ASSERT_EQ(initRef.initTransitions(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(initRef.initSingularities(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(initRef.makeFeaturesConsistent(), SingularityInitializer::SUCCESS);
+        allocateTracingProps(meshPropsRef);
+        MotorcycleQueue mQRef;
+        ASSERT_EQ(MotorcycleSpawner(meshPropsRef, mQRef).spawnSingularityMotorcycles(), MotorcycleSpawner::SUCCESS);
+        ASSERT_EQ(MotorcycleTracer(meshPropsRef, mQRef).traceAllMotorcycles(), MotorcycleTracer::SUCCESS);
+        ASSERT_EQ(MCBuilder(meshPropsRef).discoverBlocks(), MCBuilder::SUCCESS);
+        ASSERT_EQ(meshProps.ref<MC_BLOCK_DATA>().size(), meshPropsRef.ref<MC_BLOCK_DATA>().size());
+
+        // Wall priority decides which motorcycle stops which, so the walls and blocks themselves have to match.
+        // Edges may be split in a different order, so only quantized meshes (no splits) can be compared per element
+        if (isQuantized())
+        {
+            ASSERT_EQ(meshRaw.n_faces(), meshRawRef.n_faces());
+            for (FH f : meshRaw.faces())
+                ASSERT_EQ(meshProps.get<IS_WALL>(f), meshPropsRef.get<IS_WALL>(f));
+            auto blockSizes = [](TetMeshProps& props)
+            {
+                vector<size_t> sizes;
+                for (auto& kv : props.ref<MC_BLOCK_DATA>())
+                    sizes.push_back(kv.second.tets.size());
+                std::sort(sizes.begin(), sizes.end());
+                return sizes;
+            };
+            ASSERT_EQ(blockSizes(meshProps), blockSizes(meshPropsRef));
+        }
+        auto blockVolumes = [](TetMeshProps& props)
+        {
+            auto& mesh = props.mesh();
+            vector<double> volumes;
+            for (auto& kv : props.ref<MC_BLOCK_DATA>())
+            {
+                double volume = 0.0;
+                for (CH tet : kv.second.tets)
+                {
+                    auto vs = mesh.get_cell_vertices(tet);
+                    auto a = mesh.vertex(vs[0]);
+                    volume += std::abs(((mesh.vertex(vs[1]) - a) % (mesh.vertex(vs[2]) - a)) | (mesh.vertex(vs[3]) - a))
+                              / 6.0;
+                }
+                volumes.push_back(volume);
+            }
+            std::sort(volumes.begin(), volumes.end());
+            return volumes;
+        };
+        auto wallArea = [](TetMeshProps& props)
+        {
+            auto& mesh = props.mesh();
+            double area = 0.0;
+            for (FH f : mesh.faces())
+                if (props.get<IS_WALL>(f))
+                {
+                    auto vs = mesh.get_halfface_vertices(mesh.halfface_handle(f, 0));
+                    auto a = mesh.vertex(vs[0]);
+                    area += ((mesh.vertex(vs[1]) - a) % (mesh.vertex(vs[2]) - a)).norm() / 2.0;
+                }
+            return area;
+        };
+        auto volumes = blockVolumes(meshProps);
+        auto volumesRef = blockVolumes(meshPropsRef);
+        ASSERT_EQ(volumes.size(), volumesRef.size());
+        for (size_t i = 0; i < volumes.size(); i++)
+            ASSERT_NEAR(volumes[i], volumesRef[i], 1e-9 * std::max(1.0, volumesRef.back()));
+        double area = wallArea(meshPropsRef);
+        ASSERT_NEAR(wallArea(meshProps), area, 1e-9 * std::max(1.0, area));
     }
 };
 
@@ -138,3 +245,58 @@ INSTANTIATE_TEST_SUITE_P(ForEachValidDequantizedModel,
 INSTANTIATE_TEST_SUITE_P(ForEachValidAlgohexModel,
                          MotorcycleTracingSuccessTest,
                          ::testing::ValuesIn(algohexModelNames));
+
+TEST_P(MotorcycleTracingWavefrontTest, ItMatchesSequentialTracing)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel,
+                         MotorcycleTracingWavefrontTest,
+                         ::testing::ValuesIn(minimalModelNames));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         MotorcycleTracingWavefrontTest,
+                         ::testing::ValuesIn(quantizedModelNames));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidDequantizedModel,
+                         MotorcycleTracingWavefrontTest,
+                         ::testing::ValuesIn(dequantizedModelNames));
+
+TEST(MotorcycleQueueTest, PopsByExactDistanceThenFIFO)
+{
+    // Distances whose double representations coincide but which differ as rationals
+    Q base(1, 3);
+    Q tiny(1, 1);
+    mpq_div_2exp(tiny.get_mpq_t(), tiny.get_mpq_t(), 100);
+    ASSERT_EQ(Q(base + tiny).get_d(), base.get_d());
+
+    MotorcycleQueue mQ;
+    vector<size_t> ids;
+    auto pushDist = [&mQ, &ids](const Q& dist)
+    {
+        Motorcycle mot(CH(0), EH(0), Vec3i(1, 2, 0), 0, 0, dist, dist);
+        ids.push_back(mot.ID);
+        mQ.push(mot);
+    };
+    for (const Q& dist : {Q(base + tiny), base, Q(2), base, Q(0), Q(base - tiny)})
+        pushDist(dist);
+    ASSERT_EQ(mQ.size(), 6u);
+
+    auto expectTopAndPop = [&mQ, &ids](size_t i)
+    {
+        ASSERT_FALSE(mQ.empty());
+        EXPECT_EQ(mQ.top().ID, ids[i]);
+        mQ.pop();
+    };
+    expectTopAndPop(4);
+    expectTopAndPop(5);
+    expectTopAndPop(1);
+    // Reuses a freed slot, must still be ordered after the older motorcycle of equal distance
+    pushDist(base);
+    expectTopAndPop(3);
+    expectTopAndPop(6);
+    expectTopAndPop(0);
+    expectTopAndPop(2);
+    EXPECT_TRUE(mQ.empty());
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <TS3D/helpers.h>
+
+#include <random>
+
+class TS3DEliminationTest : public ::testing::TestWithParam<int>
+{
+  protected:
+    /**
+     * @brief Build a fixed sparse constraint matrix that resembles the sector constraints of TrulySeamless3D:
+     *        few entries of +-1 per row, plus rows that are combinations of earlier ones (so zero rows occur).
+     *
+     * @param seed IN: seed of the pseudo random generator
+     * @return SparseMatrixi constraint matrix
+     */
+    SparseMatrixi constraintMatrix(int seed)
+    {
+        const int nRows = 60;
+        const int nCols = 90;
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> col(0, nCols - 1);
+        std::uniform_int_distribution<int> sign(0, 1);
+
+        vector<vector<int>> rows;
+        for (int i = 0; i < nRows; i++)
+        {
+            vector<int> row(nCols, 0);
+            if (i % 5 == 4)
+                for (int j = 0; j < nCols; j++)
+                    row[j] = rows[i - 1][j] - rows[i - 3][j];
+            else
+                for (int n = 0; n < 4; n++)
+                    row[col(rng)] = sign(rng) ? 1 : -1;
+            rows.push_back(row);
+        }
+
+        vector<Triplet<int>> triplets;
+        for (int i = 0; i < nRows; i++)
+            for (int j = 0; j < nCols; j++)
+                if (rows[i][j] != 0)
+                    triplets.emplace_back(i, j, rows[i][j]);
+        SparseMatrixi C(nRows, nCols);
+        C.setFromTriplets(triplets.begin(), triplets.end());
+        return C;
+    }
+};
+
+TEST_P(TS3DEliminationTest, SparseMatchesDenseReduction)
+{
+    SparseMatrixi C = constraintMatrix(GetParam());
+    double time = 0.0;
+
+    // Seamlessness constraints are homogeneous, so b is only checked to stay zero
+    SparseMatrixi CDense = C;
+    VectorXd bDense = VectorXd::Zero(C.rows());
+    VectorXi indexCDense, indexRDense;
+    IREF(CDense, bDense, indexCDense, indexRDense, true, time);
+    IRREF(CDense, bDense, indexCDense, true, time);
+
+    SparseMatrixi CSparse = C;
+    VectorXd bSparse = VectorXd::Zero(C.rows());
+    VectorXi indexCSparse, indexRSparse;
+    sparseIRREF(CSparse, bSparse, indexCSparse, indexRSparse, time);
+
+    ASSERT_TRUE(bSparse.isZero());
+    ASSERT_EQ(indexCSparse, indexCDense);
+    ASSERT_EQ(indexRSparse, indexRDense);
+
+    // The reduced row echelon form is unique up to the scaling of each row
+    for (int i = 0; i < C.rows(); i++)
+    {
+        if (indexCDense(i) == -1)
+        {
+            ASSERT_EQ(CSparse.row(i).nonZeros(), 0);
+            continue;
+        }
+        int pivotDense = CDense.coeff(i, indexCDense(i));
+        int pivotSparse = CSparse.coeff(i, indexCSparse(i));
+        ASSERT_NE(pivotSparse, 0);
+        for (int j = 0; j < C.cols(); j++)
+            ASSERT_EQ((int64_t)CSparse.coeff(i, j) * pivotDense, (int64_t)CDense.coeff(i, j) * pivotSparse);
+    }
+}
+
+TEST_P(TS3DEliminationTest, SparseKeepsRightHandSideConsistent)
+{
+    SparseMatrixi C = constraintMatrix(GetParam());
+    double time = 0.0;
+
+    // b = C * x for an integer x, so the reduced system has to be satisfied by x as well
+    std::mt19937 rng(GetParam());
+    std::uniform_int_distribution<int> value(-20, 20);
+    VectorXd x(C.cols());
+    for (int j = 0; j < C.cols(); j++)
+        x(j) = value(rng);
+    VectorXd b = C.cast<double>() * x;
+    ASSERT_FALSE(b.isZero());
+
+    VectorXi indexC, indexR;
+    sparseIRREF(C, b, indexC, indexR, time);
+    ASSERT_EQ(C.cast<double>() * x, b);
+}
+
+INSTANTIATE_TEST_SUITE_P(ForFixedSeeds, TS3DEliminationTest, ::testing::Values(1, 2, 3, 4, 5));
+
+TEST(TS3DEliminationOverflowTest, SparseFallsBackToArbitraryPrecision)
+{
+    // Rows are combinations of the rows of R with coefficients of about 1e8. The reduced row echelon form is R,
+    // but eliminating the first column yields primitive rows with coefficients of about 1e16.
+    const int R[3][4] = {{1, 0, 0, 2}, {0, 1, 0, -3}, {0, 0, 1, 5}};
+    const int U[4][3] = {{100000007, 99999989, 99999971},
+                         {99999959, 100000037, 99999941},
+                         {100000039, 99999931, 100000049},
+                         {199999966, 200000026, 199999912}};
+    vector<Triplet<int>> triplets;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+        {
+            int Cij = U[i][0] * R[0][j] + U[i][1] * R[1][j] + U[i][2] * R[2][j];
+            if (Cij != 0)
+                triplets.emplace_back(i, j, Cij);
+        }
+    SparseMatrixi C(4, 4);
+    C.setFromTriplets(triplets.begin(), triplets.end());
+    VectorXd x(4);
+    x << 3, -1, 4, 1;
+    VectorXd b = C.cast<double>() * x;
+    double time = 0.0;
+
+    // The int-checked dense elimination overflows on this matrix
+    SparseMatrixi CDense = C;
+    VectorXd bDense = b;
+    VectorXi indexCDense, indexRDense;
+    ASSERT_THROW(IREF(CDense, bDense, indexCDense, indexRDense, true, time), std::runtime_error);
+
+    VectorXi indexC, indexR;
+    sparseIRREF(C, b, indexC, indexR, time);
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(indexC(i), i);
+        int pivot = C.coeff(i, i);
+        ASSERT_EQ(std::abs(pivot), 1);
+        for (int j = 0; j < 4; j++)
+            ASSERT_EQ(C.coeff(i, j) * pivot, R[i][j]);
+    }
+    ASSERT_EQ(indexC(3), -1);
+    ASSERT_EQ(C.row(3).nonZeros(), 0);
+    ASSERT_EQ(C.cast<double>() * x, b);
+}
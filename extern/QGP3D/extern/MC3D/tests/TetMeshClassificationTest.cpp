@@ -0,0 +1,101 @@
+#include "./TestUtils.hpp"
+
+#include "MC3D/Algorithm/SingularityInitializer.hpp"
+#include "MC3D/Algorithm/MCBuilder.hpp"
+#include "MC3D/Algorithm/MCReducer.hpp"
+#include "MC3D/Mesh/TetMeshManipulator.hpp"
+
+class TetMeshClassificationTest : public FullToolChainTest
+{
+  public:
+    TetMeshClassificationTest() : FullToolChainTest(), init(meshProps), builder(meshProps)
+    {
+    }
+
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(reader.readSeamlessParamWithWalls(), Reader::SUCCESS);
+        ASSERT_EQ(init.initTransitions(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(init.initSingularities(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(init.makeFeaturesConsistent(), SingularityInitializer::SUCCESS);
+        // Populate the cache before the MC exists, so that building the MC has to invalidate it
+        meshProps.updateClassification();
+        ASSERT_EQ(builder.discoverBlocks(), MCBuilder::SUCCESS);
+        ASSERT_EQ(builder.connectMCMesh(true, true), MCBuilder::SUCCESS);
+    }
+
+    void assertClassificationConsistent()
+    {
+        meshProps.updateClassification();
+        ASSERT_TRUE(meshProps.isClassificationUpToDate());
+        ASSERT_TRUE(meshProps.isClassificationConsistent());
+    }
+
+    SingularityInitializer init;
+    MCBuilder builder;
+};
+
+class TetMeshClassificationSuccessTest : public TetMeshClassificationTest
+{
+  protected:
+    void run()
+    {
+        MCMeshProps& mcMeshProps = *meshProps.get<MC_MESH_PROPS>();
+        assertClassificationConsistent();
+        for (VH n : mcMeshRaw.vertices())
+            ASSERT_TRUE(meshProps.isNode(mcMeshProps.get<NODE_MESH_VERTEX>(n)));
+
+        // Refinement and collapses have to reclassify the modified neighborhood
+        TetMeshManipulator tetManipulator(meshProps);
+        CH b = *mcMeshRaw.cells().first;
+        tetManipulator.splitTet(*mcMeshProps.ref<BLOCK_MESH_TETS>(b).begin(), Vec4Q(Q(1, 4), Q(1, 4), Q(1, 4), Q(1, 4)));
+        assertClassificationConsistent();
+
+        FH p = *mcMeshRaw.faces().first;
+        FH f = meshRaw.face_handle(*mcMeshProps.ref<PATCH_MESH_HALFFACES>(p).begin());
+        VH vF = tetManipulator.splitFace(f, Vec3Q(Q(1, 3), Q(1, 3), Q(1, 3)));
+        ASSERT_TRUE(meshProps.isInPatch(vF));
+        assertClassificationConsistent();
+
+        EH a = *mcMeshRaw.edges().first;
+        HEH he = mcMeshProps.ref<ARC_MESH_HALFEDGES>(a).front();
+        VH vA = tetManipulator.splitHalfEdge(he, *meshRaw.hec_iter(he), Q(1, 2));
+        ASSERT_TRUE(meshProps.isInArc(vA));
+        ASSERT_TRUE(meshProps.isInPatch(vA));
+        assertClassificationConsistent();
+
+        HEH heCollapse = mcMeshProps.ref<ARC_MESH_HALFEDGES>(a).front();
+        if (meshRaw.to_vertex_handle(heCollapse) == vA)
+            heCollapse = meshRaw.opposite_halfedge_handle(heCollapse);
+        if (tetManipulator.collapseValid(heCollapse, true, false))
+        {
+            tetManipulator.collapseHalfEdge(heCollapse);
+            assertClassificationConsistent();
+        }
+
+        // Merges performed by the reducer rewrite the patch and arc mapping
+        reducer.init(false, true, true);
+        while (reducer.isReducible())
+            reducer.removeNextPatch();
+        assertClassificationConsistent();
+
+        meshProps.clearMC();
+        assertClassificationConsistent();
+        for (VH v : meshRaw.vertices())
+            ASSERT_FALSE(meshProps.isNode(v));
+    }
+};
+
+TEST_P(TetMeshClassificationSuccessTest, ItTracksModifications)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel,
+                         TetMeshClassificationSuccessTest,
+                         ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         TetMeshClassificationSuccessTest,
+                         ::testing::ValuesIn(quantizedModelNamesOut));
@@ -0,0 +1,316 @@
+#include "./TestUtils.hpp"
+
+#include "MC3D/Algorithm/SingularityInitializer.hpp"
+#include "MC3D/Algorithm/MCBuilder.hpp"
+#include "MC3D/Mesh/TetMeshManipulator.hpp"
+
+class TetMeshManipulatorTest : public FullToolChainTest
+{
+  public:
+    TetMeshManipulatorTest()
+        : FullToolChainTest(), meshPropsRef(meshRawRef, mcMeshRawRef), readerRef(meshPropsRef, inputFile())
+    {
+    }
+
+  protected:
+    void SetUp() override
+    {
+        buildMC(reader, meshProps);
+        buildMC(readerRef, meshPropsRef);
+    }
+
+    void buildMC(Reader& r, TetMeshProps& mp)
+    {
+        SingularityInitializer init(mp);
+        MCBuilder builder(mp);
+        ASSERT_EQ(r.readSeamlessParamWithWalls(), Reader::SUCCESS);
+        ASSERT_EQ(init.initTransitions(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(init.initSingularities(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(init.makeFeaturesConsistent(), SingularityInitializer::SUCCESS);
+        ASSERT_EQ(builder.discoverBlocks(), MCBuilder::SUCCESS);
+        ASSERT_EQ(builder.connectMCMesh(true, true), MCBuilder::SUCCESS);
+    }
+
+    TetMesh meshRawRef;
+    MCMesh mcMeshRawRef;
+    TetMeshProps meshPropsRef;
+    Reader readerRef;
+};
+
+class TetMeshSplitAllTest : public TetMeshManipulatorTest
+{
+  protected:
+    void run()
+    {
+        // Split all edges of some tets (so that tets are split repeatedly) and some patch faces
+        set<EH> es;
+        set<FH> fs;
+        for (CH tet : meshRaw.cells())
+        {
+            if (tet.idx() % 50 == 0)
+                for (EH e : meshRaw.cell_edges(tet))
+                    es.insert(e);
+        }
+        for (FH f : meshRaw.faces())
+            if (f.idx() % 20 == 0 && meshProps.isInPatch(f))
+                fs.insert(f);
+
+        TetMeshManipulator manipulator(meshProps);
+        int nSplits = manipulator.splitAll(es, fs);
+
+        TetMeshManipulator manipulatorRef(meshPropsRef);
+        int nSplitsRef = 0;
+        for (EH e : es)
+        {
+            manipulatorRef.splitHalfEdge(meshRawRef.halfedge_handle(e, 0), *meshRawRef.ec_iter(e), Q(1, 2));
+            nSplitsRef++;
+        }
+        for (FH f : fs)
+            if (!meshRawRef.is_deleted(f))
+            {
+                manipulatorRef.splitFace(f, {Q(1, 3), Q(1, 3), Q(1, 3)});
+                nSplitsRef++;
+            }
+        ASSERT_EQ(nSplits, nSplitsRef);
+
+        ASSERT_EQ(meshRaw.n_vertices(), meshRawRef.n_vertices());
+        ASSERT_EQ(meshRaw.n_cells(), meshRawRef.n_cells());
+        for (CH tet : meshRaw.cells())
+        {
+            ASSERT_FALSE(meshRawRef.is_deleted(tet));
+            ASSERT_EQ(meshProps.ref<CHART>(tet), meshPropsRef.ref<CHART>(tet));
+        }
+
+        const MCMeshProps& mcMeshProps = *meshProps.get<MC_MESH_PROPS>();
+        const MCMeshProps& mcMeshPropsRef = *meshPropsRef.get<MC_MESH_PROPS>();
+        for (CH b : mcMeshRaw.cells())
+            ASSERT_EQ(mcMeshProps.ref<BLOCK_MESH_TETS>(b), mcMeshPropsRef.ref<BLOCK_MESH_TETS>(b));
+        for (FH p : mcMeshRaw.faces())
+            ASSERT_EQ(mcMeshProps.ref<PATCH_MESH_HALFFACES>(p), mcMeshPropsRef.ref<PATCH_MESH_HALFFACES>(p));
+        for (EH a : mcMeshRaw.edges())
+            ASSERT_EQ(mcMeshProps.ref<ARC_MESH_HALFEDGES>(a), mcMeshPropsRef.ref<ARC_MESH_HALFEDGES>(a));
+
+        assertValidMC(false);
+    }
+};
+
+TEST_P(TetMeshSplitAllTest, ItMatchesSequentialSplits)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, TetMeshSplitAllTest, ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         TetMeshSplitAllTest,
+                         ::testing::ValuesIn(quantizedModelNamesOut));
+
+class TetMeshSplitAllCutsTest : public TetMeshManipulatorTest
+{
+  protected:
+    void run()
+    {
+        // Cut edges of some tets once or twice (so that subedges and tets are split repeatedly)
+        map<EH, set<Q>> eCuts;
+        for (CH tet : meshRaw.cells())
+            if (tet.idx() % 50 == 0)
+                for (EH e : meshRaw.cell_edges(tet))
+                {
+                    if (e.idx() % 2 == 0)
+                        eCuts[e] = {Q(1, 3), Q(3, 4)};
+                    else
+                        eCuts[e] = {Q(2, 5)};
+                }
+
+        TetMeshManipulator manipulator(meshProps);
+        int nSplits = manipulator.splitAll(eCuts);
+
+        TetMeshManipulator manipulatorRef(meshPropsRef);
+        int nSplitsRef = 0;
+        for (auto& [e, ts] : eCuts)
+        {
+            HEH he = meshRawRef.halfedge_handle(e, 0);
+            VH vD = meshRawRef.to_vertex_handle(he);
+            Q tPrev = 0;
+            for (const Q& t : ts)
+            {
+                VH vN = manipulatorRef.splitHalfEdge(he, *meshRawRef.hec_iter(he), (t - tPrev) / (1 - tPrev));
+                he = meshRawRef.find_halfedge(vN, vD);
+                tPrev = t;
+                nSplitsRef++;
+            }
+        }
+        ASSERT_EQ(nSplits, nSplitsRef);
+
+        ASSERT_EQ(meshRaw.n_vertices(), meshRawRef.n_vertices());
+        ASSERT_EQ(meshRaw.n_cells(), meshRawRef.n_cells());
+        for (CH tet : meshRaw.cells())
+        {
+            ASSERT_FALSE(meshRawRef.is_deleted(tet));
+            ASSERT_EQ(meshProps.ref<CHART>(tet), meshPropsRef.ref<CHART>(tet));
+        }
+
+        const MCMeshProps& mcMeshProps = *meshProps.get<MC_MESH_PROPS>();
+        const MCMeshProps& mcMeshPropsRef = *meshPropsRef.get<MC_MESH_PROPS>();
+        for (EH a : mcMeshRaw.edges())
+            ASSERT_EQ(mcMeshProps.ref<ARC_MESH_HALFEDGES>(a), mcMeshPropsRef.ref<ARC_MESH_HALFEDGES>(a));
+
+        assertValidMC(false);
+    }
+};
+
+TEST_P(TetMeshSplitAllCutsTest, ItMatchesSequentialSplits)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, TetMeshSplitAllCutsTest, ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         TetMeshSplitAllCutsTest,
+                         ::testing::ValuesIn(quantizedModelNamesOut));
+
+class TetMeshSnapshotTest : public TetMeshManipulatorTest
+{
+  protected:
+    void run()
+    {
+        // Lazy snapshots of the original charts and transitions vs. explicit deep copies
+        meshProps.takeSnapshot<CHART_ORIG>();
+        meshProps.takeSnapshot<TRANSITION_ORIG>();
+        meshPropsRef.release<TRANSITION_ORIG>();
+        meshPropsRef.allocate<CHART_ORIG>();
+        meshPropsRef.allocate<TRANSITION_ORIG>();
+        for (CH tet : meshRawRef.cells())
+            meshPropsRef.set<CHART_ORIG>(tet, meshPropsRef.ref<CHART>(tet));
+        for (FH f : meshRawRef.faces())
+            meshPropsRef.set<TRANSITION_ORIG>(f, meshPropsRef.get<TRANSITION>(f));
+
+        // Modify some current charts and transitions, then split some edges and patch faces
+        for (TetMeshProps* mp : {&meshProps, &meshPropsRef})
+        {
+            for (CH tet : mp->mesh().cells())
+                if (tet.idx() % 7 == 0)
+                    for (auto& kv : mp->ref<CHART>(tet))
+                        kv.second += Vec3Q(1, 0, 0);
+            for (FH f : mp->mesh().faces())
+                if (f.idx() % 11 == 0)
+                    mp->reset<TRANSITION>(f);
+        }
+        set<EH> es;
+        set<FH> fs;
+        for (CH tet : meshRaw.cells())
+            if (tet.idx() % 50 == 0)
+                for (EH e : meshRaw.cell_edges(tet))
+                    es.insert(e);
+        for (FH f : meshRaw.faces())
+            if (f.idx() % 20 == 0 && meshProps.isInPatch(f))
+                fs.insert(f);
+        for (TetMeshProps* mp : {&meshProps, &meshPropsRef})
+        {
+            TetMeshManipulator manipulator(*mp);
+            for (EH e : es)
+                manipulator.splitHalfEdge(mp->mesh().halfedge_handle(e, 0), *mp->mesh().ec_iter(e), Q(1, 2));
+            for (FH f : fs)
+                if (!mp->mesh().is_deleted(f))
+                    manipulator.splitFace(f, {Q(1, 3), Q(1, 3), Q(1, 3)});
+        }
+
+        // Read through const accessors, which never detach snapshot elements
+        const TetMeshProps& props = meshProps;
+        ASSERT_EQ(meshRaw.n_cells(), meshRawRef.n_cells());
+        int nShared = 0;
+        for (CH tet : meshRaw.cells())
+        {
+            ASSERT_EQ(props.ref<CHART_ORIG>(tet), meshPropsRef.ref<CHART_ORIG>(tet));
+            ASSERT_EQ(props.ref<CHART>(tet), meshPropsRef.ref<CHART>(tet));
+            if (props.isSnapshotShared<CHART_ORIG>(tet))
+                nShared++;
+        }
+        ASSERT_GT(nShared, 0);
+        for (FH f : meshRaw.faces())
+            ASSERT_EQ(props.get<TRANSITION_ORIG>(f), meshPropsRef.get<TRANSITION_ORIG>(f));
+
+        // Releasing the current charts materializes all shared original charts
+        meshProps.release<CHART>();
+        ASSERT_FALSE(props.isSnapshotShared<CHART_ORIG>(*meshRaw.cells().first));
+        for (CH tet : meshRaw.cells())
+            ASSERT_EQ(props.ref<CHART_ORIG>(tet), meshPropsRef.ref<CHART_ORIG>(tet));
+    }
+};
+
+TEST_P(TetMeshSnapshotTest, ItMatchesDeepCopies)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, TetMeshSnapshotTest, ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         TetMeshSnapshotTest,
+                         ::testing::ValuesIn(quantizedModelNamesOut));
+
+class TetMeshSplitTetTest : public TetMeshManipulatorTest
+{
+  protected:
+    void run()
+    {
+        // Give the original and IGM charts values that differ from the current charts
+        meshProps.takeSnapshot<CHART_ORIG>();
+        meshProps.allocate<CHART_IGM>();
+        for (CH tet : meshRaw.cells())
+        {
+            if (tet.idx() % 7 == 0)
+                for (auto& kv : meshProps.ref<CHART>(tet))
+                    kv.second += Vec3Q(1, 0, 0);
+            for (auto& kv : meshProps.ref<CHART>(tet))
+                meshProps.ref<CHART_IGM>(tet)[kv.first] = kv.second + kv.second + Vec3Q(0, 0, 1);
+        }
+
+        vector<CH> tets;
+        for (CH tet : meshRaw.cells())
+            if (tet.idx() % 50 == 0)
+                tets.push_back(tet);
+
+        // Each chart of the new vertex has to be interpolated from the same chart of the split tet
+        const TetMeshProps& props = meshProps;
+        TetMeshManipulator manipulator(meshProps);
+        Vec4Q barCoords(Q(1, 2), Q(1, 4), Q(1, 8), Q(1, 8));
+        for (CH tet : tets)
+        {
+            Vec3Q uvw(0, 0, 0);
+            Vec3Q uvwOrig(0, 0, 0);
+            Vec3Q igm(0, 0, 0);
+            int i = 0;
+            for (VH v : meshRaw.tet_vertices(tet))
+            {
+                uvw += barCoords[i] * props.ref<CHART>(tet).at(v);
+                uvwOrig += barCoords[i] * props.ref<CHART_ORIG>(tet).at(v);
+                igm += barCoords[i] * props.ref<CHART_IGM>(tet).at(v);
+                i++;
+            }
+            ASSERT_NE(uvw, igm);
+
+            VH vN = manipulator.splitTet(tet, barCoords);
+            for (CH child : meshRaw.vertex_cells(vN))
+            {
+                ASSERT_EQ(props.ref<CHART>(child).at(vN), uvw);
+                ASSERT_EQ(props.ref<CHART_ORIG>(child).at(vN), uvwOrig);
+                ASSERT_EQ(props.ref<CHART_IGM>(child).at(vN), igm);
+            }
+        }
+
+        assertValidMC(false);
+    }
+};
+
+TEST_P(TetMeshSplitTetTest, ItInterpolatesEachChart)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, TetMeshSplitTetTest, ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel,
+                         TetMeshSplitTetTest,
+                         ::testing::ValuesIn(quantizedModelNamesOut));
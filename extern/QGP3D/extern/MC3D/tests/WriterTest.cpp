@@ -0,0 +1,124 @@
+#include "./TestUtils.hpp"
+
+#include <fstream>
+#include <limits>
+
+class WriterTest : public FullToolChainTest
+{
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(reader.readSeamlessParamWithWalls(), Reader::SUCCESS);
+    }
+
+    std::string tmpFile(bool exact, bool binary)
+    {
+        return ::testing::TempDir() + GetParam() + (exact ? "_exact" : "_double") + (binary ? "_bin" : "_txt")
+               + fileExt();
+    }
+
+    void assertRoundTrip(bool exact, bool binary)
+    {
+        std::string file = tmpFile(exact, binary);
+        ASSERT_EQ(Writer(meshProps, file, exact, binary).writeSeamlessParamAndWalls(), Writer::SUCCESS);
+
+        std::ifstream is(file, std::ios::binary);
+        char magic[sizeof(Writer::BINARY_MAGIC)] = {};
+        is.read(magic, sizeof(magic));
+        ASSERT_EQ(std::equal(magic, magic + sizeof(magic), Writer::BINARY_MAGIC), binary);
+
+        TetMesh meshRawRead;
+        MCMesh mcMeshRawRead;
+        TetMeshProps meshPropsRead(meshRawRead, mcMeshRawRead);
+        ASSERT_EQ(Reader(meshPropsRead, file).readSeamlessParamWithWalls(), Reader::SUCCESS);
+
+        ASSERT_EQ(meshRawRead.n_vertices(), meshRaw.n_vertices());
+        ASSERT_EQ(meshRawRead.n_cells(), meshRaw.n_cells());
+        for (VH v : meshRaw.vertices())
+            ASSERT_EQ(meshRawRead.vertex(v), meshRaw.vertex(v));
+        for (CH tet : meshRaw.cells())
+            for (const auto& kv : meshProps.ref<CHART>(tet))
+                for (int i = 0; i < 3; i++)
+                {
+                    const Q& read = meshPropsRead.ref<CHART>(tet).at(kv.first)[i];
+                    if (exact)
+                        ASSERT_EQ(read, kv.second[i]);
+                    else
+                        ASSERT_EQ(read.get_d(), kv.second[i].get_d());
+                }
+        // Faces may be enumerated in a different order after reading, so match them by their vertices
+        for (FH f : meshRaw.faces())
+        {
+            auto vs = meshRaw.get_halfface_vertices(meshRaw.halfface_handle(f, 0));
+            FH fRead = meshRawRead.face_handle(meshRawRead.find_halfface({vs[0], vs[1], vs[2]}));
+            ASSERT_TRUE(fRead.is_valid());
+            ASSERT_EQ(meshPropsRead.get<IS_WALL>(fRead), meshProps.get<IS_WALL>(f));
+            ASSERT_EQ(meshPropsRead.get<WALL_DIST>(fRead), meshProps.get<WALL_DIST>(f));
+        }
+
+        // The binary encoding marks its wall section, so it can be skipped when reading without walls
+        if (binary)
+        {
+            TetMesh meshRawNoWalls;
+            MCMesh mcMeshRawNoWalls;
+            TetMeshProps meshPropsNoWalls(meshRawNoWalls, mcMeshRawNoWalls);
+            ASSERT_EQ(Reader(meshPropsNoWalls, file).readSeamlessParam(), Reader::SUCCESS);
+            ASSERT_FALSE(meshPropsNoWalls.isAllocated<IS_WALL>());
+            ASSERT_EQ(meshRawNoWalls.n_cells(), meshRaw.n_cells());
+        }
+    }
+};
+
+class WriterRoundTripTest : public WriterTest
+{
+  protected:
+    void run()
+    {
+        for (bool exact : {true, false})
+            for (bool binary : {false, true})
+                assertRoundTrip(exact, binary);
+    }
+};
+
+TEST_P(WriterRoundTripTest, ItReadsBackWhatItWrote)
+{
+    run();
+}
+
+class WriterCorruptCountTest : public WriterTest
+{
+  protected:
+    void run()
+    {
+        std::string file = tmpFile(false, true);
+        ASSERT_EQ(Writer(meshProps, file, false, true).writeSeamlessParamAndWalls(), Writer::SUCCESS);
+
+        // The vertex count directly follows the magic and the flag word. Neither a count that overflows int nor
+        // one that needs more bytes than the whole file may be accepted (or allocated for).
+        std::streamoff countPos = sizeof(Writer::BINARY_MAGIC) + sizeof(uint32_t);
+        uint64_t fileSize = std::ifstream(file, std::ios::binary | std::ios::ate).tellg();
+        for (uint64_t count : {uint64_t(std::numeric_limits<int>::max()) + 1, fileSize})
+        {
+            std::fstream fs(file, std::ios::in | std::ios::out | std::ios::binary);
+            fs.seekp(countPos);
+            fs.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            fs.close();
+
+            TetMesh meshRawRead;
+            MCMesh mcMeshRawRead;
+            TetMeshProps meshPropsRead(meshRawRead, mcMeshRawRead);
+            ASSERT_NE(Reader(meshPropsRead, file).readSeamlessParamWithWalls(), Reader::SUCCESS);
+        }
+    }
+};
+
+TEST_P(WriterCorruptCountTest, ItRejectsCountsBeyondTheFile)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, WriterRoundTripTest, ::testing::ValuesIn(minimalModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForEachValidQuantizedModel, WriterRoundTripTest, ::testing::ValuesIn(quantizedModelNamesOut));
+
+INSTANTIATE_TEST_SUITE_P(ForTheMinimalModel, WriterCorruptCountTest, ::testing::ValuesIn(minimalModelNamesOut));
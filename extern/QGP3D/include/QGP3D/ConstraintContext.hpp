@@ -0,0 +1,110 @@
+#ifndef QGP3D_CONSTRAINTCONTEXT_HPP
+#define QGP3D_CONSTRAINTCONTEXT_HPP
+
+#include <MC3D/Mesh/MCMeshNavigator.hpp>
+
+namespace qgp3d
+{
+using namespace mc3d;
+
+/**
+ * @brief Cache of the critical structure of an MC, from which quantization constraints are derived: critical links
+ *        and criticality of nodes, arcs and patches. Per-element data is stored in arrays indexed by MC element index.
+ *        It is shared by the SeparationChecker, the quantizers, the IQP solvers and ConstraintExtractor.
+ *
+ *        All of this only depends on the MC structure, so it is computed on first access and reused until the
+ *        revision of the MC changes (see MCMeshProps::revision()), i.e. until the MC is modified by
+ *        MCMeshManipulator or its singularity/feature tags change. References returned by the accessors are valid
+ *        until the next access after such a change.
+ */
+class ConstraintContext : public virtual MCMeshNavigator
+{
+  public:
+    /**
+     * @brief Create a context for the MC of \p meshProps . Nothing is computed before the first access.
+     *
+     * @param meshProps IN: mesh whose MC to derive the critical structure of
+     */
+    ConstraintContext(const TetMeshProps& meshProps);
+
+    /**
+     * @brief Critical links of the MC (including features), see MCMeshNavigator::getCriticalLinks().
+     *        Their lengths refer to the arc lengths at the time of computation.
+     *
+     * @return const vector<CriticalLink>& critical links
+     */
+    const vector<CriticalLink>& criticalLinks();
+
+    /**
+     * @brief Index of the critical link containing arc \p a
+     *
+     * @param a IN: arc
+     * @return int index into criticalLinks(), -1 if \p a is not critical
+     */
+    int arcCriticalLink(const EH& a);
+
+    /**
+     * @brief Indices of the critical links starting at node \p n (links are directed)
+     *
+     * @param n IN: node
+     * @return const vector<int>& indices into criticalLinks()
+     */
+    const vector<int>& nodeCriticalLinksOut(const VH& n);
+
+    /**
+     * @brief Indices of the critical links ending at node \p n (links are directed)
+     *
+     * @param n IN: node
+     * @return const vector<int>& indices into criticalLinks()
+     */
+    const vector<int>& nodeCriticalLinksIn(const VH& n);
+
+    /**
+     * @brief Per arc: whether it is part of a critical link
+     *
+     * @return const vector<bool>& flags indexed by arc index
+     */
+    const vector<bool>& isCriticalArc();
+
+    /**
+     * @brief Per node: whether it is singular or on a feature
+     *
+     * @return const vector<bool>& flags indexed by node index
+     */
+    const vector<bool>& isCriticalNode();
+
+    /**
+     * @brief Per patch: whether it is on the boundary or a feature
+     *
+     * @return const vector<bool>& flags indexed by patch index
+     */
+    const vector<bool>& isCriticalPatch();
+
+    /**
+     * @brief Whether the cached data matches the current MC
+     *
+     * @return true if no recomputation is needed on the next access
+     * @return false else
+     */
+    bool isUpToDate() const;
+
+  private:
+    /**
+     * @brief Recompute the critical structure, if the MC changed since it was last computed
+     */
+    void update();
+
+    size_t _revision = 0; // Revision of the MC the data was computed for (0 is never handed out)
+
+    vector<CriticalLink> _criticalLinks;       // Critical links of the MC
+    vector<int> _arcCriticalLink;              // Per arc: index of containing critical link or -1
+    vector<vector<int>> _nodeCriticalLinksOut; // Per node: critical links starting at node
+    vector<vector<int>> _nodeCriticalLinksIn;  // Per node: critical links ending at node
+    vector<bool> _isCriticalArc;               // Per arc: whether part of a critical link
+    vector<bool> _isCriticalNode;              // Per node: whether singular or on a feature
+    vector<bool> _isCriticalPatch;             // Per patch: whether on boundary or a feature
+};
+
+} // namespace qgp3d
+
+#endif
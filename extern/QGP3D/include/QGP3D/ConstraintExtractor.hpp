@@ -3,7 +3,10 @@
 
 #include "MC3D/Mesh/MCMeshManipulator.hpp"
 
+#include "QGP3D/ConstraintContext.hpp"
 #include "QGP3D/PathConstraint.hpp"
+
+#include <memory>
 namespace qgp3d
 {
 using namespace mc3d;
@@ -29,6 +32,15 @@ class ConstraintExtractor : public MCMeshNavigator
      */
     ConstraintExtractor(const TetMeshProps& meshProps);
 
+    /**
+     * @brief Creates an instance that manages NodeTree extraction from \p meshProps and takes the critical links
+     *        of the MC from \p ctx instead of recomputing them
+     *
+     * @param meshProps IN: mesh whose singular-node NodeTree to extract
+     * @param ctx IN/OUT: cached critical structure of the MC of \p meshProps
+     */
+    ConstraintExtractor(const TetMeshProps& meshProps, ConstraintContext& ctx);
+
     /**
      * @brief Get the segments of the arc-sceleton connecting all singular links of the MC.
      *        Segments are maximum sequences of (half)arcs connecting 2 (possibly pseudo-)singular
@@ -225,6 +237,8 @@ class ConstraintExtractor : public MCMeshNavigator
         ARTIFICIAL_ON_BOUNDARY
     };
 
+    std::unique_ptr<ConstraintContext> _ownedCtx;   // Context created by this instance, if none was passed
+    ConstraintContext& _ctx;                        // Cached critical structure of the MC
     VH _nRoot;                                      // Root node of dual MC spanning tree
     CH _bRoot;                                      // Root block of dual MC spanning tree
     vector<CH> _cellTreePrecursor;                  // Precursor in dual spanning tree
@@ -1,6 +1,8 @@
 #ifndef QGP3D_CONSTRAINTWRITER_HPP
 #define QGP3D_CONSTRAINTWRITER_HPP
 
+#include "QGP3D/ConstraintContext.hpp"
+
 #include <MC3D/Mesh/TetMeshNavigator.hpp>
 
 #include <fstream>
@@ -36,6 +38,15 @@ class ConstraintWriter : public TetMeshNavigator
      */
     RetCode writeTetPathConstraints();
 
+    /**
+     * @brief Write constraints/paths to specified file, taking the critical structure of the MC from \p ctx
+     *
+     * @param ctx IN/OUT: cached critical structure of the MC, e.g. the one of the SeparationChecker used for
+     *                    quantization
+     * @return RetCode
+     */
+    RetCode writeTetPathConstraints(ConstraintContext& ctx);
+
   private:
     const std::string _fileName;
     std::ofstream _os;
@@ -71,7 +71,7 @@ class BaseIQPSolver
     virtual void enableQuickSolve() = 0;
 
     /**
-     * @brief Switch to exact solving with optimality gap <1e-4
+     * @brief Switch to exact solving with optimality gap <EXACT_GAP
      */
     virtual void enableExactSolve() = 0;
 
@@ -89,6 +89,14 @@ class BaseIQPSolver
      */
     virtual double objectiveValue() const = 0;
 
+    /**
+     * @brief Whether the last solve proved its solution optimal up to the gap of an exact solve (e.g. a quick solve
+     *        that happened to close the gap), so that an exact re-solve of the same problem would be redundant
+     *
+     * @return true if the optimality gap of the last solution is at most EXACT_GAP
+     */
+    virtual bool lastSolveProvedOptimal() const = 0;
+
     /**
      * @brief Use the previous solution as warm start for next solve
      */
@@ -101,6 +109,8 @@ class BaseIQPSolver
     virtual void addConstraints(const vector<vector<pair<int, EH>>>& nonZeroSum) = 0;
 
   protected:
+    static constexpr double EXACT_GAP = 1e-4; // relative optimality gap of exact solves
+
     double _scaling;             // scale target lengths by this factor for quantization
     double _varLowerBound;       // lower bound for arc lengths
     double _maxSeconds;          // time limit for solver in seconds
@@ -14,6 +14,7 @@
 
 #include <MC3D/Mesh/MCMeshManipulator.hpp>
 
+#include "QGP3D/ConstraintContext.hpp"
 #include "QGP3D/IQP/BaseIQPSolver.hpp"
 
 namespace qgp3d
@@ -31,12 +32,14 @@ class BonminIQPSolver : public BaseIQPSolver, public virtual MCMeshManipulator
      * @brief Create new IQP solver instance based on Bonmin
      *
      * @param meshProps IN: mesh whose MC to quantize
+     * @param ctx IN: cached critical structure of the MC (critical links are enforced to be of positive length)
      * @param scaling IN: scale target lengths by this factor for quantization
      * @param varLowerBound IN: lower bound for arc lengths
      * @param maxSeconds IN: time limit for solver in seconds
      * @param individualArcFactor IN: objective = this * <arc-length-deviation> + (1-this) * <block-length-deviation>
      */
     BonminIQPSolver(TetMeshProps& meshProps,
+                    ConstraintContext& ctx,
                     double scaling,
                     double varLowerBound,
                     double maxSeconds = 180,
@@ -54,6 +57,7 @@ class BonminIQPSolver : public BaseIQPSolver, public virtual MCMeshManipulator
     virtual void enableExactSolve();
     virtual BaseIQPSolver::RetCode solve();
     virtual double objectiveValue() const;
+    virtual bool lastSolveProvedOptimal() const;
     virtual void addConstraints(const vector<vector<pair<int, EH>>>& nonZeroSum);
     virtual void useCurrentAsWarmStart();
     ///@}
@@ -261,11 +265,15 @@ class BonminIQPSolver : public BaseIQPSolver, public virtual MCMeshManipulator
         }
     };
 
+    ConstraintContext& _ctx;              // Critical structure of the MC, shared with the quantizer
     Ipopt::SmartPtr<BonminIQP> _instance; // The Bonmin problem instance
     Bonmin::BonminSetup _setupQuick;      // used for solving quick but suboptimal
     Bonmin::BonminSetup _setupExact;      // used for solving exact with tight optimality gap
     double _lastObjective = DBL_MAX;      // objective of last solution
+    bool _lastProvedOptimal = false;      // whether last solution was proven optimal up to EXACT_GAP
     bool _quickSolve = false;             // which setup to use for solving
+    bool _quickModelOutdated = false;     // whether constraints were added since the quick setup last got the model
+    bool _exactModelOutdated = false;     // whether constraints were added since the exact setup last got the model
 };
 
 } // namespace impl
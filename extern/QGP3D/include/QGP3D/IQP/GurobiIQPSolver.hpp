@@ -6,6 +6,7 @@
 
 #include <gurobi_c++.h>
 
+#include "QGP3D/ConstraintContext.hpp"
 #include "QGP3D/IQP/BaseIQPSolver.hpp"
 #include <MC3D/Mesh/MCMeshManipulator.hpp>
 
@@ -24,12 +25,14 @@ class GurobiIQPSolver : public BaseIQPSolver, public virtual MCMeshManipulator
      * @brief Create new IQP solver instance based on Bonmin
      *
      * @param meshProps IN: mesh whose MC to quantize
+     * @param ctx IN: cached critical structure of the MC (critical links are enforced to be of positive length)
      * @param scaling IN: scale target lengths by this factor for quantization
      * @param varLowerBound IN: lower bound for arc lengths
      * @param maxSeconds IN: time limit for solver in seconds
      * @param individualArcFactor IN: objective = this * <arc-length-deviation> + (1-this) * <block-length-deviation>
      */
     GurobiIQPSolver(TetMeshProps& meshProps,
+                    ConstraintContext& ctx,
                     double scaling,
                     double varLowerBound,
                     double maxSeconds = 180,
@@ -47,6 +50,7 @@ class GurobiIQPSolver : public BaseIQPSolver, public virtual MCMeshManipulator
     virtual void enableExactSolve();
     virtual BaseIQPSolver::RetCode solve();
     virtual double objectiveValue() const;
+    virtual bool lastSolveProvedOptimal() const;
     virtual void useCurrentAsWarmStart();
     virtual void addConstraints(const vector<vector<pair<int, EH>>>& nonZeroSum);
     ///@}
@@ -56,6 +60,7 @@ class GurobiIQPSolver : public BaseIQPSolver, public virtual MCMeshManipulator
     }
 
   private:
+    ConstraintContext& _ctx;         // Critical structure of the MC, shared with the quantizer
     GRBEnv _env;                     // Gurobi environment
     GRBModel _model;                 // Gurobi problem instance
     map<EH, GRBVar> _arc2var;        // Matching of arcs to IQP variables
@@ -70,6 +70,27 @@ class BaseLPSolver : public virtual MCMeshNavigator
         return _dynamicConstraints;
     }
 
+    /**
+     * @brief Change the scaling factor for target lengths. The LP base setup does not depend on the scaling, so this
+     *        may be called at any time between solves.
+     *
+     * @param scaling IN: new scaling factor for target lengths
+     */
+    void setScaling(double scaling)
+    {
+        _scaling = scaling;
+    }
+
+    /**
+     * @brief Number of LP solves performed so far
+     *
+     * @return int number of calls to solve()
+     */
+    int nSolves() const
+    {
+        return _nSolves;
+    }
+
   protected:
     /**
      * @brief Optimal factor by which to scale a given sheet to minimize deviation objective
@@ -160,6 +181,7 @@ class BaseLPSolver : public virtual MCMeshNavigator
     double _scaling;                                   // scaling factor for target lengths
     const ISPQuantizer::Decomposition& _decomp;        // decomposition into subproblems passed from outside
     vector<vector<pair<int, EH>>> _dynamicConstraints; // inequality constraints dynamically and incrementally added
+    int _nSolves = 0;                                  // number of LP solves performed
 };
 
 } // namespace qgp3d
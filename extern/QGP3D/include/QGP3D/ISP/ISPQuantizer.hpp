@@ -12,6 +12,10 @@ class BaseLPSolver;
 
 /**
  * @brief Class to execute quantization using the greedy [I]nteger[S]heet[P]ump algorithm
+ *
+ *        An instance acts as a quantization session: the decomposition, the critical links, the LP models and all
+ *        constraints discovered so far are kept between calls to quantize(), so that further scalings are solved
+ *        incrementally, starting from the previous integer solution. The MC must not change between calls.
  */
 class ISPQuantizer : public virtual MCMeshManipulator
 {
@@ -43,8 +47,11 @@ class ISPQuantizer : public virtual MCMeshManipulator
      */
     ISPQuantizer(TetMeshProps& meshProps, SeparationChecker& sep);
 
+    ~ISPQuantizer();
+
     /**
-     * @brief Compute quantization
+     * @brief Compute quantization. Repeated calls reuse the session state built by previous calls and start from the
+     *        current quantization.
      *
      * @param scaling IN: scale target lengths by this factor for quantization
      * @param varLowerBound IN: lower bound for arc lengths
@@ -52,12 +59,34 @@ class ISPQuantizer : public virtual MCMeshManipulator
      */
     RetCode quantize(double scaling = 1.0, double varLowerBound = 0.0);
 
+    /**
+     * @brief Number of LP solves performed by the last call to quantize()
+     *
+     * @return int number of LP solves
+     */
+    int nLPSolves() const;
+
+    /**
+     * @brief Number of separation rounds (constraint additions) needed by the last call to quantize()
+     *
+     * @return int number of separation rounds
+     */
+    int nSeparationRounds() const;
+
   protected:
     /**
      * @brief Decompose MC domain into problems (mostly) independent, as specified above, stored internally
      */
     void decomposeIntoSubproblems();
 
+    /**
+     * @brief Create the LP solver and determine the critical links and critical elements, unless done by a previous
+     *        call
+     *
+     * @param scaling IN: scale target lengths by this factor for quantization
+     */
+    void setupSession(double scaling);
+
     /**
      * @brief Perform a greedy descent using sheet inflation/deflation operators obtained from LP solves
      *
@@ -85,7 +114,8 @@ class ISPQuantizer : public virtual MCMeshManipulator
      * @param criticalLinks IN: critical links previously determined
      * @return vector<vector<pair<int, EH>>> violated constraints (encoded non-intuitively)
      */
-    vector<vector<pair<int, EH>>> violatedSimpleConstraints(double varLowerBound, vector<CriticalLink>& criticalLinks);
+    vector<vector<pair<int, EH>>> violatedSimpleConstraints(double varLowerBound,
+                                                            const vector<CriticalLink>& criticalLinks);
 
     /**
      * @brief Number of constraints in \p constraints violated by the current quantization
@@ -117,6 +147,14 @@ class ISPQuantizer : public virtual MCMeshManipulator
 
     SeparationChecker& _sep; // Separation checker given from outside
     Decomposition _decomp;   // Decomposition of the MC domain into quantization subproblems
+
+    std::unique_ptr<BaseLPSolver> _sheetFinder;              // LP solver kept across quantize() calls
+    vector<vector<pair<int, EH>>> _dynamicConstraints;       // All constraints added so far
+    vector<vector<pair<int, EH>>> _simpleDynamicConstraints; // Non-separation constraints added so far
+    double _varLowerBound = -DBL_MAX;                        // Lower bound the constraints above were added for
+
+    int _nLPSolves = 0;         // Number of LP solves of last quantization
+    int _nSeparationRounds = 0; // Number of separation rounds of last quantization
 };
 
 } // namespace qgp3d
@@ -3,6 +3,8 @@
 
 #include <MC3D/Mesh/MCMeshNavigator.hpp>
 
+#include "QGP3D/ConstraintContext.hpp"
+
 namespace qgp3d
 {
 using namespace mc3d;
@@ -78,12 +80,32 @@ class SeparationChecker : public virtual MCMeshNavigator
      *                            lengths (including sign) may not be 0.
      * @return RetCode SUCCESS or error code
      */
-    void findSeparationViolatingPaths(vector<CriticalLink>& criticalLinks,
+    void findSeparationViolatingPaths(const vector<CriticalLink>& criticalLinks,
                                       const vector<bool>& arcIsCritical,
                                       const vector<bool>& nodeIsCritical,
                                       const vector<bool>& patchIsCritical,
                                       vector<vector<pair<int, EH>>>& nonZeroSumArcs);
 
+    /**
+     * @brief Find separation violations for the critical structure of the current MC (see
+     *        findSeparationViolatingPaths() above), as cached by constraintContext()
+     *
+     * @param nonZeroSumArcs OUT: MC arcs with associated +/- sign info into \p nonZeroSumArcs . The sum of these arcs'
+     *                            lengths (including sign) may not be 0.
+     */
+    void findSeparationViolatingPaths(vector<vector<pair<int, EH>>>& nonZeroSumArcs);
+
+    /**
+     * @brief Critical structure of the MC, shared by all quantizers and solvers using this separationchecker.
+     *        It is recomputed automatically whenever the MC changes.
+     *
+     * @return ConstraintContext& cached critical structure
+     */
+    ConstraintContext& constraintContext()
+    {
+        return _constraintContext;
+    }
+
     /**
      * @brief Return all paths previously found by this separationchecker via findSeparationViolatingPaths
      *
@@ -186,6 +208,7 @@ class SeparationChecker : public virtual MCMeshNavigator
 
     vector<vector<std::pair<int, EH>>> _allSeparatingPaths;      // Full set of separation violating paths
     vector<vector<std::pair<int, EH>>> _failsafeSeparatingPaths; // Full set of separation violating paths (monotonous)
+    ConstraintContext _constraintContext; // Cached critical structure of the MC
 };
 
 } // namespace qgp3d
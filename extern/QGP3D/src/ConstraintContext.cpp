@@ -0,0 +1,103 @@
+#include "QGP3D/ConstraintContext.hpp"
+
+namespace qgp3d
+{
+
+ConstraintContext::ConstraintContext(const TetMeshProps& meshProps)
+    : TetMeshNavigator(meshProps), MCMeshNavigator(meshProps)
+{
+}
+
+const vector<ConstraintContext::CriticalLink>& ConstraintContext::criticalLinks()
+{
+    update();
+    return _criticalLinks;
+}
+
+int ConstraintContext::arcCriticalLink(const EH& a)
+{
+    update();
+    return _arcCriticalLink[a.idx()];
+}
+
+const vector<int>& ConstraintContext::nodeCriticalLinksOut(const VH& n)
+{
+    update();
+    return _nodeCriticalLinksOut[n.idx()];
+}
+
+const vector<int>& ConstraintContext::nodeCriticalLinksIn(const VH& n)
+{
+    update();
+    return _nodeCriticalLinksIn[n.idx()];
+}
+
+const vector<bool>& ConstraintContext::isCriticalArc()
+{
+    update();
+    return _isCriticalArc;
+}
+
+const vector<bool>& ConstraintContext::isCriticalNode()
+{
+    update();
+    return _isCriticalNode;
+}
+
+const vector<bool>& ConstraintContext::isCriticalPatch()
+{
+    update();
+    return _isCriticalPatch;
+}
+
+bool ConstraintContext::isUpToDate() const
+{
+    // Revisions are unique across all MCs, so this also detects a different MC
+    return _revision == mcMeshProps().revision();
+}
+
+void ConstraintContext::update()
+{
+    if (isUpToDate())
+        return;
+
+    auto& mcMesh = mcMeshProps().mesh();
+
+    map<EH, int> a2criticalLinkIdx;
+    map<VH, vector<int>> n2criticalLinksOut;
+    map<VH, vector<int>> n2criticalLinksIn;
+    getCriticalLinks(_criticalLinks, a2criticalLinkIdx, n2criticalLinksOut, n2criticalLinksIn, true);
+
+    _arcCriticalLink.assign(mcMesh.n_edges(), -1);
+    _isCriticalArc.assign(mcMesh.n_edges(), false);
+    for (auto& kv : a2criticalLinkIdx)
+    {
+        _arcCriticalLink[kv.first.idx()] = kv.second;
+        _isCriticalArc[kv.first.idx()] = true;
+    }
+
+    _nodeCriticalLinksOut.assign(mcMesh.n_vertices(), {});
+    _nodeCriticalLinksIn.assign(mcMesh.n_vertices(), {});
+    for (auto& kv : n2criticalLinksOut)
+        _nodeCriticalLinksOut[kv.first.idx()] = std::move(kv.second);
+    for (auto& kv : n2criticalLinksIn)
+        _nodeCriticalLinksIn[kv.first.idx()] = std::move(kv.second);
+
+    _isCriticalNode.assign(mcMesh.n_vertices(), false);
+    for (VH n : mcMesh.vertices())
+    {
+        auto type = mcMeshProps().nodeType(n);
+        if (type.first == SingularNodeType::SINGULAR || type.second == FeatureNodeType::FEATURE
+            || type.second == FeatureNodeType::SEMI_FEATURE_SINGULAR_BRANCH)
+            _isCriticalNode[n.idx()] = true;
+    }
+
+    bool hasFeaturePatches = mcMeshProps().isAllocated<IS_FEATURE_F>();
+    _isCriticalPatch.assign(mcMesh.n_faces(), false);
+    for (FH p : mcMesh.faces())
+        _isCriticalPatch[p.idx()] = mcMesh.is_boundary(p) || (hasFeaturePatches && mcMeshProps().get<IS_FEATURE_F>(p));
+
+    _revision = mcMeshProps().revision();
+}
+
+} // namespace qgp3d
@@ -6,7 +6,13 @@ namespace qgp3d
 {
 
 ConstraintExtractor::ConstraintExtractor(const TetMeshProps& meshProps)
-    : TetMeshNavigator(meshProps), MCMeshNavigator(meshProps)
+    : TetMeshNavigator(meshProps), MCMeshNavigator(meshProps), _ownedCtx(new ConstraintContext(meshProps)),
+      _ctx(*_ownedCtx)
+{
+}
+
+ConstraintExtractor::ConstraintExtractor(const TetMeshProps& meshProps, ConstraintContext& ctx)
+    : TetMeshNavigator(meshProps), MCMeshNavigator(meshProps), _ctx(ctx)
 {
 }
 
@@ -258,7 +264,7 @@ ConstraintExtractor::getTetPathConstraints(const vector<vector<HEH>>& haSequence
                     // We can use this to get the arc direction under the orig param
                     CH tet = *itTet;
                     HEH he = *itHe;
-                    auto& chartOrig = meshProps().ref<CHART_ORIG>(tet);
+                    const auto& chartOrig = meshProps().ref<CHART_ORIG>(tet);
                     auto uvwOrig1 = chartOrig.at(meshProps().mesh().from_vertex_handle(he));
                     auto uvwOrig2 = chartOrig.at(meshProps().mesh().to_vertex_handle(he));
                     UVWDir dir = transOrigCurr.invert().rotate(toDir(uvwOrig2 - uvwOrig1));
@@ -448,34 +454,24 @@ void ConstraintExtractor::assignNodeTypes()
 {
     auto& mcMesh = mcMeshProps().mesh();
 
-    vector<CriticalLink> criticalLinks;
-    map<EH, int> a2criticalLinkIdx;
-    map<VH, vector<int>> n2criticalLinksOut;
-    map<VH, vector<int>> n2criticalLinksIn;
-    getCriticalLinks(criticalLinks, a2criticalLinkIdx, n2criticalLinksOut, n2criticalLinksIn, true);
-
-    _arcIsCritical = vector<bool>(mcMesh.n_edges(), false);
-    for (auto& kv : a2criticalLinkIdx)
-        _arcIsCritical[kv.first.idx()] = true;
+    auto& criticalLinks = _ctx.criticalLinks();
+    _arcIsCritical = _ctx.isCriticalArc();
 
     int nCircular = 0;
-    for (auto path : criticalLinks)
+    for (auto& path : criticalLinks)
         if (path.cyclic)
             nCircular++;
     LOG(INFO) << nCircular << " cyclic links out of " << criticalLinks.size();
 
+    auto isOnCriticalLink
+        = [this](const VH& n) { return !_ctx.nodeCriticalLinksIn(n).empty() || !_ctx.nodeCriticalLinksOut(n).empty(); };
+
     // Mark singular nodes (including those inserted into circular arcs)
     _constraintNodeType = vector<ConstraintNodeType>(mcMesh.n_vertices(), NONE);
-    for (auto* coll : {&n2criticalLinksIn, &n2criticalLinksOut})
-        for (auto& kv : *coll)
-        {
-            auto type = mcMeshProps().nodeType(kv.first);
-            if (type.first == SingularNodeType::SINGULAR || type.second == FeatureNodeType::FEATURE
-                || type.second == FeatureNodeType::SEMI_FEATURE_SINGULAR_BRANCH)
-                _constraintNodeType[kv.first.idx()] = NATIVE;
-            else
-                _constraintNodeType[kv.first.idx()] = ARTIFICIAL_ON_LINK;
-        }
+    auto& isCriticalNode = _ctx.isCriticalNode();
+    for (VH n : mcMesh.vertices())
+        if (isOnCriticalLink(n))
+            _constraintNodeType[n.idx()] = isCriticalNode[n.idx()] ? NATIVE : ARTIFICIAL_ON_LINK;
 
     vector<BoundaryRegion> boundaryRegions;
     map<HFH, int> hp2boundaryID;
@@ -490,9 +486,7 @@ void ConstraintExtractor::assignNodeTypes()
     // Check for boundary regions with no critical nodes or critical arcs in them
     for (auto& region : boundaryRegions)
     {
-        if (containsMatching(region.ns,
-                             [&](const VH& n)
-                             { return n2criticalLinksIn.count(n) != 0 || n2criticalLinksOut.count(n) != 0; }))
+        if (containsMatching(region.ns, isOnCriticalLink))
             continue;
         assert(!region.ns.empty());
         _constraintNodeType[region.ns.begin()->idx()] = ARTIFICIAL_ON_BOUNDARY;
@@ -982,7 +976,7 @@ int ConstraintExtractor::getCycleCoord(const CH& tetStart, const VH& vConn, cons
         throw std::logic_error("Artificial singular node that is not incident on a cyclic singularity");
     auto connectingTets = connectingTetPath(tetStart, cycleHe, vConn);
     connectingTets.push_front(tetStart);
-    auto& chartOrig = meshProps().ref<CHART_ORIG>(cycleTet);
+    const auto& chartOrig = meshProps().ref<CHART_ORIG>(cycleTet);
     Vec3Q uvwOrig1 = chartOrig.at(meshProps().mesh().from_vertex_handle(cycleHe));
     Vec3Q uvwOrig2 = chartOrig.at(meshProps().mesh().to_vertex_handle(cycleHe));
     return toCoord(
@@ -13,12 +13,18 @@ ConstraintWriter::ConstraintWriter(const TetMeshProps& meshProps, const std::str
 }
 
 ConstraintWriter::RetCode ConstraintWriter::writeTetPathConstraints()
+{
+    ConstraintContext ctx(meshProps());
+    return writeTetPathConstraints(ctx);
+}
+
+ConstraintWriter::RetCode ConstraintWriter::writeTetPathConstraints(ConstraintContext& ctx)
 {
     _os = std::ofstream(_fileName);
     auto ret = checkFile();
     if (ret != RetCode::SUCCESS)
         return ret;
-    ConstraintExtractor extr(meshProps());
+    ConstraintExtractor extr(meshProps(), ctx);
 
     auto haSequences = extr.getCriticalSkeletonArcs();
     auto tetPathConstraints = extr.getTetPathConstraints(haSequences);
@@ -19,10 +19,81 @@ namespace qgp3d
 {
 namespace impl
 {
-BonminIQPSolver::BonminIQPSolver(
-    TetMeshProps& meshProps, double scaling, double varLowerBound, double maxSeconds, double individualArcFactor)
+
+namespace
+{
+
+using SparseRow = vector<pair<int, Q>>; // (column, coefficient) pairs sorted by column
+
+/**
+ * @brief Select a maximal subset of linearly independent rows by exact sparse gaussian elimination.
+ *        Each row is reduced by the stored echelon rows whose pivot (smallest column) it contains, and selected if
+ *        it does not vanish. Rows that reduce to zero are linear combinations of previously selected rows.
+ *
+ * @param rows IN: sparse rows
+ * @param nCols IN: number of columns
+ * @return vector<int> indices of the selected rows in ascending order
+ */
+vector<int> linearlyIndependentRows(const vector<SparseRow>& rows, int nCols)
+{
+    vector<SparseRow> pivot2row(nCols); // echelon rows normalized to a pivot coefficient of 1
+    vector<int> selected;
+    SparseRow reduced;
+    SparseRow merged;
+    for (int i = 0; i < (int)rows.size(); i++)
+    {
+        reduced = rows[i];
+        while (!reduced.empty() && !pivot2row[reduced.front().first].empty())
+        {
+            // reduced -= factor * pivotRow, which eliminates the leading coefficient
+            const SparseRow& pivotRow = pivot2row[reduced.front().first];
+            Q factor = reduced.front().second;
+            merged.clear();
+            auto it1 = reduced.begin() + 1;
+            auto it2 = pivotRow.begin() + 1;
+            while (it1 != reduced.end() || it2 != pivotRow.end())
+            {
+                if (it2 == pivotRow.end() || (it1 != reduced.end() && it1->first < it2->first))
+                    merged.emplace_back(*it1++);
+                else if (it1 == reduced.end() || it2->first < it1->first)
+                {
+                    merged.emplace_back(it2->first, -factor * it2->second);
+                    it2++;
+                }
+                else
+                {
+                    Q coeff = it1->second - factor * it2->second;
+                    if (coeff != 0)
+                        merged.emplace_back(it1->first, coeff);
+                    it1++;
+                    it2++;
+                }
+            }
+            reduced.swap(merged);
+        }
+        if (reduced.empty())
+            continue;
+
+        Q pivot = reduced.front().second;
+        for (auto& kv : reduced)
+            kv.second /= pivot;
+        pivot2row[reduced.front().first] = std::move(reduced);
+        reduced = SparseRow();
+        selected.push_back(i);
+    }
+    return selected;
+}
+
+} // namespace
+
+BonminIQPSolver::BonminIQPSolver(TetMeshProps& meshProps,
+                                 ConstraintContext& ctx,
+                                 double scaling,
+                                 double varLowerBound,
+                                 double maxSeconds,
+                                 double individualArcFactor)
     : TetMeshNavigator(meshProps), TetMeshManipulator(meshProps), MCMeshNavigator(meshProps),
-      MCMeshManipulator(meshProps), BaseIQPSolver(scaling, varLowerBound, maxSeconds, individualArcFactor),
+      MCMeshManipulator(meshProps), BaseIQPSolver(scaling, varLowerBound, maxSeconds, individualArcFactor), _ctx(ctx),
       _instance(new BonminIQP(meshProps, scaling, varLowerBound))
 {
 }
@@ -55,7 +126,7 @@ void BonminIQPSolver::setupDefaultOptions()
         setup->options()->SetNumericValue("integer_tolerance", 1e-3);
     }
     _setupExact.options()->SetNumericValue("allowable_fraction_gap",
-                                    1e-4); // obj considered optimal if gap small
+                                    EXACT_GAP); // obj considered optimal if gap small
     _setupQuick.options()->SetNumericValue("allowable_fraction_gap",
                                     0.99); // obj considered optimal if gap small
     _setupQuick.options()->SetIntegerValue("solution_limit", 1);
@@ -121,19 +192,15 @@ void BonminIQPSolver::setupConstraints()
 {
     auto& mc = mcMeshProps().mesh();
 
-    vector<CriticalLink> criticalLinks;
-    map<EH, int> a2criticalLinkIdx;
-    map<VH, vector<int>> n2criticalLinksOut;
-    map<VH, vector<int>> n2criticalLinksIn;
-    getCriticalLinks(criticalLinks, a2criticalLinkIdx, n2criticalLinksOut, n2criticalLinksIn, true);
+    const vector<CriticalLink>& criticalLinks = _ctx.criticalLinks();
 
     _instance->_constraints.clear();
 
     {
-        Eigen::MatrixXd equalityMatrix(2 * mc.n_logical_faces(), _instance->_arc2idx.size());
-        equalityMatrix.setZero();
-        int globalIdx = 0;
-        // Each patches opposite arc lengths must match
+        // Each patches opposite arc lengths must match.
+        // Only a linearly independent subset of these equalities is passed to the solver. It is extracted by sparse
+        // exact elimination, as each equality only involves the few arcs bounding a single patch.
+        vector<SparseRow> equalityRows;
         for (FH patch : mc.faces())
         {
             HFH hp = mc.halfface_handle(patch, 0);
@@ -156,28 +223,27 @@ void BonminIQPSolver::setupConstraints()
                 if (esA == esB)
                     continue;
 
-                for (HEH ha : dir2orderedHas[dirSide])
-                    equalityMatrix(globalIdx, _instance->_arc2idx.at(mc.edge_handle(ha))) = 1;
-
-                for (HEH ha : dir2orderedHas[-dirSide])
-                    equalityMatrix(globalIdx, _instance->_arc2idx.at(mc.edge_handle(ha))) = -1;
+                map<int, int> idx2coeff;
+                for (EH a : esA)
+                    idx2coeff[_instance->_arc2idx.at(a)] = 1;
+                for (EH a : esB)
+                    idx2coeff[_instance->_arc2idx.at(a)] = -1;
 
-                globalIdx++;
+                equalityRows.emplace_back();
+                for (auto& kv : idx2coeff)
+                    equalityRows.back().emplace_back(kv.first, kv.second);
             }
         }
-        Eigen::FullPivLU<Eigen::MatrixXd> decomp(equalityMatrix.transpose());
-        Eigen::MatrixXd image = decomp.image(equalityMatrix.transpose()).transpose();
 
-        for (int i = 0; i < image.rows(); i++)
+        for (int i : linearlyIndependentRows(equalityRows, _instance->_arc2idx.size()))
         {
             vector<int> vars;
             vector<double> coeffs;
-            for (int j = 0; j < image.cols(); j++)
-                if (std::abs(image(i, j)) > 1e-6)
-                {
-                    vars.push_back(j);
-                    coeffs.push_back(std::round(image(i, j)));
-                }
+            for (auto& kv : equalityRows[i])
+            {
+                vars.push_back(kv.first);
+                coeffs.push_back(kv.second.get_d());
+            }
             _instance->_constraints.push_back({vars, coeffs, 0.0, true});
         }
     }
@@ -305,16 +371,29 @@ void BonminIQPSolver::useCurrentAsWarmStart()
 
 BaseIQPSolver::RetCode BonminIQPSolver::solve()
 {
+    _lastProvedOptimal = false;
     try
     {
+        // Bonmin's branch-and-bound can not be resumed, but the setups keep their NLP interface across solves.
+        // It only has to be reloaded for the setup that is actually used, if constraints were added in between.
+        bool& modelOutdated = _quickSolve ? _quickModelOutdated : _exactModelOutdated;
+        Bonmin::BonminSetup& setup = _quickSolve ? _setupQuick : _setupExact;
+        if (modelOutdated)
+        {
+            setup.nonlinearSolver()->setModel(_instance);
+            modelOutdated = false;
+        }
+
         Bonmin::Bab bb;
-        bb(_quickSolve ? _setupQuick : _setupExact);
+        bb(setup);
         std::cout << std::flush;
 
         _lastObjective = bb.bestObj();
         DLOG(INFO) << "Bonmin solved IQP with final objective value of " << _lastObjective;
 
         int status = bb.mipStatus();
+        _lastProvedOptimal = status == Bonmin::Bab::FeasibleOptimal
+                             && _lastObjective - bb.bestBound() <= EXACT_GAP * std::abs(_lastObjective);
         if (status != Bonmin::Bab::FeasibleOptimal && status != Bonmin::Bab::Feasible)
         {
             LOG(ERROR) << "Bad status return by Bonmin solver";
@@ -339,6 +418,11 @@ double BonminIQPSolver::objectiveValue() const
     return _lastObjective;
 }
 
+bool BonminIQPSolver::lastSolveProvedOptimal() const
+{
+    return _lastProvedOptimal;
+}
+
 void BonminIQPSolver::addConstraints(const vector<vector<pair<int, EH>>>& nonZeroSum)
 {
     for (auto& aColl : nonZeroSum)
@@ -352,8 +436,8 @@ void BonminIQPSolver::addConstraints(const vector<vector<pair<int, EH>>>& nonZer
         }
         _instance->_constraints.push_back({vars, coeffs, 1.0, false});
     }
-    _setupQuick.nonlinearSolver()->setModel(_instance);
-    _setupExact.nonlinearSolver()->setModel(_instance);
+    _quickModelOutdated = true;
+    _exactModelOutdated = true;
 }
 
 BonminIQPSolver::BonminIQP::BonminIQP(const TetMeshProps& meshProps, double scaling, double varLowerBound)
@@ -8,10 +8,14 @@ namespace qgp3d
 namespace impl
 {
 
-GurobiIQPSolver::GurobiIQPSolver(
-    TetMeshProps& meshProps, double scaling, double varLowerBound, double maxSeconds, double individualArcFactor)
+GurobiIQPSolver::GurobiIQPSolver(TetMeshProps& meshProps,
+                                 ConstraintContext& ctx,
+                                 double scaling,
+                                 double varLowerBound,
+                                 double maxSeconds,
+                                 double individualArcFactor)
     : TetMeshNavigator(meshProps), TetMeshManipulator(meshProps), MCMeshNavigator(meshProps),
-      MCMeshManipulator(meshProps), BaseIQPSolver(scaling, varLowerBound, maxSeconds, individualArcFactor),
+      MCMeshManipulator(meshProps), BaseIQPSolver(scaling, varLowerBound, maxSeconds, individualArcFactor), _ctx(ctx),
       _env(true), _model(
         (_env.set(GRB_IntParam_LogToConsole, true),_env.start(), _env))
 {
@@ -90,11 +94,7 @@ void GurobiIQPSolver::setupConstraints()
 {
     auto& mc = mcMeshProps().mesh();
 
-    vector<CriticalLink> criticalLinks;
-    map<EH, int> a2criticalLinkIdx;
-    map<VH, vector<int>> n2criticalLinksOut;
-    map<VH, vector<int>> n2criticalLinksIn;
-    getCriticalLinks(criticalLinks, a2criticalLinkIdx, n2criticalLinksOut, n2criticalLinksIn, true);
+    const vector<CriticalLink>& criticalLinks = _ctx.criticalLinks();
 
     // Each patches opposite arc lengths must match
     for (FH patch : mc.faces())
@@ -220,7 +220,7 @@ void GurobiIQPSolver::enableQuickSolve()
 
 void GurobiIQPSolver::enableExactSolve()
 {
-    _model.set(GRB_DoubleParam_MIPGap, 1e-4);
+    _model.set(GRB_DoubleParam_MIPGap, EXACT_GAP);
 }
 
 void GurobiIQPSolver::finalizeSetup()
@@ -265,6 +265,11 @@ double GurobiIQPSolver::objectiveValue() const
     return _model.getObjective().getValue();
 }
 
+bool GurobiIQPSolver::lastSolveProvedOptimal() const
+{
+    return _model.get(GRB_IntAttr_Status) == GRB_OPTIMAL && _model.get(GRB_DoubleAttr_MIPGap) <= EXACT_GAP;
+}
+
 void GurobiIQPSolver::useCurrentAsWarmStart()
 {
     for (auto& kv : _arc2var)
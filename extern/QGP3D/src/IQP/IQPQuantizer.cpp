@@ -2,6 +2,8 @@
 
 #include "QGP3D/IQP/IQPQuantizer.hpp"
 
+#include <utility>
+
 #define INDIVIDUAL_ARC_FACTOR 1.0
 
 #ifdef QGP3D_WITH_GUROBI
@@ -49,7 +51,7 @@ IQPQuantizer::RetCode IQPQuantizer::quantize(double scaling, double varLowerBoun
         {
             // Determine current arc length
             double length = 0.0;
-            for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(arc))
+            for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(arc))
                 length += edgeLengthUVW<CHART>(meshProps().mesh().edge_handle(he));
             mcMeshProps().set<ARC_DBL_LENGTH>(arc, length);
         }
@@ -61,35 +63,11 @@ IQPQuantizer::RetCode IQPQuantizer::quantize(double scaling, double varLowerBoun
         for (EH a: mcMeshProps().mesh().edges())
             previousSolution[a] = mcMeshProps().get<ARC_INT_LENGTH>(a);
 
-    vector<CriticalLink> criticalLinks;
-    map<EH, int> a2criticalLinkIdx;
-    map<VH, vector<int>> n2criticalLinksOut;
-    map<VH, vector<int>> n2criticalLinksIn;
-    getCriticalLinks(criticalLinks, a2criticalLinkIdx, n2criticalLinksOut, n2criticalLinksIn, true);
-
-    vector<bool> isCriticalArc(mc.n_edges(), false);
-    vector<bool> isCriticalNode(mc.n_vertices(), false);
-    vector<bool> isCriticalPatch(mc.n_faces(), false);
-    for (auto& kv : a2criticalLinkIdx)
-        isCriticalArc[kv.first.idx()] = true;
-    for (VH n : mc.vertices())
-    {
-        auto type = mcMeshProps().nodeType(n);
-        if (type.first == SingularNodeType::SINGULAR || type.second == FeatureNodeType::FEATURE
-            || type.second == FeatureNodeType::SEMI_FEATURE_SINGULAR_BRANCH)
-            isCriticalNode[n.idx()] = true;
-    }
-    for (FH p : mc.faces())
-        isCriticalPatch[p.idx()]
-            = mc.is_boundary(p)
-                || (mcMeshProps().isAllocated<IS_FEATURE_F>() && mcMeshProps().get<IS_FEATURE_F>(p));
-
-
-
 #ifdef QGP3D_WITH_GUROBI
-    impl::GurobiIQPSolver iqp(meshProps(), scaling, std::max(-GRB_INFINITY, varLowerBound), maxSecondsIQP, INDIVIDUAL_ARC_FACTOR);
+    impl::GurobiIQPSolver iqp(meshProps(), _sep.constraintContext(), scaling, std::max(-GRB_INFINITY, varLowerBound), maxSecondsIQP, INDIVIDUAL_ARC_FACTOR);
 #else
-    impl::BonminIQPSolver iqp(meshProps(), scaling, varLowerBound, maxSecondsIQP, INDIVIDUAL_ARC_FACTOR);
+    impl::BonminIQPSolver iqp(
+        meshProps(), _sep.constraintContext(), scaling, varLowerBound, maxSecondsIQP, INDIVIDUAL_ARC_FACTOR);
 #endif
     iqp.setupDefaultOptions();
     iqp.setupVariables();
@@ -144,8 +122,7 @@ IQPQuantizer::RetCode IQPQuantizer::quantize(double scaling, double varLowerBoun
         else
         {
             vector<vector<pair<int, EH>>> forcedNonZeroSum;
-            _sep.findSeparationViolatingPaths(
-                criticalLinks, isCriticalArc, isCriticalNode, isCriticalPatch, forcedNonZeroSum);
+            _sep.findSeparationViolatingPaths(forcedNonZeroSum);
             validSolution = forcedNonZeroSum.size() == 0;
 
             if (!validSolution)
@@ -158,7 +135,8 @@ IQPQuantizer::RetCode IQPQuantizer::quantize(double scaling, double varLowerBoun
             {
                 for (EH a: mcMeshProps().mesh().edges())
                     previousSolution[a] = mcMeshProps().get<ARC_INT_LENGTH>(a);
-                nextSolveExact = !nextSolveExact;
+                // Validated quick solutions are only re-solved exactly if the quick solve left an optimality gap
+                nextSolveExact = !nextSolveExact && !iqp.lastSolveProvedOptimal();
             }
         }
     }
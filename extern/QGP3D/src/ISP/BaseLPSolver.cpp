@@ -48,6 +48,7 @@ map<int, double> BaseLPSolver::integerSheet(int bundleToChange, bool add, bool f
     {
         DLOG(INFO) << "Optimizing LP model";
         bool success = solve(subproblem);
+        _nSolves++;
         if (!success)
         {
             removeTemporaryConstraints(subproblem);
@@ -101,6 +102,7 @@ map<int, double> BaseLPSolver::integerSheet(int bundleToChange, bool add, bool f
             reconstrainToNextInt(subproblem, maxBundle);
             DLOG(INFO) << "Reoptimizing LP model";
             bool success = solve(subproblem);
+            _nSolves++;
             if (!success)
             {
                 // instead scale by lcd
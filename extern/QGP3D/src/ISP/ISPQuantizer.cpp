@@ -1,5 +1,7 @@
 #include "QGP3D/ISP/ISPQuantizer.hpp"
 
+#include <utility>
+
 #ifdef QGP3D_WITH_GUROBI
 #include "QGP3D/ISP/GurobiLPSolver.hpp"
 #else
@@ -16,6 +18,10 @@ ISPQuantizer::ISPQuantizer(TetMeshProps& meshProps, SeparationChecker& sep)
     decomposeIntoSubproblems();
 }
 
+ISPQuantizer::~ISPQuantizer()
+{
+}
+
 namespace
 {
 
@@ -56,7 +62,7 @@ ISPQuantizer::RetCode ISPQuantizer::quantize(double scaling, double varLowerBoun
         {
             // Determine current arc length
             double length = 0.0;
-            for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(arc))
+            for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(arc))
                 length += edgeLengthUVW<CHART>(meshProps().mesh().edge_handle(he));
             mcMeshProps().set<ARC_DBL_LENGTH>(arc, length);
         }
@@ -65,40 +71,21 @@ ISPQuantizer::RetCode ISPQuantizer::quantize(double scaling, double varLowerBoun
     if (!mcMeshProps().isAllocated<ARC_INT_LENGTH>())
         mcMeshProps().allocate<ARC_INT_LENGTH>(0);
 
-        // Create and setup LP solver
-#ifdef QGP3D_WITH_GUROBI
-    impl::GurobiLPSolver sheetFinder(meshProps(), scaling, _decomp);
-#else
-    impl::ClpLPSolver sheetFinder(meshProps(), scaling, _decomp);
-#endif
-    sheetFinder.setupLPBase();
-
-    // Compute critical link structure
-    vector<CriticalLink> criticalLinks;
-    map<EH, int> a2criticalLinkIdx;
-    map<VH, vector<int>> n2criticalLinksOut;
-    map<VH, vector<int>> n2criticalLinksIn;
-    getCriticalLinks(criticalLinks, a2criticalLinkIdx, n2criticalLinksOut, n2criticalLinksIn, true);
-
-    vector<bool> isCriticalArc(mcMesh.n_edges(), false);
-    vector<bool> isCriticalNode(mcMesh.n_vertices(), false);
-    vector<bool> isCriticalPatch(mcMesh.n_faces(), false);
-    for (auto& kv : a2criticalLinkIdx)
-        isCriticalArc[kv.first.idx()] = true;
-    for (VH n : mcMesh.vertices())
+    setupSession(scaling);
+    if (varLowerBound != _varLowerBound)
     {
-        auto type = mcMeshProps().nodeType(n);
-        if (type.first == SingularNodeType::SINGULAR || type.second == FeatureNodeType::FEATURE
-            || type.second == FeatureNodeType::SEMI_FEATURE_SINGULAR_BRANCH)
-            isCriticalNode[n.idx()] = true;
+        // Simple constraints encode the lower bound, separation constraints are rediscovered via _sep
+        _dynamicConstraints.clear();
+        _simpleDynamicConstraints.clear();
+        _sheetFinder->setDynamicConstraints(_dynamicConstraints);
+        _varLowerBound = varLowerBound;
     }
-    for (FH p : mcMesh.faces())
-        isCriticalPatch[p.idx()] = mcMesh.is_boundary(p)
-                                   || (mcMeshProps().isAllocated<IS_FEATURE_F>() && mcMeshProps().get<IS_FEATURE_F>(p));
+    BaseLPSolver& sheetFinder = *_sheetFinder;
+    int nSolvesPre = sheetFinder.nSolves();
 
     // Main algo
-    vector<vector<pair<int, EH>>> dynamicConstraints;
-    vector<vector<pair<int, EH>>> simpleDynamicConstraints;
+    auto& dynamicConstraints = _dynamicConstraints;
+    auto& simpleDynamicConstraints = _simpleDynamicConstraints;
 
     double currentObj = greedyDescent(sheetFinder, scaling, false);
 
@@ -113,7 +100,7 @@ ISPQuantizer::RetCode ISPQuantizer::quantize(double scaling, double varLowerBoun
         if (useGlobalProblem)
             currentObj = greedyDescent(sheetFinder, scaling, true);
 
-        auto constraints = violatedSimpleConstraints(varLowerBound, criticalLinks);
+        auto constraints = violatedSimpleConstraints(varLowerBound, _sep.constraintContext().criticalLinks());
         simpleDynamicConstraints.insert(simpleDynamicConstraints.end(), constraints.begin(), constraints.end());
 
         if (constraints.empty())
@@ -122,8 +109,7 @@ ISPQuantizer::RetCode ISPQuantizer::quantize(double scaling, double varLowerBoun
                 constraints = _sep.previousSeparationViolatingPaths();
             else
             {
-                _sep.findSeparationViolatingPaths(
-                    criticalLinks, isCriticalArc, isCriticalNode, isCriticalPatch, constraints);
+                _sep.findSeparationViolatingPaths(constraints);
                 DLOG(INFO) << "Found unseparated features? " << !constraints.empty();
             }
         }
@@ -158,6 +144,8 @@ ISPQuantizer::RetCode ISPQuantizer::quantize(double scaling, double varLowerBoun
         else if (!dynamicConstraints.empty())
             useGlobalProblem = !useGlobalProblem;
     }
+    _nLPSolves = sheetFinder.nSolves() - nSolvesPre;
+    _nSeparationRounds = iter;
     DLOG(INFO) << "Needed " << iter << " sheet pump iterations to separate critical entities";
     DLOG(INFO) << "Final obj after separating critical arcs: " << currentObj;
 
@@ -170,6 +158,33 @@ ISPQuantizer::RetCode ISPQuantizer::quantize(double scaling, double varLowerBoun
     return SUCCESS;
 }
 
+void ISPQuantizer::setupSession(double scaling)
+{
+    if (_sheetFinder)
+    {
+        _sheetFinder->setScaling(scaling);
+        return;
+    }
+
+    // Create and setup LP solver
+#ifdef QGP3D_WITH_GUROBI
+    _sheetFinder = std::make_unique<impl::GurobiLPSolver>(meshProps(), scaling, _decomp);
+#else
+    _sheetFinder = std::make_unique<impl::ClpLPSolver>(meshProps(), scaling, _decomp);
+#endif
+    _sheetFinder->setupLPBase();
+}
+
+int ISPQuantizer::nLPSolves() const
+{
+    return _nLPSolves;
+}
+
+int ISPQuantizer::nSeparationRounds() const
+{
+    return _nSeparationRounds;
+}
+
 void ISPQuantizer::decomposeIntoSubproblems()
 {
     auto& mcMesh = mcMeshProps().mesh();
@@ -541,7 +556,7 @@ double ISPQuantizer::makeFeasible(BaseLPSolver& sheetFinder, double scaling)
 }
 
 vector<vector<pair<int, EH>>> ISPQuantizer::violatedSimpleConstraints(double varLowerBound,
-                                                                      vector<CriticalLink>& criticalLinks)
+                                                                      const vector<CriticalLink>& criticalLinks)
 {
     auto& mcMesh = mcMeshProps().mesh();
 
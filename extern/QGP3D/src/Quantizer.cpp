@@ -8,6 +8,8 @@
 
 #include <TS3D/trulyseamless.h>
 
+#include <utility>
+
 namespace qgp3d
 {
 
@@ -114,7 +116,7 @@ Quantizer::quantize(double scaleFactor, vector<PathConstraint>& constraints, int
         TS3D::TrulySeamless3D sanitizer(_meshCopy);
         for (auto tet : _meshCopy.cells())
             for (auto v : _meshCopy.tet_vertices(tet))
-                sanitizer.setParam(tet, v, Vec3Q2d(_meshProps.ref<CHART>(tet).at(v)));
+                sanitizer.setParam(tet, v, Vec3Q2d(std::as_const(_meshProps).ref<CHART>(tet).at(v)));
         if (_meshProps.isAllocated<IS_FEATURE_E>())
             for (auto e : _meshCopy.edges())
                 if (_meshProps.get<IS_FEATURE_E>(e))
@@ -189,7 +191,8 @@ Quantizer::quantize(double scaleFactor, vector<PathConstraint>& constraints, int
     (void)retIQP;
 #endif
 
-    ConstraintExtractor extr(_meshProps);
+    // The MC is unchanged since the quantizers ran, so the critical structure they cached is reused
+    ConstraintExtractor extr(_meshProps, sep.constraintContext());
 
     auto haSequences = extr.getCriticalSkeletonArcs();
     auto tetPathConstraints = extr.getTetPathConstraints(haSequences);
@@ -9,7 +9,8 @@ bool SeparationChecker::GreaterPathLengthCompare::operator()(const WeaklyMonoton
     return p1.length > p2.length || (p1.length == p2.length && p1.path.size() > p2.path.size());
 }
 
-SeparationChecker::SeparationChecker(TetMeshProps& meshProps) : TetMeshNavigator(meshProps), MCMeshNavigator(meshProps)
+SeparationChecker::SeparationChecker(TetMeshProps& meshProps)
+    : TetMeshNavigator(meshProps), MCMeshNavigator(meshProps), _constraintContext(meshProps)
 {
 }
 
@@ -35,7 +36,7 @@ int SeparationChecker::numHexesInQuantization() const
 }
 
 void
-SeparationChecker::findSeparationViolatingPaths(vector<CriticalLink>& criticalLinks,
+SeparationChecker::findSeparationViolatingPaths(const vector<CriticalLink>& criticalLinks,
                                                 const vector<bool>& arcIsCritical,
                                                 const vector<bool>& nodeIsCritical,
                                                 const vector<bool>& patchIsCritical,
@@ -45,9 +46,11 @@ SeparationChecker::findSeparationViolatingPaths(vector<CriticalLink>& criticalLi
     vector<vector<pair<int, EH>>> failsafeNonZeroSumArcs;
     // For each critical link s1 find paths connecting s1 to other critical links s2 or surface patches p2
     // Then check for overlaps between these, accumulating the quantized edge lengths along the path as deltas.
-    for (auto& criticalLink : criticalLinks)
+    for (const auto& link : criticalLinks)
     {
         // This has been shifted from calling functions to here. Makes no sense to have caller do this
+        // (the links may be shared, so the current lengths are accumulated into a copy)
+        CriticalLink criticalLink = link;
         criticalLink.length = 0;
         for (HEH ha : criticalLink.pathHas)
             criticalLink.length += mcMeshProps().get<ARC_INT_LENGTH>(mcMeshProps().mesh().edge_handle(ha));
@@ -59,6 +62,13 @@ SeparationChecker::findSeparationViolatingPaths(vector<CriticalLink>& criticalLi
     _allSeparatingPaths.insert(_allSeparatingPaths.end(), nonZeroSumArcs.begin(), nonZeroSumArcs.end());
 }
 
+void SeparationChecker::findSeparationViolatingPaths(vector<vector<pair<int, EH>>>& nonZeroSumArcs)
+{
+    auto& ctx = _constraintContext;
+    findSeparationViolatingPaths(
+        ctx.criticalLinks(), ctx.isCriticalArc(), ctx.isCriticalNode(), ctx.isCriticalPatch(), nonZeroSumArcs);
+}
+
 void SeparationChecker::traceExhaustPaths(const CriticalLink& criticalLink1,
                                                                 const vector<bool>& arcIsCritical,
                                                                 const vector<bool>& nodeIsCritical,
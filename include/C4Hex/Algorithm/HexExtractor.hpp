@@ -1,6 +1,7 @@
 #ifndef C4HEX_HEXEXTRACTORBASE_HPP
 #define C4HEX_HEXEXTRACTORBASE_HPP
 
+#include "C4Hex/Interface/HexMeshStreamWriter.hpp"
 #include "C4Hex/Mesh/HexMeshProps.hpp"
 #include "C4Hex/Mesh/PolyMeshProps.hpp"
 #include <MC3D/Mesh/MCMeshNavigator.hpp>
@@ -21,6 +22,7 @@ class HexExtractor : public MCMeshNavigator
     enum RetCode
     {
         SUCCESS = 0,
+        MISSING_GRID_VERTEX = 1, // An integer grid point of a block has no hex vertex (streaming extraction only)
     };
 
     /**
@@ -41,7 +43,25 @@ class HexExtractor : public MCMeshNavigator
      */
     RetCode extractHexMesh(int subdiv);
 
+    /**
+     * @brief Extract the hex mesh and stream it to \p writer block by block.
+     *        Only the MC skeleton (nodes, arcs and patches) is kept in the hex mesh, the hexes and the hex vertices
+     *        interior to blocks are written to \p writer and discarded after each block.
+     *
+     * @param writer IN/OUT: writer to stream the hex mesh to (must have been begun)
+     * @return RetCode SUCCESS or MISSING_GRID_VERTEX
+     */
+    RetCode extractHexMesh(HexMeshStreamWriter& writer);
+
   protected:
+    /**
+     * @brief Allocate the properties of the hex mesh and extract the hex vertices, edges and faces of the MC skeleton
+     *
+     * @param subdiv IN: how many times to divide the integer grid facets (1x1) along the two facet axes
+     * @return map<FH, map<Vec3Q, VH>> mapping of patches to hex vertices by IGM (in coord
+     *                                                             system of first halfpatches block)
+     */
+    map<FH, map<Vec3Q, VH>> createSkeleton(int subdiv);
     /**
      * @brief Add a hex vertex for every MC node
      *
@@ -80,6 +100,38 @@ class HexExtractor : public MCMeshNavigator
      */
     map<CH, map<Vec3Q, VH>> createBlockHexVEFC(const map<FH, map<Vec3Q, VH>>& p2igm2hexV, int subdiv);
 
+    /**
+     * @brief Determine on which side of the bounding box of a block \p igm lies
+     *
+     * @param igm IN: igm of a point inside the block
+     * @param minIGM IN: igm of the lower corner of the block
+     * @param maxIGM IN: igm of the upper corner of the block
+     * @return UVWDir side of the block or NONE if \p igm is interior to the block
+     */
+    UVWDir blockBoundaryDir(const Vec3Q& igm, const Vec3i& minIGM, const Vec3i& maxIGM) const;
+
+    /**
+     * @brief Find the hex vertex created for patch point \p igm on side \p lookupDir of block \p b
+     *
+     * @param p2igm2hexV IN: mapping of patches to hex vertices by IGM (in coord system of first halfpatches block)
+     * @param b IN: block
+     * @param igm IN: igm of the point in the coord system of \p b
+     * @param lookupDir IN: side of \p b that \p igm lies on
+     * @return VH hex vertex of \p igm
+     */
+    VH patchHexV(const map<FH, map<Vec3Q, VH>>& p2igm2hexV, const CH& b, const Vec3Q& igm, UVWDir lookupDir) const;
+
+    /**
+     * @brief Determine the positions of all (subdivided) integer grid points strictly inside block \p b
+     *
+     * @param b IN: block
+     * @param minIGM IN: igm of the lower corner of \p b
+     * @param maxIGM IN: igm of the upper corner of \p b
+     * @param subdiv IN: how many times to divide the integer grid facets (1x1) along the two facet axes
+     * @return map<Vec3Q, Vec3d> positions of the interior grid points by IGM
+     */
+    map<Vec3Q, Vec3d> blockInteriorPositions(const CH& b, const Vec3i& minIGM, const Vec3i& maxIGM, int subdiv) const;
+
     /**
      * @brief Determine the barycentric coordinates of \p igmUVW wrt \p hf given that \p coord1 and \p coord3
      *        are the variable coordinates
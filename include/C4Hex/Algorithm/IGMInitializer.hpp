@@ -106,6 +106,17 @@ class IGMInitializer : public virtual MCMeshManipulator
      */
     void allocateIGM();
 
+    /**
+     * @brief Round the IGM of all block-interior vertices to multiples of 1/2^\p denominatorBits, so that exact
+     *        predicates on them operate on small denominators instead of the up to 2^52 of values converted from
+     *        doubles. Vertices on patches keep their exact values. A vertex is only moved if every incident tet of
+     *        positive IGM volume keeps a positive volume, else it keeps its previous value.
+     *
+     * @param denominatorBits IN: k, such that coordinates are snapped to the lattice of multiples of 1/2^k
+     * @return int number of vertices moved
+     */
+    int snapInteriorIGM(int denominatorBits);
+
   private:
     /**
      * @brief Use 2D-Tutte to rescale the vertex IGMs for patches
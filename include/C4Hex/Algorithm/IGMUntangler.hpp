@@ -1,8 +1,11 @@
 #ifndef C4HEX_PARAMOPTIMIZER_HPP
 #define C4HEX_PARAMOPTIMIZER_HPP
 
+#include <MC3D/Mesh/MCEmbeddingIndex.hpp>
 #include <MC3D/Mesh/MCMeshManipulator.hpp>
 
+#include <memory>
+
 namespace c4hex
 {
 using namespace mc3d;
@@ -266,6 +269,9 @@ class IGMUntangler : public virtual MCMeshManipulator
 
     set<CH> _blocksOptimizedByTLC; // Blocks already untangled by TLC method (to avoid retrying in case of failure)
 
+    // Compact copy of BLOCK_MESH_TETS, kept up to date across calls via the MC3D manipulators' dirty tracking
+    std::unique_ptr<MCEmbeddingIndex> _embedding;
+
     // Interface for L-BFGS
     class FoldoverEnergy
     {
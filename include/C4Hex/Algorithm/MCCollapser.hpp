@@ -39,9 +39,14 @@ class MCCollapser : public virtual MCMeshManipulator
      * @param optimize IN: whether to smooth the resulting MC afterwards
      * @param randomOrder IN: which order of collapses (random or smalles elements first)
      * @param direction IN: direction of collapses (0: globally coordinated, 1: random, 2: from min valence)
+     * @param batchArcs IN: whether to collapse batches of 0-arcs with pairwise disjoint block neighborhoods
+     *                      between two decimation passes, instead of a single 0-arc
      * @return RetCode SUCCESS or error code
      */
-    RetCode collapseAllZeroElements(bool optimize = false, bool randomOrder = false, int direction = 0);
+    RetCode collapseAllZeroElements(bool optimize = false,
+                                    bool randomOrder = false,
+                                    int direction = 0,
+                                    bool batchArcs = false);
 
     /**
      * @brief Count the number of zero elements according to the underlying quantization
@@ -66,7 +71,83 @@ class MCCollapser : public virtual MCMeshManipulator
      */
     void markZeros();
 
+    /**
+     * @brief Number of arcs collapsed so far
+     */
+    int nCollapsedArcs() const;
+
+    /**
+     * @brief Number of patches collapsed so far
+     */
+    int nCollapsedPatches() const;
+
+    /**
+     * @brief Number of blocks collapsed so far
+     */
+    int nCollapsedBlocks() const;
+
+    /**
+     * @brief Number of 0-arc batches collapsed so far (only in batch mode)
+     */
+    int nArcBatches() const;
+
+    /**
+     * @brief Enable or disable local MC consistency checks after each collapse and bisection. The checks only cover
+     *        the blocks around the modified elements (see MCMeshNavigator::checkLocalMC()), so they are cheap enough
+     *        for release builds. The first failing operation is logged and collapsing is aborted by throwing
+     *        std::logic_error.
+     *
+     * @param enable IN: whether to check
+     */
+    void setConsistencyChecks(bool enable);
+
+    /**
+     * @brief Enable or disable parallel evaluation and checking of 0-arc batches (only in batch mode). The lock
+     *        state and preferred direction of all 0-arcs and the consistency checks of a batch are computed on
+     *        multiple threads. The collapses themselves stay serial: they modify the shared tet mesh and MC and are
+     *        applied one after the other in batch order.
+     *
+     * @param enable IN: whether to evaluate and check batches in parallel
+     */
+    void setParallelBatchChecks(bool enable);
+
   private:
+    /**
+     * @brief Blocks incident on any of \p nodes, if consistency checks are enabled
+     *
+     * @param nodes IN: MC nodes
+     * @return set<CH> incident blocks (empty if consistency checks are disabled)
+     */
+    set<CH> checkRegion(const set<VH>& nodes) const;
+
+    /**
+     * @brief Blocks incident on any node of \p patches, if consistency checks are enabled
+     */
+    set<CH> checkRegion(const vector<FH>& patches) const;
+
+    /**
+     * @brief Blocks incident on any node of \p blocks, if consistency checks are enabled
+     */
+    set<CH> checkRegion(const vector<CH>& blocks) const;
+
+    /**
+     * @brief Check the blocks of \p region after \p operation, if consistency checks are enabled
+     *
+     * @param operation IN: description of the last operation for logging
+     * @param region IN: blocks to check (deleted blocks are skipped)
+     */
+    void checkMCAfter(const std::string& operation, const set<CH>& region) const;
+
+    /**
+     * @brief Check the blocks of each of \p regions after the corresponding of \p operations, if consistency checks
+     *        are enabled. The regions are checked in parallel if parallel batch checks are enabled, the first failing
+     *        operation (in the given order) is reported.
+     *
+     * @param operations IN: descriptions of the operations for logging
+     * @param regions IN: blocks to check per operation (deleted blocks are skipped)
+     */
+    void checkMCAfter(const vector<std::string>& operations, const vector<set<CH>>& regions) const;
+
     /**
      * @brief Assign globally preferred collapse directions to each block
      */
@@ -117,6 +198,13 @@ class MCCollapser : public virtual MCMeshManipulator
      */
     RetCode collapseHalfarc(const HEH& haCollapse);
 
+    /**
+     * @brief Directed arc collapse without consistency check
+     *
+     * @param haCollapse IN: zero-halfarc
+     */
+    void collapseHalfarcUnchecked(const HEH& haCollapse);
+
     /**
      * @brief Directed pillow patch collapse. Ideal direction is chosen automatically.
      *
@@ -175,6 +263,24 @@ class MCCollapser : public virtual MCMeshManipulator
      */
     bool collapseNextZeroArc();
 
+    /**
+     * @brief Collapse a batch of 0-arcs whose block neighborhoods (blocks incident on either node) are pairwise
+     *        disjoint. The collapse of one such arc does not alter the embedding, connectivity or lock state of any
+     *        other arc of the batch, so the batch can be selected upfront and collapsed without rescanning the MC.
+     *        Arcs are selected greedily in the same order as by collapseNextZeroArc(). Consistency checks are run
+     *        once the whole batch is collapsed.
+     *
+     * @return int number of collapsed arcs
+     */
+    int collapseZeroArcBatch();
+
+    /**
+     * @brief All 0-arcs in the order in which they should be collapsed
+     *
+     * @return vector<EH> 0-arcs
+     */
+    vector<EH> zeroArcsInCollapseOrder() const;
+
     /**
      * @brief Collapse the next encountered pillow patch
      *
@@ -245,6 +351,7 @@ class MCCollapser : public virtual MCMeshManipulator
     int _nCollapsedAs = 0; // Accumulated number of arc collapses
     int _nCollapsedPs = 0; // Accumulated number of patch collapses
     int _nCollapsedBs = 0; // Accumulated number of block collapses
+    int _nArcBatches = 0;  // Accumulated number of 0-arc batches
 
     int _nTetsPre = 0; // Number of tets before collapsing
     int _nFsPre = 0;   // Number of faces before collapsing
@@ -262,8 +369,11 @@ class MCCollapser : public virtual MCMeshManipulator
 
     MCSplitter _refiner; // Internal refiner for bisection operations
 
-    bool _randomOrder = false; // Whether to execute collapses in random order
-    int _direction = 0;        // Directedness of collapse process
+    bool _randomOrder = false;         // Whether to execute collapses in random order
+    int _direction = 0;                // Directedness of collapse process
+    bool _batchArcs = false;           // Whether to collapse independent 0-arcs in batches
+    bool _parallelBatchChecks = false; // Whether to evaluate and check 0-arc batches on multiple threads
+    bool _checkMC = false;             // Whether to check the MC locally after each operation
 };
 
 } // namespace c4hex
@@ -0,0 +1,148 @@
+#ifndef C4HEX_HEXMESHSTREAMWRITER_HPP
+#define C4HEX_HEXMESHSTREAMWRITER_HPP
+
+#include <MC3D/Types.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace c4hex
+{
+using namespace mc3d;
+
+/**
+ * @brief Class that writes a hex mesh to a binary legacy VTK unstructured grid (.vtk) element by element, without
+ *        requiring the mesh to be present in memory.
+ *
+ *        Hexes are written as VTK_HEXAHEDRON cells, MC patch facets as VTK_QUAD cells and MC arc segments as VTK_LINE
+ *        cells. MC_BLOCK_ID, MC_PATCH_ID, MC_ARC_ID, the feature markers and IS_SINGULAR are written as cell data
+ *        (-1/0 for cells of other types), MC_NODE_ID and IS_FEATURE_V as point data.
+ *
+ *        Vertices are written directly to the output file, everything that has to follow the vertices in the file
+ *        is spooled to temporary files next to the output and appended in finish().
+ */
+class HexMeshStreamWriter
+{
+  public:
+    enum RetCode
+    {
+        SUCCESS = 0,
+        FILE_INACCESSIBLE = 1,
+    };
+
+    /**
+     * @brief Create a writer that writes to \p filename
+     *
+     * @param filename IN: name of the file to write to
+     */
+    HexMeshStreamWriter(const std::string& filename);
+
+    ~HexMeshStreamWriter();
+
+    /**
+     * @brief Open the output and temporary files and write the file header
+     *
+     * @return RetCode SUCCESS or FILE_INACCESSIBLE
+     */
+    RetCode begin();
+
+    /**
+     * @brief Append a vertex
+     *
+     * @param xyz IN: position
+     * @param nodeID IN: index of the MC node the vertex coincides with or -1
+     * @param featureV IN: feature marker of the vertex
+     * @return int index of the vertex in the output
+     */
+    int addVertex(const Vec3d& xyz, int nodeID = -1, int featureV = 0);
+
+    /**
+     * @brief Append a segment of an MC arc
+     *
+     * @param vs IN: output indices of the two vertices
+     * @param arcID IN: index of the MC arc
+     * @param featureE IN: feature marker of the arc
+     * @param singular IN: whether the arc is singular
+     */
+    void addArcSegment(const array<int, 2>& vs, int arcID, int featureE, bool singular);
+
+    /**
+     * @brief Append a facet of an MC patch
+     *
+     * @param vs IN: output indices of the four vertices (in cyclic order)
+     * @param patchID IN: index of the MC patch
+     * @param featureF IN: feature marker of the patch
+     */
+    void addPatchQuad(const array<int, 4>& vs, int patchID, int featureF);
+
+    /**
+     * @brief Append a hex
+     *
+     * @param vs IN: output indices of the eight vertices in VTK_HEXAHEDRON order
+     * @param blockID IN: index of the MC block
+     */
+    void addHex(const array<int, 8>& vs, int blockID);
+
+    /**
+     * @brief Complete the file: write the vertex count and append all spooled cell and point data
+     *
+     * @return RetCode SUCCESS or FILE_INACCESSIBLE
+     */
+    RetCode finish();
+
+    /**
+     * @brief Number of vertices written so far
+     */
+    int nVertices() const;
+
+    /**
+     * @brief Number of hexes written so far
+     */
+    size_t nHexes() const;
+
+  private:
+    enum Spool
+    {
+        CONNECTIVITY = 0,
+        CELL_TYPE,
+        BLOCK_ID,
+        PATCH_ID,
+        ARC_ID,
+        FEATURE,
+        SINGULAR,
+        NODE_ID,
+        FEATURE_V,
+        N_SPOOLS
+    };
+
+    /**
+     * @brief Append a cell and its cell data to the spools
+     */
+    void addCell(const int* vs, int n, int type, int blockID, int patchID, int arcID, int feature, int singular);
+
+    /**
+     * @brief Write \p val big endian (as required by binary legacy VTK) to \p out
+     */
+    static void writeBE(std::ostream& out, int32_t val);
+
+    /**
+     * @brief Write \p val big endian (as required by binary legacy VTK) to \p out
+     */
+    static void writeBE(std::ostream& out, double val);
+
+    std::string spoolName(int spool) const;
+
+    std::string _filename;
+    std::ofstream _out;
+    std::streampos _nPointsPos;
+    array<std::fstream, N_SPOOLS> _spools;
+
+    int _nVertices;
+    size_t _nCells;
+    size_t _nConnectivity;
+    size_t _nHexes;
+};
+
+} // namespace c4hex
+
+#endif
@@ -20,6 +20,14 @@ class HexRemesher : public virtual MCMeshNavigator
     {
         SUCCESS = 0,
         FILE_INACCESSIBLE = 1,
+        MISSING_GRID_VERTEX = 2, // Some integer grid point of a block has no hex vertex
+    };
+
+    enum FileFormat
+    {
+        OVM_ASCII = 0,  // OpenVolumeMesh .ovm
+        OVM_BINARY = 1, // OpenVolumeMesh .ovmb
+        VTK_BINARY = 2, // binary legacy VTK unstructured grid .vtk (hex meshes only)
     };
 
     /**
@@ -54,21 +62,37 @@ class HexRemesher : public virtual MCMeshNavigator
      */
     RetCode extractMCMesh(PolyMeshProps& hexMeshProps);
 
+    /**
+     * @brief Extract the hex mesh and stream it block by block to \p filename (binary legacy VTK) without keeping
+     *        the hexes in memory. The result is identical to extractHexMesh() followed by writeHexMesh() with
+     *        VTK_BINARY, except for the order of vertices and cells.
+     *
+     * @param filename IN: name of the file to write to
+     * @return RetCode SUCCESS, FILE_INACCESSIBLE or MISSING_GRID_VERTEX
+     */
+    RetCode streamHexMesh(const std::string& filename);
+
     /**
      * @brief Write the extracted hex mesh to \p filename
      *
      * @param filename IN: name of the file to write to
+     * @param format IN: file format to write
      * @return RetCode SUCCESS or FILE_INACCESSIBLE
      */
-    RetCode writeHexMesh(const HexMeshProps& hexMeshProps, const std::string& filename) const;
+    RetCode
+    writeHexMesh(const HexMeshProps& hexMeshProps, const std::string& filename, FileFormat format = OVM_ASCII) const;
 
     /**
      * @brief Write the extracted hex mesh to \p filename
      *
      * @param filename IN: name of the file to write to
+     * @param format IN: file format to write (VTK_BINARY is not supported for poly meshes, OVM_BINARY is written
+     *                   instead)
      * @return RetCode SUCCESS or FILE_INACCESSIBLE
      */
-    RetCode writePolyHexMesh(const PolyMeshProps& hexMeshProps, const std::string& filename) const;
+    RetCode writePolyHexMesh(const PolyMeshProps& hexMeshProps,
+                             const std::string& filename,
+                             FileFormat format = OVM_ASCII) const;
 
     /**
      * @brief Smooth the surface of the hex mesh by shifting vertices towards the center of their neighbors.
@@ -87,6 +111,30 @@ class HexRemesher : public virtual MCMeshNavigator
      * @return RetCode SUCCESS
      */
     RetCode smoothSurface(PolyMeshProps& hexMeshProps, int iter);
+
+  private:
+    /**
+     * @brief Shared implementation of smoothSurface for HexMeshProps and PolyMeshProps.
+     *        Builds flat stencils (movable vertices, their neighbors and incident boundary faces) once and then
+     *        performs parallel Jacobi sweeps, first over all boundary vertices, then over all interior vertices.
+     *
+     * @param hexMeshProps IN/OUT: mesh to smooth
+     * @param iter how often each vertex should be shifted
+     * @return RetCode SUCCESS
+     */
+    template <typename MESHPROPS>
+    RetCode smoothSurfaceImpl(MESHPROPS& hexMeshProps, int iter);
+
+    /**
+     * @brief Write \p mesh to \p filename in one of the OpenVolumeMesh formats
+     *
+     * @param mesh IN: mesh to write
+     * @param filename IN: name of the file to write to
+     * @param binary IN: whether to write .ovmb instead of .ovm
+     * @return RetCode SUCCESS or FILE_INACCESSIBLE
+     */
+    template <typename MESH>
+    RetCode writeOVM(const MESH& mesh, const std::string& filename, bool binary) const;
 };
 
 } // namespace c4hex
@@ -1,6 +1,7 @@
 #ifndef C4HEX_IGMGENERATOR_HPP
 #define C4HEX_IGMGENERATOR_HPP
 
+#include <MC3D/Algorithm/TetRemesher.hpp>
 #include <MC3D/Mesh/MCMeshNavigator.hpp>
 #include <MC3D/Mesh/TetMeshManipulator.hpp>
 
@@ -25,6 +26,19 @@ class IGMGenerator : public virtual TetMeshManipulator, public virtual MCMeshNav
         NO_CONVERGENCE = 23,
     };
 
+    /**
+     * @brief Schedule of the remeshing passes performed before and in between untangling iterations
+     *
+     * FIXED: angle bound sequence and i % 3 rotation of global remeshing/collapsing passes
+     * ADAPTIVE: passes restricted to tangled blocks, chosen by measured changes per second, skipping passes that
+     *           changed nothing in their previous round
+     */
+    enum class RemeshSchedule
+    {
+        FIXED,
+        ADAPTIVE
+    };
+
     /**
      * @brief Create an instance that manages the generation of an IGM from a seamless param and an MC
      *
@@ -38,9 +52,99 @@ class IGMGenerator : public virtual TetMeshManipulator, public virtual MCMeshNav
      * @param simplifyBaseMesh IN: whether to decimate and remesh base mesh to improve condition of param problem
      * @param maxUntanglingIter IN: maximum iterations of outer untangling iterations to eliminate parametric inversions
      * @param maxInnerIter IN: maximum iterations of inner untangling iterations to eliminate parametric inversions
+     * @param schedule IN: how remeshing passes are scheduled
+     * @param snapDenominatorBits IN: if positive, block-interior IGM coordinates are snapped to multiples of
+     *                                1/2^snapDenominatorBits after initialization and each untangling iteration
+     *                                (see IGMInitializer::snapInteriorIGM())
      * @return RetCode SUCCESS, QUANTIZATION_ERROR or RESCALING_ERROR
      */
-    RetCode generateBlockwiseIGM(bool simplifyBaseMesh, int maxInnerIter = 500, int maxUntanglingIter = 40);
+    RetCode generateBlockwiseIGM(bool simplifyBaseMesh,
+                                 int maxInnerIter = 500,
+                                 int maxUntanglingIter = 40,
+                                 RemeshSchedule schedule = RemeshSchedule::FIXED,
+                                 int snapDenominatorBits = 0);
+
+    /**
+     * @brief Number of outer untangling iterations performed by the last call to generateBlockwiseIGM
+     *
+     * @return int number of untangling iterations
+     */
+    int nUntanglingIterations() const;
+
+    /**
+     * @brief Wall time spent in IGMInitializer by the last call to generateBlockwiseIGM
+     *
+     * @return double seconds
+     */
+    double initializationSeconds() const;
+
+    /**
+     * @brief Wall time spent in IGMUntangler by the last call to generateBlockwiseIGM
+     *
+     * @return double seconds
+     */
+    double untanglingSeconds() const;
+
+    /**
+     * @brief Count the tets with non-positive IGM volume
+     *
+     * @return int number of inverted tets
+     */
+    int nInvertedTetsIGM() const;
+
+  private:
+    /**
+     * @brief Remeshing passes between untangling iterations
+     */
+    enum class RemeshPass
+    {
+        REMESH_ANGLES,
+        REMESH_VL_RATIO,
+        COLLAPSE_BOUNDED,
+        COLLAPSE_UNBOUNDED
+    };
+
+    /**
+     * @brief Accumulated cost and effect of a remeshing pass
+     */
+    struct PassCost
+    {
+        int nRuns = 0;
+        int nChanges = 0;
+        double seconds = 0.0;
+        bool changedInLastRun = true;
+    };
+
+    /**
+     * @brief Name of \p pass for logging
+     */
+    static const char* remeshPassName(RemeshPass pass);
+
+    /**
+     * @brief Run a single remeshing pass, log its duration and record its cost in _passCosts
+     *
+     * @param remesher IN/OUT: remesher operating on the tet mesh
+     * @param pass IN: which pass to run
+     * @param blockedBlocks IN: blocks whose tets should not be touched
+     * @return int number of changes performed by the pass
+     */
+    int runRemeshPass(TetRemesher& remesher, RemeshPass pass, const set<CH>& blockedBlocks);
+
+    /**
+     * @brief Choose the next pass among \p candidates: skip passes that changed nothing in their last run,
+     *        prefer passes never run, else pick the pass with the most changes per second
+     *
+     * @param candidates IN: passes eligible in the current round
+     * @param pass OUT: chosen pass
+     * @return true if a pass was chosen
+     * @return false if all candidates are skipped in this round
+     */
+    bool chooseRemeshPass(const vector<RemeshPass>& candidates, RemeshPass& pass);
+
+    map<RemeshPass, PassCost> _passCosts; // cost model of the adaptive remesh schedule
+    int _nUntanglingIter = 0;             // outer untangling iterations of the last IGM generation
+    double _initSeconds = 0.0;            // time spent initializing in the last IGM generation
+    double _untangleSeconds = 0.0;        // time spent untangling in the last IGM generation
 };
 
 } // namespace c4hex
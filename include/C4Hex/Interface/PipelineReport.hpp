@@ -0,0 +1,120 @@
+#ifndef C4HEX_PIPELINEREPORT_HPP
+#define C4HEX_PIPELINEREPORT_HPP
+
+#include <MC3D/Types.hpp>
+
+#include <chrono>
+#include <string>
+
+namespace c4hex
+{
+using namespace mc3d;
+
+/**
+ * @brief Class that records wall time, memory usage and counters of consecutive pipeline stages and writes them as
+ *        a JSON report.
+ *
+ *        Stages are flat and consecutive: beginning a stage ends the previous one. Memory is reported as resident set
+ *        size in KiB. On Linux, the peak RSS of each stage is measured by resetting the high water mark at the start
+ *        of the stage (if the kernel permits, else the reported peak is the peak since process start).
+ */
+class PipelineReport
+{
+  public:
+    enum RetCode
+    {
+        SUCCESS = 0,
+        FILE_INACCESSIBLE = 1,
+    };
+
+    /**
+     * @brief Create a report that is written to \p filename
+     *
+     * @param filename IN: name of the JSON file to write to, empty to disable writing
+     */
+    PipelineReport(const std::string& filename);
+
+    /**
+     * @brief End the current stage (if any) and begin a new one
+     *
+     * @param name IN: name of the stage
+     */
+    void beginStage(const std::string& name);
+
+    /**
+     * @brief End the current stage (if any)
+     */
+    void endStage();
+
+    /**
+     * @brief Record a counter for the current stage (or the last ended stage, if none is running).
+     *        Recording the same counter twice overwrites the previous value.
+     *
+     * @param key IN: name of the counter
+     * @param value IN: value of the counter
+     */
+    void setCounter(const std::string& key, double value);
+
+    /**
+     * @brief Record that \p stage failed with \p errorCode and end the current stage
+     *
+     * @param stage IN: description of the failed step
+     * @param errorCode IN: error code returned by the failed step
+     */
+    void fail(const std::string& stage, int errorCode);
+
+    /**
+     * @brief End the current stage (if any) and write the report, unless disabled
+     *
+     * @return RetCode SUCCESS or FILE_INACCESSIBLE
+     */
+    RetCode write();
+
+    /**
+     * @brief Current resident set size of the process
+     *
+     * @return size_t RSS in KiB (0 if unavailable)
+     */
+    static size_t currentRSS();
+
+    /**
+     * @brief Peak resident set size of the process since start or the last resetPeakRSS()
+     *
+     * @return size_t peak RSS in KiB (0 if unavailable)
+     */
+    static size_t peakRSS();
+
+    /**
+     * @brief Reset the peak resident set size to the current one, if supported by the OS
+     *
+     * @return true if reset
+     * @return false else
+     */
+    static bool resetPeakRSS();
+
+  private:
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Stage
+    {
+        std::string name;
+        double seconds = 0.0;
+        size_t rssBegin = 0;
+        size_t rssEnd = 0;
+        size_t peakRSS = 0;
+        vector<pair<std::string, double>> counters;
+    };
+
+    std::string _filename;
+    Clock::time_point _start;
+    vector<Stage> _stages;
+    bool _stageRunning = false;
+    Clock::time_point _stageStart;
+
+    std::string _failedStage;
+    int _errorCode = 0;
+};
+
+} // namespace c4hex
+
+#endif
@@ -1,6 +1,7 @@
 #include "C4Hex/Algorithm/EmbeddingCollapser.hpp"
 
 #include <list>
+#include <utility>
 
 namespace c4hex
 {
@@ -57,7 +58,8 @@ bool EmbeddingCollapser::currentlyCollapsingPatch() const
 EmbeddingCollapser::RetCode EmbeddingCollapser::collapseArcEmbedding(const HEH& ha)
 {
     DLOG(INFO) << "PRECOLLAPSE of halfarc " << ha << " which has "
-               << mcMeshProps().ref<ARC_MESH_HALFEDGES>(mcMeshProps().mesh().edge_handle(ha)).size() << " halfedges";
+               << std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(mcMeshProps().mesh().edge_handle(ha)).size()
+               << " halfedges";
 
     setVars(ha);
 
@@ -77,14 +79,14 @@ EmbeddingCollapser::RetCode EmbeddingCollapser::collapseArcEmbedding(const HEH&
 EmbeddingCollapser::RetCode
 EmbeddingCollapser::collapsePillowPatchEmbedding(const FH& p, const HEH& haMoving, const HEH& haStationary)
 {
-    DLOG(INFO) << "PRECOLLAPSE of patch " << p << " which has " << mcMeshProps().ref<PATCH_MESH_HALFFACES>(p).size()
-               << " halffaces";
+    DLOG(INFO) << "PRECOLLAPSE of patch " << p << " which has "
+               << std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p).size() << " halffaces";
 
     setVars(p, haMoving, haStationary);
 
     // Mark vertices of collapse patch as touched to guide local collapsing/remeshing
     if (meshProps().isAllocated<TOUCHED>())
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(_pCollapse))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(_pCollapse))
             for (VH v : meshProps().get_halfface_vertices(hf))
             {
                 meshProps().set<TOUCHED>(v, true);
@@ -118,7 +120,7 @@ EmbeddingCollapser::collapsePillowBlockEmbedding(const CH& b, const HFH& hpMovin
     applyTransitionToBlock(mcMeshProps().hpTransition<PATCH_TRANSITION>(hpMoving), b);
     assert(mcMeshProps().hpTransition<PATCH_TRANSITION>(hpMoving).isIdentity());
 
-    auto newPatchHalffaces = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p1);
+    auto newPatchHalffaces = std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p1);
     bool flip1 = (hpStationary.idx() % 2) == (hpMoving.idx() % 2);
     if (flip1)
     {
@@ -141,7 +143,7 @@ EmbeddingCollapser::collapsePillowBlockEmbedding(const CH& b, const HFH& hpMovin
     tetsOpp.insert(tets.begin(), tets.end());
     tets.clear();
 
-    for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p2))
+    for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p2))
     {
         assert(meshProps().get<MC_PATCH>(tetMesh.face_handle(hf)) == p2);
         meshProps().reset<MC_PATCH>(tetMesh.face_handle(hf));
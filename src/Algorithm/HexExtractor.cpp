@@ -1,5 +1,7 @@
 #include "C4Hex/Algorithm/HexExtractor.hpp"
 
+#include <utility>
+
 namespace c4hex
 {
 
@@ -15,9 +17,95 @@ typename HexExtractor<MESHPROPS>::RetCode HexExtractor<MESHPROPS>::HexExtractor:
     if (!std::is_same<MESHPROPS, PolyMeshProps>::value)
         subdiv = 0;
 
-    int stepsPerInt = std::max(1, subdiv + 1);
-    Q stepSize = Q(1, stepsPerInt);
+    auto p2igm2hexV = createSkeleton(subdiv);
+    createBlockHexVEFC(p2igm2hexV, subdiv);
+
+    return SUCCESS;
+}
+
+template <typename MESHPROPS>
+typename HexExtractor<MESHPROPS>::RetCode HexExtractor<MESHPROPS>::extractHexMesh(HexMeshStreamWriter& writer)
+{
+    const MCMesh& mc = mcMeshProps().mesh();
+    auto& hexMesh = _hexMeshProps.mesh();
+
+    auto p2igm2hexV = createSkeleton(0);
+
+    // Skeleton vertices keep their index in the output
+    for (VH v : hexMesh.vertices())
+        writer.addVertex(hexMesh.vertex(v),
+                         _hexMeshProps.template get<MC_NODE_ID>(v),
+                         _hexMeshProps.template get<IS_FEATURE_V>(v));
+    for (EH e : hexMesh.edges())
+        if (_hexMeshProps.template get<MC_ARC_ID>(e) != -1)
+            writer.addArcSegment({hexMesh.from_vertex_handle(hexMesh.halfedge_handle(e, 0)).idx(),
+                                  hexMesh.to_vertex_handle(hexMesh.halfedge_handle(e, 0)).idx()},
+                                 _hexMeshProps.template get<MC_ARC_ID>(e),
+                                 _hexMeshProps.template get<IS_FEATURE_E>(e),
+                                 _hexMeshProps.template get<IS_SINGULAR>(e));
+    for (FH f : hexMesh.faces())
+        if (_hexMeshProps.template get<MC_PATCH_ID>(f) != -1)
+        {
+            array<int, 4> vs;
+            int i = 0;
+            for (VH v : hexMesh.halfface_vertices(hexMesh.halfface_handle(f, 0)))
+                vs[i++] = v.idx();
+            assert(i == 4);
+            writer.addPatchQuad(
+                vs, _hexMeshProps.template get<MC_PATCH_ID>(f), _hexMeshProps.template get<IS_FEATURE_F>(f));
+        }
+
+    for (CH b : mc.cells())
+    {
+        Vec3i minIGM
+            = Vec3Q2i(nodeIGMinBlock(mcMeshProps().ref<BLOCK_CORNER_NODES>(b).at(UVWDir::NEG_U_NEG_V_NEG_W), b));
+        Vec3i maxIGM
+            = Vec3Q2i(nodeIGMinBlock(mcMeshProps().ref<BLOCK_CORNER_NODES>(b).at(UVWDir::POS_U_POS_V_POS_W), b));
+
+        map<Vec3Q, int> igm2idx;
+        for (const auto& kv : blockInteriorPositions(b, minIGM, maxIGM, 0))
+            igm2idx[kv.first] = writer.addVertex(kv.second);
+        for (int U = minIGM[0]; U <= maxIGM[0]; U++)
+            for (int V = minIGM[1]; V <= maxIGM[1]; V++)
+                for (int W = minIGM[2]; W <= maxIGM[2]; W++)
+                {
+                    Vec3Q igm(U, V, W);
+                    UVWDir lookupDir = blockBoundaryDir(igm, minIGM, maxIGM);
+                    if (lookupDir != UVWDir::NONE)
+                    {
+                        VH v = patchHexV(p2igm2hexV, b, igm, lookupDir);
+                        if (v.is_valid())
+                            igm2idx[igm] = v.idx();
+                    }
+                }
+        // Every grid point maps to a distinct vertex, so a complete lookup has exactly one entry per grid point
+        if ((int)igm2idx.size()
+            != (maxIGM[0] - minIGM[0] + 1) * (maxIGM[1] - minIGM[1] + 1) * (maxIGM[2] - minIGM[2] + 1))
+        {
+            LOG(ERROR) << "Block " << b << " has integer grid points without a hex vertex, can not stream its hexes";
+            return MISSING_GRID_VERTEX;
+        }
+
+        for (int U = minIGM[0]; U < maxIGM[0]; U++)
+            for (int V = minIGM[1]; V < maxIGM[1]; V++)
+                for (int W = minIGM[2]; W < maxIGM[2]; W++)
+                    writer.addHex({igm2idx[Vec3Q(U, V, W)],
+                                   igm2idx[Vec3Q(U + 1, V, W)],
+                                   igm2idx[Vec3Q(U + 1, V + 1, W)],
+                                   igm2idx[Vec3Q(U, V + 1, W)],
+                                   igm2idx[Vec3Q(U, V, W + 1)],
+                                   igm2idx[Vec3Q(U + 1, V, W + 1)],
+                                   igm2idx[Vec3Q(U + 1, V + 1, W + 1)],
+                                   igm2idx[Vec3Q(U, V + 1, W + 1)]},
+                                  b.idx());
+    }
+
+    return SUCCESS;
+}
 
+template <typename MESHPROPS>
+map<FH, map<Vec3Q, VH>> HexExtractor<MESHPROPS>::createSkeleton(int subdiv)
+{
     _hexMeshProps.mesh().clear();
 
     _hexMeshProps.template allocate<MC_NODE_ID>(-1);
@@ -35,10 +123,7 @@ typename HexExtractor<MESHPROPS>::RetCode HexExtractor<MESHPROPS>::HexExtractor:
 
     auto n2hexV = createNodeHexV();
     auto a2delta2hexV = createArcHexVE(n2hexV, subdiv);
-    auto p2igm2hexV = createPatchHexVEF(a2delta2hexV, subdiv);
-    createBlockHexVEFC(p2igm2hexV, subdiv);
-
-    return SUCCESS;
+    return createPatchHexVEF(a2delta2hexV, subdiv);
 }
 
 template <typename MESHPROPS>
@@ -79,7 +164,7 @@ map<EH, vector<VH>> HexExtractor<MESHPROPS>::createArcHexVE(const map<VH, VH>& n
         VH nFrom = mc.from_vertex_handle(ha);
         VH nTo = mc.to_vertex_handle(ha);
 
-        auto& hes = mcMeshProps().ref<ARC_MESH_HALFEDGES>(a);
+        const auto& hes = std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a);
         auto itHeCurrent = hes.begin();
         CH b = meshProps().get<MC_BLOCK>(*tetMesh.hec_iter(*itHeCurrent));
         UVWDir dir = halfarcDirInBlock(ha, b);
@@ -279,7 +364,7 @@ map<FH, map<Vec3Q, VH>> HexExtractor<MESHPROPS>::createPatchHexVEF(const map<EH,
                    == (sideLengths.first * stepsPerInt + 1) * (sideLengths.second * stepsPerInt + 1));
 
             {
-                for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+                for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
                 {
                     if (flipped)
                         hf = tetMesh.opposite_halfface_handle(hf);
@@ -380,7 +465,6 @@ map<CH, map<Vec3Q, VH>> HexExtractor<MESHPROPS>::createBlockHexVEFC(const map<FH
                                                                     int subdiv)
 {
     const MCMesh& mc = mcMeshProps().mesh();
-    const TetMesh& tetMesh = meshProps().mesh();
     map<CH, map<Vec3Q, VH>> b2igm2hexV;
 
     int stepsPerInt = std::max(1, subdiv + 1);
@@ -405,114 +489,15 @@ map<CH, map<Vec3Q, VH>> HexExtractor<MESHPROPS>::createBlockHexVEFC(const map<FH
                                  stepW++)
                             {
                                 Vec3Q igm(U + stepU * stepSize, V + stepV * stepSize, W + stepW * stepSize);
-                                bool patchLookup = true;
-                                UVWDir lookupDir = UVWDir::NONE;
-                                if (U == minIGM[0] && stepU == 0)
-                                    lookupDir = UVWDir::NEG_U;
-                                else if (U == maxIGM[0] && stepU == 0)
-                                    lookupDir = UVWDir::POS_U;
-                                else if (V == minIGM[1] && stepV == 0)
-                                    lookupDir = UVWDir::NEG_V;
-                                else if (V == maxIGM[1] && stepV == 0)
-                                    lookupDir = UVWDir::POS_V;
-                                else if (W == minIGM[2] && stepW == 0)
-                                    lookupDir = UVWDir::NEG_W;
-                                else if (W == maxIGM[2] && stepW == 0)
-                                    lookupDir = UVWDir::POS_W;
-                                else
-                                    patchLookup = false;
-
-                                if (!patchLookup)
+                                UVWDir lookupDir = blockBoundaryDir(igm, minIGM, maxIGM);
+                                if (lookupDir == UVWDir::NONE)
                                     igm2hexV[igm] = _hexMeshProps.mesh().add_vertex(Vec3d(DBL_MAX, DBL_MAX, DBL_MAX));
                                 else
-                                {
-                                    const auto& patches = mcMeshProps().ref<BLOCK_FACE_PATCHES>(b).at(lookupDir);
-#ifndef NDEBUG
-                                    bool found = false;
-#endif
-                                    for (FH p : patches)
-                                    {
-                                        assert(p2igm2hexV.find(p) != p2igm2hexV.end());
-                                        auto& patchigm2hexV = p2igm2hexV.find(p)->second;
-                                        bool mainHP = mc.incident_cell(mc.halfface_handle(p, 0)) == b;
-                                        Vec3Q transformedIGM = igm;
-                                        if (!mainHP)
-                                        {
-                                            Transition trans = mcMeshProps().get<PATCH_IGM_TRANSITION>(p);
-                                            transformedIGM = trans.invert().apply(Vec3Q(igm));
-                                        }
-                                        auto it = patchigm2hexV.find(transformedIGM);
-                                        if (it != patchigm2hexV.end())
-                                        {
-#ifndef NDEBUG
-                                            found = true;
-#endif
-                                            igm2hexV[igm] = it->second;
-                                        }
-                                    }
-                                    assert(found);
-                                }
+                                    igm2hexV[igm] = patchHexV(p2igm2hexV, b, igm, lookupDir);
                             }
 
-        for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
-        {
-            if (doubleVolumeIGM(tet) < 1e-6 && rationalVolumeIGM(tet) <= 0)
-                continue;
-
-            Vec3Q bboxMin(DBL_MAX, DBL_MAX, DBL_MAX);
-            Vec3Q bboxMax(-DBL_MAX, -DBL_MAX, -DBL_MAX);
-            for (VH v : tetMesh.tet_vertices(tet))
-            {
-                Vec3Q igm = meshProps().ref<CHART_IGM>(tet).at(v);
-                for (int coord = 0; coord < 3; coord++)
-                {
-                    bboxMin[coord] = std::min(igm[coord], bboxMin[coord]);
-                    bboxMax[coord] = std::max(igm[coord], bboxMax[coord]);
-                }
-            }
-            if (std::ceil(bboxMin[0].get_d()) > std::floor(bboxMax[0].get_d())
-                && std::ceil(bboxMin[1].get_d()) > std::floor(bboxMax[1].get_d())
-                && std::ceil(bboxMin[2].get_d()) > std::floor(bboxMax[2].get_d()))
-                continue;
-            Q minU = Q(std::ceil(Q(bboxMin[0] * stepsPerInt).get_d())) / stepsPerInt;
-            Q maxU = Q(std::floor(Q(bboxMax[0] * stepsPerInt).get_d())) / stepsPerInt;
-            Q minV = Q(std::ceil(Q(bboxMin[1] * stepsPerInt).get_d())) / stepsPerInt;
-            Q maxV = Q(std::floor(Q(bboxMax[1] * stepsPerInt).get_d())) / stepsPerInt;
-            Q minW = Q(std::ceil(Q(bboxMin[2] * stepsPerInt).get_d())) / stepsPerInt;
-            Q maxW = Q(std::floor(Q(bboxMax[2] * stepsPerInt).get_d())) / stepsPerInt;
-            for (Q U = minU; U <= maxU; U += stepSize)
-            {
-                if (U == minIGM[0] || U == maxIGM[0])
-                    continue;
-                for (Q V = minV; V <= maxV; V += stepSize)
-                {
-                    if (V == minIGM[1] || V == maxIGM[1])
-                        continue;
-                    for (Q W = minW; W <= maxW; W += stepSize)
-                    {
-                        if (W == minIGM[2] || W == maxIGM[2])
-                            continue;
-                        double Ud = U.get_d();
-                        double Vd = V.get_d();
-                        double Wd = W.get_d();
-                        if (std::trunc(Ud) != Ud && std::trunc(Vd) != Vd && std::trunc(Wd) != Wd)
-                            continue;
-                        Vec3Q igm = Vec3Q(U, V, W);
-
-                        Vec4Q barCoords(0, 0, 0, 0);
-                        if (barycentricCoordsIGM(tet, igm, barCoords))
-                        {
-                            auto vsItPair = tetMesh.tet_vertices(tet);
-                            vector<VH> vs(vsItPair.first, vsItPair.second);
-                            Vec3Q xyz(0, 0, 0);
-                            for (int i = 0; i < 4; i++)
-                                xyz += barCoords[i] * Vec3Q(tetMesh.vertex(vs[i]));
-                            _hexMeshProps.mesh().set_vertex(igm2hexV.at(igm), Vec3Q2d(xyz));
-                        }
-                    }
-                }
-            }
-        }
+        for (const auto& kv : blockInteriorPositions(b, minIGM, maxIGM, subdiv))
+            _hexMeshProps.mesh().set_vertex(igm2hexV.at(kv.first), kv.second);
 
 #ifndef NDEBUG
         for (const auto& kv : igm2hexV)
@@ -586,6 +571,126 @@ map<CH, map<Vec3Q, VH>> HexExtractor<MESHPROPS>::createBlockHexVEFC(const map<FH
     return b2igm2hexV;
 }
 
+template <typename MESHPROPS>
+UVWDir HexExtractor<MESHPROPS>::blockBoundaryDir(const Vec3Q& igm, const Vec3i& minIGM, const Vec3i& maxIGM) const
+{
+    if (igm[0] == minIGM[0])
+        return UVWDir::NEG_U;
+    else if (igm[0] == maxIGM[0])
+        return UVWDir::POS_U;
+    else if (igm[1] == minIGM[1])
+        return UVWDir::NEG_V;
+    else if (igm[1] == maxIGM[1])
+        return UVWDir::POS_V;
+    else if (igm[2] == minIGM[2])
+        return UVWDir::NEG_W;
+    else if (igm[2] == maxIGM[2])
+        return UVWDir::POS_W;
+    return UVWDir::NONE;
+}
+
+template <typename MESHPROPS>
+VH HexExtractor<MESHPROPS>::patchHexV(const map<FH, map<Vec3Q, VH>>& p2igm2hexV,
+                                      const CH& b,
+                                      const Vec3Q& igm,
+                                      UVWDir lookupDir) const
+{
+    const MCMesh& mc = mcMeshProps().mesh();
+
+    for (FH p : mcMeshProps().ref<BLOCK_FACE_PATCHES>(b).at(lookupDir))
+    {
+        assert(p2igm2hexV.find(p) != p2igm2hexV.end());
+        auto& patchigm2hexV = p2igm2hexV.find(p)->second;
+        bool mainHP = mc.incident_cell(mc.halfface_handle(p, 0)) == b;
+        Vec3Q transformedIGM = igm;
+        if (!mainHP)
+        {
+            Transition trans = mcMeshProps().get<PATCH_IGM_TRANSITION>(p);
+            transformedIGM = trans.invert().apply(Vec3Q(igm));
+        }
+        auto it = patchigm2hexV.find(transformedIGM);
+        if (it != patchigm2hexV.end())
+            return it->second;
+    }
+    assert(false);
+    return VH(-1);
+}
+
+template <typename MESHPROPS>
+map<Vec3Q, Vec3d> HexExtractor<MESHPROPS>::blockInteriorPositions(const CH& b,
+                                                                  const Vec3i& minIGM,
+                                                                  const Vec3i& maxIGM,
+                                                                  int subdiv) const
+{
+    const TetMesh& tetMesh = meshProps().mesh();
+
+    int stepsPerInt = std::max(1, subdiv + 1);
+    Q stepSize(1, stepsPerInt);
+
+    map<Vec3Q, Vec3d> igm2xyz;
+    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    {
+        if (doubleVolumeIGM(tet) < 1e-6 && rationalVolumeIGM(tet) <= 0)
+            continue;
+
+        Vec3Q bboxMin(DBL_MAX, DBL_MAX, DBL_MAX);
+        Vec3Q bboxMax(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+        for (VH v : tetMesh.tet_vertices(tet))
+        {
+            Vec3Q igm = meshProps().ref<CHART_IGM>(tet).at(v);
+            for (int coord = 0; coord < 3; coord++)
+            {
+                bboxMin[coord] = std::min(igm[coord], bboxMin[coord]);
+                bboxMax[coord] = std::max(igm[coord], bboxMax[coord]);
+            }
+        }
+        if (std::ceil(bboxMin[0].get_d()) > std::floor(bboxMax[0].get_d())
+            && std::ceil(bboxMin[1].get_d()) > std::floor(bboxMax[1].get_d())
+            && std::ceil(bboxMin[2].get_d()) > std::floor(bboxMax[2].get_d()))
+            continue;
+        Q minU = Q(std::ceil(Q(bboxMin[0] * stepsPerInt).get_d())) / stepsPerInt;
+        Q maxU = Q(std::floor(Q(bboxMax[0] * stepsPerInt).get_d())) / stepsPerInt;
+        Q minV = Q(std::ceil(Q(bboxMin[1] * stepsPerInt).get_d())) / stepsPerInt;
+        Q maxV = Q(std::floor(Q(bboxMax[1] * stepsPerInt).get_d())) / stepsPerInt;
+        Q minW = Q(std::ceil(Q(bboxMin[2] * stepsPerInt).get_d())) / stepsPerInt;
+        Q maxW = Q(std::floor(Q(bboxMax[2] * stepsPerInt).get_d())) / stepsPerInt;
+        for (Q U = minU; U <= maxU; U += stepSize)
+        {
+            if (U == minIGM[0] || U == maxIGM[0])
+                continue;
+            for (Q V = minV; V <= maxV; V += stepSize)
+            {
+                if (V == minIGM[1] || V == maxIGM[1])
+                    continue;
+                for (Q W = minW; W <= maxW; W += stepSize)
+                {
+                    if (W == minIGM[2] || W == maxIGM[2])
+                        continue;
+                    double Ud = U.get_d();
+                    double Vd = V.get_d();
+                    double Wd = W.get_d();
+                    if (std::trunc(Ud) != Ud && std::trunc(Vd) != Vd && std::trunc(Wd) != Wd)
+                        continue;
+                    Vec3Q igm = Vec3Q(U, V, W);
+
+                    Vec4Q barCoords(0, 0, 0, 0);
+                    if (barycentricCoordsIGM(tet, igm, barCoords))
+                    {
+                        auto vsItPair = tetMesh.tet_vertices(tet);
+                        vector<VH> vs(vsItPair.first, vsItPair.second);
+                        Vec3Q xyz(0, 0, 0);
+                        for (int i = 0; i < 4; i++)
+                            xyz += barCoords[i] * Vec3Q(tetMesh.vertex(vs[i]));
+                        igm2xyz[igm] = Vec3Q2d(xyz);
+                    }
+                }
+            }
+        }
+    }
+
+    return igm2xyz;
+}
+
 template <typename MESHPROPS>
 bool HexExtractor<MESHPROPS>::barycentricCoordsIGM(
     const HFH& hf, const Vec3Q& igmUVW, int coord1, int coord3, Vec3Q& barCoords) const
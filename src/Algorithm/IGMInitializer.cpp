@@ -4,6 +4,8 @@
 #include <Eigen/Sparse>
 #include <Eigen/SparseCholesky>
 
+#include <utility>
+
 // #define UNIFORM_SPACING
 
 namespace c4hex
@@ -61,6 +63,57 @@ IGMInitializer::RetCode IGMInitializer::initializeFromQuantization()
     return SUCCESS;
 }
 
+int IGMInitializer::snapInteriorIGM(int denominatorBits)
+{
+    const TetMesh& mesh = meshProps().mesh();
+    mpz_class den = 1;
+    den <<= denominatorBits;
+
+    int nSnapped = 0;
+    int nKept = 0;
+    for (VH v : mesh.vertices())
+    {
+        if (meshProps().isInPatch(v))
+            continue;
+
+        // Block-interior vertices have the same IGM in all incident tets
+        CH tetRef = *mesh.vc_iter(v);
+        Vec3Q igm = meshProps().ref<CHART_IGM>(tetRef).at(v);
+        Vec3Q snapped;
+        for (int coord = 0; coord < 3; coord++)
+        {
+            Q scaled = igm[coord] * den + Q(1, 2);
+            mpz_class num;
+            mpz_fdiv_q(num.get_mpz_t(), scaled.get_num_mpz_t(), scaled.get_den_mpz_t());
+            snapped[coord] = Q(num, den);
+            snapped[coord].canonicalize();
+        }
+        if (snapped == igm)
+            continue;
+
+        vector<CH> positiveTets;
+        for (CH tet : mesh.vertex_cells(v))
+            if (rationalVolumeIGM(tet) > 0)
+                positiveTets.push_back(tet);
+        for (CH tet : mesh.vertex_cells(v))
+            meshProps().ref<CHART_IGM>(tet).at(v) = snapped;
+
+        // Each accepted move only affects the incident tets, so checking them keeps all orientations valid
+        if (containsMatching(positiveTets, [this](const CH& tet) { return rationalVolumeIGM(tet) <= 0; }))
+        {
+            for (CH tet : mesh.vertex_cells(v))
+                meshProps().ref<CHART_IGM>(tet).at(v) = igm;
+            nKept++;
+        }
+        else
+            nSnapped++;
+    }
+    LOG(INFO) << "Snapped " << nSnapped << " block-interior IGM vertices to multiples of 1/2^" << denominatorBits
+              << ", " << nKept << " kept exact to preserve tet orientations";
+
+    return nSnapped;
+}
+
 bool IGMInitializer::splitAllNecessaryForInjectiveBoundary()
 {
     const MCMesh& mcMesh = mcMeshProps().mesh();
@@ -69,7 +122,7 @@ bool IGMInitializer::splitAllNecessaryForInjectiveBoundary()
     set<FH> cutFaces;
 
     for (EH a : mcMesh.edges())
-        for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(a))
+        for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a))
             for (VH v : mesh.halfedge_vertices(he))
                 for (HEH he2 : mesh.outgoing_halfedges(v))
                 {
@@ -118,7 +171,7 @@ bool IGMInitializer::splitAllNecessaryForInjectiveBoundary()
                     }
                 }
     for (FH p : mcMesh.faces())
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
             for (VH v : mesh.halfface_vertices(hf))
             {
                 for (HEH he2 : mesh.outgoing_halfedges(v))
@@ -208,11 +261,7 @@ bool IGMInitializer::splitAllNecessaryForInjectiveBoundary()
                 }
             }
 
-    for (EH e : cutEdges)
-        splitHalfEdge(mesh.halfedge_handle(e, 0), *mesh.ec_iter(e), Q(0.5));
-    for (FH f : cutFaces)
-        if (!mesh.is_deleted(f))
-            splitFace(f, {Q(1, 3), Q(1, 3), Q(1, 3)});
+    splitAll(cutEdges, cutFaces);
     LOG(INFO) << "Split " << cutEdges.size() << " edges and " << cutFaces.size()
               << " faces, to prevent degenerate boundary IGM";
     return !cutEdges.empty() || !cutFaces.empty();
@@ -232,10 +281,7 @@ bool IGMInitializer::splitSomeNecessaryForInjectiveInterior()
             for (EH e : mesh.cell_edges(tet))
                 if (!meshProps().isInPatch(e))
                     cutEdges.insert(e);
-    for (EH e : cutEdges)
-        splitHalfEdge(mesh.halfedge_handle(e, 0), *mesh.ec_iter(e), Q(0.5));
-    for (FH f : cutFaces)
-        splitFace(f, {Q(1, 3), Q(1, 3), Q(1, 3)});
+    splitAll(cutEdges, cutFaces);
     LOG(INFO) << "Split " << cutEdges.size() << " edges and " << cutFaces.size()
               << " faces, to prevent overconstrained inverted interior IGM";
     return !cutEdges.empty() || !cutFaces.empty();
@@ -265,10 +311,7 @@ bool IGMInitializer::splitAllSufficientForInjectiveInterior()
         if (nEonPatch == 3)
             cutFaces.insert(f);
     }
-    for (EH e : cutEdges)
-        splitHalfEdge(mesh.halfedge_handle(e, 0), *mesh.ec_iter(e), Q(0.5));
-    for (FH f : cutFaces)
-        splitFace(f, {Q(1, 3), Q(1, 3), Q(1, 3)});
+    splitAll(cutEdges, cutFaces);
     LOG(INFO) << "Split " << cutEdges.size() << " edges and " << cutFaces.size()
               << " faces, to guarantee existence of bijective map";
     return !cutEdges.empty() || !cutFaces.empty();
@@ -387,7 +430,7 @@ void IGMInitializer::determineIGMTransitions()
         if (mc.is_boundary(p))
             continue;
 
-        auto& hfs = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p);
+        const auto& hfs = std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p);
 
         auto itPairPNs = mc.face_vertices(p);
         auto ns = vector<VH>(itPairPNs.first, itPairPNs.second);
@@ -413,7 +456,7 @@ void IGMInitializer::determineIGMTransitions()
         transIGM.translation = -deltaIGM;
 
         mcMeshProps().set<PATCH_IGM_TRANSITION>(p, transIGM);
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
             meshProps().setTransition<TRANSITION_IGM>(hf, transIGM);
     }
 }
@@ -426,7 +469,7 @@ void IGMInitializer::initializeOnArcs()
     for (EH a : mc.edges())
     {
         HEH ha = mc.halfedge_handle(a, 0);
-        const auto& hes = mcMeshProps().ref<ARC_MESH_HALFEDGES>(a);
+        const auto& hes = std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a);
 
         VH nStart = mc.from_vertex_handle(ha);
         VH nEnd = mc.to_vertex_handle(ha);
@@ -496,7 +539,7 @@ void IGMInitializer::initializeOnPatches2DTutte(bool meanValWeights, bool xyzTar
             b = mc.incident_cell(mc.halfface_handle(p, 1));
         Transition transIGM = mcMeshProps().get<PATCH_IGM_TRANSITION>(p);
 
-        auto& hfs = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p);
+        const auto& hfs = std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p);
 
         int isoCoord = toCoord(halfpatchNormalDir(mc.halfface_handle(p, 0)));
         Q isoValue(0);
@@ -527,7 +570,7 @@ void IGMInitializer::initializeOnPatches2DTutte(bool meanValWeights, bool xyzTar
 
         map<VH, int> vtx2index;
         set<EH> innerEdges;
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
         {
             for (VH v : mesh.halfface_vertices(hf))
             {
@@ -678,7 +721,7 @@ void IGMInitializer::initializeInBlocks3DTutte(bool cotWeights, bool xyzTarget)
     for (CH b : mc.cells())
     {
         map<VH, int> vtx2index;
-        for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+        for (CH tet : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b))
         {
             for (VH v : mesh.cell_vertices(tet))
             {
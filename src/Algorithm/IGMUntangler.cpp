@@ -96,6 +96,13 @@ IGMUntangler::RetCode IGMUntangler::untangleIGM(double areaVsAngles, int maxIter
     const MCMesh& mc = mcMeshProps().mesh();
     const TetMesh& mesh = meshProps().mesh();
 
+    // Tet refinement (also by previous calls) marks affected blocks dirty, only those are re-gathered
+    if (!_embedding)
+        _embedding.reset(new MCEmbeddingIndex(mcMeshProps()));
+    else
+        _embedding->update();
+    assert(_embedding->isConsistent());
+
     // Sanity check on input before trying to untangle it
     for (CH b : mcMeshProps().mesh().cells())
     {
@@ -169,7 +176,7 @@ IGMUntangler::RetCode IGMUntangler::untangleIGM(double areaVsAngles, int maxIter
             continue;
 
         map<CH, map<VH, Vec3Q>> cell2igm;
-        for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+        for (CH tet : _embedding->blockTets(b))
             cell2igm[tet] = meshProps().ref<CHART_IGM>(tet);
 
         set<CH> flippedTetsTLC;
@@ -183,8 +190,8 @@ IGMUntangler::RetCode IGMUntangler::untangleIGM(double areaVsAngles, int maxIter
             determineIGMStats(b, blockVol, negVolTLC, minVolTLC, flippedTetsTLC);
 
             LOG(INFO) << "BLOCK " << b << ": after TLC, bad/all tets: " << flippedTetsTLC.size() << "/"
-                      << mcMeshProps().ref<BLOCK_MESH_TETS>(b).size() << " ("
-                      << (double)flippedTetsTLC.size() / mcMeshProps().ref<BLOCK_MESH_TETS>(b).size() * 100.0
+                      << _embedding->blockTets(b).size() << " ("
+                      << (double)flippedTetsTLC.size() / _embedding->blockTets(b).size() * 100.0
                       << "%); neg/total volume: " << negVolTLC << "/" << blockVol << " ("
                       << negVolTLC / blockVol * 100.0 << "%)";
 
@@ -194,7 +201,7 @@ IGMUntangler::RetCode IGMUntangler::untangleIGM(double areaVsAngles, int maxIter
             if (flippedTetsTLC.size() > tetsFlippedPre.size()
                 || (flippedTetsTLC.size() == tetsFlippedPre.size() && minVolTLC < minVolPre))
             {
-                for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+                for (CH tet : _embedding->blockTets(b))
                     meshProps().ref<CHART_IGM>(tet) = cell2igm[tet];
                 negVolTLC = negVolPre;
                 minVolTLC = minVolPre;
@@ -202,7 +209,7 @@ IGMUntangler::RetCode IGMUntangler::untangleIGM(double areaVsAngles, int maxIter
             }
             else
             {
-                for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+                for (CH tet : _embedding->blockTets(b))
                     cell2igm[tet] = meshProps().ref<CHART_IGM>(tet);
             }
         }
@@ -215,8 +222,8 @@ IGMUntangler::RetCode IGMUntangler::untangleIGM(double areaVsAngles, int maxIter
         set<CH> flippedTetsFFM;
         determineIGMStats(b, blockVol, negVolFFM, minVolFFM, flippedTetsFFM);
         LOG(INFO) << "BLOCK " << b << ": after FFM, bad/all tets: " << flippedTetsFFM.size() << "/"
-                  << mcMeshProps().ref<BLOCK_MESH_TETS>(b).size() << " ("
-                  << (double)flippedTetsFFM.size() / mcMeshProps().ref<BLOCK_MESH_TETS>(b).size() * 100.0
+                  << _embedding->blockTets(b).size() << " ("
+                  << (double)flippedTetsFFM.size() / _embedding->blockTets(b).size() * 100.0
                   << "%); neg/total volume: " << negVolFFM << "/" << blockVol << " (" << negVolFFM / blockVol * 100.0
                   << "%)";
 
@@ -238,7 +245,7 @@ IGMUntangler::RetCode IGMUntangler::untangleIGM(double areaVsAngles, int maxIter
             negVolTotal += negVolTLC;
             nFlippedTotal += flippedTetsTLC.size();
             flippedTets = flippedTetsTLC;
-            for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+            for (CH tet : _embedding->blockTets(b))
                 meshProps().ref<CHART_IGM>(tet) = cell2igm[tet];
         }
 
@@ -301,7 +308,7 @@ void IGMUntangler::determineIGMStats(
     blockVol = 0.0;
     minVol = DBL_MAX;
     tetsInverted.clear();
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : _embedding->blockTets(b))
     {
         Q vol = rationalVolumeIGM(tet);
         minVol = std::min(minVol, vol.get_d());
@@ -333,8 +340,8 @@ IGMUntangler::RetCode IGMUntangler::untangleByTLC(const CH& b, int maxIter, int
     map<VH, map<CH, int>> v2corner2idx;
     vector<pair<VH, vector<CH>>> idx2v;
     vector<CH> idx2tet;
-    vector<vector<unsigned>> F(mcMeshProps().ref<BLOCK_MESH_TETS>(b).size());
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    vector<vector<unsigned>> F(_embedding->blockTets(b).size());
+    for (CH tet : _embedding->blockTets(b))
     {
         for (VH v : mesh.tet_vertices(tet))
         {
@@ -478,7 +485,7 @@ IGMUntangler::RetCode IGMUntangler::untangleByFFM(const CH& b, double areaVsAngl
     LOG(INFO) << "Fixing/optimizing by FFM block " << b;
 
     int nVertices = lowerBounds.size() / 3;
-    int nTets = mcMeshProps().ref<BLOCK_MESH_TETS>(b).size();
+    int nTets = _embedding->blockTets(b).size();
 
     Eigen::VectorXd UVWflat(Eigen::VectorXd::Zero(3 * nVertices));
     Eigen::VectorXd XYZflat(Eigen::VectorXd::Zero(3 * nVertices));
@@ -670,7 +677,7 @@ IGMUntangler::RetCode IGMUntangler::untangleByFFM(const CH& b, double areaVsAngl
     applyUntangling(v2corner2idx, nInteriorVs, bestUVWflat);
 
     int tetIdx = 0;
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : _embedding->blockTets(b))
     {
         bool valid = rationalVolumeIGM(tet) > 0;
         if (valid != (bestTetDetJ(tetIdx) > 0))
@@ -695,7 +702,7 @@ Eigen::Matrix4Xi IGMUntangler::fixBlockVertices(const CH& b,
 {
     DLOG(INFO) << "Fixing block vertices";
     v2corner2idx.clear();
-    Eigen::Matrix4Xi tetVtxIndices(Eigen::Matrix4Xi::Zero(4, mcMeshProps().ref<BLOCK_MESH_TETS>(b).size()));
+    Eigen::Matrix4Xi tetVtxIndices(Eigen::Matrix4Xi::Zero(4, _embedding->blockTets(b).size()));
     const TetMesh& mesh = meshProps().mesh();
     Vec3d minIGMblock(DBL_MAX, DBL_MAX, DBL_MAX);
     Vec3d maxIGMblock(-DBL_MAX, -DBL_MAX, -DBL_MAX);
@@ -703,7 +710,7 @@ Eigen::Matrix4Xi IGMUntangler::fixBlockVertices(const CH& b,
     nInteriorVertices = 0;
 
     // First non-boundary
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : _embedding->blockTets(b))
     {
         for (VH v : mesh.tet_vertices(tet))
         {
@@ -735,7 +742,7 @@ Eigen::Matrix4Xi IGMUntangler::fixBlockVertices(const CH& b,
     nInteriorVertices = maxIdx;
 
     // Then boundary
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : _embedding->blockTets(b))
     {
         for (VH v : mesh.tet_vertices(tet))
         {
@@ -776,7 +783,7 @@ Eigen::Matrix4Xi IGMUntangler::fixBlockVertices(const CH& b,
     }
 
     int tetIdx = 0;
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : _embedding->blockTets(b))
     {
         int vtxNum = 0;
         for (VH v : mesh.tet_vertices(tet))
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <algorithm>
 #include <random>
+#include <utility>
 
 namespace c4hex
 {
@@ -23,6 +24,104 @@ MCCollapser::MCCollapser(TetMeshProps& meshProps)
 {
 }
 
+int MCCollapser::nCollapsedArcs() const
+{
+    return _nCollapsedAs;
+}
+
+int MCCollapser::nCollapsedPatches() const
+{
+    return _nCollapsedPs;
+}
+
+int MCCollapser::nCollapsedBlocks() const
+{
+    return _nCollapsedBs;
+}
+
+int MCCollapser::nArcBatches() const
+{
+    return _nArcBatches;
+}
+
+void MCCollapser::setConsistencyChecks(bool enable)
+{
+    _checkMC = enable;
+}
+
+void MCCollapser::setParallelBatchChecks(bool enable)
+{
+    _parallelBatchChecks = enable;
+}
+
+set<CH> MCCollapser::checkRegion(const set<VH>& nodes) const
+{
+    set<CH> region;
+    if (!_checkMC)
+        return region;
+    for (VH n : nodes)
+        for (CH b : mcMeshProps().mesh().vertex_cells(n))
+            if (b.is_valid())
+                region.insert(b);
+    return region;
+}
+
+set<CH> MCCollapser::checkRegion(const vector<FH>& patches) const
+{
+    set<VH> nodes;
+    if (_checkMC)
+        for (FH p : patches)
+            for (VH n : mcMeshProps().mesh().face_vertices(p))
+                nodes.insert(n);
+    return checkRegion(nodes);
+}
+
+set<CH> MCCollapser::checkRegion(const vector<CH>& blocks) const
+{
+    set<VH> nodes;
+    if (_checkMC)
+        for (CH b : blocks)
+            for (VH n : mcMeshProps().mesh().cell_vertices(b))
+                nodes.insert(n);
+    return checkRegion(nodes);
+}
+
+void MCCollapser::checkMCAfter(const std::string& operation, const set<CH>& region) const
+{
+    if (!_checkMC)
+        return;
+    if (!checkLocalMC(region))
+    {
+        LOG(ERROR) << "MC became inconsistent by " << operation;
+        throw std::logic_error("MC became inconsistent by " + operation);
+    }
+}
+
+void MCCollapser::checkMCAfter(const vector<std::string>& operations, const vector<set<CH>>& regions) const
+{
+    if (!_checkMC)
+        return;
+    assert(operations.size() == regions.size());
+    // Checking only reads the tet mesh and MC, once no classification is left to be computed lazily
+    if (_parallelBatchChecks)
+    {
+        meshProps().updateClassification();
+        assert(meshProps().isClassificationUpToDate());
+    }
+    vector<char> consistent(regions.size(), true);
+#ifdef C4HEX_WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) if (_parallelBatchChecks)
+#endif
+    for (int i = 0; i < (int)regions.size(); i++)
+        consistent[i] = checkLocalMC(regions[i]);
+    for (int i = 0; i < (int)regions.size(); i++)
+        if (!consistent[i])
+        {
+            LOG(ERROR) << "MC became inconsistent by " << operations[i];
+            throw std::logic_error("MC became inconsistent by " + operations[i]);
+        }
+}
+
 bool MCCollapser::hasZeroLengthArcs() const
 {
     for (EH a : mcMeshProps().mesh().edges())
@@ -131,7 +230,8 @@ HEH MCCollapser::preferredCollapseHalfarc(const EH& a) const
     return ha0;
 }
 
-MCCollapser::RetCode MCCollapser::collapseAllZeroElements(bool optimize, bool randomOrder, int direction)
+MCCollapser::RetCode
+MCCollapser::collapseAllZeroElements(bool optimize, bool randomOrder, int direction, bool batchArcs)
 {
     auto& mcMesh = mcMeshProps().mesh();
     auto& tetMesh = meshProps().mesh();
@@ -140,9 +240,11 @@ MCCollapser::RetCode MCCollapser::collapseAllZeroElements(bool optimize, bool ra
 
     assertValidMC(true, true);
 
-    LOG(INFO) << "Collapsing randomOrder: " << randomOrder << " and direction: " << direction;
+    LOG(INFO) << "Collapsing randomOrder: " << randomOrder << ", direction: " << direction
+              << " and batchArcs: " << batchArcs;
     _randomOrder = randomOrder;
     _direction = direction;
+    _batchArcs = batchArcs;
 
     MCReducer reducer(meshProps());
 
@@ -209,7 +311,8 @@ MCCollapser::RetCode MCCollapser::collapseAllZeroElements(bool optimize, bool ra
         }
 
         if (collapseNextPillowBlock() || collapseNextPillowPatch() || bisectNextBlockByPillowPatch()
-            || collapseNextZeroArc() || bisectNextAlmostPillowPatch(false) || bisectNextAlmostPillowBlock())
+            || (_batchArcs ? collapseZeroArcBatch() > 0 : collapseNextZeroArc()) || bisectNextAlmostPillowPatch(false)
+            || bisectNextAlmostPillowBlock())
         {
             change = true;
             continue;
@@ -288,6 +391,15 @@ MCCollapser::RetCode MCCollapser::collapseAllZeroElements(bool optimize, bool ra
 }
 
 MCCollapser::RetCode MCCollapser::collapseHalfarc(const HEH& haCollapse)
+{
+    auto& mcMesh = mcMeshProps().mesh();
+    auto region = checkRegion(set<VH>{mcMesh.from_vertex_handle(haCollapse), mcMesh.to_vertex_handle(haCollapse)});
+    collapseHalfarcUnchecked(haCollapse);
+    checkMCAfter("collapse of halfarc " + std::to_string(haCollapse.idx()), region);
+    return SUCCESS;
+}
+
+void MCCollapser::collapseHalfarcUnchecked(const HEH& haCollapse)
 {
     TemporaryPropAllocator<TetMeshProps, CHILD_CELLS, CHILD_FACES, CHILD_EDGES, CHILD_HALFFACES, CHILD_HALFEDGES>
         propGuard(meshProps());
@@ -297,7 +409,6 @@ MCCollapser::RetCode MCCollapser::collapseHalfarc(const HEH& haCollapse)
     collapseArcConnectivity(haCollapse);
 
     assertValidMC(false, false);
-    return SUCCESS;
 }
 
 MCCollapser::RetCode MCCollapser::collapsePillowPatch(const FH& pCollapse, const set<HEH>& has)
@@ -307,12 +418,15 @@ MCCollapser::RetCode MCCollapser::collapsePillowPatch(const FH& pCollapse, const
     HEH haStationary = *(++has.begin());
 
     determineStationaryEnd(haMoving, haStationary);
+    auto fvs = mcMeshProps().mesh().face_vertices(pCollapse);
+    auto region = checkRegion(set<VH>(fvs.first, fvs.second));
     auto ret = EmbeddingCollapser(meshProps()).collapsePillowPatchEmbedding(pCollapse, haMoving, haStationary);
     if (ret != EmbeddingCollapser::SUCCESS)
         throw std::logic_error("Rerouting failed");
     collapsePillowPatchConnectivity(pCollapse, haMoving, haStationary);
 
     assertValidMC(false, false);
+    checkMCAfter("collapse of pillow patch " + std::to_string(pCollapse.idx()), region);
     return SUCCESS;
 }
 
@@ -329,10 +443,13 @@ MCCollapser::RetCode MCCollapser::collapsePillowBlock(const CH& bCollapse)
     HFH hpMoving = *(++itHps);
 
     determineStationaryEnd(hpMoving, hpStationary);
+    auto cvs = mcMeshProps().mesh().cell_vertices(bCollapse);
+    auto region = checkRegion(set<VH>(cvs.first, cvs.second));
     EmbeddingCollapser(meshProps()).collapsePillowBlockEmbedding(bCollapse, hpMoving, hpStationary);
     collapsePillowBlockConnectivity(bCollapse, hpMoving, hpStationary);
 
     assertValidMC(false, false);
+    checkMCAfter("collapse of pillow block " + std::to_string(bCollapse.idx()), region);
     return SUCCESS;
 }
 
@@ -341,10 +458,13 @@ MCCollapser::RetCode MCCollapser::collapseCigarBlock(const CH& bCollapse)
     LOG(INFO) << "Collapsing cigar block " << bCollapse;
 
     HFH hpCigar = *mcMeshProps().mesh().chf_iter(bCollapse);
+    auto cvs = mcMeshProps().mesh().cell_vertices(bCollapse);
+    auto region = checkRegion(set<VH>(cvs.first, cvs.second));
     EmbeddingCollapser(meshProps()).collapseCigarBlockEmbedding(bCollapse);
     collapsePillowBlockConnectivity(bCollapse, hpCigar, HFH());
 
     assertValidMC(false, false);
+    checkMCAfter("collapse of cigar block " + std::to_string(bCollapse.idx()), region);
     return SUCCESS;
 }
 
@@ -651,10 +771,83 @@ void MCCollapser::collapsePillowBlockConnectivity(const CH& b, const HFH& hpRemo
 }
 
 bool MCCollapser::collapseNextZeroArc()
+{
+    DLOG(INFO) << "Looking for 0-arc to collapse";
+
+    for (EH a : zeroArcsInCollapseOrder())
+    {
+        HEH haPreferred = preferredCollapseHalfarc(a);
+        if (!haPreferred.is_valid())
+            continue;
+
+        collapseHalfarc(haPreferred);
+        return true;
+    }
+    return false;
+}
+
+int MCCollapser::collapseZeroArcBatch()
 {
     auto& mcMesh = mcMeshProps().mesh();
 
-    DLOG(INFO) << "Looking for 0-arc to collapse";
+    DLOG(INFO) << "Looking for independent 0-arcs to collapse";
+
+    // Lock state and preferred direction only read the tet mesh and MC, but random directions have to be drawn in
+    // order
+    vector<EH> asZero = zeroArcsInCollapseOrder();
+    vector<HEH> hasPreferred(asZero.size());
+    if (_parallelBatchChecks)
+    {
+        meshProps().updateClassification();
+        assert(meshProps().isClassificationUpToDate());
+    }
+#ifdef C4HEX_WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (_parallelBatchChecks && _direction != 1)
+#endif
+    for (int i = 0; i < (int)asZero.size(); i++)
+        hasPreferred[i] = preferredCollapseHalfarc(asZero[i]);
+
+    vector<bool> bTaken(mcMesh.n_cells(), false);
+    vector<HEH> batch;
+    for (int i = 0; i < (int)asZero.size(); i++)
+    {
+        HEH haPreferred = hasPreferred[i];
+        if (!haPreferred.is_valid())
+            continue;
+
+        set<CH> bsAround;
+        for (VH n : mcMesh.edge_vertices(asZero[i]))
+            for (CH b : mcMesh.vertex_cells(n))
+                if (b.is_valid())
+                    bsAround.insert(b);
+        if (containsMatching(bsAround, [&](const CH& b) { return bTaken[b.idx()]; }))
+            continue;
+        for (CH b : bsAround)
+            bTaken[b.idx()] = true;
+        batch.push_back(haPreferred);
+    }
+    if (batch.empty())
+        return 0;
+
+    LOG(INFO) << "Collapsing batch of " << batch.size() << " independent 0-arcs";
+    // The regions are disjoint, so the collapses can be checked together once the whole batch is done
+    vector<std::string> operations;
+    vector<set<CH>> regions;
+    for (HEH ha : batch)
+    {
+        assert(!mcMesh.is_deleted(ha) && isZeroArc(mcMesh.edge_handle(ha)) && !collapseIsLocked(ha));
+        operations.emplace_back("collapse of halfarc " + std::to_string(ha.idx()));
+        regions.emplace_back(checkRegion(set<VH>{mcMesh.from_vertex_handle(ha), mcMesh.to_vertex_handle(ha)}));
+        collapseHalfarcUnchecked(ha);
+    }
+    checkMCAfter(operations, regions);
+    _nArcBatches++;
+    return batch.size();
+}
+
+vector<EH> MCCollapser::zeroArcsInCollapseOrder() const
+{
+    auto& mcMesh = mcMeshProps().mesh();
 
     vector<EH> asZero;
     for (EH a : mcMesh.edges())
@@ -673,16 +866,7 @@ bool MCCollapser::collapseNextZeroArc()
                   { return mcMeshProps().get<ARC_DBL_LENGTH>(a) < mcMeshProps().get<ARC_DBL_LENGTH>(b); });
     if (!asZero.empty())
         assert(mcMeshProps().get<ARC_DBL_LENGTH>(asZero.front()) <= mcMeshProps().get<ARC_DBL_LENGTH>(asZero.back()));
-    for (EH a : asZero)
-    {
-        HEH haPreferred = preferredCollapseHalfarc(a);
-        if (!haPreferred.is_valid())
-            continue;
-
-        collapseHalfarc(haPreferred);
-        return true;
-    }
-    return false;
+    return asZero;
 }
 
 bool MCCollapser::collapseNextPillowPatch()
@@ -761,11 +945,15 @@ bool MCCollapser::bisectNextAlmostPillowPatch(bool allowZeroLoop)
         auto itPair = mcMesh.halfface_halfedges(mcMesh.halfface_handle(p, 0));
         size_t numHas = std::distance(itPair.first, itPair.second);
         vector<FH> psSub;
+        auto fvs = mcMesh.face_vertices(p);
+        auto region = numHas > 3 ? checkRegion(set<VH>(fvs.first, fvs.second)) : set<CH>();
         if (numHas > 3 && _refiner.bisectPatchAcrossDir(p, UVWDir::ANY, allowZeroLoop, psSub))
         {
             LOG(INFO) << "Bisected patch " << p;
             _nBisectionsP++;
             assertValidMC(false, false);
+            region.merge(checkRegion(psSub));
+            checkMCAfter("bisection of almost-pillow patch " + std::to_string(p.idx()), region);
             return true;
         }
     }
@@ -808,11 +996,15 @@ bool MCCollapser::bisectNextZeroPatch(bool allowZeroLoop)
             }
         }
         vector<FH> psSub;
+        auto fvs = mcMesh.face_vertices(p);
+        auto region = zeroDir != UVWDir::NONE ? checkRegion(set<VH>(fvs.first, fvs.second)) : set<CH>();
         if (zeroDir != UVWDir::NONE && _refiner.bisectPatchAcrossDir(p, zeroDir, allowZeroLoop, psSub))
         {
             LOG(INFO) << "Bisected patch " << p;
             _nBisectionsP++;
             assertValidMC(false, false);
+            region.merge(checkRegion(psSub));
+            checkMCAfter("bisection of 0-patch " + std::to_string(p.idx()), region);
             return true;
         }
     }
@@ -835,12 +1027,16 @@ bool MCCollapser::bisectNextAlmostPillowBlock()
             if (hps.size() <= 2)
                 continue;
             vector<CH> subBlocks;
+            auto cvs = mcMesh.cell_vertices(b);
+            auto region = checkRegion(set<VH>(cvs.first, cvs.second));
             bool refined = _refiner.bisectBlockOrPatch(b, subBlocks);
             if (refined)
             {
                 LOG(INFO) << "Bisected block " << b;
                 _nBisectionsB++;
                 assertValidMC(false, false);
+                region.merge(checkRegion(subBlocks));
+                checkMCAfter("bisection of almost-pillow block " + std::to_string(b.idx()), region);
                 return true;
             }
         }
@@ -940,7 +1136,7 @@ bool MCCollapser::bisectNextBlockByPillowPatch()
                             }
                             set<EH> ringEs;
                             for (EH a : ringAs)
-                                for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(a))
+                                for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a))
                                     ringEs.insert(tetMesh.edge_handle(he));
                             HFH hfSeed = hfs.front();
                             set<HFH> hfsVisited({hfSeed});
@@ -977,9 +1173,14 @@ bool MCCollapser::bisectNextBlockByPillowPatch()
                                     sstr2 << ringHa << ", ";
                                 LOG(INFO) << "...which has the following halfarcs on its boundary: " << sstr2.str();
                                 vector<CH> subBlocks;
+                                auto cvs = mcMesh.cell_vertices(b);
+                                auto region = checkRegion(set<VH>(cvs.first, cvs.second));
                                 _refiner.cutBlock(b, ringHas, subBlocks);
                                 _nBisectionsP++;
                                 assertValidMC(false, false);
+                                region.merge(checkRegion(subBlocks));
+                                checkMCAfter("bisection of block " + std::to_string(b.idx()) + " by a pillow patch",
+                                             region);
                                 return true;
                             }
                         }
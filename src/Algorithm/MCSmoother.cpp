@@ -4,6 +4,8 @@
 #include "C4Hex/Algorithm/SurfaceRouter.hpp"
 #include <MC3D/Algorithm/TetRemesher.hpp>
 
+#include <utility>
+
 namespace c4hex
 {
 
@@ -104,7 +106,7 @@ void MCSmoother::smoothMC()
         for (FH p : mcMesh.edge_faces(a))
         {
             p2trans[p] = mcMeshProps().ref<PATCH_TRANSITION>(p);
-            p2hfs[p] = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p);
+            p2hfs[p] = std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p);
         }
 
         // Order patches incident on a starting from hp
@@ -139,7 +141,7 @@ void MCSmoother::smoothMC()
                 if (b.is_valid())
                     bs.insert(b);
         for (CH b : bs)
-            b2tets[b] = mcMeshProps().ref<BLOCK_MESH_TETS>(b);
+            b2tets[b] = std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b);
         _blocksChanged = bs;
         if (refloodFillBlocks() != SUCCESS)
         {
@@ -195,7 +197,7 @@ void MCSmoother::smoothMC()
         EH a = _aReroute;
         collectAllowedRegionAroundArc(_aReroute);
 
-        auto hesA = mcMeshProps().ref<ARC_MESH_HALFEDGES>(a);
+        auto hesA = std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a);
 
         bool change = false;
         auto ret = reroute(a, &change);
@@ -210,7 +212,7 @@ void MCSmoother::smoothMC()
         for (FH p2 : mcMesh.edge_faces(a))
         {
             p2trans[p2] = mcMeshProps().ref<PATCH_TRANSITION>(p2);
-            p2hfs[p2] = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p2);
+            p2hfs[p2] = std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p2);
         }
 
         // Order patches incident on a starting from hp
@@ -246,7 +248,7 @@ void MCSmoother::smoothMC()
                 if (b.is_valid())
                     bs.insert(b);
         for (CH b : bs)
-            b2tets[b] = mcMeshProps().ref<BLOCK_MESH_TETS>(b);
+            b2tets[b] = std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b);
         _blocksChanged = bs;
         if (refloodFillBlocks() != SUCCESS)
         {
@@ -371,7 +373,7 @@ void MCSmoother::collectAllowedRegionAroundArc(const EH& aIn)
                 bs.insert(b);
     for (CH b : bs)
     {
-        for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+        for (CH tet : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b))
         {
             if (tetMesh.is_deleted(tet))
                 throw std::logic_error("Tet deleted before inserting into allowedspace");
@@ -393,7 +395,7 @@ void MCSmoother::collectAllowedRegionAroundArc(const EH& aIn)
             {
                 boundaryPs.insert(p);
                 _b2unaffectedPs[b].push_back(p);
-                for (HFH element : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+                for (HFH element : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
                     _forbiddenFs.insert(tetMesh.face_handle(element));
             }
         }
@@ -413,11 +415,11 @@ void MCSmoother::collectAllowedRegionAroundArc(const EH& aIn)
 
     for (FH p : ps)
         if (!contains(mcMesh.face_edges(p), aIn))
-            for (HFH element : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+            for (HFH element : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
                 _forbiddenFs.insert(tetMesh.face_handle(element));
     for (EH a : as)
         if (a != aIn)
-            for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(a))
+            for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a))
                 _forbiddenEs.insert(tetMesh.edge_handle(he));
     for (VH n : ns)
         _forbiddenVs.insert(mcMeshProps().get<NODE_MESH_VERTEX>(n));
@@ -438,7 +440,7 @@ void MCSmoother::collectAllowedRegionAroundArc(const EH& aIn)
             if (bs.count(bNext) != 0)
             {
                 DLOG(INFO) << "Splitting toroidal allowed space by marking some faces splitters";
-                for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+                for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
                 {
                     for (VH v : meshProps().get_halfface_vertices(hf))
                         _torusSplitterV.insert(v);
@@ -483,7 +485,7 @@ void MCSmoother::collectAllowedRegionAroundArc(const EH& aIn)
             }
             if (bVisited.size() != allBs.size())
             {
-                for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(a))
+                for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a))
                 {
                     for (VH v : tetMesh.halfedge_vertices(he))
                         _torusSplitterV.insert(v);
@@ -538,7 +540,7 @@ void MCSmoother::collectAllowedRegionAroundArc(const EH& aIn)
                 pBoundary.insert(he);
         for (HEH he : pBoundary)
             boundaryVs.insert(tetMesh.from_vertex_handle(he));
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
             surfaceFs.insert(tetMesh.face_handle(hf));
         _p2boundary[p] = pBoundary;
         if (!mcMesh.is_boundary(p))
@@ -628,7 +630,7 @@ MCSmoother::RetCode MCSmoother::refloodFillBlocks()
             ps.insert(p);
         assert(ps.count(pSeed) != 0);
         for (FH p : ps)
-            for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+            for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
                 if (tetMesh.is_deleted(hf))
                 {
                     LOG(ERROR) << "Floodfilling block failed, because a boundary patch halfface is deleted";
@@ -897,18 +899,18 @@ MCSmoother::RetCode MCSmoother::reroute(const FH& p)
     if (!mcMesh.is_boundary(p))
     {
         set<VH> boundaryVs;
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
             for (EH e : tetMesh.halfface_edges(hf))
             {
                 int n = 0;
                 for (HFH hf2 : tetMesh.edge_halffaces(e))
-                    if (mcMeshProps().ref<PATCH_MESH_HALFFACES>(p).count(hf2) != 0)
+                    if (std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p).count(hf2) != 0)
                         n++;
                 if (n != 2)
                     for (VH v : tetMesh.edge_vertices(e))
                         boundaryVs.insert(v);
             }
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
             for (VH v : meshProps().get_halfface_vertices(hf))
                 if (boundaryVs.count(v) == 0 && tetMesh.is_boundary(v))
                     throw std::logic_error("Non-boundary patch touches boundary before rerouting");
@@ -1122,7 +1124,7 @@ void MCSmoother::updateArcEmbedding(const EH& a, list<HEH>& hesA)
     auto& tetMesh = meshProps().mesh();
 
     meshProps().replaceByChildren(hesA);
-    for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(a))
+    for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a))
     {
         if (meshProps().get<MC_ARC>(tetMesh.edge_handle(he)) == a)
         {
@@ -1143,7 +1145,7 @@ void MCSmoother::updatePatchEmbedding(const FH& p, set<HFH>& hfsP, Transition* t
     auto& tetMesh = meshProps().mesh();
 
     meshProps().replaceByChildren(hfsP);
-    for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+    for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
     {
         if (meshProps().get<MC_PATCH>(tetMesh.face_handle(hf)) == p)
         {
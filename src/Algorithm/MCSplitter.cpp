@@ -8,6 +8,7 @@
 
 
 #include <fstream>
+#include <utility>
 
 namespace c4hex
 {
@@ -120,7 +121,7 @@ bool MCSplitter::bisectPatchAcrossDir(const FH& p, UVWDir dir, bool allowLoop, v
         else
         {
             double length = 0.0;
-            for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(aSplitting))
+            for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(aSplitting))
                 length += edgeLengthUVW<CHART>(tetMesh.edge_handle(he));
             mcMeshProps().set<ARC_DBL_LENGTH>(aSplitting, length);
         }
@@ -399,7 +400,7 @@ VH MCSplitter::findVertexAtLengthFraction(const EH& a, double frac)
 {
     auto& tetMesh = meshProps().mesh();
 
-    auto& aHes = mcMeshProps().ref<ARC_MESH_HALFEDGES>(a);
+    const auto& aHes = std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a);
     if (aHes.size() == 1)
         splitHalfEdge(aHes.front(), *tetMesh.hec_iter(aHes.front()), Q(0.5));
     assert(aHes.size() >= 2);
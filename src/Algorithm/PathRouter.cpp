@@ -3,6 +3,7 @@
 
 #include <fstream>
 #include <queue>
+#include <utility>
 
 
 namespace c4hex
@@ -274,7 +275,7 @@ PathRouter::RetCode PathRouter::shortestPathThroughVolume(const VH& vFrom,
     {
         set<CH> tetVisited({seedTet});
         list<pair<CH, Transition>> tetQ({{seedTet, Transition()}});
-        Vec3Q uvwFrom = meshProps().ref<CHART>(seedTet).at(vFrom);
+        Vec3Q uvwFrom = std::as_const(meshProps()).ref<CHART>(seedTet).at(vFrom);
         Vec3Q uvwTo;
         while (!tetQ.empty())
         {
@@ -283,7 +284,7 @@ PathRouter::RetCode PathRouter::shortestPathThroughVolume(const VH& vFrom,
 
             if (contains(tetMesh.tet_vertices(tetTrans.first), vTo))
             {
-                uvwTo = tetTrans.second.invert().apply(meshProps().ref<CHART>(tetTrans.first).at(vTo));
+                uvwTo = tetTrans.second.invert().apply(std::as_const(meshProps()).ref<CHART>(tetTrans.first).at(vTo));
                 break;
             }
 
@@ -330,7 +331,7 @@ PathRouter::RetCode PathRouter::shortestPathThroughVolume(const VH& vFrom,
                         tetMesh.tet_vertices(tetNext),
                         [&, this](const VH& v)
                         {
-                            Vec3Q uvw = transNext.invert().apply(meshProps().ref<CHART>(tetNext).at(v));
+                            Vec3Q uvw = transNext.invert().apply(std::as_const(meshProps()).ref<CHART>(tetNext).at(v));
                             return uvw[0] <= bboxMax[0] && uvw[0] >= bboxMin[0] && uvw[1] <= bboxMax[1]
                                    && uvw[1] >= bboxMin[1] && uvw[2] <= bboxMax[2] && uvw[2] >= bboxMin[2];
                         });
@@ -830,7 +831,7 @@ PathRouter::RetCode PathRouter::reroutePathThroughPatch(const FH& p, list<HEH>&
     if (vFrom == vTo)
         LOG(WARNING) << "WARNING: Trying to reroute path between identical from/to vertex, this probably does not work";
     _p = p;
-    auto& pHfs = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p);
+    const auto& pHfs = std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p);
 
     set<VH> forbiddenVs;
     set<EH> forbiddenEs;
@@ -850,7 +851,7 @@ PathRouter::RetCode PathRouter::reroutePathThroughPatch(const FH& p, list<HEH>&
                      != 0;
 
         for (EH a : mcMesh.face_edges(p))
-            for (HEH he : mcMeshProps().ref<ARC_MESH_HALFEDGES>(a))
+            for (HEH he : std::as_const(mcMeshProps()).ref<ARC_MESH_HALFEDGES>(a))
             {
                 forbiddenEs.insert(tetMesh.edge_handle(he));
                 for (VH v : tetMesh.halfedge_vertices(he))
@@ -1049,7 +1050,7 @@ PathRouter::RetCode PathRouter::refineToAllowReroute(const FH& p, const VH& vFro
     auto& tetMesh = meshProps().mesh();
 
     // Split all edges that connect 2 arc vertices but are not arcs themselves
-    auto& pHfs = mcMeshProps().ref<PATCH_MESH_HALFFACES>(p);
+    const auto& pHfs = std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p);
     for (HFH hf : pHfs)
         for (EH e : tetMesh.halfface_edges(hf))
             if (meshProps().isInArc(e))
@@ -1187,7 +1188,7 @@ void PathRouter::reroute(list<HEH>& pathRerouted,
 {
     auto& tetMesh = meshProps().mesh();
     HEH heCurrent = *pathIt;
-    auto& pHfs = mcMeshProps().ref<PATCH_MESH_HALFFACES>(_p);
+    const auto& pHfs = std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(_p);
     hfsTransferred.insert(getTransferredHf(heCurrent));
 
     if (addedHes.size() == 2 && currentVs.find(tetMesh.to_vertex_handle(addedHes.front())) != currentVs.end())
@@ -1,6 +1,7 @@
 #include "C4Hex/Algorithm/SurfaceRouter.hpp"
 
 #include <fstream>
+#include <utility>
 
 #include <ClpSimplex.hpp>
 
@@ -130,7 +131,7 @@ SurfaceRouter::RetCode SurfaceRouter::calcMinimalSurfaceByLP(set<CH>& space,
 #ifdef MINIMIZE_XYZ
                     pos.emplace_back(tetMesh.vertex(v));
 #else
-                    pos.emplace_back(Vec3Q2d(meshProps().ref<CHART>(tet).at(v)));
+                    pos.emplace_back(Vec3Q2d(std::as_const(meshProps()).ref<CHART>(tet).at(v)));
 #endif
                 double area = ((pos[2] - pos[0]) % (pos[1] - pos[0])).length();
                 area = std::max(area, 1e-6 * (1 + (double)rand() / RAND_MAX));
@@ -551,7 +552,7 @@ SurfaceRouter::minimalSurfaceThroughBlock(const CH& b, set<HFH>& surface, set<CH
 
     // Floodfill space between old and new surface to find transferred tets
     vector<bool> tetVisited(tetMesh.n_cells(), false);
-    for (CH tetSeed : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tetSeed : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b))
     {
         if (tetVisited[tetSeed.idx()])
             continue;
@@ -1315,7 +1316,7 @@ SurfaceRouter::RetCode SurfaceRouter::refineToAllowReroute(const CH& b, set<HFH>
 
     set<EH> esCut;
     set<FH> fsSplit;
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b))
     {
         for (EH e : tetMesh.cell_edges(tet))
             if (esCut.find(e) == esCut.end() && _forbiddenEs.find(e) == _forbiddenEs.end()
@@ -1679,7 +1680,7 @@ void SurfaceRouter::setForbiddenElements(const CH& b)
     _forbiddenEs.clear();
     _forbiddenVs.clear();
 
-    for (CH tet : mcMeshProps().ref<BLOCK_MESH_TETS>(b))
+    for (CH tet : std::as_const(mcMeshProps()).ref<BLOCK_MESH_TETS>(b))
         for (HFH hf : tetMesh.cell_halffaces(tet))
             if (meshProps().isBlockBoundary(hf))
                 _forbiddenFs.insert(tetMesh.face_handle(hf));
@@ -0,0 +1,198 @@
+#include "C4Hex/Interface/HexMeshStreamWriter.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+
+namespace c4hex
+{
+
+// VTK cell types
+static constexpr int VTK_LINE = 3;
+static constexpr int VTK_QUAD = 9;
+static constexpr int VTK_HEXAHEDRON = 12;
+
+// Width reserved for the vertex count, which is only known after all vertices have been streamed
+static constexpr int COUNT_WIDTH = 20;
+
+HexMeshStreamWriter::HexMeshStreamWriter(const std::string& filename)
+    : _filename(filename), _nVertices(0), _nCells(0), _nConnectivity(0), _nHexes(0)
+{
+}
+
+HexMeshStreamWriter::~HexMeshStreamWriter()
+{
+    for (int spool = 0; spool < N_SPOOLS; spool++)
+        if (_spools[spool].is_open())
+        {
+            _spools[spool].close();
+            std::remove(spoolName(spool).c_str());
+        }
+}
+
+HexMeshStreamWriter::RetCode HexMeshStreamWriter::begin()
+{
+    _out.open(_filename, std::ios::binary);
+    if (!_out.good())
+    {
+        LOG(ERROR) << "Could not write to file " << _filename;
+        return FILE_INACCESSIBLE;
+    }
+    for (int spool = 0; spool < N_SPOOLS; spool++)
+    {
+        _spools[spool].open(spoolName(spool),
+                            std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+        if (!_spools[spool].good())
+        {
+            LOG(ERROR) << "Could not write to temporary file " << spoolName(spool);
+            return FILE_INACCESSIBLE;
+        }
+    }
+
+    LOG(INFO) << "Streaming hex mesh to " << _filename;
+
+    _out << "# vtk DataFile Version 3.0\n"
+         << "C4Hex hex mesh\n"
+         << "BINARY\n"
+         << "DATASET UNSTRUCTURED_GRID\n"
+         << "POINTS ";
+    _nPointsPos = _out.tellp();
+    _out << std::left << std::setw(COUNT_WIDTH) << 0 << " double\n";
+    return SUCCESS;
+}
+
+int HexMeshStreamWriter::addVertex(const Vec3d& xyz, int nodeID, int featureV)
+{
+    for (int coord = 0; coord < 3; coord++)
+        writeBE(_out, xyz[coord]);
+    writeBE(_spools[NODE_ID], nodeID);
+    writeBE(_spools[FEATURE_V], featureV);
+    return _nVertices++;
+}
+
+void HexMeshStreamWriter::addArcSegment(const array<int, 2>& vs, int arcID, int featureE, bool singular)
+{
+    addCell(vs.data(), 2, VTK_LINE, -1, -1, arcID, featureE, singular ? 1 : 0);
+}
+
+void HexMeshStreamWriter::addPatchQuad(const array<int, 4>& vs, int patchID, int featureF)
+{
+    addCell(vs.data(), 4, VTK_QUAD, -1, patchID, -1, featureF, 0);
+}
+
+void HexMeshStreamWriter::addHex(const array<int, 8>& vs, int blockID)
+{
+    addCell(vs.data(), 8, VTK_HEXAHEDRON, blockID, -1, -1, 0, 0);
+    _nHexes++;
+}
+
+void HexMeshStreamWriter::addCell(
+    const int* vs, int n, int type, int blockID, int patchID, int arcID, int feature, int singular)
+{
+    writeBE(_spools[CONNECTIVITY], n);
+    for (int i = 0; i < n; i++)
+    {
+        assert(vs[i] >= 0 && vs[i] < _nVertices);
+        writeBE(_spools[CONNECTIVITY], vs[i]);
+    }
+    writeBE(_spools[CELL_TYPE], type);
+    writeBE(_spools[BLOCK_ID], blockID);
+    writeBE(_spools[PATCH_ID], patchID);
+    writeBE(_spools[ARC_ID], arcID);
+    writeBE(_spools[FEATURE], feature);
+    writeBE(_spools[SINGULAR], singular);
+    _nCells++;
+    _nConnectivity += n + 1;
+}
+
+HexMeshStreamWriter::RetCode HexMeshStreamWriter::finish()
+{
+    auto appendSpool = [this](int spool)
+    {
+        // Streaming an empty buffer would set the failbit of _out
+        bool empty = _spools[spool].tellp() == 0;
+        _spools[spool].flush();
+        _spools[spool].seekg(0);
+        if (!empty)
+            _out << _spools[spool].rdbuf();
+        _out << "\n";
+    };
+
+    _out << "\nCELLS " << _nCells << " " << _nConnectivity << "\n";
+    appendSpool(CONNECTIVITY);
+    _out << "CELL_TYPES " << _nCells << "\n";
+    appendSpool(CELL_TYPE);
+
+    _out << "CELL_DATA " << _nCells << "\n";
+    for (auto spoolAndName : {std::make_pair(BLOCK_ID, "MC_BLOCK_ID"),
+                              std::make_pair(PATCH_ID, "MC_PATCH_ID"),
+                              std::make_pair(ARC_ID, "MC_ARC_ID"),
+                              std::make_pair(FEATURE, "FEATURE"),
+                              std::make_pair(SINGULAR, "IS_SINGULAR")})
+    {
+        _out << "SCALARS " << spoolAndName.second << " int 1\nLOOKUP_TABLE default\n";
+        appendSpool(spoolAndName.first);
+    }
+
+    _out << "POINT_DATA " << _nVertices << "\n";
+    for (auto spoolAndName : {std::make_pair(NODE_ID, "MC_NODE_ID"), std::make_pair(FEATURE_V, "IS_FEATURE_V")})
+    {
+        _out << "SCALARS " << spoolAndName.second << " int 1\nLOOKUP_TABLE default\n";
+        appendSpool(spoolAndName.first);
+    }
+
+    _out.seekp(_nPointsPos);
+    _out << std::left << std::setw(COUNT_WIDTH) << _nVertices;
+    _out.close();
+
+    for (int spool = 0; spool < N_SPOOLS; spool++)
+    {
+        _spools[spool].close();
+        std::remove(spoolName(spool).c_str());
+    }
+
+    if (_out.fail())
+    {
+        LOG(ERROR) << "Could not write to file " << _filename;
+        return FILE_INACCESSIBLE;
+    }
+    LOG(INFO) << "Streamed " << _nVertices << " vertices and " << _nHexes << " hexes to " << _filename;
+    return SUCCESS;
+}
+
+int HexMeshStreamWriter::nVertices() const
+{
+    return _nVertices;
+}
+
+size_t HexMeshStreamWriter::nHexes() const
+{
+    return _nHexes;
+}
+
+void HexMeshStreamWriter::writeBE(std::ostream& out, int32_t val)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    char bytes[4];
+    for (int i = 0; i < 4; i++)
+        bytes[i] = (char)((bits >> (8 * (3 - i))) & 0xff);
+    out.write(bytes, 4);
+}
+
+void HexMeshStreamWriter::writeBE(std::ostream& out, double val)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    char bytes[8];
+    for (int i = 0; i < 8; i++)
+        bytes[i] = (char)((bits >> (8 * (7 - i))) & 0xff);
+    out.write(bytes, 8);
+}
+
+std::string HexMeshStreamWriter::spoolName(int spool) const
+{
+    return _filename + ".spool" + std::to_string(spool);
+}
+
+} // namespace c4hex
@@ -3,9 +3,11 @@
 #include "C4Hex/Algorithm/HexExtractor.hpp"
 
 #include "OpenVolumeMesh/FileManager/FileManager.hh"
+#include "OpenVolumeMesh/IO/ovmb_write.hh"
 
 #include <fstream>
 #include <iomanip>
+#include <utility>
 
 namespace c4hex
 {
@@ -28,6 +30,24 @@ HexRemesher::RetCode HexRemesher::extractPolyHexMesh(PolyMeshProps& hexMeshProps
     return SUCCESS;
 }
 
+HexRemesher::RetCode HexRemesher::streamHexMesh(const std::string& filename)
+{
+    HexMeshStreamWriter writer(filename);
+    if (writer.begin() != HexMeshStreamWriter::SUCCESS)
+        return FILE_INACCESSIBLE;
+
+    // Only holds the MC skeleton
+    HexMesh skeletonMesh;
+    HexMeshProps skeletonProps(skeletonMesh);
+    HexExtractor<HexMeshProps> hexex(meshProps(), skeletonProps);
+    if (hexex.extractHexMesh(writer) != HexExtractor<HexMeshProps>::SUCCESS)
+        return MISSING_GRID_VERTEX;
+
+    if (writer.finish() != HexMeshStreamWriter::SUCCESS)
+        return FILE_INACCESSIBLE;
+    return SUCCESS;
+}
+
 HexRemesher::RetCode HexRemesher::extractMCMesh(PolyMeshProps& polyMeshProps)
 {
     map<VH, VH> v2v;
@@ -55,7 +75,7 @@ HexRemesher::RetCode HexRemesher::extractMCMesh(PolyMeshProps& polyMeshProps)
         set<VH> vs;
         set<EH> es;
         set<FH> fs;
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
             fs.insert(meshProps().mesh().face_handle(hf));
         for (FH f : fs)
             for (EH e : meshProps().mesh().face_edges(f))
@@ -111,7 +131,7 @@ HexRemesher::RetCode HexRemesher::extractMCMesh(PolyMeshProps& polyMeshProps)
                 }
             }
         auto& phfsNew = p2hfsNew[p];
-        for (HFH hf : mcMeshProps().ref<PATCH_MESH_HALFFACES>(p))
+        for (HFH hf : std::as_const(mcMeshProps()).ref<PATCH_MESH_HALFFACES>(p))
         {
             vector<VH> hfvs;
             for (VH v : meshProps().mesh().halfface_vertices(hf))
@@ -144,233 +164,236 @@ HexRemesher::RetCode HexRemesher::extractMCMesh(PolyMeshProps& polyMeshProps)
 
 HexRemesher::RetCode HexRemesher::smoothSurface(HexMeshProps& hexMeshProps, int iter)
 {
-    HexMesh& hexMesh = hexMeshProps.mesh();
+    return smoothSurfaceImpl(hexMeshProps, iter);
+}
 
-    vector<VH> vs;
-    vs.reserve(hexMesh.n_logical_vertices());
-    for (VH v : hexMesh.vertices())
-        if (hexMesh.is_boundary(v))
-            vs.push_back(v);
-    for (VH v : hexMesh.vertices())
-        if (!hexMesh.is_boundary(v))
-            vs.push_back(v);
-    for (int i = 0; i < iter; i++)
+HexRemesher::RetCode HexRemesher::smoothSurface(PolyMeshProps& hexMeshProps, int iter)
+{
+    return smoothSurfaceImpl(hexMeshProps, iter);
+}
+
+template <typename MESHPROPS>
+HexRemesher::RetCode HexRemesher::smoothSurfaceImpl(MESHPROPS& hexMeshProps, int iter)
+{
+    auto& hexMesh = hexMeshProps.mesh();
+    if (iter <= 0)
+        return SUCCESS;
+
+    auto isFixed = [&](const VH& v)
     {
-        for (VH v : vs)
+        if (hexMeshProps.template get<IS_FEATURE_V>(v))
+            return true;
+        for (FH f : hexMesh.vertex_faces(v))
+            if (hexMeshProps.template get<IS_FEATURE_F>(f))
+                return true;
+        for (EH e : hexMesh.vertex_edges(v))
+            if (hexMeshProps.template get<IS_FEATURE_E>(e))
+                return true;
+        for (EH e : hexMesh.vertex_edges(v))
+            if (hexMesh.is_boundary(e) && hexMeshProps.template get<IS_SINGULAR>(e))
+                return true;
+        return false;
+    };
+
+    // Stencils of all movable vertices in CSR layout, boundary vertices first. Boundary vertices only consider
+    // neighbors along boundary edges and keep the first, second and fourth corner of each incident boundary face
+    // (which span its normal)
+    vector<int> vs;
+    int nBoundary = 0;
+    vector<int> nbOffsets(1, 0);
+    vector<int> nbs;
+    vector<int> hfOffsets(1, 0);
+    vector<array<int, 3>> hfCorners;
+    for (bool boundaryPass : {true, false})
+        for (VH v : hexMesh.vertices())
         {
             bool isBoundary = hexMesh.is_boundary(v);
-
-            bool onFeature = hexMeshProps.get<IS_FEATURE_V>(v);
-            if (!onFeature)
-                for (FH f : hexMesh.vertex_faces(v))
-                    if (hexMeshProps.get<IS_FEATURE_F>(f))
-                        onFeature = true;
-            if (!onFeature)
-                for (EH e : hexMesh.vertex_edges(v))
-                    if (hexMeshProps.get<IS_FEATURE_E>(e))
-                        onFeature = true;
-            if (!onFeature)
-                for (EH e : hexMesh.vertex_edges(v))
-                    if (hexMesh.is_boundary(e) && hexMeshProps.get<IS_SINGULAR>(e))
-                        onFeature = true;
-            if (onFeature)
+            if (isBoundary != boundaryPass || isFixed(v))
                 continue;
 
-            {
-                Vec3d avgPos(0, 0, 0);
-                int numNeighbors = 0;
-                for (HEH he : hexMesh.outgoing_halfedges(v))
+            int nNeighbors = 0;
+            for (HEH he : hexMesh.outgoing_halfedges(v))
+                if (!isBoundary || hexMesh.is_boundary(hexMesh.edge_handle(he)))
                 {
-                    VH otherVert = hexMesh.to_vertex_handle(he);
-                    // For each neighbour
-                    if (!isBoundary || hexMesh.is_boundary(hexMesh.edge_handle(he)))
-                    {
-                        Vec3d pos = hexMesh.vertex(otherVert);
-                        avgPos += pos;
-                        numNeighbors++;
-                    }
+                    nbs.emplace_back(hexMesh.to_vertex_handle(he).idx());
+                    nNeighbors++;
                 }
-                avgPos /= numNeighbors;
-                Vec3d newPos = (avgPos + hexMesh.vertex(v)) / 2.0;
-
-                if (isBoundary)
-                {
-                    Vec3d avgNormal(0, 0, 0);
-                    for (HFH hf : hexMesh.vertex_halffaces(v))
+            if (nNeighbors == 0)
+            {
+                nbs.resize(nbOffsets.back());
+                continue;
+            }
+            if (isBoundary)
+                for (HFH hf : hexMesh.vertex_halffaces(v))
+                    if (hexMesh.is_boundary(hf))
                     {
-                        if (hexMesh.is_boundary(hf))
-                        {
-                            std::vector<Vec3d> vertices;
-                            for (VH vHF : hexMesh.halfface_vertices(hf))
-                                vertices.emplace_back(hexMesh.vertex(vHF));
-                            Vec3d normal = (vertices[1] - vertices[0]) % (vertices[3] - vertices[0]);
-                            normal.normalize();
-                            avgNormal += normal;
-                        }
+                        auto hfVs = hexMesh.get_halfface_vertices(hf);
+                        hfCorners.push_back({hfVs[0].idx(), hfVs[1].idx(), hfVs[3].idx()});
                     }
-                    avgNormal.normalize();
 
-                    bool tooSpread = false;
-                    for (HFH hf : hexMesh.vertex_halffaces(v))
-                    {
-                        if (hexMesh.is_boundary(hf))
-                        {
-                            std::vector<Vec3d> vertices;
-                            for (VH vHF : hexMesh.halfface_vertices(hf))
-                                vertices.emplace_back(hexMesh.vertex(vHF));
-                            Vec3d normal = (vertices[1] - vertices[0]) % (vertices[3] - vertices[0]);
-                            normal.normalize();
-                            if ((avgNormal | normal) < 0.8)
-                            {
-                                tooSpread = true;
-                                break;
-                            }
-                        }
-                    }
-                    if (tooSpread)
-                        continue;
+            vs.emplace_back(v.idx());
+            nbOffsets.emplace_back((int)nbs.size());
+            hfOffsets.emplace_back((int)hfCorners.size());
+            if (isBoundary)
+                nBoundary++;
+        }
 
-                    Vec3d diff = newPos - hexMesh.vertex(v);
-                    double dist = diff | avgNormal;
-                    newPos = newPos - dist * avgNormal;
-                }
+    vector<double> xyz(3 * hexMesh.n_vertices());
+    for (VH v : hexMesh.vertices())
+        for (int coord = 0; coord < 3; coord++)
+            xyz[3 * v.idx() + coord] = hexMesh.vertex(v)[coord];
+    vector<double> xyzNew(xyz);
 
-                hexMesh.set_vertex(v, newPos);
+    auto pos = [&xyz](int v)
+    {
+        return Vec3d(xyz[3 * v], xyz[3 * v + 1], xyz[3 * v + 2]);
+    };
+    auto normal = [&pos](const array<int, 3>& corners)
+    {
+        Vec3d n = (pos(corners[1]) - pos(corners[0])) % (pos(corners[2]) - pos(corners[0]));
+        return n.normalize();
+    };
+
+    // Jacobi sweep over vs[begin, end)
+    auto sweep = [&](int begin, int end)
+    {
+#ifdef C4HEX_WITH_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = begin; i < end; i++)
+        {
+            int v = vs[i];
+            Vec3d avgPos(0, 0, 0);
+            for (int j = nbOffsets[i]; j < nbOffsets[i + 1]; j++)
+                avgPos += pos(nbs[j]);
+            avgPos /= nbOffsets[i + 1] - nbOffsets[i];
+            Vec3d newPos = (avgPos + pos(v)) / 2.0;
+
+            if (i < nBoundary)
+            {
+                Vec3d avgNormal(0, 0, 0);
+                for (int j = hfOffsets[i]; j < hfOffsets[i + 1]; j++)
+                    avgNormal += normal(hfCorners[j]);
+                avgNormal.normalize();
+
+                bool tooSpread = false;
+                for (int j = hfOffsets[i]; j < hfOffsets[i + 1] && !tooSpread; j++)
+                    tooSpread = (avgNormal | normal(hfCorners[j])) < 0.8;
+                if (tooSpread)
+                    continue;
+
+                double dist = (newPos - pos(v)) | avgNormal;
+                newPos = newPos - dist * avgNormal;
             }
-        }
-    }
-    return SUCCESS;
-}
 
-HexRemesher::RetCode HexRemesher::smoothSurface(PolyMeshProps& hexMeshProps, int iter)
-{
-    PolyMesh& hexMesh = hexMeshProps.mesh();
+            for (int coord = 0; coord < 3; coord++)
+                xyzNew[3 * v + coord] = newPos[coord];
+        }
+        for (int i = begin; i < end; i++)
+            for (int coord = 0; coord < 3; coord++)
+                xyz[3 * vs[i] + coord] = xyzNew[3 * vs[i] + coord];
+    };
 
-    vector<VH> vs;
-    vs.reserve(hexMesh.n_logical_vertices());
-    for (VH v : hexMesh.vertices())
-        if (hexMesh.is_boundary(v))
-            vs.push_back(v);
-    for (VH v : hexMesh.vertices())
-        if (!hexMesh.is_boundary(v))
-            vs.push_back(v);
     for (int i = 0; i < iter; i++)
     {
-        for (VH v : vs)
-        {
-            bool isBoundary = hexMesh.is_boundary(v);
+        sweep(0, nBoundary);
+        sweep(nBoundary, (int)vs.size());
+    }
 
-            bool onFeature = hexMeshProps.get<IS_FEATURE_V>(v);
-            if (!onFeature)
-                for (FH f : hexMesh.vertex_faces(v))
-                    if (hexMeshProps.get<IS_FEATURE_F>(f))
-                        onFeature = true;
-            if (!onFeature)
-                for (EH e : hexMesh.vertex_edges(v))
-                    if (hexMeshProps.get<IS_FEATURE_E>(e))
-                        onFeature = true;
-            if (!onFeature)
-                for (EH e : hexMesh.vertex_edges(v))
-                    if (hexMesh.is_boundary(e) && hexMeshProps.get<IS_SINGULAR>(e))
-                        onFeature = true;
-            if (onFeature)
-                continue;
+    for (int v : vs)
+        hexMesh.set_vertex(VH(v), pos(v));
 
-            {
-                Vec3d avgPos(0, 0, 0);
-                int numNeighbors = 0;
-                for (HEH he : hexMesh.outgoing_halfedges(v))
-                {
-                    VH otherVert = hexMesh.to_vertex_handle(he);
-                    // For each neighbour
-                    if (!isBoundary || hexMesh.is_boundary(hexMesh.edge_handle(he)))
-                    {
-                        Vec3d pos = hexMesh.vertex(otherVert);
-                        avgPos += pos;
-                        numNeighbors++;
-                    }
-                }
-                avgPos /= numNeighbors;
-                Vec3d newPos = (avgPos + hexMesh.vertex(v)) / 2.0;
+    return SUCCESS;
+}
 
-                if (isBoundary)
-                {
-                    Vec3d avgNormal(0, 0, 0);
-                    for (HFH hf : hexMesh.vertex_halffaces(v))
-                    {
-                        if (hexMesh.is_boundary(hf))
-                        {
-                            std::vector<Vec3d> vertices;
-                            for (VH vHF : hexMesh.halfface_vertices(hf))
-                                vertices.emplace_back(hexMesh.vertex(vHF));
-                            Vec3d normal = (vertices[1] - vertices[0]) % (vertices[3] - vertices[0]);
-                            normal.normalize();
-                            avgNormal += normal;
-                        }
-                    }
-                    avgNormal.normalize();
-                    bool tooSpread = false;
-                    for (HFH hf : hexMesh.vertex_halffaces(v))
-                    {
-                        if (hexMesh.is_boundary(hf))
-                        {
-                            std::vector<Vec3d> vertices;
-                            for (VH vHF : hexMesh.halfface_vertices(hf))
-                                vertices.emplace_back(hexMesh.vertex(vHF));
-                            Vec3d normal = (vertices[1] - vertices[0]) % (vertices[3] - vertices[0]);
-                            normal.normalize();
-                            if ((avgNormal | normal) < 0.8)
-                            {
-                                tooSpread = true;
-                                break;
-                            }
-                        }
-                    }
-                    if (tooSpread)
-                        continue;
+HexRemesher::RetCode
+HexRemesher::writeHexMesh(const HexMeshProps& hexMeshProps, const std::string& filename, FileFormat format) const
+{
+    if (format != VTK_BINARY)
+        return writeOVM(hexMeshProps.mesh(), filename, format == OVM_BINARY);
 
-                    Vec3d diff = newPos - hexMesh.vertex(v);
-                    double dist = diff | avgNormal;
-                    newPos = newPos - dist * avgNormal;
-                }
+    const HexMesh& hexMesh = hexMeshProps.mesh();
 
-                hexMesh.set_vertex(v, newPos);
-            }
+    HexMeshStreamWriter writer(filename);
+    if (writer.begin() != HexMeshStreamWriter::SUCCESS)
+        return FILE_INACCESSIBLE;
+
+    for (VH v : hexMesh.vertices())
+        writer.addVertex(
+            hexMesh.vertex(v), hexMeshProps.get<MC_NODE_ID>(v), hexMeshProps.get<IS_FEATURE_V>(v));
+    for (EH e : hexMesh.edges())
+        if (hexMeshProps.get<MC_ARC_ID>(e) != -1)
+            writer.addArcSegment({hexMesh.from_vertex_handle(hexMesh.halfedge_handle(e, 0)).idx(),
+                                  hexMesh.to_vertex_handle(hexMesh.halfedge_handle(e, 0)).idx()},
+                                 hexMeshProps.get<MC_ARC_ID>(e),
+                                 hexMeshProps.get<IS_FEATURE_E>(e),
+                                 hexMeshProps.get<IS_SINGULAR>(e));
+    for (FH f : hexMesh.faces())
+        if (hexMeshProps.get<MC_PATCH_ID>(f) != -1)
+        {
+            array<int, 4> vs;
+            int i = 0;
+            for (VH v : hexMesh.halfface_vertices(hexMesh.halfface_handle(f, 0)))
+                vs[i++] = v.idx();
+            writer.addPatchQuad(vs, hexMeshProps.get<MC_PATCH_ID>(f), hexMeshProps.get<IS_FEATURE_F>(f));
         }
+    for (CH c : hexMesh.cells())
+    {
+        // OVM orders the vertices of a hex as front face (0,1,2,3) and back face (4,5,6,7) with 4 behind 0 and 5
+        // behind 3, VTK as bottom face (0,1,2,3) and top face (4,5,6,7) with 4+i above i
+        vector<VH> ovmVs;
+        for (VH v : hexMesh.hex_vertices(c))
+            ovmVs.emplace_back(v);
+        assert(ovmVs.size() == 8);
+        writer.addHex({ovmVs[0].idx(),
+                       ovmVs[1].idx(),
+                       ovmVs[2].idx(),
+                       ovmVs[3].idx(),
+                       ovmVs[4].idx(),
+                       ovmVs[7].idx(),
+                       ovmVs[6].idx(),
+                       ovmVs[5].idx()},
+                      hexMeshProps.get<MC_BLOCK_ID>(c));
     }
+
+    if (writer.finish() != HexMeshStreamWriter::SUCCESS)
+        return FILE_INACCESSIBLE;
     return SUCCESS;
 }
 
-HexRemesher::RetCode HexRemesher::writeHexMesh(const HexMeshProps& hexMeshProps, const std::string& filename) const
+HexRemesher::RetCode
+HexRemesher::writePolyHexMesh(const PolyMeshProps& hexMeshProps, const std::string& filename, FileFormat format) const
 {
-    std::ofstream out(filename);
-    if (!out.good())
-    {
-        LOG(ERROR) << "Could not write to file " << filename;
-        return FILE_INACCESSIBLE;
-    }
-    out << std::setprecision(std::numeric_limits<double>::max_digits10);
-
-    LOG(INFO) << "Writing extracted hex mesh to " << filename;
-
-    OVM::IO::FileManager().writeStream(out, hexMeshProps.mesh());
-
-    return SUCCESS;
+    if (format == VTK_BINARY)
+        LOG(WARNING) << "VTK output is only supported for hex meshes, writing binary OVM instead";
+    return writeOVM(hexMeshProps.mesh(), filename, format != OVM_ASCII);
 }
 
-HexRemesher::RetCode HexRemesher::writePolyHexMesh(const PolyMeshProps& hexMeshProps, const std::string& filename) const
+template <typename MESH>
+HexRemesher::RetCode HexRemesher::writeOVM(const MESH& mesh, const std::string& filename, bool binary) const
 {
-    std::ofstream out(filename);
+    std::ofstream out(filename, binary ? std::ios::out | std::ios::binary : std::ios::out);
     if (!out.good())
     {
         LOG(ERROR) << "Could not write to file " << filename;
         return FILE_INACCESSIBLE;
     }
-    out << std::setprecision(std::numeric_limits<double>::max_digits10);
 
     LOG(INFO) << "Writing extracted hex mesh to " << filename;
 
-    OVM::IO::FileManager().writeStream(out, hexMeshProps.mesh());
+    if (binary)
+    {
+        if (OVM::IO::ovmb_write(out, mesh) != OVM::IO::WriteResult::Ok)
+        {
+            LOG(ERROR) << "Could not write to file " << filename;
+            return FILE_INACCESSIBLE;
+        }
+    }
+    else
+    {
+        out << std::setprecision(std::numeric_limits<double>::max_digits10);
+        OVM::IO::FileManager().writeStream(out, mesh);
+    }
 
     return SUCCESS;
 }
@@ -3,7 +3,9 @@
 #include "C4Hex/Algorithm/IGMInitializer.hpp"
 #include "C4Hex/Algorithm/IGMUntangler.hpp"
 
-#include <MC3D/Algorithm/TetRemesher.hpp>
+#include <MC3D/Mesh/MCEmbeddingIndex.hpp>
+
+#include <chrono>
 
 namespace c4hex
 {
@@ -14,39 +16,86 @@ IGMGenerator::IGMGenerator(TetMeshProps& meshProps)
 {
 }
 
-IGMGenerator::RetCode IGMGenerator::generateBlockwiseIGM(bool simplifyBaseMesh, int maxInnerIter, int maxUntanglingIter)
+IGMGenerator::RetCode IGMGenerator::generateBlockwiseIGM(bool simplifyBaseMesh,
+                                                         int maxInnerIter,
+                                                         int maxUntanglingIter,
+                                                         RemeshSchedule schedule,
+                                                         int snapDenominatorBits)
 {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    bool adaptive = schedule == RemeshSchedule::ADAPTIVE;
+    _passCosts.clear();
+    _nUntanglingIter = 0;
+    _initSeconds = 0.0;
+    _untangleSeconds = 0.0;
     TetRemesher remesher(meshProps());
+    // Tet collapses/splits mark the affected blocks dirty, only those are re-gathered on update
+    MCEmbeddingIndex embedding(*meshProps().get<MC_MESH_PROPS>());
+
+    auto logInvertedBlocks = [&]()
+    {
+        embedding.update();
+        for (CH b : mcMeshProps().mesh().cells())
+        {
+            int nInvalidUVW = 0;
+            for (CH tet : embedding.blockTets(b))
+                if (rationalVolumeIGM(tet) <= 0)
+                    nInvalidUVW++;
+            if (nInvalidUVW > 0)
+                LOG(INFO) << "Block " << b << " nTetsInvalidIGM " << nInvalidUVW;
+        }
+    };
+
+    auto timedCollapse = [&](bool onlyNonOriginals, bool keepInjectivity, bool considerAngles, double angleBound)
+    {
+        auto passStart = std::chrono::high_resolution_clock::now();
+        int nCollapsed = remesher.collapseAllPossibleEdges(
+            onlyNonOriginals, true, keepInjectivity, considerAngles, angleBound);
+        LOG(INFO) << "Collapse pass (angle bound " << angleBound << ") took "
+                  << std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - passStart).count()
+                  << "s";
+        return nCollapsed;
+    };
 
     if (simplifyBaseMesh)
     {
         LOG(INFO) << "Simplifying base mesh to simplify IGM computation";
+        for (double angleBound : {30, 20, 10, 5, 2})
+        {
+            meshProps().allocate<TOUCHED>(true);
+            size_t nTetsPre = meshProps().mesh().n_logical_cells();
+            int nCollapsed = timedCollapse(false, true, true, angleBound);
+            // Each further (less restrictive) bound costs another full pass, stop when returns diminish
+            if (adaptive && nCollapsed < 0.001 * nTetsPre)
+                break;
+        }
         meshProps().allocate<TOUCHED>(true);
-        remesher.collapseAllPossibleEdges(false, true, true, true, 30);
-        meshProps().allocate<TOUCHED>(true);
-        remesher.collapseAllPossibleEdges(false, true, true, true, 20);
-        meshProps().allocate<TOUCHED>(true);
-        remesher.collapseAllPossibleEdges(false, true, true, true, 10);
-        meshProps().allocate<TOUCHED>(true);
-        remesher.collapseAllPossibleEdges(false, true, true, true, 5);
-        meshProps().allocate<TOUCHED>(true);
-        remesher.collapseAllPossibleEdges(false, true, true, true, 2);
-        meshProps().allocate<TOUCHED>(true);
-        remesher.collapseAllPossibleEdges(false, true, false, true, 5);
+        timedCollapse(false, false, true, 5);
     }
     else
-        remesher.collapseAllPossibleEdges(true, true, true, true, 5);
+        timedCollapse(true, true, true, 5);
 
     IGMInitializer init(meshProps());
-    auto retInit = init.initializeFromQuantization();
+    auto timedInitialization = [&]()
+    {
+        auto initStart = std::chrono::high_resolution_clock::now();
+        auto ret = init.initializeFromQuantization();
+        // A failed initialization may leave the IGM incomplete
+        if (snapDenominatorBits > 0 && (ret == IGMInitializer::SUCCESS || ret == IGMInitializer::INVALID_ELEMENTS))
+            init.snapInteriorIGM(snapDenominatorBits);
+        _initSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - initStart).count();
+        return ret;
+    };
+
+    auto retInit = timedInitialization();
     if (retInit != IGMInitializer::SUCCESS && retInit != IGMInitializer::INVALID_ELEMENTS)
         return INITIALIZATION_ERROR;
     if (simplifyBaseMesh)
     {
         meshProps().allocate<TOUCHED>(true);
-        remesher.collapseAllPossibleEdges(false, true, true, true, 20);
+        timedCollapse(false, true, true, 20);
         // Initialize again, hoping for less refinement
-        retInit = init.initializeFromQuantization();
+        retInit = timedInitialization();
         if (retInit != IGMInitializer::SUCCESS && retInit != IGMInitializer::INVALID_ELEMENTS)
             return INITIALIZATION_ERROR;
 
@@ -55,65 +104,86 @@ IGMGenerator::RetCode IGMGenerator::generateBlockwiseIGM(bool simplifyBaseMesh,
     }
 
     LOG(INFO) << "After initializing the IGM via naive 3D tutte, the following blocks have inversions:";
-    for (CH b : mcMeshProps().mesh().cells())
-    {
-        int nInvalidUVW = 0;
-        for (CH tet : mcMeshProps().get<BLOCK_MESH_TETS>(b))
-            if (rationalVolumeIGM(tet) <= 0)
-                nInvalidUVW++;
-        if (nInvalidUVW > 0)
-            LOG(INFO) << "Block " << b << " nTetsInvalidIGM " << nInvalidUVW;
-    }
+    logInvertedBlocks();
     LOG(INFO) << "...proceeding to IGM untangling";
 
     IGMUntangler optimizer(meshProps());
     auto retUntangling = IGMUntangler::NO_CONVERGENCE;
     for (int i = 0; i < maxUntanglingIter && retUntangling != IGMUntangler::SUCCESS; i++)
     {
+        _nUntanglingIter++;
         double areaVsAngles = 0.5 + (((i + 1) % 3) - 1) * (0.49);
+        auto untangleStart = std::chrono::high_resolution_clock::now();
         retUntangling = optimizer.untangleIGM(
             areaVsAngles,
             i < 0.75 * maxUntanglingIter ? maxInnerIter
                                          : (i < 0.9 * maxUntanglingIter ? 3 * maxInnerIter : 10 * maxInnerIter));
+        if (snapDenominatorBits > 0
+            && (retUntangling == IGMUntangler::SUCCESS || retUntangling == IGMUntangler::NO_CONVERGENCE))
+            init.snapInteriorIGM(snapDenominatorBits);
+        _untangleSeconds
+            += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - untangleStart).count();
         if (retUntangling != IGMUntangler::SUCCESS && retUntangling != IGMUntangler::NO_CONVERGENCE)
             return UNTANGLING_ERROR;
         if (retUntangling != IGMUntangler::SUCCESS)
         {
             // Mark valid blocks as excluded
             set<CH> excludedBlocks;
+            embedding.update();
             for (CH b : mcMeshProps().mesh().cells())
-                if (!containsMatching(meshProps().get<MC_MESH_PROPS>()->get<BLOCK_MESH_TETS>(b),
+                if (!containsMatching(embedding.blockTets(b),
                                       [&](const CH& tet) { return rationalVolumeIGM(tet) <= 0; }))
                     excludedBlocks.insert(b);
             meshProps().allocate<TOUCHED>(true);
-            // Mark vertices not incident on non-excluded block excluded
-            for (auto v : meshProps().mesh().vertices())
-                if (findNoneOf(meshProps().mesh().vertex_cells(v), excludedBlocks).is_valid())
-                    meshProps().set<TOUCHED>(v, false);
 
-            // Try different remeshing/collapsing variations to improve condition of untangling problem
-            if (simplifyBaseMesh)
+            if (adaptive)
             {
-                if (i % 3 == 0)
-                {
-                    if (i < 0.75 * maxUntanglingIter)
-                        remesher.remeshToImproveAngles(
-                            true, true, TetRemesher::QualityMeasure::ANGLES, 0, excludedBlocks);
-                    else
-                        remesher.remeshToImproveAngles(
-                            true, true, TetRemesher::QualityMeasure::VL_RATIO, 0, excludedBlocks);
-                }
-                else if (i % 3 == 1)
-                    remesher.collapseAllPossibleEdges(simplifyBaseMesh, true, true, true, 5);
-                else
-                    remesher.collapseAllPossibleEdges(simplifyBaseMesh, true, true, true, 0);
+                // Only seed passes from vertices of still tangled blocks
+                for (auto v : meshProps().mesh().vertices())
+                    if (!containsMatching(meshProps().mesh().vertex_cells(v),
+                                          [&](const CH& tet)
+                                          { return excludedBlocks.count(meshProps().get<MC_BLOCK>(tet)) == 0; }))
+                        meshProps().set<TOUCHED>(v, false);
+
+                vector<RemeshPass> candidates;
+                if (simplifyBaseMesh)
+                    candidates.push_back(i < 0.75 * maxUntanglingIter ? RemeshPass::REMESH_ANGLES
+                                                                      : RemeshPass::REMESH_VL_RATIO);
+                candidates.push_back(RemeshPass::COLLAPSE_BOUNDED);
+                candidates.push_back(RemeshPass::COLLAPSE_UNBOUNDED);
+                RemeshPass pass;
+                if (chooseRemeshPass(candidates, pass))
+                    runRemeshPass(remesher, pass, excludedBlocks);
             }
             else
             {
-                if (i % 3 == 2)
-                    remesher.collapseAllPossibleEdges(true, true, true, true, 0);
+                // Mark vertices not incident on non-excluded block excluded
+                for (auto v : meshProps().mesh().vertices())
+                    if (findNoneOf(meshProps().mesh().vertex_cells(v), excludedBlocks).is_valid())
+                        meshProps().set<TOUCHED>(v, false);
+
+                // Try different remeshing/collapsing variations to improve condition of untangling problem
+                if (simplifyBaseMesh)
+                {
+                    if (i % 3 == 0)
+                    {
+                        if (i < 0.75 * maxUntanglingIter)
+                            runRemeshPass(remesher, RemeshPass::REMESH_ANGLES, excludedBlocks);
+                        else
+                            runRemeshPass(remesher, RemeshPass::REMESH_VL_RATIO, excludedBlocks);
+                    }
+                    else if (i % 3 == 1)
+                        runRemeshPass(remesher, RemeshPass::COLLAPSE_BOUNDED, {});
+                    else
+                        runRemeshPass(remesher, RemeshPass::COLLAPSE_UNBOUNDED, {});
+                }
                 else
-                    remesher.collapseAllPossibleEdges(true, true, true, true, 5);
+                {
+                    if (i % 3 == 2)
+                        runRemeshPass(remesher, RemeshPass::COLLAPSE_UNBOUNDED, {});
+                    else
+                        runRemeshPass(remesher, RemeshPass::COLLAPSE_BOUNDED, {});
+                }
             }
 
             if (i > 5)
@@ -131,10 +201,11 @@ IGMGenerator::RetCode IGMGenerator::generateBlockwiseIGM(bool simplifyBaseMesh,
                     init.splitSomeNecessaryForInjectiveInterior();
                 else
                 {
+                    const set<CH>& blockedBlocks = adaptive ? excludedBlocks : set<CH>();
                     if (i < 3)
-                        remesher.collapseAllPossibleEdges(!simplifyBaseMesh, true, true, true, 10);
+                        remesher.collapseAllPossibleEdges(!simplifyBaseMesh, true, true, true, 10, blockedBlocks);
                     else
-                        remesher.collapseAllPossibleEdges(!simplifyBaseMesh, true, true, false, 0);
+                        remesher.collapseAllPossibleEdges(!simplifyBaseMesh, true, true, false, 0, blockedBlocks);
                 }
             }
             optimizer.reset();
@@ -146,23 +217,126 @@ IGMGenerator::RetCode IGMGenerator::generateBlockwiseIGM(bool simplifyBaseMesh,
     else
         remesher.collapseAllPossibleEdges(true, true, true, true, 5);
 
+    for (auto& kv : _passCosts)
+        LOG(INFO) << "Remesh pass " << remeshPassName(kv.first) << ": " << kv.second.nRuns << " runs, "
+                  << kv.second.nChanges << " changes, " << kv.second.seconds << "s";
+    LOG(INFO) << "IGM generation (" << (adaptive ? "adaptive" : "fixed") << " remesh schedule) took "
+              << std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count() << "s";
+    // The exact sweep over all tets only serves to compare the adaptive schedule against the fixed one
+    if (adaptive)
+        LOG(INFO) << "Inverted tets remaining after adaptive remeshing: " << nInvertedTetsIGM();
+
     if (retUntangling == IGMUntangler::NO_CONVERGENCE)
     {
         LOG(INFO) << "Some inverted tets remain in IGM in the following blocks:";
         init.minimizeCutSurface();
-        for (CH b : mcMeshProps().mesh().cells())
-        {
-            int nInvalidUVW = 0;
-            for (CH tet : mcMeshProps().get<BLOCK_MESH_TETS>(b))
-                if (rationalVolumeIGM(tet) <= 0)
-                    nInvalidUVW++;
-            if (nInvalidUVW > 0)
-                LOG(INFO) << "Block " << b << " nTetsInvalidIGM " << nInvalidUVW;
-        }
+        logInvertedBlocks();
         return NO_CONVERGENCE;
     }
 
     return SUCCESS;
 }
 
+const char* IGMGenerator::remeshPassName(RemeshPass pass)
+{
+    switch (pass)
+    {
+    case RemeshPass::REMESH_ANGLES:
+        return "REMESH_ANGLES";
+    case RemeshPass::REMESH_VL_RATIO:
+        return "REMESH_VL_RATIO";
+    case RemeshPass::COLLAPSE_BOUNDED:
+        return "COLLAPSE_BOUNDED";
+    case RemeshPass::COLLAPSE_UNBOUNDED:
+        return "COLLAPSE_UNBOUNDED";
+    }
+    return "";
+}
+
+int IGMGenerator::runRemeshPass(TetRemesher& remesher, RemeshPass pass, const set<CH>& blockedBlocks)
+{
+    auto passStart = std::chrono::high_resolution_clock::now();
+    int nChanges = 0;
+    switch (pass)
+    {
+    case RemeshPass::REMESH_ANGLES:
+        nChanges = remesher.remeshToImproveAngles(true, true, TetRemesher::QualityMeasure::ANGLES, 0, blockedBlocks);
+        break;
+    case RemeshPass::REMESH_VL_RATIO:
+        nChanges
+            = remesher.remeshToImproveAngles(true, true, TetRemesher::QualityMeasure::VL_RATIO, 0, blockedBlocks);
+        break;
+    case RemeshPass::COLLAPSE_BOUNDED:
+        nChanges = remesher.collapseAllPossibleEdges(true, true, true, true, 5, blockedBlocks);
+        break;
+    case RemeshPass::COLLAPSE_UNBOUNDED:
+        nChanges = remesher.collapseAllPossibleEdges(true, true, true, true, 0, blockedBlocks);
+        break;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - passStart).count();
+    LOG(INFO) << "Remesh pass " << remeshPassName(pass) << " performed " << nChanges << " changes in " << seconds
+              << "s";
+
+    auto& cost = _passCosts[pass];
+    cost.nRuns++;
+    cost.nChanges += nChanges;
+    cost.seconds += seconds;
+    cost.changedInLastRun = nChanges > 0;
+    return nChanges;
+}
+
+bool IGMGenerator::chooseRemeshPass(const vector<RemeshPass>& candidates, RemeshPass& pass)
+{
+    bool chosen = false;
+    double bestYield = -1.0;
+    for (RemeshPass candidate : candidates)
+    {
+        auto& cost = _passCosts[candidate];
+        if (cost.nRuns == 0)
+        {
+            // Never run, costs unknown
+            pass = candidate;
+            return true;
+        }
+        if (!cost.changedInLastRun)
+        {
+            // Skip once, give it another chance in the next round
+            cost.changedInLastRun = true;
+            continue;
+        }
+        double yield = cost.nChanges / (cost.seconds + 1e-3);
+        if (yield > bestYield)
+        {
+            bestYield = yield;
+            pass = candidate;
+            chosen = true;
+        }
+    }
+    return chosen;
+}
+
+int IGMGenerator::nUntanglingIterations() const
+{
+    return _nUntanglingIter;
+}
+
+double IGMGenerator::initializationSeconds() const
+{
+    return _initSeconds;
+}
+
+double IGMGenerator::untanglingSeconds() const
+{
+    return _untangleSeconds;
+}
+
+int IGMGenerator::nInvertedTetsIGM() const
+{
+    int nInverted = 0;
+    for (CH tet : meshProps().mesh().cells())
+        if (rationalVolumeIGM(tet) <= 0)
+            nInverted++;
+    return nInverted;
+}
+
 } // namespace c4hex
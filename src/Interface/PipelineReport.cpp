@@ -0,0 +1,216 @@
+#include "C4Hex/Interface/PipelineReport.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#endif
+
+namespace c4hex
+{
+
+namespace
+{
+std::string jsonString(const std::string& str)
+{
+    std::string escaped = "\"";
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            // Control characters are only valid as \u escapes
+            char hex[7];
+            std::snprintf(hex, sizeof(hex), "\\u%04x", (unsigned)(unsigned char)c);
+            escaped += hex;
+        }
+        else
+            escaped += c;
+    }
+    return escaped + "\"";
+}
+
+std::string jsonNumber(double value)
+{
+    // JSON has no representation of NaN or infinity
+    if (!std::isfinite(value))
+        return "null";
+    std::ostringstream out;
+    out << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+    return out.str();
+}
+
+#ifdef __linux__
+size_t procStatusKB(const std::string& key)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':')
+            return std::stoul(line.substr(key.size() + 1));
+    return 0;
+}
+#endif
+} // namespace
+
+PipelineReport::PipelineReport(const std::string& filename) : _filename(filename), _start(Clock::now())
+{
+}
+
+void PipelineReport::beginStage(const std::string& name)
+{
+    endStage();
+    resetPeakRSS();
+    _stages.emplace_back();
+    _stages.back().name = name;
+    _stages.back().rssBegin = currentRSS();
+    _stageRunning = true;
+    _stageStart = Clock::now();
+}
+
+void PipelineReport::endStage()
+{
+    if (!_stageRunning)
+        return;
+    Stage& stage = _stages.back();
+    stage.seconds = std::chrono::duration<double>(Clock::now() - _stageStart).count();
+    stage.rssEnd = currentRSS();
+    stage.peakRSS = std::max(peakRSS(), std::max(stage.rssBegin, stage.rssEnd));
+    _stageRunning = false;
+    LOG(INFO) << "Stage " << stage.name << " took " << stage.seconds << "s, peak RSS " << stage.peakRSS / 1024
+              << " MiB";
+}
+
+void PipelineReport::setCounter(const std::string& key, double value)
+{
+    if (_stages.empty())
+        return;
+    for (auto& kv : _stages.back().counters)
+        if (kv.first == key)
+        {
+            kv.second = value;
+            return;
+        }
+    _stages.back().counters.emplace_back(key, value);
+}
+
+void PipelineReport::fail(const std::string& stage, int errorCode)
+{
+    endStage();
+    _failedStage = stage;
+    _errorCode = errorCode;
+}
+
+PipelineReport::RetCode PipelineReport::write()
+{
+    endStage();
+    if (_filename.empty())
+        return SUCCESS;
+
+    std::ofstream out(_filename);
+    if (!out.good())
+    {
+        LOG(ERROR) << "Could not write to file " << _filename;
+        return FILE_INACCESSIBLE;
+    }
+
+    LOG(INFO) << "Writing pipeline report to " << _filename;
+
+    size_t maxPeak = 0;
+    for (const auto& stage : _stages)
+        maxPeak = std::max(maxPeak, stage.peakRSS);
+
+    out << "{\n";
+    out << "  \"status\": " << jsonString(_failedStage.empty() ? "success" : "failed") << ",\n";
+    if (!_failedStage.empty())
+    {
+        out << "  \"failed_stage\": " << jsonString(_failedStage) << ",\n";
+        out << "  \"error_code\": " << _errorCode << ",\n";
+    }
+    out << "  \"total_seconds\": " << jsonNumber(std::chrono::duration<double>(Clock::now() - _start).count())
+        << ",\n";
+    out << "  \"peak_rss_kb\": " << maxPeak << ",\n";
+    out << "  \"stages\": [";
+    for (size_t i = 0; i < _stages.size(); i++)
+    {
+        const Stage& stage = _stages[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\n";
+        out << "      \"name\": " << jsonString(stage.name) << ",\n";
+        out << "      \"seconds\": " << jsonNumber(stage.seconds) << ",\n";
+        out << "      \"rss_begin_kb\": " << stage.rssBegin << ",\n";
+        out << "      \"rss_end_kb\": " << stage.rssEnd << ",\n";
+        out << "      \"peak_rss_kb\": " << stage.peakRSS << ",\n";
+        out << "      \"counters\": {";
+        for (size_t j = 0; j < stage.counters.size(); j++)
+            out << (j == 0 ? "" : ", ") << jsonString(stage.counters[j].first) << ": "
+                << jsonNumber(stage.counters[j].second);
+        out << "}\n";
+        out << "    }";
+    }
+    out << "\n  ]\n}\n";
+
+    return out.good() ? SUCCESS : FILE_INACCESSIBLE;
+}
+
+size_t PipelineReport::currentRSS()
+{
+#ifdef __linux__
+    return procStatusKB("VmRSS");
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS)
+        return 0;
+    return info.resident_size / 1024;
+#else
+    return 0;
+#endif
+}
+
+size_t PipelineReport::peakRSS()
+{
+#ifdef __linux__
+    size_t hwm = procStatusKB("VmHWM");
+    if (hwm != 0)
+        return hwm;
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+#elif defined(__APPLE__)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024;
+#else
+    return 0;
+#endif
+}
+
+bool PipelineReport::resetPeakRSS()
+{
+#ifdef __linux__
+    // Writing 5 to clear_refs resets VmHWM to the current RSS (Linux >= 4.0)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (!clearRefs.good())
+        return false;
+    clearRefs << "5";
+    clearRefs.flush();
+    return clearRefs.good();
+#else
+    return false;
+#endif
+}
+
+} // namespace c4hex
@@ -0,0 +1,134 @@
+#include "C4Hex/Algorithm/IGMInitializer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace c4hex;
+
+class IGMSnappingTest : public ::testing::TestWithParam<int>
+{
+  public:
+    IGMSnappingTest() : meshProps(meshRaw, mcMeshRaw)
+    {
+    }
+
+  protected:
+    /**
+     * @brief Build an n x n x n grid of unit cubes, each split into 6 tets, with a single block bounded by walls.
+     *        The IGM of interior vertices is perturbed by small rationals off the 1/2^k lattice. The center vertex
+     *        is displaced so far that rounding it to a coarse lattice would flatten some of its tets, its 1-ring is
+     *        left unperturbed.
+     */
+    void SetUp() override
+    {
+        const int n = 6;
+        auto vIdx = [n](int i, int j, int k) { return (i * (n + 1) + j) * (n + 1) + k; };
+        for (int i = 0; i <= n; i++)
+            for (int j = 0; j <= n; j++)
+                for (int k = 0; k <= n; k++)
+                {
+                    VH v = meshRaw.add_vertex(Vec3d(i, j, k));
+                    Vec3Q igm(i, j, k);
+                    int distCenter = std::max({std::abs(i - n / 2), std::abs(j - n / 2), std::abs(k - n / 2)});
+                    if (distCenter == 0)
+                    {
+                        vCenter = v;
+                        igm[0] += Q(9, 20);
+                        igm[1] -= Q(9, 20);
+                    }
+                    else if (distCenter > 1 && i > 0 && i < n && j > 0 && j < n && k > 0 && k < n)
+                        for (int coord = 0; coord < 3; coord++)
+                            igm[coord] += Q((v.idx() * (coord + 2)) % 7 - 3, 31);
+                    igms.push_back(igm);
+                }
+
+        meshProps.allocate<CHART_IGM>();
+        const int axes[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                for (int k = 0; k < n; k++)
+                    for (auto& axis : axes)
+                    {
+                        // Kuhn triangulation: walk from the lower to the upper corner along the permuted axes
+                        int ijk[3] = {i, j, k};
+                        vector<VH> vs{VH(vIdx(ijk[0], ijk[1], ijk[2]))};
+                        for (int step = 0; step < 3; step++)
+                        {
+                            ijk[axis[step]]++;
+                            vs.push_back(VH(vIdx(ijk[0], ijk[1], ijk[2])));
+                        }
+                        Vec3d a = meshRaw.vertex(vs[0]);
+                        if (((meshRaw.vertex(vs[1]) - a) % (meshRaw.vertex(vs[2]) - a) | (meshRaw.vertex(vs[3]) - a))
+                            < 0)
+                            std::swap(vs[2], vs[3]);
+                        CH tet = meshRaw.add_cell(vs);
+                        for (VH v : vs)
+                            meshProps.ref<CHART_IGM>(tet)[v] = igms[v.idx()];
+                    }
+
+        meshProps.allocate<IS_WALL>(false);
+        for (FH f : meshRaw.faces())
+            if (meshRaw.is_boundary(f))
+                meshProps.set<IS_WALL>(f, true);
+    }
+
+    void run()
+    {
+        IGMInitializer init(meshProps);
+        set<CH> positiveTets;
+        for (CH tet : meshRaw.cells())
+            if (init.rationalVolumeIGM(tet) > 0)
+                positiveTets.insert(tet);
+        ASSERT_EQ(positiveTets.size(), meshRaw.n_cells());
+
+        int denominatorBits = GetParam();
+        mpz_class den = 1;
+        den <<= denominatorBits;
+        int nSnapped = init.snapInteriorIGM(denominatorBits);
+
+        // Interior vertices are moved onto the lattice or kept, patch vertices are never moved
+        int nMoved = 0;
+        for (VH v : meshRaw.vertices())
+        {
+            Vec3Q igm = meshProps.ref<CHART_IGM>(*meshRaw.vc_iter(v)).at(v);
+            for (CH tet : meshRaw.vertex_cells(v))
+                ASSERT_EQ(meshProps.ref<CHART_IGM>(tet).at(v), igm);
+            if (igm == igms[v.idx()])
+                continue;
+            ASSERT_FALSE(meshProps.isInPatch(v));
+            for (int coord = 0; coord < 3; coord++)
+                ASSERT_EQ(Q(igm[coord] * den).get_den(), 1);
+            nMoved++;
+        }
+        ASSERT_EQ(nMoved, nSnapped);
+        ASSERT_GT(nSnapped, 0);
+
+        for (CH tet : positiveTets)
+            ASSERT_GT(init.rationalVolumeIGM(tet), 0);
+
+        // Up to 1/8, the center vertex would be rounded onto the plane of two of its ring vertices
+        Vec3Q igmCenter = meshProps.ref<CHART_IGM>(*meshRaw.vc_iter(vCenter)).at(vCenter);
+        if (denominatorBits <= 3)
+        {
+            ASSERT_EQ(igmCenter, igms[vCenter.idx()]);
+        }
+        else
+        {
+            ASSERT_NE(igmCenter, igms[vCenter.idx()]);
+        }
+    }
+
+    TetMesh meshRaw;
+    MCMesh mcMeshRaw;
+    TetMeshProps meshProps;
+    vector<Vec3Q> igms; // IGM of each vertex before snapping
+    VH vCenter;         // vertex that can only be snapped to fine lattices
+};
+
+TEST_P(IGMSnappingTest, ItKeepsOrientationsAndSnapsToTheLattice)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(ForDenominatorBits, IGMSnappingTest, ::testing::Values(1, 2, 3, 8));